@@ -13,6 +13,8 @@
  *  History         :
  *      18-06-04    :   Initial version.
  *      19-02-08    :   Additions by Bart Theelen.
+ *      17-10-26    :   CSR matrices and stationary solvers.
+ *      17-10-26    :   Streaming XML parser and binary cache.
  *
  * $Id: base.h,v 1.2.2.4 2010-04-22 06:48:18 mgeilen Exp $
  *
@@ -45,6 +47,7 @@
 
 /* XML */
 #include "xml/xml.h"
+#include "xml/sax.h"
 
 /* Temporary file */
 #include "tempfile/tempfile.h"
@@ -69,6 +72,8 @@
 
 /* Sparse Matrices */
 #include "matrix/matrix.h"
+#include "matrix/csr_matrix.h"
+#include "matrix/stationary.h"
 
 /* MaxPlus algebra */
 #include "maxplus/maxplus.h"
@@ -76,4 +81,10 @@
 /* Lookups (i.e. hash tables)  */
 #include "lookup/clookup.h"
 
+/* Binary cache */
+#include "cache/cache.h"
+
+/* Pool of worker threads */
+#include "parallel/parallel.h"
+
 #endif
@@ -0,0 +1,280 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   cache.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Content-addressed cache of binary files
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "cache.h"
+#include "../exception/exception.h"
+#include "../log/log.h"
+#include <cstdio>
+
+#ifdef _MSC_VER
+#include <direct.h>
+#include <process.h>
+#define getpid _getpid
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Header of a cache entry ("SDF3" in little-endian byte order)
+#define CACHE_MAGIC     0x33464453
+#define CACHE_VERSION   1
+
+/**
+ * CHashContent ()
+ * The function returns the 64-bit FNV-1a hash of a block of memory. Blocks
+ * can be chained by passing the hash of the previous block as seed.
+ */
+CHash CHashContent(const char *data, const size_t size, const CHash seed)
+{
+    CHash h = seed;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        h ^= (unsigned char)data[i];
+        h *= 1099511628211ULL;
+    }
+
+    return h;
+}
+
+/**
+ * open ()
+ * The function maps the file into memory. It returns false when the file
+ * cannot be opened.
+ */
+bool CMappedFile::open(const CString &filename)
+{
+    close();
+
+#ifdef _MSC_VER
+    ifstream in(filename.c_str(), std::ios::binary);
+
+    if (!in.is_open())
+        return false;
+
+    buffer.assign(std::istreambuf_iterator<char>(in),
+                  std::istreambuf_iterator<char>());
+    data = buffer.data();
+    size = buffer.size();
+#else
+    struct stat st;
+    void *p;
+    int fd;
+
+    fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    if (fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // Empty files cannot be mapped
+    if (st.st_size == 0)
+    {
+        ::close(fd);
+        data = "";
+        size = 0;
+        return true;
+    }
+
+    p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+        return false;
+
+    data = (const char *)p;
+    size = st.st_size;
+#endif
+
+    return true;
+}
+
+/**
+ * close ()
+ * The function unmaps the file.
+ */
+void CMappedFile::close()
+{
+#ifdef _MSC_VER
+    buffer.clear();
+#else
+    if (data != NULL && size != 0)
+        munmap((void *)data, size);
+#endif
+
+    data = NULL;
+    size = 0;
+}
+
+/**
+ * getString ()
+ * The function reads a string.
+ */
+CString CBinaryReader::getString()
+{
+    uint len = getUInt();
+
+    if (len > size - pos)
+        throw CException("Unexpected end of binary data.");
+
+    pos += len;
+
+    return CString(std::string(data + pos - len, len));
+}
+
+/**
+ * get ()
+ * The function copies the next n bytes into p.
+ */
+void CBinaryReader::get(void *p, const size_t n)
+{
+    if (n > size - pos)
+        throw CException("Unexpected end of binary data.");
+
+    memcpy(p, data + pos, n);
+    pos += n;
+}
+
+/**
+ * getEntryName ()
+ * The function returns the name of the file that holds an entry.
+ */
+CString CBinaryCache::getEntryName(const CString &kind, const CHash key) const
+{
+    char hex[17];
+
+    snprintf(hex, sizeof(hex), "%016llx", key);
+
+    return dir + "/" + kind + "-" + CString(hex) + ".bin";
+}
+
+/**
+ * find ()
+ * The function maps the entry of the given kind and key. On a hit, it
+ * returns true and the reader points to the payload of the entry. The
+ * payload remains valid as long as the entry is open.
+ */
+bool CBinaryCache::find(const CString &kind, const CHash key,
+                        CMappedFile &entry, CBinaryReader &payload) const
+{
+    if (!entry.open(getEntryName(kind, key)))
+        return false;
+
+    try
+    {
+        CBinaryReader header(entry.getData(), entry.getSize());
+
+        if (header.getUInt() != CACHE_MAGIC
+            || header.getUInt() != CACHE_VERSION
+            || header.getString() != kind
+            || header.getULong() != key)
+        {
+            entry.close();
+            return false;
+        }
+
+        // The payload fills the remainder of the entry
+        unsigned long long sz = header.getULong();
+        if (sz != entry.getSize() - header.getPosition())
+        {
+            entry.close();
+            return false;
+        }
+
+        payload = CBinaryReader(entry.getData() + header.getPosition(), sz);
+    }
+    catch (CException &e)
+    {
+        entry.close();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * store ()
+ * The function stores an entry. The entry is written to a temporary file
+ * which then replaces the entry, so readers never see a partial entry.
+ * Failures are reported as warnings; the cache is only an optimization.
+ */
+void CBinaryCache::store(const CString &kind, const CHash key,
+                         const CBinaryWriter &payload) const
+{
+    CString name = getEntryName(kind, key);
+    CString tmpName = name + "." + CString(getpid()) + ".tmp";
+    CBinaryWriter header;
+    FILE *file;
+    bool ok;
+
+    header.putUInt(CACHE_MAGIC);
+    header.putUInt(CACHE_VERSION);
+    header.putString(kind);
+    header.putULong(key);
+    header.putULong(payload.getBuffer().size());
+
+    // Create the cache directory when needed
+#ifdef _MSC_VER
+    _mkdir(dir.c_str());
+#else
+    mkdir(dir.c_str(), 0777);
+#endif
+
+    file = fopen(tmpName.c_str(), "wb");
+    if (file == NULL)
+    {
+        logWarning("Cannot write cache entry '" + tmpName + "'.");
+        return;
+    }
+
+    ok = fwrite(header.getBuffer().data(), 1, header.getBuffer().size(), file)
+         == header.getBuffer().size();
+    ok = ok && fwrite(payload.getBuffer().data(), 1,
+                      payload.getBuffer().size(), file)
+         == payload.getBuffer().size();
+    ok = (fclose(file) == 0) && ok;
+
+#ifdef _MSC_VER
+    remove(name.c_str());
+#endif
+    if (!ok || rename(tmpName.c_str(), name.c_str()) != 0)
+    {
+        remove(tmpName.c_str());
+        logWarning("Cannot write cache entry '" + name + "'.");
+    }
+}
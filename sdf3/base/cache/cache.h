@@ -0,0 +1,217 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   cache.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Content-addressed cache of binary files
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef BASE_CACHE_CACHE_H_INCLUDED
+#define BASE_CACHE_CACHE_H_INCLUDED
+
+#include "../string/cstring.h"
+
+/* Content hash */
+typedef unsigned long long CHash;
+
+#define CHASH_INIT      14695981039346656037ULL
+
+/**
+ * CHashContent ()
+ * The function returns the 64-bit FNV-1a hash of a block of memory. Blocks
+ * can be chained by passing the hash of the previous block as seed.
+ */
+CHash CHashContent(const char *data, const size_t size,
+                   const CHash seed = CHASH_INIT);
+
+/**
+ * CMappedFile
+ * Read-only memory mapping of a file.
+ */
+class CMappedFile
+{
+    public:
+        // Constructor
+        CMappedFile() : data(NULL), size(0) {};
+
+        // Destructor
+        ~CMappedFile()
+        {
+            close();
+        };
+
+        // Map the file, returns false when it cannot be opened
+        bool open(const CString &filename);
+        void close();
+
+        // Contents
+        const char *getData() const
+        {
+            return data;
+        };
+        size_t getSize() const
+        {
+            return size;
+        };
+
+    private:
+        // Not copyable
+        CMappedFile(const CMappedFile &f);
+        CMappedFile &operator=(const CMappedFile &f);
+
+        const char *data;
+        size_t size;
+#ifdef _MSC_VER
+        std::string buffer;
+#endif
+};
+
+/**
+ * CBinaryWriter
+ * Serializes values into a buffer (native byte order).
+ */
+class CBinaryWriter
+{
+    public:
+        void putUInt(const uint v)
+        {
+            put(&v, sizeof(v));
+        };
+        void putULong(const unsigned long long v)
+        {
+            put(&v, sizeof(v));
+        };
+        void putDouble(const double v)
+        {
+            put(&v, sizeof(v));
+        };
+        void putString(const CString &s)
+        {
+            putUInt(s.size());
+            put(s.data(), s.size());
+        };
+
+        const std::string &getBuffer() const
+        {
+            return buffer;
+        };
+
+    private:
+        void put(const void *p, const size_t n)
+        {
+            buffer.append((const char *)p, n);
+        };
+
+        std::string buffer;
+};
+
+/**
+ * CBinaryReader
+ * Reads values written by a CBinaryWriter from a block of memory. Reading
+ * beyond the end of the block throws an exception.
+ */
+class CBinaryReader
+{
+    public:
+        // Constructor
+        CBinaryReader() : data(NULL), size(0), pos(0) {};
+        CBinaryReader(const char *data, const size_t size)
+            : data(data), size(size), pos(0) {};
+
+        uint getUInt()
+        {
+            uint v;
+            get(&v, sizeof(v));
+            return v;
+        };
+        unsigned long long getULong()
+        {
+            unsigned long long v;
+            get(&v, sizeof(v));
+            return v;
+        };
+        double getDouble()
+        {
+            double v;
+            get(&v, sizeof(v));
+            return v;
+        };
+        CString getString();
+
+        size_t getPosition() const
+        {
+            return pos;
+        };
+        bool atEnd() const
+        {
+            return pos == size;
+        };
+
+    private:
+        void get(void *p, const size_t n);
+
+        const char *data;
+        size_t size;
+        size_t pos;
+};
+
+/**
+ * CBinaryCache
+ * Directory with binary entries keyed on a kind (e.g. the type of object
+ * that is stored) and a content hash. Entries are memory-mapped when they
+ * are read and replaced atomically when they are written, so concurrent
+ * processes can share the cache.
+ */
+class CBinaryCache
+{
+    public:
+        // Constructor
+        CBinaryCache(const CString &dir) : dir(dir) {};
+
+        // Directory
+        CString getDirectory() const
+        {
+            return dir;
+        };
+
+        // Map the entry; on a hit the reader points to its payload, which
+        // remains valid as long as the entry is open
+        bool find(const CString &kind, const CHash key, CMappedFile &entry,
+                  CBinaryReader &payload) const;
+
+        // Store an entry (failures are reported as warnings)
+        void store(const CString &kind, const CHash key,
+                   const CBinaryWriter &payload) const;
+
+    private:
+        CString getEntryName(const CString &kind, const CHash key) const;
+
+        CString dir;
+};
+
+#endif
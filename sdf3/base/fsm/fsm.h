@@ -12,6 +12,7 @@
  *
  *  History         :
  *      23-03-09    :   Initial version.
+ *      17-10-26    :   Virtual destructor of the abstract FSM.
  *
  *
  * This program is free software; you can redistribute it and/or modify it
@@ -140,6 +141,7 @@ namespace FSM
         class FiniteStateMachine
         {
             public:
+                virtual ~FiniteStateMachine() {};
                 virtual State *getInitialState() = 0 ;
         };
 
@@ -0,0 +1,228 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   csr_matrix.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Sparse Matrices in compressed sparse row format
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "csr_matrix.h"
+#include "../exception/exception.h"
+#include "../parallel/parallel.h"
+#include <climits>
+
+// Minimal number of non-zero elements per thread in a multiplication
+#define CSR_MATRIX_MINIMAL_NONZEROS_PER_THREAD     32768
+
+/**
+ * CSRMatrix constructor
+ */
+CSRMatrix::CSRMatrix(const CId R, const CId C)
+{
+    NumberOfRows = R;
+    NumberOfColumns = C;
+    RowStart.resize(R + 1, 0);
+}
+
+/**
+ * CSRMatrix constructor
+ */
+CSRMatrix::CSRMatrix(const CId R, const CId C, const vector<CSRMatrixEntry> &Entries)
+{
+    NumberOfRows = R;
+    NumberOfColumns = C;
+
+    // count the entries in each row
+
+    vector<CSize> Start(R + 1, 0);
+
+    for (CSize k = 0; k != Entries.size(); k++)
+    {
+        if (Entries[k].Row >= R || Entries[k].Column >= C)
+            throw CException("Error: matrix entry out of range.");
+        Start[Entries[k].Row + 1]++;
+    }
+
+    for (CId i = 0; i != R; i++)
+        Start[i + 1] += Start[i];
+
+    // distribute the entries over the rows
+
+    vector<CId> UnsortedColumns(Entries.size());
+    vector<CDouble> UnsortedValues(Entries.size());
+    vector<CSize> Position(Start.begin(), Start.end() - 1);
+
+    for (CSize k = 0; k != Entries.size(); k++)
+    {
+        CSize p = Position[Entries[k].Row]++;
+        UnsortedColumns[p] = Entries[k].Column;
+        UnsortedValues[p] = Entries[k].Value;
+    }
+
+    // sort each row on column and add up duplicate entries
+
+    RowStart.resize(R + 1, 0);
+    Columns.reserve(Entries.size());
+    Values.reserve(Entries.size());
+
+    vector<CSize> Order;
+
+    for (CId i = 0; i != R; i++)
+    {
+        Order.clear();
+        for (CSize k = Start[i]; k != Start[i + 1]; k++)
+            Order.push_back(k);
+
+        std::sort(Order.begin(), Order.end(), [&](CSize a, CSize b)
+        {
+            return UnsortedColumns[a] < UnsortedColumns[b];
+        });
+
+        for (CSize k = 0; k != Order.size(); k++)
+        {
+            if (Columns.size() > RowStart[i] && Columns.back() == UnsortedColumns[Order[k]])
+                Values.back() += UnsortedValues[Order[k]];
+            else
+            {
+                Columns.push_back(UnsortedColumns[Order[k]]);
+                Values.push_back(UnsortedValues[Order[k]]);
+            }
+        }
+
+        RowStart[i + 1] = Columns.size();
+    }
+}
+
+/**
+ * CSRMatrix::get
+ */
+CDouble CSRMatrix::get(const CId i, const CId j) const
+{
+    vector<CId>::const_iterator First = Columns.begin() + RowStart[i];
+    vector<CId>::const_iterator Last = Columns.begin() + RowStart[i + 1];
+    vector<CId>::const_iterator Element = std::lower_bound(First, Last, j);
+
+    if (Element == Last || *Element != j)
+        return 0.0;
+    else
+        return Values[Element - Columns.begin()];
+}
+
+/**
+ * CSRMatrix::transpose
+ */
+CSRMatrix CSRMatrix::transpose() const
+{
+    CSRMatrix Transpose(NumberOfColumns, NumberOfRows);
+
+    // count the elements in each column
+
+    for (CSize k = 0; k != Columns.size(); k++)
+        Transpose.RowStart[Columns[k] + 1]++;
+
+    for (CId j = 0; j != NumberOfColumns; j++)
+        Transpose.RowStart[j + 1] += Transpose.RowStart[j];
+
+    // visiting the rows in order keeps the columns of the transpose sorted
+
+    Transpose.Columns.resize(Columns.size());
+    Transpose.Values.resize(Values.size());
+
+    vector<CSize> Position(Transpose.RowStart.begin(), Transpose.RowStart.end() - 1);
+
+    for (CId i = 0; i != NumberOfRows; i++)
+        for (CSize k = RowStart[i]; k != RowStart[i + 1]; k++)
+        {
+            CSize p = Position[Columns[k]]++;
+            Transpose.Columns[p] = i;
+            Transpose.Values[p] = Values[k];
+        }
+
+    return Transpose;
+}
+
+/**
+ * CSRMatrix::multiplyRows
+ */
+void CSRMatrix::multiplyRows(const vector<CDouble> &X, vector<CDouble> &Y, const CId First, const CId Last) const
+{
+    for (CId i = First; i != Last; i++)
+    {
+        CDouble Sum = 0;
+
+        for (CSize k = RowStart[i]; k != RowStart[i + 1]; k++)
+            Sum += Values[k] * X[Columns[k]];
+
+        Y[i] = Sum;
+    }
+}
+
+/**
+ * CSRMatrix::multiply
+ * the rows are divided into blocks with about the same number of non-zero
+ * elements, each of which is multiplied by a worker of the pool (see
+ * base/parallel)
+ */
+void CSRMatrix::multiply(const vector<CDouble> &X, vector<CDouble> &Y, const CSize NumberOfThreads) const
+{
+    if (X.size() != NumberOfColumns)
+        throw CException("Error: vector size does not match the number of matrix columns.");
+
+    Y.resize(NumberOfRows);
+
+    // determine number of threads
+
+    CSize Blocks = getNumberOfNonZeros() / CSR_MATRIX_MINIMAL_NONZEROS_PER_THREAD;
+    CSize Threads = CNrWorkers(Blocks < UINT_MAX ? uint(Blocks) : UINT_MAX, uint(NumberOfThreads));
+
+    if (Threads <= 1)
+    {
+        multiplyRows(X, Y, 0, NumberOfRows);
+        return;
+    }
+
+    // divide rows over the threads
+
+    vector<CId> Bounds(1, 0);
+
+    for (CSize t = 1; t != Threads; t++)
+    {
+        CSize Bound = (getNumberOfNonZeros() * t) / Threads;
+        CId Last = std::lower_bound(RowStart.begin(), RowStart.end() - 1, Bound) - RowStart.begin();
+
+        if (Last > Bounds.back())
+            Bounds.push_back(Last);
+    }
+
+    Bounds.push_back(NumberOfRows);
+
+    CParallelFor(uint(Bounds.size() - 1), uint(Threads), [&](uint b, uint)
+    {
+        multiplyRows(X, Y, Bounds[b], Bounds[b + 1]);
+    });
+}
@@ -0,0 +1,129 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   csr_matrix.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Sparse Matrices in compressed sparse row format
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef CSR_MATRIX_H_INCLUDED
+#define CSR_MATRIX_H_INCLUDED
+
+#include "../basic_types.h"
+
+/**
+ * CSRMatrixEntry
+ * element of a sparse matrix given by its row, column and value
+ */
+class CSRMatrixEntry
+{
+
+    public:
+        // Constructor
+        CSRMatrixEntry(const CId R, const CId C, const CDouble V)
+        {
+            Row = R;
+            Column = C;
+            Value = V;
+        };
+
+        // Instance Variables
+        CId Row;
+        CId Column;
+        CDouble Value;
+};
+
+/**
+ * CSRMatrix
+ * sparse matrix in compressed sparse row format; the columns and values of
+ * the non-zero elements in row i are stored at the positions getRowStart(i)
+ * up to getRowEnd(i), sorted on column
+ */
+class CSRMatrix
+{
+
+    public:
+        // Constructor (entries with the same row and column are added up)
+        CSRMatrix(const CId R, const CId C, const vector<CSRMatrixEntry> &Entries);
+
+        // Access to dimensions
+        CId getNumberOfRows() const
+        {
+            return NumberOfRows;
+        };
+        CId getNumberOfColumns() const
+        {
+            return NumberOfColumns;
+        };
+        CSize getNumberOfNonZeros() const
+        {
+            return Values.size();
+        };
+
+        // Access to elements
+        CSize getRowStart(const CId i) const
+        {
+            return RowStart[i];
+        };
+        CSize getRowEnd(const CId i) const
+        {
+            return RowStart[i + 1];
+        };
+        CId getColumn(const CSize k) const
+        {
+            return Columns[k];
+        };
+        CDouble getValue(const CSize k) const
+        {
+            return Values[k];
+        };
+        CDouble get(const CId i, const CId j) const;
+
+        // Functions
+        CSRMatrix transpose() const;
+
+        // Y = A * X, computed by NumberOfThreads threads (0 selects the
+        // number of hardware threads)
+        void multiply(const vector<CDouble> &X, vector<CDouble> &Y, const CSize NumberOfThreads = 1) const;
+
+    private:
+        // Constructor for an empty matrix
+        CSRMatrix(const CId R, const CId C);
+
+        // Y = A * X for the rows First up to Last
+        void multiplyRows(const vector<CDouble> &X, vector<CDouble> &Y, const CId First, const CId Last) const;
+
+        // Instance Variables
+        CId NumberOfRows;
+        CId NumberOfColumns;
+        vector<CSize> RowStart;
+        vector<CId> Columns;
+        vector<CDouble> Values;
+};
+
+#endif
@@ -0,0 +1,178 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   stationary.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Iterative solvers for the stationary distribution of
+ *                      Markov chains
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "stationary.h"
+#include "../exception/exception.h"
+#include <cmath>
+
+/**
+ * normalise
+ * scales a non-negative vector to a probability distribution
+ */
+static void normalise(vector<CDouble> &X)
+{
+    CDouble Sum = 0;
+
+    for (CSize i = 0; i != X.size(); i++)
+        Sum += X[i];
+
+    if (Sum <= 0)
+        throw CException("Error: stationary distribution vanishes; Markov chain is not irreducible.");
+
+    for (CSize i = 0; i != X.size(); i++)
+        X[i] /= Sum;
+}
+
+/**
+ * StationarySolver::computeResidual
+ * computes |Q.X - X| (1-norm), where Q is the transposed transition matrix;
+ * Y is used as work space
+ */
+CDouble StationarySolver::computeResidual(const CSRMatrix &Q, const vector<CDouble> &X, vector<CDouble> &Y) const
+{
+    Q.multiply(X, Y, NumberOfThreads);
+
+    CDouble Sum = 0;
+
+    for (CSize i = 0; i != X.size(); i++)
+        Sum += fabs(Y[i] - X[i]);
+
+    return Sum;
+}
+
+/**
+ * StationarySolver::solve
+ */
+bool StationarySolver::solve(const CSRMatrix &P, vector<CDouble> &Distribution)
+{
+    if (P.getNumberOfRows() != P.getNumberOfColumns())
+        throw CException("Error: transition matrix is not square.");
+
+    CId NumberOfStates = P.getNumberOfRows();
+
+    NumberOfIterations = 0;
+    Residual = 0;
+
+    // trivial cases
+
+    if (NumberOfStates == 0)
+    {
+        Distribution.clear();
+        return true;
+    }
+
+    if (NumberOfStates == 1)
+    {
+        Distribution.assign(1, 1);
+        return true;
+    }
+
+    // row j of the transpose holds the probabilities of the transitions into state j
+
+    CSRMatrix Q = P.transpose();
+
+    vector<CDouble> X(NumberOfStates, 1.0 / NumberOfStates);
+    vector<CDouble> Y(NumberOfStates);
+
+    bool Converged = false;
+
+    while (!Converged && NumberOfIterations != MaximumNumberOfIterations)
+    {
+        NumberOfIterations++;
+
+        if (SolverMethod == POWER)
+        {
+
+            // residual of the current iterate comes for free with the step
+
+            Residual = computeResidual(Q, X, Y);
+
+            if (Residual <= Tolerance)
+                Converged = true;
+            else
+            {
+                for (CId j = 0; j != NumberOfStates; j++)
+                    X[j] = (X[j] + Y[j]) / 2;
+
+                normalise(X);
+            }
+        }
+        else
+        {
+            CDouble Change = 0;
+
+            // sweep through the states, using the updated values immediately
+
+            for (CId j = 0; j != NumberOfStates; j++)
+            {
+                CDouble Sum = 0;
+                CDouble SelfLoop = 0;
+
+                for (CSize k = Q.getRowStart(j); k != Q.getRowEnd(j); k++)
+                {
+                    if (Q.getColumn(k) == j)
+                        SelfLoop += Q.getValue(k);
+                    else
+                        Sum += Q.getValue(k) * X[Q.getColumn(k)];
+                }
+
+                if (SelfLoop < 1)
+                {
+                    CDouble Value = Sum / (1 - SelfLoop);
+                    Change += fabs(Value - X[j]);
+                    X[j] = Value;
+                }
+            }
+
+            normalise(X);
+
+            // a small change does not guarantee a small residual on slowly mixing chains
+
+            if (Change <= Tolerance)
+            {
+                Residual = computeResidual(Q, X, Y);
+
+                if (Residual <= Tolerance)
+                    Converged = true;
+            }
+        }
+    }
+
+    if (!Converged)
+        Residual = computeResidual(Q, X, Y);
+
+    Distribution = X;
+
+    return Converged;
+}
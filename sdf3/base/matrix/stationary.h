@@ -0,0 +1,132 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   stationary.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Iterative solvers for the stationary distribution of
+ *                      Markov chains
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef STATIONARY_H_INCLUDED
+#define STATIONARY_H_INCLUDED
+
+#include "csr_matrix.h"
+
+/**
+ * StationarySolver
+ * iterative computation of the stationary distribution of an irreducible
+ * Markov chain with transition probability matrix P (row i contains the
+ * probabilities of the transitions from state i); the iteration stops once
+ * the residual |x.P - x| (1-norm) of the normalised distribution x is at
+ * most the tolerance
+ *
+ * POWER iterates x := x.(P + I) / 2, which also converges for periodic
+ * chains; its matrix-vector products use NumberOfThreads threads
+ * GAUSS_SEIDEL solves x.(P - I) = 0 by Gauss-Seidel sweeps, which
+ * typically needs far fewer iterations
+ */
+class StationarySolver
+{
+
+    public:
+        // Methods
+        enum Method { POWER, GAUSS_SEIDEL };
+
+        // Constructor
+        StationarySolver()
+        {
+            SolverMethod = GAUSS_SEIDEL;
+            Tolerance = 1e-10;
+            MaximumNumberOfIterations = 10000;
+            NumberOfThreads = 1;
+            NumberOfIterations = 0;
+            Residual = 0;
+        };
+
+        // Settings
+        void setMethod(const Method M)
+        {
+            SolverMethod = M;
+        };
+        Method getMethod() const
+        {
+            return SolverMethod;
+        };
+        void setTolerance(const CDouble T)
+        {
+            Tolerance = T;
+        };
+        CDouble getTolerance() const
+        {
+            return Tolerance;
+        };
+        void setMaximumNumberOfIterations(const CSize N)
+        {
+            MaximumNumberOfIterations = N;
+        };
+        CSize getMaximumNumberOfIterations() const
+        {
+            return MaximumNumberOfIterations;
+        };
+        // 0 selects the number of hardware threads
+        void setNumberOfThreads(const CSize N)
+        {
+            NumberOfThreads = N;
+        };
+        CSize getNumberOfThreads() const
+        {
+            return NumberOfThreads;
+        };
+
+        // Statistics of the last call to solve
+        CSize getNumberOfIterations() const
+        {
+            return NumberOfIterations;
+        };
+        CDouble getResidual() const
+        {
+            return Residual;
+        };
+
+        // Functions (returns whether the iteration converged)
+        bool solve(const CSRMatrix &P, vector<CDouble> &Distribution);
+
+    private:
+        // Residual of distribution X for transposed transition matrix Q
+        CDouble computeResidual(const CSRMatrix &Q, const vector<CDouble> &X, vector<CDouble> &Y) const;
+
+        // Instance Variables
+        Method SolverMethod;
+        CDouble Tolerance;
+        CSize MaximumNumberOfIterations;
+        CSize NumberOfThreads;
+        CSize NumberOfIterations;
+        CDouble Residual;
+};
+
+#endif
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      23-03-09    :   Initial version.
+ *      17-10-26    :   Vectorizable kernels and matrix-matrix product.
  *
  *
  * This program is free software; you can redistribute it and/or modify it
@@ -40,6 +41,117 @@
 
 namespace MaxPlus
 {
+    // Plain double versions of MP_MINUSINFINITY and the bound used by
+    // MP_ISMINUSINFINITY
+    static const CDouble mpMinusInfinity = -1.0e+30;
+    static const CDouble mpMinusInfinityBound = -1.0e+20;
+
+    // Block sizes of the matrix-matrix product. A block of blockInner rows
+    // and blockCols columns of the right operand (256KB) stays in the cache
+    // while it is combined with all rows of the left operand.
+    static const unsigned int blockInner = 64;
+    static const unsigned int blockCols = 512;
+
+    /**
+     * mpPlus ()
+     * Branch-free MP_PLUS on doubles. The compiler turns the selection into
+     * vector compare and blend instructions (SSE/AVX on x86, NEON on ARM).
+     */
+    static inline CDouble mpPlus(const CDouble a, const CDouble b)
+    {
+        const CDouble s = a + b;
+        const CDouble lowest = (a < b) ? a : b;
+        return (lowest < mpMinusInfinityBound) ? mpMinusInfinity : s;
+    }
+
+    /**
+     * mpMax ()
+     * MP_MAX on doubles.
+     */
+    static inline CDouble mpMax(const CDouble a, const CDouble b)
+    {
+        return (a > b) ? a : b;
+    }
+
+    /**
+     * kernelAdd ()
+     * r[i] = a[i] + c for i in [0, n). r may be equal to a.
+     */
+    static void kernelAdd(const CDouble *a, const CDouble c, CDouble *r,
+                          const unsigned int n)
+    {
+        for (unsigned int i = 0; i < n; i++)
+            r[i] = mpPlus(a[i], c);
+    }
+
+    /**
+     * kernelAdd ()
+     * r[i] = a[i] + b[i] for i in [0, n). r may be equal to a or b.
+     */
+    static void kernelAdd(const CDouble *a, const CDouble *b, CDouble *r,
+                          const unsigned int n)
+    {
+        for (unsigned int i = 0; i < n; i++)
+            r[i] = mpPlus(a[i], b[i]);
+    }
+
+    /**
+     * kernelMaximum ()
+     * r[i] = max(a[i], b[i]) for i in [0, n). r may be equal to a or b.
+     */
+    static void kernelMaximum(const CDouble *a, const CDouble *b, CDouble *r,
+                              const unsigned int n)
+    {
+        for (unsigned int i = 0; i < n; i++)
+            r[i] = mpMax(a[i], b[i]);
+    }
+
+    /**
+     * kernelAddMaximum ()
+     * r[i] = max(r[i], c + b[i]) for i in [0, n). r may be equal to b.
+     */
+    static void kernelAddMaximum(const CDouble c, const CDouble *b, CDouble *r,
+                                 const unsigned int n)
+    {
+        for (unsigned int i = 0; i < n; i++)
+            r[i] = mpMax(r[i], mpPlus(c, b[i]));
+    }
+
+    /**
+     * kernelInnerProduct ()
+     * Returns max(-inf, a[0] + b[0], ..., a[n-1] + b[n-1]). The maximum is
+     * accumulated element-wise in an array of lanes, which the compiler
+     * vectorizes like the other kernels, and the lanes are combined at the
+     * end.
+     */
+    static CDouble kernelInnerProduct(const CDouble *a, const CDouble *b,
+                                      const unsigned int n)
+    {
+        const unsigned int lanes = 16;
+        CDouble m[lanes];
+        CDouble result = mpMinusInfinity;
+        unsigned int k = 0;
+
+        if (n >= lanes)
+        {
+            for (unsigned int j = 0; j < lanes; j++)
+                m[j] = mpMinusInfinity;
+
+            for (; k + lanes <= n; k += lanes)
+            {
+                for (unsigned int j = 0; j < lanes; j++)
+                    m[j] = mpMax(m[j], mpPlus(a[k + j], b[k + j]));
+            }
+
+            for (unsigned int j = 0; j < lanes; j++)
+                result = mpMax(result, m[j]);
+        }
+
+        for (; k < n; k++)
+            result = mpMax(result, mpPlus(a[k], b[k]));
+
+        return result;
+    }
 
     /**
      * Construct a Maxplus vector of size
@@ -170,10 +282,8 @@ namespace MaxPlus
         unsigned int M = this->getSize();
         assert(result->getSize() == M);
 
-        for (unsigned int pos = 0; pos < M; pos++)
-        {
-            result->put(pos, this->get(pos) + increase); // uses MP_PLUS()
-        }
+        if (M > 0)
+            kernelAdd(&this->table[0], increase, &result->table[0], M);
     }
 
     /**
@@ -185,10 +295,8 @@ namespace MaxPlus
         assert(vecB->getSize() == M);
         assert(result->getSize() == M);
 
-        for (unsigned int pos = 0; pos < M; pos++)
-        {
-            result->put(pos, MP_MAX(this->get(pos), vecB->get(pos)));
-        }
+        if (M > 0)
+            kernelMaximum(&this->table[0], &vecB->table[0], &result->table[0], M);
     }
 
 
@@ -229,10 +337,8 @@ namespace MaxPlus
     {
         assert(this->getSize() == vecB->getSize());
         assert(this->getSize() == res->getSize());
-        for (unsigned int row = 0; row < this->getSize(); row++)
-        {
-            res->put(row, this->get(row) + vecB->get(row));
-        }
+        if (this->getSize() > 0)
+            kernelAdd(&this->table[0], &vecB->table[0], &res->table[0], this->getSize());
     }
 
     /**
@@ -412,16 +518,87 @@ namespace MaxPlus
         Vector *res = new Vector(this->getRows());
 
         // Perform point-wise multiplication
+        const unsigned int MC = this->getCols();
         for (unsigned int i = 0; i < this->getRows(); i++)
         {
-            MPTime m = MP_MINUSINFINITY;
-            for (unsigned int k = 0; k < this->getCols(); k++)
+            if (MC == 0)
+                res->table[i] = mpMinusInfinity;
+            else
+                res->table[i] = kernelInnerProduct(&this->table[i * MC], &v.table[0], MC);
+        }
+        return res;
+    }
+
+    /**
+     * mpmultiply()
+     * Matrix-matrix multiplication.
+     */
+    Matrix *Matrix::mpmultiply(const Matrix &m) const
+    {
+        Matrix *res = new Matrix(this->getRows(), m.getCols());
+        try
+        {
+            this->mpmultiply(m, res);
+        }
+        catch (...)
+        {
+            delete res;
+            throw;
+        }
+        return res;
+    }
+
+    /**
+     * mpmultiply()
+     * Matrix-matrix multiplication with existing result matrix, which must
+     * differ from both operands. Row i of the result is the maximum over k of
+     * row k of m increased with element (i,k) of this matrix. The columns of
+     * m are processed in blocks, so that the rows of a block of m are reused
+     * from the cache. Elements of this matrix equal to -inf are skipped.
+     */
+    void Matrix::mpmultiply(const Matrix &m, Matrix *result) const
+    {
+        const unsigned int MR = this->getRows();
+        const unsigned int MK = this->getCols();
+        const unsigned int MC = m.getCols();
+
+        if (MK != m.getRows() || result->getRows() != MR
+            || result->getCols() != MC)
+        {
+            throw CException("Matrices are of incompatible size in"
+                             "Matrix::mpmultiply");
+        }
+        if (result == this || result == &m)
+        {
+            throw CException("Result matrix may not be an operand in"
+                             "Matrix::mpmultiply");
+        }
+
+        for (unsigned int pos = 0; pos < result->table.size(); pos++)
+            result->table[pos] = mpMinusInfinity;
+
+        for (unsigned int c = 0; c < MC; c += blockCols)
+        {
+            const unsigned int nc = (MC - c < blockCols) ? MC - c : blockCols;
+
+            for (unsigned int kb = 0; kb < MK; kb += blockInner)
             {
-                m = MP_MAX(m, MP_PLUS(this->get(i, k), v.get(k)));
+                const unsigned int ke = (MK - kb < blockInner) ? MK : kb + blockInner;
+
+                for (unsigned int i = 0; i < MR; i++)
+                {
+                    const CDouble *a = &this->table[i * MK];
+                    CDouble *r = &result->table[i * MC + c];
+
+                    for (unsigned int k = kb; k < ke; k++)
+                    {
+                        if (a[k] < mpMinusInfinityBound)
+                            continue;
+                        kernelAddMaximum(a[k], &m.table[k * MC + c], r, nc);
+                    }
+                }
             }
-            res->put(i, m);
         }
-        return res;
     }
 
     /**
@@ -514,13 +691,8 @@ namespace MaxPlus
             throw CException("Matrices are of different size in"
                              "Matrix::add(Matrix*, MPTime, Matrix*");
         }
-        for (unsigned int r = 0; r < MR; r++)
-        {
-            for (unsigned int c = 0; c < MC; c++)
-            {
-                result->put(r, c, this->get(r, c) + increase); // uses MP_PLUS()
-            }
-        }
+        if (MR * MC > 0)
+            kernelAdd(&this->table[0], increase, &result->table[0], MR * MC);
     }
 
 
@@ -540,13 +712,8 @@ namespace MaxPlus
                              "Matrix::maximum(Matrix*, Matrix*, Matrix*");
         }
 
-        for (unsigned int r = 0; r < MR; r++)
-        {
-            for (unsigned int c = 0; c < MC; c++)
-            {
-                result->put(r, c, MP_MAX(this->get(r, c), matB->get(r, c)));
-            }
-        }
+        if (MR * MC > 0)
+            kernelMaximum(&this->table[0], &matB->table[0], &result->table[0], MR * MC);
     }
 
     /**
@@ -666,46 +833,34 @@ namespace MaxPlus
 
 
         Matrix *distMat = this->createCopy();
+        vector<CDouble> &dist = distMat->table;
 
-        //// DEBUG-MAT
-        //MaxPlus::Matrix lengthMat(N);
-        //for (unsigned int kk=0; kk<N*N; kk++) lengthMat.table[kk]=1;
+        // Every path is at least -inf and, with implied self-edges, the
+        // empty path from a node to itself has length 0
+        for (unsigned int pos = 0; pos < N * N; pos++)
+            dist[pos] = mpMax(dist[pos], mpMinusInfinity);
+        if (implyZeroSelfEdges)
+        {
+            for (unsigned int u = 0; u < N; u++)
+                dist[u * N + u] = mpMax(dist[u * N + u], 0);
+        }
 
-        // k - intermediate node
-        //
+        // Element (v,u) holds the longest path from u to v. For intermediate
+        // node k, row v is updated with the paths from u to k (row k),
+        // extended with the path from k to v (element (v,k)).
         for (unsigned int k = 0; k < N; k++)
         {
+            const CDouble *row_k = &dist[k * N];
 
-            //// DEBUG-MAT
-            //debug_mat(distMat, k);
-
-            for (unsigned int u = 0; u < N; u++)
+            for (unsigned int v = 0; v < N; v++)
             {
-                for (unsigned int v = 0; v < N; v++)
-                {
-                    MPTime extra = (implyZeroSelfEdges && u == v) ? (MPTime)0 : MP_MINUSINFINITY;
-                    MPTime path_u2v = MP_MAX(distMat->get(v, u), extra);
-                    MPTime path_u2k = distMat->get(k, u);
-                    MPTime path_k2v = distMat->get(v, k);
-
-                    MPTime path_u2v_candidate = (path_u2k + path_k2v);  // uses MP_PLUS()
-                    if (path_u2v_candidate > path_u2v)
-                    {
-                        path_u2v = path_u2v_candidate;
-
-                        ////DEBUG-MAT
-                        //lengthMat.put(v,u, lengthMat.get(k,u) + lengthMat.get(v,k));
-
-                    }
-                    distMat->put(v, u, path_u2v);
-                }
+                const CDouble path_k2v = dist[v * N + k];
+                if (path_k2v < mpMinusInfinityBound)
+                    continue;
+                kernelAddMaximum(path_k2v, row_k, &dist[v * N], N);
             }
         }
 
-        //// DEBUG-MAT
-        //debug_mat(distMat, N);
-        //cerr << "length(0,0) = " << lengthMat.get(0,0) << endl;
-
         for (unsigned int k = 0; k < N; k++)
         {
             if (distMat->get(k, k) > posCycleThre)
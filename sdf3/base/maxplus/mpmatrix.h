@@ -12,6 +12,7 @@
  *
  *  History         :
  *      23-03-09    :   Initial version.
+ *      17-10-26    :   Vectorizable kernels and matrix-matrix product.
  *
  *
  * This program is free software; you can redistribute it and/or modify it
@@ -42,6 +43,7 @@ class CString;
 
 namespace MaxPlus
 {
+    class Matrix;
 
     /**
      * Vector, represents a MaxPlus column vector
@@ -112,7 +114,11 @@ namespace MaxPlus
             MPTime minimalFiniteElement(unsigned int *itsPosition_Ptr = NULL) const;
 
         private:
-            vector<MPTime> table;
+            friend class Matrix;
+
+            // Elements are stored as plain doubles so that the compiler can
+            // vectorize the loops over them
+            vector<CDouble> table;
     };
 
 
@@ -153,6 +159,8 @@ namespace MaxPlus
             void maximum(const Matrix *matB, Matrix *result);
 
             Vector *mpmultiply(const Vector &v) const;
+            Matrix *mpmultiply(const Matrix &m) const;
+            void mpmultiply(const Matrix &m, Matrix *result) const;
 
             Matrix &operator+=(MPTime increase)
             {
@@ -194,7 +202,8 @@ namespace MaxPlus
             Matrix();
 
         private:
-            vector<MPTime> table;
+            // Row-major storage of plain doubles (see Vector)
+            vector<CDouble> table;
             unsigned int szRows;
             unsigned int szCols;
     };
@@ -0,0 +1,129 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   parallel.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Pool of worker threads
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "parallel.h"
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+/**
+ * CNrWorkers ()
+ * The function returns the number of workers of a pool which executes n jobs
+ * with at most nrThreads threads.
+ */
+uint CNrWorkers(const uint n, const uint nrThreads)
+{
+    uint nrWorkers = nrThreads;
+
+    if (nrWorkers == 0)
+        nrWorkers = std::thread::hardware_concurrency();
+    if (nrWorkers > n)
+        nrWorkers = n;
+    if (nrWorkers == 0)
+        nrWorkers = 1;
+
+    return nrWorkers;
+}
+
+/**
+ * CParallelRun ()
+ * The function executes worker(t) for t = 0 .. nrWorkers-1, each on its own
+ * thread. The calling thread executes worker 0.
+ */
+void CParallelRun(const uint nrWorkers,
+                  const std::function<void(uint)> &worker)
+{
+    std::vector<std::thread> workers;
+    std::exception_ptr error;
+    std::atomic<bool> failed(false);
+
+    // Keep the first exception of a worker
+    auto run = [&](uint t)
+    {
+        try
+        {
+            worker(t);
+        }
+        catch (...)
+        {
+            if (!failed.exchange(true))
+                error = std::current_exception();
+        }
+    };
+
+    for (uint t = 1; t < nrWorkers; t++)
+        workers.push_back(std::thread(run, t));
+
+    // The calling thread is also part of the pool
+    if (nrWorkers > 0)
+        run(0);
+
+    for (uint t = 0; t < workers.size(); t++)
+        workers[t].join();
+
+    if (failed)
+        std::rethrow_exception(error);
+}
+
+/**
+ * CParallelFor ()
+ * The function executes job(i, t) for i = 0 .. n-1 on a pool of workers.
+ * When a job throws an exception, no new jobs are started.
+ */
+void CParallelFor(const uint n, const uint nrThreads,
+                  const std::function<void(uint, uint)> &job)
+{
+    std::atomic<uint> next(0);
+    std::atomic<bool> failed(false);
+
+    if (n == 0)
+        return;
+
+    // Worker which executes jobs till none is left
+    CParallelRun(CNrWorkers(n, nrThreads), [&](uint t)
+    {
+        for (uint i = next++; i < n && !failed; i = next++)
+        {
+            try
+            {
+                job(i, t);
+            }
+            catch (...)
+            {
+                failed = true;
+                throw;
+            }
+        }
+    });
+}
@@ -0,0 +1,69 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   parallel.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Pool of worker threads
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef BASE_PARALLEL_PARALLEL_H_INCLUDED
+#define BASE_PARALLEL_PARALLEL_H_INCLUDED
+
+#include "../basic_types.h"
+#include <functional>
+
+/**
+ * CNrWorkers ()
+ * The function returns the number of workers of a pool which executes n jobs
+ * with at most nrThreads threads. When nrThreads is zero, the number of
+ * hardware threads is used. The pool has at least one worker.
+ */
+uint CNrWorkers(const uint n, const uint nrThreads);
+
+/**
+ * CParallelRun ()
+ * The function executes worker(t) for t = 0 .. nrWorkers-1, each on its own
+ * thread. The calling thread is also part of the pool and executes worker 0.
+ * The first exception thrown by a worker is rethrown once all workers have
+ * finished.
+ */
+void CParallelRun(const uint nrWorkers,
+                  const std::function<void(uint)> &worker);
+
+/**
+ * CParallelFor ()
+ * The function executes job(i, t) for i = 0 .. n-1 on a pool of
+ * CNrWorkers(n, nrThreads) workers; t is the worker which executes the job.
+ * Workers take the next job till no job is left. When a job throws an
+ * exception, no new jobs are started and the exception is rethrown once all
+ * workers have finished.
+ */
+void CParallelFor(const uint n, const uint nrThreads,
+                  const std::function<void(uint, uint)> &job);
+
+#endif
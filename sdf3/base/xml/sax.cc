@@ -0,0 +1,365 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   sax.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Streaming (SAX) XML interface functions
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "sax.h"
+#include "../exception/exception.h"
+#include <cstring>
+#include <cstdio>
+#include <cstdarg>
+#include <exception>
+
+/**
+ * find ()
+ * The function returns the SAX2 entry of the attribute with the given name or
+ * NULL when the element has no such attribute.
+ */
+const char **CSAXAttributes::find(const CString &name) const
+{
+    for (int i = 0; i < nrAttributes; i++)
+    {
+        if (name == attributes[5 * i])
+            return &attributes[5 * i];
+    }
+
+    return NULL;
+}
+
+/**
+ * hasAttribute ()
+ * The function returns true if the element has an attribute with the given
+ * name.
+ */
+bool CSAXAttributes::hasAttribute(const CString &name) const
+{
+    return find(name) != NULL;
+}
+
+/**
+ * getAttribute ()
+ * The function returns the value of the attribute with the given name. An
+ * empty string is returned when the element has no such attribute.
+ */
+CString CSAXAttributes::getAttribute(const CString &name) const
+{
+    const char **attr = find(name);
+
+    if (attr == NULL)
+        return CString();
+
+    return CString(std::string(attr[3], attr[4] - attr[3]));
+}
+
+/**
+ * getName ()
+ * The function returns the name of the i-th attribute.
+ */
+CString CSAXAttributes::getName(const int i) const
+{
+    return CString(attributes[5 * i]);
+}
+
+/**
+ * getValue ()
+ * The function returns the value of the i-th attribute.
+ */
+CString CSAXAttributes::getValue(const int i) const
+{
+    const char **attr = &attributes[5 * i];
+
+    return CString(std::string(attr[3], attr[4] - attr[3]));
+}
+
+#ifdef _MSC_VER
+
+void CParseStream(const CString &filename, CSAXHandler &handler)
+{
+    throw CException("Streaming XML parser not supported on this platform.");
+}
+
+void CParseStream(const char *buffer, const size_t size, const CString &name,
+                  CSAXHandler &handler)
+{
+    throw CException("Streaming XML parser not supported on this platform.");
+}
+
+#else
+
+#include <libxml/parser.h>
+
+// Size of the chunks that are pushed into the parser
+#define SAX_CHUNK_SIZE  65536
+
+/**
+ * CSAXContext
+ * State shared between the parser callbacks.
+ */
+typedef struct _CSAXContext
+{
+    CSAXHandler *handler;
+    xmlParserCtxtPtr parser;
+    std::exception_ptr error;
+    CString message;
+    bool stopped;
+} CSAXContext;
+
+/**
+ * stopParser ()
+ * Stop the parser from within a callback.
+ */
+static void stopParser(CSAXContext *c)
+{
+    c->stopped = true;
+    xmlStopParser(c->parser);
+}
+
+/**
+ * saxStartElement ()
+ * SAX2 callback for the start of an element.
+ */
+static void saxStartElement(void *ctx, const xmlChar *localname,
+                            const xmlChar *prefix, const xmlChar *URI, int nrNamespaces,
+                            const xmlChar **namespaces, int nrAttributes, int nrDefaulted,
+                            const xmlChar **attributes)
+{
+    CSAXContext *c = (CSAXContext *)ctx;
+
+    if (c->stopped)
+        return;
+
+    try
+    {
+        c->handler->startElement((const char *)localname,
+                                 CSAXAttributes((const char **)attributes, nrAttributes));
+    }
+    catch (...)
+    {
+        c->error = std::current_exception();
+        stopParser(c);
+    }
+}
+
+/**
+ * saxEndElement ()
+ * SAX2 callback for the end of an element.
+ */
+static void saxEndElement(void *ctx, const xmlChar *localname,
+                          const xmlChar *prefix, const xmlChar *URI)
+{
+    CSAXContext *c = (CSAXContext *)ctx;
+
+    if (c->stopped)
+        return;
+
+    try
+    {
+        c->handler->endElement((const char *)localname);
+
+        if (c->handler->isDone())
+            stopParser(c);
+    }
+    catch (...)
+    {
+        c->error = std::current_exception();
+        stopParser(c);
+    }
+}
+
+/**
+ * saxCharacters ()
+ * SAX callback for character data.
+ */
+static void saxCharacters(void *ctx, const xmlChar *ch, int len)
+{
+    CSAXContext *c = (CSAXContext *)ctx;
+
+    if (c->stopped)
+        return;
+
+    try
+    {
+        c->handler->characters((const char *)ch, len);
+    }
+    catch (...)
+    {
+        c->error = std::current_exception();
+        stopParser(c);
+    }
+}
+
+/**
+ * saxError ()
+ * SAX callback for (fatal) errors. Only the first message is kept.
+ */
+static void saxError(void *ctx, const char *msg, ...)
+{
+    CSAXContext *c = (CSAXContext *)ctx;
+    char buffer[256];
+    va_list args;
+    int len;
+
+    if (!c->message.empty())
+        return;
+
+    va_start(args, msg);
+    len = vsnprintf(buffer, sizeof(buffer), msg, args);
+    va_end(args);
+
+    // Strip trailing newline
+    if (len > 0 && len < (int)sizeof(buffer) && buffer[len - 1] == '\n')
+        buffer[len - 1] = '\0';
+
+    c->message = buffer;
+}
+
+/**
+ * CSAXParser
+ * Push parser that feeds the events to a handler.
+ */
+class CSAXParser
+{
+    public:
+        CSAXParser(const CString &name, CSAXHandler &handler)
+            : name(name)
+        {
+            xmlSAXHandler sax;
+
+            memset(&sax, 0, sizeof(sax));
+            sax.initialized = XML_SAX2_MAGIC;
+            sax.startElementNs = saxStartElement;
+            sax.endElementNs = saxEndElement;
+            sax.characters = saxCharacters;
+            sax.error = saxError;
+            sax.fatalError = saxError;
+
+            context.handler = &handler;
+            context.stopped = false;
+            context.parser = xmlCreatePushParserCtxt(&sax, &context, NULL, 0,
+                             name.c_str());
+            if (context.parser == NULL)
+                throw CException("Failed creating parser for '" + name + "'.");
+            xmlCtxtUseOptions(context.parser, XML_PARSE_NONET);
+        };
+
+        ~CSAXParser()
+        {
+            xmlFreeParserCtxt(context.parser);
+        };
+
+        // Push a chunk of the document, returns false once the parser stopped
+        bool push(const char *chunk, const int size, const bool last)
+        {
+            int res = xmlParseChunk(context.parser, chunk, size, last ? 1 : 0);
+
+            if (context.stopped)
+                return false;
+
+            if (res != 0 || (last && !context.parser->wellFormed))
+            {
+                throw CException("Failed parsing '" + name + "': "
+                                 + (context.message.empty() ? CString("not well-formed")
+                                    : context.message));
+            }
+
+            return !last;
+        };
+
+        // Rethrow the first exception of the handler
+        void finish()
+        {
+            if (context.error)
+                std::rethrow_exception(context.error);
+        };
+
+    private:
+        CString name;
+        CSAXContext context;
+};
+
+/**
+ * CParseStream ()
+ * Stream the file through the handler without building a document tree.
+ * The document is not validated against its schema.
+ */
+void CParseStream(const CString &filename, CSAXHandler &handler)
+{
+    char chunk[SAX_CHUNK_SIZE];
+    FILE *file;
+    size_t size;
+
+    file = fopen(filename.c_str(), "rb");
+    if (file == NULL)
+        throw CException("Failed opening '" + filename + "'.");
+
+    try
+    {
+        CSAXParser parser(filename, handler);
+
+        do
+        {
+            size = fread(chunk, 1, SAX_CHUNK_SIZE, file);
+        }
+        while (parser.push(chunk, (int)size, size < SAX_CHUNK_SIZE));
+
+        parser.finish();
+    }
+    catch (...)
+    {
+        fclose(file);
+        throw;
+    }
+
+    fclose(file);
+}
+
+/**
+ * CParseStream ()
+ * Stream an in-memory document through the handler. The name is only used
+ * in error messages.
+ */
+void CParseStream(const char *buffer, const size_t size, const CString &name,
+                  CSAXHandler &handler)
+{
+    CSAXParser parser(name, handler);
+    size_t pos = 0, len;
+
+    do
+    {
+        len = size - pos < SAX_CHUNK_SIZE ? size - pos : SAX_CHUNK_SIZE;
+        pos += len;
+    }
+    while (parser.push(buffer + pos - len, (int)len, pos == size));
+
+    parser.finish();
+}
+
+#endif
@@ -0,0 +1,110 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   sax.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Streaming (SAX) XML interface functions
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef BASE_XML_SAX_H_INCLUDED
+#define BASE_XML_SAX_H_INCLUDED
+
+#include "../string/cstring.h"
+
+/**
+ * CSAXAttributes
+ * The attributes of an element as reported by the streaming parser. The
+ * object refers to the buffers of the parser and is only valid inside the
+ * callback to which it is passed.
+ */
+class CSAXAttributes
+{
+    public:
+        // Constructor (libxml2 SAX2 layout: localname, prefix, URI,
+        // value, end for every attribute)
+        CSAXAttributes(const char **attributes, const int nrAttributes)
+            : attributes(attributes), nrAttributes(nrAttributes) {};
+
+        // Access
+        bool hasAttribute(const CString &name) const;
+        CString getAttribute(const CString &name) const;
+
+        // Iteration over all attributes
+        int size() const
+        {
+            return nrAttributes;
+        };
+        CString getName(const int i) const;
+        CString getValue(const int i) const;
+
+    private:
+        const char **find(const CString &name) const;
+
+        const char **attributes;
+        int nrAttributes;
+};
+
+/**
+ * CSAXHandler
+ * Receives the events of the streaming parser. Exceptions thrown by a
+ * callback stop the parser and are rethrown by CParseStream.
+ */
+class CSAXHandler
+{
+    public:
+        virtual ~CSAXHandler() {};
+
+        // Events
+        virtual void startElement(const CString &name,
+                                  const CSAXAttributes &attributes) = 0;
+        virtual void endElement(const CString &name) = 0;
+        virtual void characters(const char *ch, const int len) {};
+
+        // Stop the parser once the handler has seen all it needs
+        virtual bool isDone() const
+        {
+            return false;
+        };
+};
+
+/**
+ * CParseStream ()
+ * Stream the file through the handler without building a document tree.
+ * The document is not validated against its schema.
+ */
+void CParseStream(const CString &filename, CSAXHandler &handler);
+
+/**
+ * CParseStream ()
+ * Stream an in-memory document through the handler. The name is only used
+ * in error messages.
+ */
+void CParseStream(const char *buffer, const size_t size, const CString &name,
+                  CSAXHandler &handler);
+
+#endif
@@ -13,6 +13,7 @@
  *
  *  History         :
  *      26-04-10    :   Initial version.
+ *      17-10-26    :   Compressed sparse row automaton.
  *
  * $Id: maxplusautomaton.cc,v 1.1.2.15 2010-08-04 14:47:36 mgeilen Exp $
  *
@@ -35,8 +36,7 @@
  */
 
 #include "maxplusautomaton.h"
-#include "sdf/analysis/mcm/mcmgraph.h"
-#include "sdf/analysis/mcm/mcmyto.h"
+#include "sdf/analysis/mcm/mcmhoward.h"
 
 
 namespace FSMSADF
@@ -136,30 +136,25 @@ namespace FSMSADF
             // create a minimizal edge labelled scenario automaton
             EdgeLabeledScenarioFSM *elsFSM = FSMConverter::minimalEdgeLabeledFSM(g->getFSM());
 
-            MaxPlusAutomaton *fsm = new MaxPlusAutomaton();
-
-            // add state for every initial token and location of the fsm
-
             // get the number of initial tokens
             unsigned int nrTokens = (*scenarioMatrices->begin()).second->getSize();
             if (nrTokens == 0)
                 throw CException("Graph has no initial tokens. Cannot compute throughput");
 
             // create the FSM states for every pair of a state of the FSMSADF's FSM
-            // and an initial token
+            // and an initial token. The states of (q, k) for all k are
+            // numbered consecutively from stateOffset[q].
+            map<CId, uint> stateOffset;
+            uint nrStates = 0;
             ELSSetOfStates *Q = elsFSM->getStates();
             ELSSetOfStates::CIter q;
             for (q = Q->begin(); q != Q->end(); q++)
             {
-                for (unsigned int k = 0; k < nrTokens; k++)
-                {
-                    // create a state for (q, k)
-                    CId qId = ((ELSState *)(*q))->getLabel();
-                    MPAState *s = new MPAState(make_mpastatelabel(qId, k));
-                    fsm->addState(s);
-                }
+                stateOffset[((ELSState *)(*q))->getLabel()] = nrStates;
+                nrStates += nrTokens;
             }
 
+            MaxPlusAutomaton mpa(nrStates);
 
             // add the edges. For every edge (q1, q2) in the original fsm,
             // let s be the scenario of q2 and let M_s be the matrix of s
@@ -170,7 +165,7 @@ namespace FSMSADF
             for (q = Q->begin(); q != Q->end(); q++)
             {
                 ELSState *q1 = (ELSState *) *q;
-                CId q1Id = q1->getLabel();
+                uint q1Offset = stateOffset[q1->getLabel()];
 
                 // for every outgoing edge of the state
                 ELSSetOfEdges  *t = (ELSSetOfEdges *) q1->getOutgoingEdges();
@@ -178,9 +173,9 @@ namespace FSMSADF
                 for (e = t->begin(); e != t->end(); e++)
                 {
                     ELSEdge *tr = (ELSEdge *) *e;
-                    CId q2Id = ((ELSState *)tr->getDestination())->getLabel();
-                    CString sc = tr->label;
-                    Matrix *Ms = (*scenarioMatrices)[sc];
+                    uint q2Offset = stateOffset[((ELSState *)tr->getDestination())->getLabel()];
+                    uint sc = mpa.addScenario(tr->label);
+                    Matrix *Ms = (*scenarioMatrices)[tr->label];
 
                     // for every entry in the matrix
                     for (unsigned int k = 0; k < nrTokens; k++)
@@ -189,23 +184,18 @@ namespace FSMSADF
                         {
                             MPDelay d = Ms->get(k, m);
                             if (!MP_ISMINUSINFINITY(d))
-                            {
-                                MPAState *src = fsm->getStateLabeled(make_mpastatelabel(q1Id, k));
-                                MPAState *dst = fsm->getStateLabeled(make_mpastatelabel(q2Id, m));
-                                fsm->addEdge(src, make_mpaedgelabel(d, &sc), dst);
-                            }
+                                mpa.addEdge(q1Offset + k, q2Offset + m, d, sc);
                         }
                     }
                 }
             }
-
+            mpa.finalize();
 
             // calculate MCM of the FSM
-            double mcm = fsm->calculateMCM();
+            double mcm = mpa.calculateMCM();
 
             delete scenarioMatrices;
             delete elsFSM;
-            delete fsm;
 
             return 1.0 / mcm;
         }
@@ -294,12 +284,12 @@ namespace FSMSADF
             // create a minimizal edge labelled scenario automaton
             EdgeLabeledScenarioFSM *elsFSM = FSMConverter::minimalEdgeLabeledFSM(g->getFSM());
 
-            MaxPlusAutomatonWithRewards *fsm = new MaxPlusAutomatonWithRewards();
-
-            // add state for every initial token and location of the fsm
-
             // create the FSM states for every pair of a state of the FSMSADF's FSM
-            // and an initial token
+            // and an initial token. The states of (q, k) for all k are
+            // numbered consecutively from stateOffset[q].
+            map<CId, uint> stateOffset;
+            map<CId, uint> stateTokens;
+            uint nrStates = 0;
             ELSSetOfStates *Q = elsFSM->getStates();
             ELSSetOfStates::CIter q;
             for (q = Q->begin(); q != Q->end(); q++)
@@ -308,15 +298,13 @@ namespace FSMSADF
                 ELSState *s = (ELSState *) *q;
                 ELSEdge *e = (ELSEdge *) * (s->getOutgoingEdges()->begin());
                 unsigned int nrTokens = (*scenarioMatrices)[e->label]->getCols();
-                for (unsigned int k = 0; k < nrTokens; k++)
-                {
-                    // create a state for (q, k)
-                    CId qId = ((ELSState *)(*q))->getLabel();
-                    MPARState *s = new MPARState(make_mpastatelabel(qId, k));
-                    fsm->addState(s);
-                }
+                stateOffset[s->getLabel()] = nrStates;
+                stateTokens[s->getLabel()] = nrTokens;
+                nrStates += nrTokens;
             }
 
+            MaxPlusAutomaton mpa(nrStates);
+
             // add the edges. For every edge (q1, q2) in the original fsm,
             // let s be the scenario of q2 and let M_s be the matrix of s
             // For every non -inf element d=M_s(k,m) add an edge from state (q1,k)
@@ -335,9 +323,16 @@ namespace FSMSADF
                 {
                     ELSEdge *tr = (ELSEdge *) *e;
                     CId q2Id = ((ELSState *)tr->getDestination())->getLabel();
-                    CString *sc = &(tr->label);
-                    Matrix *Ms = (*scenarioMatrices)[*sc];
-                    CDouble rew = g->getScenario(*sc)->getReward();
+                    uint sc = mpa.addScenario(tr->label);
+                    Matrix *Ms = (*scenarioMatrices)[tr->label];
+                    CDouble rew = g->getScenario(tr->label)->getReward();
+
+                    if (Ms->getCols() > stateTokens[q1Id]
+                        || Ms->getRows() > stateTokens[q2Id])
+                    {
+                        throw CException("Number of initial tokens of scenario '"
+                                         + tr->label + "' does not match its FSM states.");
+                    }
 
                     // for every entry in the matrix
                     for (unsigned int r = 0; r < Ms->getRows(); r++)
@@ -347,33 +342,30 @@ namespace FSMSADF
                             MPDelay d = Ms->get(r, c);
                             if (!MP_ISMINUSINFINITY(d))
                             {
-                                MPARState *src = fsm->getStateLabeled(make_mpastatelabel(q1Id, c));
-                                MPARState *dst = fsm->getStateLabeled(make_mpastatelabel(q2Id, r));
-                                fsm->addEdge(src, make_rewedgelabel(d, sc, rew), dst);
+                                mpa.addEdge(stateOffset[q1Id] + c,
+                                            stateOffset[q2Id] + r, d, sc, rew);
                             }
                         }
                     }
                 }
             }
+            mpa.finalize();
 
             // calculate MCR of the FSM
-            MPARCycle *critCycle;
-            double mcr = fsm->calculateMCRAndCycle(&critCycle);
+            vector<uint> critCycle;
+            double mcr = mpa.calculateMCRAndCycle(&critCycle);
             th = 1.0 / mcr;
 
             ScenarioList *scenarios = new ScenarioList();
-            MPARCycle::const_iterator i = critCycle->begin();
-            for (; i != critCycle->end(); i++)
+            for (uint i = 0; i < critCycle.size(); i++)
             {
-                MPAREdge *e = (MPAREdge *) *i;
-                scenarios->push_back(g->getScenario(*(e->label.scenario)));
+                uint sc = mpa.getEdgeScenario(critCycle[i]);
+                scenarios->push_back(g->getScenario(mpa.getScenario(sc)));
             }
 
             // cleanup
-            delete critCycle;
             delete scenarioMatrices;
             delete elsFSM;
-            delete fsm;
 
             return scenarios;
         }
@@ -406,182 +398,297 @@ namespace FSMSADF
 
 
         /**
-         * Compute the MCM of the maxplus automaton.
+         * MaxPlusAutomaton()
+         * Constructor of an automaton with nrStates states and no edges.
+         */
+        MaxPlusAutomaton::MaxPlusAutomaton(const uint nrStates)
+            : nStates(nrStates), edgeOffset(nrStates + 1, 0)
+        {
+        }
+
+        /**
+         * addScenario()
+         * The function returns the index of the scenario with the given name.
+         * The name is added to the table of scenarios when it is not yet in
+         * this table.
          */
-        MPDelay MaxPlusAutomaton::calculateMCM(void)
+        uint MaxPlusAutomaton::addScenario(const CString &name)
         {
+            map<CString, uint>::const_iterator i = scenarioIds.find(name);
+
+            if (i != scenarioIds.end())
+                return i->second;
 
-            // Create a new MCM graph
-            MCMgraph *mcmGraph = new MCMgraph();
+            scenarioIds[name] = scenarios.size();
+            scenarios.push_back(name);
 
-            // Generate ids by countings
-            CId id = 0;
+            return scenarios.size() - 1;
+        }
 
-            // associate states and ids in the mcm graph
-            map<MPAState *, MCMnode *> stateMap;
+        /**
+         * addEdge()
+         * The function adds an edge from state src to state dst. The edges
+         * become accessible once the automaton is finalized.
+         */
+        void MaxPlusAutomaton::addEdge(const uint src, const uint dst,
+                                       const MPDelay d, const uint sc, const CDouble reward)
+        {
+            ASSERT(src < nStates && dst < nStates, "State does not exist.");
 
-            // Create the nodes of the MCM graph
-            MPASetOfStates::const_iterator i;
-            MPASetOfStates *states = this->getStates();
-            for (i = states->begin(); i != states->end(); i++)
+            edgeSrc.push_back(src);
+            edgeDst.push_back(dst);
+            edgeDelay.push_back(d);
+            edgeScenario.push_back(sc);
+            edgeReward.push_back(reward);
+        }
+
+        /**
+         * finalize()
+         * The function sorts the edges on their source state (counting sort)
+         * and computes the offset of the outgoing edges of every state.
+         */
+        void MaxPlusAutomaton::finalize()
+        {
+            uint m = edgeSrc.size();
+            vector<uint> pos(nStates + 1, 0);
+
+            // Offset of the outgoing edges of every state
+            for (uint e = 0; e < m; e++)
+                pos[edgeSrc[e] + 1]++;
+            for (uint s = 0; s < nStates; s++)
+                pos[s + 1] += pos[s];
+            edgeOffset = pos;
+
+            // Move every edge to its position
+            vector<uint> dst(m), scenario(m);
+            vector<MPDelay> delay(m);
+            vector<CDouble> reward(m);
+            for (uint e = 0; e < m; e++)
             {
-                MPAState *const s = (MPAState *)(*i);
+                uint k = pos[edgeSrc[e]]++;
+                dst[k] = edgeDst[e];
+                delay[k] = edgeDelay[e];
+                scenario[k] = edgeScenario[e];
+                reward[k] = edgeReward[e];
+            }
+            edgeDst.swap(dst);
+            edgeDelay.swap(delay);
+            edgeScenario.swap(scenario);
+            edgeReward.swap(reward);
 
-                // Create an MCM node for this state
-                MCMnode *n = new MCMnode(id, true);
+            vector<uint>().swap(edgeSrc);
+        }
 
-                // Store id of this state
-                stateMap[s] = n;
-                id++;
+        /**
+         * createSparseMatrix()
+         * The function creates the sparse matrix for Howard's algorithm of the
+         * states from which a cycle can be reached. (Other states have no
+         * outgoing edge in the matrix, which Howard's algorithm requires.)
+         * The states are renumbered in their original order. For every arc k,
+         * ij[2k] and ij[2k+1] are its source and destination and arcs[k] is the
+         * corresponding edge. The arcs of state i are the arcs arcOffset[i] up
+         * to arcOffset[i+1].
+         */
+        void MaxPlusAutomaton::createSparseMatrix(vector<int> &ij,
+                vector<uint> &arcs, vector<uint> &arcOffset) const
+        {
+            vector<uint> outDegree(nStates), inOffset(nStates + 1, 0);
+            vector<uint> inSrc(nrEdges());
+            vector<uint> dead;
+
+            // Incoming edges of every state
+            for (uint e = 0; e < nrEdges(); e++)
+                inOffset[edgeDst[e] + 1]++;
+            for (uint s = 0; s < nStates; s++)
+                inOffset[s + 1] += inOffset[s];
+            for (uint s = 0; s < nStates; s++)
+            {
+                for (uint e = edgesBegin(s); e < edgesEnd(s); e++)
+                    inSrc[inOffset[edgeDst[e]]++] = s;
+            }
+            for (uint s = nStates; s > 0; s--)
+                inOffset[s] = inOffset[s - 1];
+            inOffset[0] = 0;
 
-                // Add the node to the MCM graph
-                mcmGraph->addNode(n);
+            // Remove states without outgoing edges till none is left
+            for (uint s = 0; s < nStates; s++)
+            {
+                outDegree[s] = edgesEnd(s) - edgesBegin(s);
+                if (outDegree[s] == 0)
+                    dead.push_back(s);
             }
+            while (!dead.empty())
+            {
+                uint s = dead.back();
+                dead.pop_back();
 
-            // Add edges to the MCM graph
-            // for all states of the fsm...
-            CId edgeId = 0;
-            for (i = states->begin(); i != states->end(); i++)
+                for (uint k = inOffset[s]; k < inOffset[s + 1]; k++)
+                {
+                    if (--outDegree[inSrc[k]] == 0)
+                        dead.push_back(inSrc[k]);
+                }
+            }
+
+            // Number the remaining states
+            vector<int> id(nStates, -1);
+            int n = 0;
+            for (uint s = 0; s < nStates; s++)
+            {
+                if (outDegree[s] != 0)
+                    id[s] = n++;
+            }
+
+            // Arcs between the remaining states
+            ij.clear();
+            arcs.clear();
+            arcOffset.clear();
+            for (uint s = 0; s < nStates; s++)
             {
-                MPAState *const s = (MPAState *)(*i);
-                MCMnode *srcNode = stateMap[s];
-                MPASetOfEdges *edges = (MPASetOfEdges *) s->getOutgoingEdges();
+                if (id[s] < 0)
+                    continue;
 
-                // ...iterate over the outgoing edges
-                MPASetOfEdges::const_iterator j;
-                for (j = edges->begin(); j != edges->end(); j++)
+                arcOffset.push_back(arcs.size());
+                for (uint e = edgesBegin(s); e < edgesEnd(s); e++)
                 {
-                    MPAEdge *edg = (MPAEdge *)(*j);
-                    MPAState *ds = (MPAState *) edg->getDestination();
-                    // Create an edge in the MCM graph for this state transition
-                    MCMedge *e = new MCMedge(edgeId++, true);
-                    e->src = srcNode;
-                    e->dst = stateMap[ds];
-                    e->w = edg->label.delay;
-                    e->d = 1;
-
-                    // Add the edge to the MCM graph and the src and dst node
-                    mcmGraph->addEdge(e);
+                    if (id[edgeDst[e]] < 0)
+                        continue;
+
+                    ij.push_back(id[s]);
+                    ij.push_back(id[edgeDst[e]]);
+                    arcs.push_back(e);
                 }
             }
+            arcOffset.push_back(arcs.size());
+        }
 
-            MCMgraph *pruned = mcmGraph->pruneEdges();
+        /**
+         * Compute the MCM of the maxplus automaton. The MCM of all strongly
+         * connected components is computed in a single run of Howard's
+         * algorithm on the sparse matrix of the automaton.
+         */
+        MPDelay MaxPlusAutomaton::calculateMCM() const
+        {
+            vector<int> ij;
+            vector<uint> arcs, arcOffset;
+            HowardSolver howard;
 
-            delete mcmGraph;
-            double mcm = pruned->calculateMaximumCycleMeanKarp();
-            delete pruned;
-            return  mcm;
+            createSparseMatrix(ij, arcs, arcOffset);
+
+            // No cycles?
+            if (arcs.empty())
+                return 0;
+
+            vector<double> a(arcs.size());
+            for (uint k = 0; k < arcs.size(); k++)
+                a[k] = edgeDelay[arcs[k]];
+
+            howard.solve(&ij[0], &a[0], arcOffset.size() - 1, arcs.size());
+
+            return howard.getMaximumCycleMean();
         }
 
         /**
          * Compute the MCR of the maxplus automaton with rewards.
          */
-        CDouble MaxPlusAutomatonWithRewards::calculateMCR()
+        CDouble MaxPlusAutomaton::calculateMCR() const
         {
             return this->calculateMCRAndCycle(NULL);
         }
 
-
         /**
-         * Compute the MCR of the maxplus automaton with rewards and return a critical cycle.
+         * Compute the MCR of the maxplus automaton with rewards and return a
+         * critical cycle. The MCR is computed with Dinkelbach's iteration.
+         * Given a ratio lambda of some cycle, Howard's algorithm computes the
+         * maximum cycle mean of the weights delay - lambda * reward. When
+         * this mean is positive, the critical cycle of the optimal policy has
+         * a larger ratio, which becomes the next lambda. The iteration stops
+         * when no cycle with a larger ratio exists. Every run of Howard's
+         * algorithm starts from the optimal policy of the previous run.
          */
-        CDouble MaxPlusAutomatonWithRewards::calculateMCRAndCycle(MPARCycle **cycle)
+        CDouble MaxPlusAutomaton::calculateMCRAndCycle(vector<uint> *cycle) const
         {
+            vector<int> ij;
+            vector<uint> arcs, arcOffset, critCycle;
+            HowardSolver howard;
+            CDouble lambda = 0;
+            bool first = true;
 
-            MCMedge **mcmCritCycle;
-            uint mcmCritCycleLen;
+            createSparseMatrix(ij, arcs, arcOffset);
 
-            // Create a new MCM graph
-            MCMgraph *mcmGraph = new MCMgraph();
+            if (arcs.empty())
+                throw CException("Max-plus automaton has no cycles.");
 
-            // Generate ids by countings
-            CId id = 0;
+            int n = arcOffset.size() - 1;
+            vector<double> a(arcs.size());
+            vector<bool> visited(n);
 
-            // associate states and ids in the mcm graph
-            map<MPARState *, MCMnode *> stateMap;
-            map<MCMedge *, MPAREdge *> revEdgeMap;
+            howard.setWarmStart(true);
 
-            // Create the nodes of the MCM graph
-            MPARSetOfStates::const_iterator i;
-            MPARSetOfStates *states = this->getStates();
-            for (i = states->begin(); i != states->end(); i++)
+            while (true)
             {
-                MPARState *const s = (MPARState *)(*i);
-
-                // Create an MCM node for this state
-                MCMnode *n = new MCMnode(id, true);
-
-                // Store id of this state
-                stateMap[s] = n;
-                id++;
-
-                // Add the node to the MCM graph
-                mcmGraph->addNode(n);
-            }
-
-            // Add edges to the MCM graph
-            // for all states of the fsm...
-            CId edgeId = 0;
-            for (i = states->begin(); i != states->end(); i++)
-            {
-                MPARState *const s = (MPARState *)(*i);
-                MCMnode *srcNode = stateMap[s];
-                MPARSetOfEdges *edges = (MPARSetOfEdges *) s->getOutgoingEdges();
+                // Maximum cycle mean of the weights delay - lambda * reward
+                for (uint k = 0; k < arcs.size(); k++)
+                    a[k] = edgeDelay[arcs[k]] - lambda * edgeReward[arcs[k]];
+                howard.solve(&ij[0], &a[0], n, arcs.size());
+
+                // The state with the largest cycle time leads to a critical
+                // cycle of the policy
+                const vector<double> &chi = howard.getCycleTimeVector();
+                const vector<int> &pi = howard.getPolicy();
+                int i = 0;
+                for (int j = 1; j < n; j++)
+                {
+                    if (chi[j] > chi[i])
+                        i = j;
+                }
+                visited.assign(n, false);
+                while (!visited[i])
+                {
+                    visited[i] = true;
+                    i = pi[i];
+                }
 
-                // ...iterate over the outgoing edges
-                MPARSetOfEdges::const_iterator j;
-                for (j = edges->begin(); j != edges->end(); j++)
+                // Edges of the cycle (the arc with the largest weight when
+                // the policy has parallel arcs)
+                vector<uint> c;
+                CDouble w = 0, r = 0;
+                int j = i;
+                do
                 {
-                    MPAREdge *edg = (MPAREdge *)(*j);
-                    MPARState *ds = (MPARState *) edg->getDestination();
-                    // Create an edge in the MCM graph for this state transition
-                    MCMedge *e = new MCMedge(edgeId++, true);
-                    e->src = srcNode;
-                    e->dst = stateMap[ds];
-                    e->w = edg->label.delay;
-                    e->d = edg->label.reward;
-
-                    revEdgeMap[e] = edg;
-
-                    // Add the edge to the MCM graph and the src and dst node
-                    mcmGraph->addEdge(e);
+                    uint best = arcOffset[j];
+                    for (uint k = arcOffset[j]; k < arcOffset[j + 1]; k++)
+                    {
+                        if (ij[2 * k + 1] == pi[j]
+                            && (ij[2 * best + 1] != pi[j] || a[k] > a[best]))
+                        {
+                            best = k;
+                        }
+                    }
+                    c.push_back(arcs[best]);
+                    w += edgeDelay[arcs[best]];
+                    r += edgeReward[arcs[best]];
+                    j = pi[j];
                 }
-            }
+                while (j != i);
 
-            // prune the graph
-            MCMgraph *pruned = mcmGraph->pruneEdges();
+                if (r <= 0)
+                    throw CException("Max-plus automaton has a cycle without reward.");
 
-            CDouble mcr;
+                // No cycle with a larger ratio?
+                if (!first && w / r <= lambda + MP_EPSILON)
+                    break;
 
-            // do we need the critical cycle?
-            if (cycle != NULL)
-            {
-                // compute MRC and cycle
-                mcr = maxCycleRatioAndCriticalCycleYoungTarjanOrlin(pruned, &mcmCritCycle, &mcmCritCycleLen);
-                // translate mcmgraph cycle back to MPA cycle
-                *cycle = new MPARCycle();
-                for (uint i = 0; i < mcmCritCycleLen; i++)
-                {
-                    (*cycle)->push_back(revEdgeMap[mcmGraph->getEdge(mcmCritCycle[i]->id)]);
-                }
-                // cleanup
-                free(mcmCritCycle);
-            }
-            else
-            {
-                mcr = maxCycleRatioYoungTarjanOrlin(pruned);
+                lambda = w / r;
+                critCycle.swap(c);
+                first = false;
             }
 
-            // cleanup
-            delete pruned;
-            delete mcmGraph;
+            if (cycle != NULL)
+                cycle->swap(critCycle);
 
-            // return the result
-            return  mcr;
+            return lambda;
         }
 
-
-
     } // End namespace MPExploreStateSpace
 
 } // End namespace FSMSADF
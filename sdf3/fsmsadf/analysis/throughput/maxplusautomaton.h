@@ -13,6 +13,7 @@
  *
  *  History         :
  *      26-04-10    :   Initial version.
+ *      17-10-26    :   Compressed sparse row automaton.
  *
  * $Id: maxplusautomaton.h,v 1.1.2.4 2010-05-07 06:14:52 mgeilen Exp $
  *
@@ -72,126 +73,99 @@ namespace FSMSADF
     namespace MPExploreMaxPlusAutomaton
     {
         /**
-         * states of the MPA are labelled with the ID of the original fsm and the token number
+         * A max-plus automaton
+         * The states of the automaton are numbered 0 up to nrStates()-1. The
+         * edges are stored in compressed sparse row form; the outgoing edges
+         * of state s are the edges edgesBegin(s) up to edgesEnd(s). Every edge
+         * carries a delay, a reward and the index of its scenario in a table
+         * in which every scenario name is stored once. Edges may be added in
+         * any order. Once all edges are added, finalize() sorts them on their
+         * source state.
          */
-        typedef struct
+        class MaxPlusAutomaton
         {
-            CId id;
-            unsigned int tokenNr;
-        } MPAStateLabel;
+            public:
+                // Constructor
+                MaxPlusAutomaton(const uint nrStates);
+
+                // Destructor
+                ~MaxPlusAutomaton() {};
+
+                // Scenarios
+                uint addScenario(const CString &name);
+                const CString &getScenario(const uint sc) const
+                {
+                    return scenarios[sc];
+                };
+
+                // Construction
+                void addEdge(const uint src, const uint dst, const MPDelay d,
+                             const uint sc, const CDouble reward = 1);
+                void finalize();
+
+                // States and edges
+                uint nrStates() const
+                {
+                    return nStates;
+                };
+                uint nrEdges() const
+                {
+                    return edgeDst.size();
+                };
+                uint edgesBegin(const uint s) const
+                {
+                    return edgeOffset[s];
+                };
+                uint edgesEnd(const uint s) const
+                {
+                    return edgeOffset[s + 1];
+                };
+                uint getEdgeDestination(const uint e) const
+                {
+                    return edgeDst[e];
+                };
+                MPDelay getEdgeDelay(const uint e) const
+                {
+                    return edgeDelay[e];
+                };
+                uint getEdgeScenario(const uint e) const
+                {
+                    return edgeScenario[e];
+                };
+                CDouble getEdgeReward(const uint e) const
+                {
+                    return edgeReward[e];
+                };
 
-        /**
-         * to support easy construction of state labels
-         */
-        inline MPAStateLabel make_mpastatelabel(CId i, unsigned int n)
-        {
-            MPAStateLabel sl;
-            sl.id = i;
-            sl.tokenNr = n;
-            return sl;
-        }
+                // calculate the MCM of the maxplus automaton graph delay
+                MPDelay calculateMCM() const;
 
-        /**
-         * comparing state labels
-         */
-        inline bool operator==(MPAStateLabel s, MPAStateLabel t)
-        {
-            return s.id == t.id && s.tokenNr == t.tokenNr;
-        }
+                // compute the maximum cycle ratio of delay over progress
+                CDouble calculateMCR() const;
+                // compute the maximum cycle ratio of delay over progress and also return a critical cycle
+                CDouble calculateMCRAndCycle(vector<uint> *cycle) const;
 
-        /**
-         * comparing state labels, lexicographic order
-         */
-        inline bool operator<(MPAStateLabel s, MPAStateLabel t)
-        {
-            if (s.id < t.id) return true;
-            if (s.id > t.id) return false;
-            return s.tokenNr < t.tokenNr;
-        }
+            private:
+                // Sparse matrix of the states from which a cycle is reachable
+                void createSparseMatrix(vector<int> &ij, vector<uint> &arcs,
+                                        vector<uint> &arcOffset) const;
 
-        /**
-         * an MPA edge is labelled with a delay and a scenario name
-         */
-        typedef struct
-        {
-            MPDelay delay;
-            CString *scenario;
-        } MPAEdgeLabel;
+                // Number of states
+                uint nStates;
 
-        /**
-         * to support easy construction od an edge label
-         */
-        inline MPAEdgeLabel make_mpaedgelabel(MPDelay d, CString *sc)
-        {
-            MPAEdgeLabel el;
-            el.delay = d;
-            el.scenario = sc;
-            return el;
-        }
-
-        // types for edges and states and sets
-        typedef ::FSM::Labeled::State<MPAStateLabel, MPAEdgeLabel> MPAState;
-        typedef ::FSM::Labeled::Edge<MPAStateLabel, MPAEdgeLabel> MPAEdge;
-        typedef ::FSM::Labeled::SetOfStates<MPAStateLabel, MPAEdgeLabel> MPASetOfStates;
-        typedef ::FSM::Labeled::SetOfEdges<MPAStateLabel, MPAEdgeLabel> MPASetOfEdges;
+                // Edges in compressed sparse row form
+                vector<uint> edgeOffset;
+                vector<uint> edgeDst;
+                vector<MPDelay> edgeDelay;
+                vector<uint> edgeScenario;
+                vector<CDouble> edgeReward;
 
-        /**
-         * A max-plus automaton
-         */
-        class MaxPlusAutomaton: public
-            ::FSM::Labeled::FiniteStateMachine<MPAStateLabel, MPAEdgeLabel>
-        {
-            public:
-                virtual ~MaxPlusAutomaton() {};
-                
-                // calculate the MCM of the maxplus automaton graph delay
-                MPDelay calculateMCM(void);
-        };
-
-        /**
-         * An edge label type for a max-plus automaton with rewards
-         */
-        typedef struct
-        {
-            MPDelay delay;
-            CString *scenario;
-            CDouble reward;
-        } MPAREdgeLabel;
+                // Source states of the edges till the automaton is finalized
+                vector<uint> edgeSrc;
 
-        /**
-         * support for easy construction of a edge label with rewards
-         */
-        inline MPAREdgeLabel make_rewedgelabel(MPDelay d, CString *sc, CDouble r)
-        {
-            MPAREdgeLabel el;
-            el.delay = d;
-            el.scenario = sc;
-            el.reward = r;
-            return el;
-        }
-
-        // types of states, edges, sets and cycle of an MPAR
-        typedef ::FSM::Labeled::State<MPAStateLabel, MPAREdgeLabel > MPARState;
-        typedef ::FSM::Labeled::Edge<MPAStateLabel, MPAREdgeLabel > MPAREdge;
-        typedef ::FSM::Labeled::SetOfStates<MPAStateLabel, MPAREdgeLabel > MPARSetOfStates;
-        typedef ::FSM::Labeled::SetOfEdges<MPAStateLabel, MPAREdgeLabel > MPARSetOfEdges;
-        typedef ::FSM::Labeled::ListOfEdges<MPAStateLabel, MPAREdgeLabel > MPARCycle;
-
-        /**
-         * A max-plus automaton with rewards. In addition to the usual max-plus
-         * automaton, its edges are labelled with rewards, a quantified amount of
-         * 'progress'.
-         */
-        class MaxPlusAutomatonWithRewards: public
-            ::FSM::Labeled::FiniteStateMachine<MPAStateLabel, MPAREdgeLabel >
-        {
-            public:
-                virtual ~MaxPlusAutomatonWithRewards() {};
-                
-                // compute the maximum cycle ratio of delay over progress
-                CDouble calculateMCR(void);
-                // compute the maximum cycle ratio of delay over progress and also return a critical cycle
-                CDouble calculateMCRAndCycle(MPARCycle **cycle);
+                // Scenario names
+                vector<CString> scenarios;
+                map<CString, uint> scenarioIds;
         };
 
         /**
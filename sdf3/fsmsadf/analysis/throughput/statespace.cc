@@ -13,6 +13,7 @@
  *
  *  History         :
  *      12-08-09    :   Initial version.
+ *      17-10-26    :   Parallel state-space exploration.
  *
  * $Id: statespace.cc,v 1.2.2.23 2010-08-18 09:01:00 mgeilen Exp $
  *
@@ -36,6 +37,12 @@
 
 #include "statespace.h"
 #include "sdf/analysis/mcm/mcmgraph.h"
+#include "sdf/analysis/mcm/mcmengine.h"
+#include <atomic>
+#include <climits>
+#include <deque>
+#include <exception>
+#include <thread>
 
 //#define _DEBUG_
 
@@ -45,9 +52,11 @@ namespace FSMSADF
     /**
      * throughputAnalysisGraphUsingStateSpace()
      * Compute the throughput of an FSM-based SDAF graph through a state-space
-     * traversal.
+     * traversal. The state-space is explored on nrThreads worker threads (0
+     * selects the number of hardware threads). A single thread uses the
+     * sequential exploration.
      */
-    Throughput throughputAnalysisGraphUsingStateSpace(Graph *g)
+    Throughput throughputAnalysisGraphUsingStateSpace(Graph *g, uint nrThreads)
     {
         MPExploreStateSpace::StateSpaceExploration sse;
         Graph *gt;
@@ -56,7 +65,10 @@ namespace FSMSADF
         gt = GraphConversion::ensureStronglyBounded(g);
 
         // Compute throughput
-        thr = sse.exploreThroughputMax(gt);
+        if (nrThreads == 1)
+            thr = sse.exploreThroughputMax(gt);
+        else
+            thr = sse.exploreThroughputMaxParallel(gt, nrThreads);
 
         // Cleanup
         delete gt;
@@ -201,22 +213,8 @@ namespace FSMSADF
         {
             // if there is some reachable state (q',v') with d' such that
             // q'=q and d+v <= d'+v' then forget
-            map<State *, MPDelay>::const_iterator i;
-            for (i = this->reachableStates.begin(); i != this->reachableStates.end(); i++)
-            {
-                if ((*i).first->fsmState == state->fsmState)
-                {
-                    Vector *vp = (*i).first->mpvector;
-                    Vector *v = state->mpvector;
-                    MPDelay dp = (*i).second;
-                    bool dominates = true;
-                    for (unsigned int k = 0; dominates && k < this->mpvector->getSize(); k++)
-                    {
-                        dominates = dominates && (d + (v->get(k)) <= dp + (vp->get(k)));
-                    }
-                    if (dominates) return false;
-                }
-            }
+            if (isDominatedByReachableState(state, d))
+                return false;
 
             // if state is already reachable update delay
             if (this->reachableStates.find(state) != this->reachableStates.end())
@@ -240,6 +238,32 @@ namespace FSMSADF
 #endif
         }
 
+        /**
+         * isDominatedByReachableState()
+         * The function returns true when some reachable state (q',v') with
+         * delay d' has q'=q and d'+v' >= d+v for the state (q,v) with delay d.
+         */
+        bool State::isDominatedByReachableState(const State *state, MPDelay d) const
+        {
+            map<State *, MPDelay>::const_iterator i;
+            for (i = this->reachableStates.begin(); i != this->reachableStates.end(); i++)
+            {
+                if ((*i).first->fsmState == state->fsmState)
+                {
+                    Vector *vp = (*i).first->mpvector;
+                    Vector *v = state->mpvector;
+                    MPDelay dp = (*i).second;
+                    bool dominates = true;
+                    for (unsigned int k = 0; dominates && k < this->mpvector->getSize(); k++)
+                    {
+                        dominates = dominates && (d + (v->get(k)) <= dp + (vp->get(k)));
+                    }
+                    if (dominates) return true;
+                }
+            }
+            return false;
+        }
+
         /**
          * print()
          * Print the state.
@@ -523,6 +547,242 @@ namespace FSMSADF
         }
 
 
+        /**
+         * insert()
+         * Insert the state unless an equal state is in the set. The function
+         * returns the state in the set and sets inserted to true when this
+         * is the supplied state.
+         */
+        State *ConcurrentStates::insert(State *s, bool &inserted)
+        {
+            uint k = s->hashValue() % shards.size();
+            std::lock_guard<std::mutex> lock(locks[k]);
+            State *t;
+
+            if (shards[k].includes(s, &t))
+            {
+                inserted = false;
+                return t;
+            }
+
+            shards[k].insert(s);
+            inserted = true;
+            return s;
+        }
+
+        /**
+         * moveTo()
+         * Move all states into the set of states. The function must not be
+         * called while other threads use the set.
+         */
+        void ConcurrentStates::moveTo(States *states)
+        {
+            for (uint k = 0; k < shards.size(); k++)
+            {
+                states->insert(shards[k].begin(), shards[k].end());
+                shards[k].clear();
+            }
+        }
+
+        /**
+         * exploreThroughputMaxParallel()
+         * Compute the throughput of the FSM-based SADF graph like
+         * exploreThroughputMax. The states are explored by a pool of worker
+         * threads. Every worker owns a queue of states from which it takes
+         * the most recently found state. A worker with an empty queue steals
+         * the oldest state from the queue of another worker. The visited
+         * states are stored in a set which is shared by the workers. A state
+         * is expanded by one worker, which also owns its set of reachable
+         * states. The MCM of the resulting state-space is computed with the
+         * MCM engine.
+         */
+        Throughput StateSpaceExploration::exploreThroughputMaxParallel(Graph *g,
+                uint nrThreads)
+        {
+            class WorkQueue
+            {
+                public:
+                    std::mutex lock;
+                    std::deque<State *> states;
+            };
+
+            State *initialState;
+            ConcurrentStates visitedStates;
+            std::atomic<unsigned long long> nrPendingStates(0);
+            std::exception_ptr error;
+            std::atomic<bool> failed(false);
+            Throughput thr = 0;
+
+            nrThreads = CNrWorkers(UINT_MAX, nrThreads);
+
+            vector<WorkQueue> queues(nrThreads);
+
+            // Create maxplus matrices from the individual scenario graphs
+            ScenarioMatrices *scenarioMatrices;
+            scenarioMatrices = GraphConversion::computeMaxPlusMatricesFromScenarios(g);
+
+            // create a minimizal edge labelled scenario automaton
+            EdgeLabeledScenarioFSM *elsFSM = FSMConverter::minimalEdgeLabeledFSM(g->getFSM());
+            MatrixLabeledScenarioFSM *mlsFSM = FSMConverter::convertToMatrixLabeledScenarioFSM(elsFSM, scenarioMatrices);
+            delete elsFSM;
+
+            // Create an initial state based on the initial FSM state
+            initialState = new State(NULL, mlsFSM->getInitialState(), NULL);
+            initialState->mpvector = new Vector(scenarioMatrices->vectorSize(), 0.0);
+
+            // Add the initial state to the set of visited states and to the
+            // queue of the first worker
+            bool inserted;
+            visitedStates.insert(initialState, inserted);
+            queues[0].states.push_back(initialState);
+            nrPendingStates = 1;
+
+            // Explore all states reachable from a state
+            auto expand = [&](State *curState, WorkQueue &queue)
+            {
+                MLSSetOfEdges *edges = (MLSSetOfEdges *)curState->fsmState->getOutgoingEdges();
+                for (MLSSetOfEdges::CIter i = edges->begin(); i != edges->end(); i++)
+                {
+                    MLSEdge *e = (MLSEdge *) *i;
+
+                    // Execute one iteration of the scenario graph
+                    State *newState = new State(curState, (MLSState *)e->getDestination(), e->label);
+                    newState->executeIteration();
+                    newState->normalize();
+
+                    // Redundant state?
+                    if (curState->isDominatedByReachableState(newState, newState->delay))
+                    {
+                        delete newState->mpvector;
+                        delete newState;
+                        continue;
+                    }
+
+                    // Add the state to the set of visited states unless it
+                    // has been reached before
+                    bool isNew;
+                    State *s = visitedStates.insert(newState, isNew);
+                    curState->addReachableState(s, newState->delay);
+
+                    if (isNew)
+                    {
+                        nrPendingStates++;
+                        std::lock_guard<std::mutex> lock(queue.lock);
+                        queue.states.push_back(newState);
+                    }
+                    else
+                    {
+                        delete newState->mpvector;
+                        delete newState;
+                    }
+                }
+            };
+
+            // Worker which explores states till no state is pending
+            auto worker = [&](uint t)
+            {
+                while (nrPendingStates > 0 && !failed)
+                {
+                    State *curState = NULL;
+
+                    // Take the most recent state from the own queue or steal
+                    // the oldest state from another queue
+                    for (uint k = 0; curState == NULL && k < nrThreads; k++)
+                    {
+                        WorkQueue &q = queues[(t + k) % nrThreads];
+                        std::lock_guard<std::mutex> lock(q.lock);
+
+                        if (q.states.empty())
+                            continue;
+
+                        if (k == 0)
+                        {
+                            curState = q.states.back();
+                            q.states.pop_back();
+                        }
+                        else
+                        {
+                            curState = q.states.front();
+                            q.states.pop_front();
+                        }
+                    }
+
+                    if (curState == NULL)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    try
+                    {
+                        expand(curState, queues[t]);
+                    }
+                    catch (...)
+                    {
+                        failed = true;
+                        throw;
+                    }
+                    nrPendingStates--;
+                }
+            };
+
+            // The states are cleaned up before an exception is rethrown
+            try
+            {
+                CParallelRun(nrThreads, worker);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            // Collect the visited states
+            States *states = new States;
+            visitedStates.moveTo(states);
+
+            // Compute throughput
+            if (!error)
+            {
+                MCMgraph *mcmGraph = createMCMgraph(states);
+                MCMengine mcmEngine;
+                double mcm;
+
+                mcmEngine.setAlgorithm(MCMengine::Howard);
+                mcmEngine.setNrThreads(nrThreads);
+                mcm = mcmEngine.solve(mcmGraph);
+                delete mcmGraph;
+
+                // MCM is zero? Then there is no throughput (throughout is infinite)
+                if (mcm == 0.0)
+                {
+                    error = std::make_exception_ptr(CException("Cannot "
+                        "compute throughout. MCM of the statespace is 0 "
+                        "(throughput is infinite)."));
+                }
+                else
+                {
+                    thr = Throughput(1.0 / mcm);
+                }
+            }
+
+            // Cleanup
+            for (States::iterator i = states->begin(); i != states->end();)
+            {
+                State *s = *i;
+                states->erase(i++);
+                delete s->mpvector;
+                delete s;
+            }
+            delete states;
+            delete scenarioMatrices;
+            delete mlsFSM;
+
+            if (error)
+                std::rethrow_exception(error);
+
+            return thr;
+        }
+
         /**
          * computeThroughput()
          * Comput the MCM of the state space. The
@@ -547,7 +807,7 @@ namespace FSMSADF
             parents[initialState] = NULL;
             mcm = dfsStateSpace(visitedStates, initialState, parents, color);
 #else
-            // Compute mcm using Karp
+            // Compute mcm using Howard
             mcm = computeMCM(visitedStates, initialState);
 #endif
 
@@ -566,6 +826,29 @@ namespace FSMSADF
          */
         double StateSpaceExploration::computeMCM(States *visitedStates,
                 State *initialState)
+        {
+            MCMgraph *mcmGraph = createMCMgraph(visitedStates);
+            MCMengine mcmEngine;
+            double mcm;
+
+            // Calculate the MCM with Howard's algorithm (the edge weights
+            // are not integer in general)
+            mcmEngine.setAlgorithm(MCMengine::Howard);
+            mcmEngine.setNrThreads(1);
+            mcm = mcmEngine.solve(mcmGraph);
+
+            // Cleanup
+            delete mcmGraph;
+
+            return mcm;
+        }
+
+        /**
+         * createMCMgraph()
+         * The function returns an MCM graph with a node for every state and
+         * an edge for every transition between states.
+         */
+        MCMgraph *StateSpaceExploration::createMCMgraph(States *visitedStates)
         {
             map<State *, MCMnode *> stateNodes;
             CId id = 0;
@@ -608,8 +891,7 @@ namespace FSMSADF
                 }
             }
 
-            // calculate the MCM
-            return mcmGraph->calculateMaximumCycleMeanKarp();
+            return mcmGraph;
         }
 
         /**
@@ -13,6 +13,7 @@
  *
  *  History         :
  *      12-08-09    :   Initial version.
+ *      17-10-26    :   Parallel state-space exploration.
  *
  * $Id: statespace.h,v 1.1.2.9 2010-05-07 19:21:20 mgeilen Exp $
  *
@@ -40,6 +41,7 @@
 #include "../../base/graph.h"
 #include "../../base/fsm.h"
 #include "thrutils.h"
+#include <mutex>
 
 #ifdef _MSC_VER
 #include <hash_set>
@@ -50,15 +52,23 @@
 using namespace __gnu_cxx;
 #endif
 
+namespace SDF
+{
+    class MCMgraph;
+}
+
 namespace FSMSADF
 {
 
     /**
      * throughputAnalysisGraphUsingStateSpace()
      * Compute the throughput of an FSM-based SDAF graph through a state-space
-     * traversal.
+     * traversal. The state-space is explored on nrThreads worker threads (0
+     * selects the number of hardware threads). By default, the sequential
+     * exploration is used.
      */
-    Throughput throughputAnalysisGraphUsingStateSpace(Graph *g);
+    Throughput throughputAnalysisGraphUsingStateSpace(Graph *g,
+            uint nrThreads = 1);
 
     /**
      * namespace MPExploreStateSpace
@@ -103,6 +113,10 @@ namespace FSMSADF
                 // returns true if the state was really added, false if it was redundant.
                 bool addReachableState(State *state, MPDelay d);
 
+                // Is the state with delay d redundant given the set of
+                // reachable states?
+                bool isDominatedByReachableState(const State *state, MPDelay d) const;
+
                 // Print the state
                 void print(ostream &out) const;
 
@@ -203,6 +217,32 @@ namespace FSMSADF
                 }
         };
 
+        /**
+         * class ConcurrentStates
+         * Set of states which is shared by a pool of threads. The set is
+         * divided into shards on the hash value of the states. Every shard
+         * has its own lock, so threads inserting different states rarely
+         * wait on each other.
+         */
+        class ConcurrentStates
+        {
+            public:
+                // Constructor
+                ConcurrentStates(const uint nrShards = 64)
+                    : shards(nrShards), locks(nrShards) {};
+
+                // Insert the state unless an equal state is in the set.
+                // Returns the state in the set.
+                State *insert(State *s, bool &inserted);
+
+                // Move all states into the set of states
+                void moveTo(States *states);
+
+            private:
+                vector<States> shards;
+                vector<std::mutex> locks;
+        };
+
         /**
          * class StateSpaceExploration
          * The state-space analysis algorithms.
@@ -217,6 +257,10 @@ namespace FSMSADF
                 // state-space traversal while combining multiple scenarios leading
                 // the same net state of the fsm.
                 Throughput exploreThroughputMax(Graph *g);
+                // Compute the throughput like exploreThroughputMax. The
+                // state-space is explored by a pool of nrThreads worker threads
+                // (0 selects the number of hardware threads).
+                Throughput exploreThroughputMaxParallel(Graph *g, uint nrThreads = 0);
 
             private:
                 // Compute the throughput of the FSM-based SADF graph by computing the
@@ -225,6 +269,8 @@ namespace FSMSADF
                                              State *initialState);
                 // Compute MCM using Karps theorem
                 double computeMCM(States *visitedStates, State *initialState);
+                // Create the MCM graph of the state-space
+                SDF::MCMgraph *createMCMgraph(States *visitedStates);
 
                 // Output the state-space in DOT format
                 void printStateSpace(States *states, ostream &out);
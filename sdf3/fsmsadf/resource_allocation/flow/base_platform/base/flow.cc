@@ -14,6 +14,7 @@
  *      07-02-07    :   Initial version.
  *      19-04-11    :   Add accessors (M. Koedam)
  *                      Virtual functions, rename to SDF3FlowBase
+ *      17-10-26    :   Number of threads of the tile binding algorithm.
  *
  * $Id: flow.cc,v 1.2 2010-02-08 08:04:42 sander Exp $
  *
@@ -52,6 +53,7 @@ namespace FSMSADF
         platformGraph(NULL),
         stateOfFlow(FlowStart),
         maxNrBindingsTileBindingAlgo(1),
+        nrThreadsTileBindingAlgo(0),
         memoryDimAlgo(NULL),
         tileBindingAlgo(NULL)
     {
@@ -193,6 +195,7 @@ namespace FSMSADF
         tileBindingAlgo->setApplicationGraph(getApplicationGraph());
         tileBindingAlgo->setPlatformGraph(getPlatformGraph());
         tileBindingAlgo->setPlatformBindings(&platformBindings);
+        tileBindingAlgo->setNrThreads(nrThreadsTileBindingAlgo);
 
         // Initialize tile binding algorithm
         tileBindingAlgo->init();
@@ -14,6 +14,7 @@
  *      29-05-09    :   Initial version.
  *      19-04-11    :   Add accessors (M. Koedam)
  *                      Virtual functions, rename to SDF3FlowBase
+ *      17-10-26    :   Number of threads of the tile binding algorithm.
  *
  * $Id: flow.h,v 1.2 2010-02-08 08:04:42 sander Exp $
  *
@@ -125,6 +126,17 @@ namespace FSMSADF
                 maxNrBindingsTileBindingAlgo = n;
             };
 
+            // Number of threads used by the tile binding and scheduling
+            // algorithm (0 means the number of hardware threads)
+            uint getNrThreadsTileBindingAlgo() const
+            {
+                return nrThreadsTileBindingAlgo;
+            };
+            void setNrThreadsTileBindingAlgo(const uint n)
+            {
+                nrThreadsTileBindingAlgo = n;
+            };
+
             // Application graph
             Graph *getApplicationGraph()
             {
@@ -195,6 +207,9 @@ namespace FSMSADF
             // Maximum number of platform bindings created in tile binding algorithm
             uint maxNrBindingsTileBindingAlgo;
 
+            // Number of threads used in tile binding algorithm
+            uint nrThreadsTileBindingAlgo;
+
         protected:
             // Memory dimensioning object
             MemoryDimAlgoBase *memoryDimAlgo;
@@ -14,6 +14,7 @@
  *      29-05-09    :   Initial version.
  *      19-04-11    :   Add accessors (M. Koedam)
  *                      Virtual functions, rename to SDF3FlowBase
+ *      17-10-26    :   Parallel binding expansion, skyline Pareto filter.
  *
  * $Id: binding.cc,v 1.1 2009-12-23 13:37:22 sander Exp $
  *
@@ -39,6 +40,9 @@
 #include "../../../../analysis/base/repetition_vector.h"
 #include "../../../scheduling/earliest_deadline_first/edf.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace FSMSADF
 {
 
@@ -50,7 +54,8 @@ namespace FSMSADF
         :
         applicationGraph(NULL),
         platformGraph(NULL),
-        platformBindings(NULL)
+        platformBindings(NULL),
+        nrThreads(0)
     {
 
     }
@@ -271,45 +276,8 @@ namespace FSMSADF
                 // Create all bindings for the actor
                 createAllBindingsOfActor(an, applicationBindings);
 
-                // Iterate over all partial application bindings
-                for (GraphBindings::iterator j = applicationBindings.begin();
-                     j != applicationBindings.end();)
-                {
-                    GraphBindingBase *b = *j;
-                    bool validBinding = true;
-
-                    // Iterate over the channel names in arbitrary order
-                    for (map<CString, Channels>::iterator
-                         k = channelNamesToChannels.begin();
-                         k != channelNamesToChannels.end(); k++)
-                    {
-                        CString cn = k->first;
-
-                        // Try to bind channel with name cn to platform
-                        if (!createBindingOfChannel(cn, b))
-                        {
-                            // All possible bindings of channel to platfrom have a
-                            // resource conflict. So, binding b cannot be realized
-                            validBinding = false;
-                            break;
-                        }
-                    }
-
-                    // Channel to platform binding is not possible?
-                    if (!validBinding)
-                    {
-                        // Erase binding and continue with next binding
-                        applicationBindings.erase(j++);
-                    }
-                    else
-                    {
-                        // Compute cost of this binding
-                        b->computeParetoQuantities(repetitionVectors, false);
-
-                        // Next binding
-                        j++;
-                    }
-                }
+                // Bind the channels and compute the cost of all bindings
+                createBindingsOfChannels(applicationBindings);
 
                 // Remove all non-Pareto optimal bindings
                 paretoMinimizationOfApplicationBindings(applicationBindings);
@@ -391,14 +359,17 @@ namespace FSMSADF
             CString &name, ActorBinding &actorBinding)
     {
         // Iterate over the actor with the specified name
-        for (Actors::iterator j = actorNamesToActors[name].begin();
-             j != actorNamesToActors[name].end(); j++)
+        const Actors &actors = getActorsWithName(name);
+
+        for (Actors::const_iterator j = actors.begin(); j != actors.end(); j++)
         {
             Actor *a = *j;
 
             // Iterate over all scenarios in which the actor appears
-            for (Scenarios::iterator k = actorToScenarios[a].begin();
-                 k != actorToScenarios[a].end(); k++)
+            const Scenarios &scenarios = getScenariosOfActor(a);
+
+            for (Scenarios::const_iterator k = scenarios.begin();
+                 k != scenarios.end(); k++)
             {
                 Scenario *s = *k;
                 if (!applicationBinding->bindActorToTile(s, a, actorBinding))
@@ -419,14 +390,17 @@ namespace FSMSADF
             CString &name)
     {
         // Iterate over the actor with the specified name
-        for (Actors::iterator j = actorNamesToActors[name].begin();
-             j != actorNamesToActors[name].end(); j++)
+        const Actors &actors = getActorsWithName(name);
+
+        for (Actors::const_iterator j = actors.begin(); j != actors.end(); j++)
         {
             Actor *a = *j;
 
             // Iterate over all scenarios in which the actor appears
-            for (Scenarios::iterator k = actorToScenarios[a].begin();
-                 k != actorToScenarios[a].end(); k++)
+            const Scenarios &scenarios = getScenariosOfActor(a);
+
+            for (Scenarios::const_iterator k = scenarios.begin();
+                 k != scenarios.end(); k++)
             {
                 Scenario *s = *k;
 
@@ -444,14 +418,18 @@ namespace FSMSADF
             CString &name, ChannelBinding &channelBinding)
     {
         // Iterate over the channel with the specified name
-        for (Channels::iterator j = channelNamesToChannels[name].begin();
-             j != channelNamesToChannels[name].end(); j++)
+        const Channels &channels = getChannelsWithName(name);
+
+        for (Channels::const_iterator j = channels.begin();
+             j != channels.end(); j++)
         {
             Channel *c = *j;
 
             // Iterate over all scenarios in which the channel appears
-            for (Scenarios::iterator k = channelToScenarios[c].begin();
-                 k != channelToScenarios[c].end(); k++)
+            const Scenarios &scenarios = getScenariosOfChannel(c);
+
+            for (Scenarios::const_iterator k = scenarios.begin();
+                 k != scenarios.end(); k++)
             {
                 Scenario *s = *k;
 
@@ -483,14 +461,18 @@ namespace FSMSADF
             CString &name)
     {
         // Iterate over the channel with the specified name
-        for (Channels::iterator j = channelNamesToChannels[name].begin();
-             j != channelNamesToChannels[name].end(); j++)
+        const Channels &channels = getChannelsWithName(name);
+
+        for (Channels::const_iterator j = channels.begin();
+             j != channels.end(); j++)
         {
             Channel *c = *j;
 
             // Iterate over all scenarios in which the channel appears
-            for (Scenarios::iterator k = channelToScenarios[c].begin();
-                 k != channelToScenarios[c].end(); k++)
+            const Scenarios &scenarios = getScenariosOfChannel(c);
+
+            for (Scenarios::const_iterator k = scenarios.begin();
+                 k != scenarios.end(); k++)
             {
                 Scenario *s = *k;
 
@@ -518,9 +500,10 @@ namespace FSMSADF
         }
 
         // Iterate over all possible processors
-        for (Processors::iterator
-             i = actorNamesToProcessorCandidates[a->getName()].begin();
-             i != actorNamesToProcessorCandidates[a->getName()].end(); i++)
+        const Processors &candidates = getProcessorCandidates(a->getName());
+
+        for (Processors::const_iterator i = candidates.begin();
+             i != candidates.end(); i++)
         {
             Processor *p = *i;
             Tile *t = p->getTile();
@@ -832,6 +815,8 @@ namespace FSMSADF
             }
 
             // Find all processors which are of a type inside the set procTypes
+            // (every actor name gets a, possibly empty, list of candidates)
+            Processors &candidates = actorNamesToProcessorCandidates[i->first];
             for (Tiles::iterator
                  j = platformGraph->getTiles().begin();
                  j != platformGraph->getTiles().end(); j++)
@@ -847,7 +832,7 @@ namespace FSMSADF
                     // Is the processor of a type supported by the actor?
                     if (procTypes.find(p->getType()) != procTypes.end())
                     {
-                        actorNamesToProcessorCandidates[i->first].push_back(p);
+                        candidates.push_back(p);
                     }
                 }
             }
@@ -870,6 +855,89 @@ namespace FSMSADF
         }
     }
 
+    /**
+     * getActorsWithName()
+     * The function returns the actors with the supplied name. The relations
+     * are only read, so the function can be used by the workers of the pool.
+     * An exception is thrown when no actor has the supplied name.
+     */
+    const Actors &TileBindingAlgoBase::getActorsWithName(
+        const CString &name) const
+    {
+        map<CString, Actors>::const_iterator i = actorNamesToActors.find(name);
+
+        if (i == actorNamesToActors.end())
+            throw CException("[ERROR] Unknown actor '" + name + "'.");
+
+        return i->second;
+    }
+
+    /**
+     * getScenariosOfActor()
+     * The function returns the scenarios in which the actor appears.
+     */
+    const Scenarios &TileBindingAlgoBase::getScenariosOfActor(Actor *a) const
+    {
+        map<Actor *, Scenarios>::const_iterator i = actorToScenarios.find(a);
+
+        if (i == actorToScenarios.end())
+            throw CException("[ERROR] Actor '" + a->getName()
+                             + "' appears in no scenario.");
+
+        return i->second;
+    }
+
+    /**
+     * getProcessorCandidates()
+     * The function returns the processors to which the actors with the
+     * supplied name can be bound.
+     */
+    const Processors &TileBindingAlgoBase::getProcessorCandidates(
+        const CString &name) const
+    {
+        map<CString, Processors>::const_iterator i =
+            actorNamesToProcessorCandidates.find(name);
+
+        if (i == actorNamesToProcessorCandidates.end())
+            throw CException("[ERROR] No processor candidates for actor '"
+                             + name + "'.");
+
+        return i->second;
+    }
+
+    /**
+     * getChannelsWithName()
+     * The function returns the channels with the supplied name. An exception
+     * is thrown when no channel has the supplied name.
+     */
+    const Channels &TileBindingAlgoBase::getChannelsWithName(
+        const CString &name) const
+    {
+        map<CString, Channels>::const_iterator i =
+            channelNamesToChannels.find(name);
+
+        if (i == channelNamesToChannels.end())
+            throw CException("[ERROR] Unknown channel '" + name + "'.");
+
+        return i->second;
+    }
+
+    /**
+     * getScenariosOfChannel()
+     * The function returns the scenarios in which the channel appears.
+     */
+    const Scenarios &TileBindingAlgoBase::getScenariosOfChannel(
+        Channel *c) const
+    {
+        map<Channel *, Scenarios>::const_iterator i = channelToScenarios.find(c);
+
+        if (i == channelToScenarios.end())
+            throw CException("[ERROR] Channel '" + c->getName()
+                             + "' appears in no scenario.");
+
+        return i->second;
+    }
+
     /**
      * sortActorNamesOnCriticality()
      * The function returns a list of actor names in which those names have been
@@ -1066,60 +1134,144 @@ namespace FSMSADF
      * createAllBindingsOfActor()
      * The function returns all possible bindings of the actors with the supplied
      * name on the platform using the (partial) bindings given in the list
-     * bindings.
+     * bindings. The partial bindings are expanded in parallel. The new bindings
+     * are ordered on the partial binding from which they are created.
      */
     void TileBindingAlgoBase::createAllBindingsOfActor(CString &name,
             GraphBindings &bindings)
     {
+        vector<GraphBindingBase *> partialBindings(bindings.begin(), bindings.end());
+        vector<GraphBindings> expandedBindings(partialBindings.size());
         GraphBindings newBindings;
 
-        // Iterate over the existing partial bindings
-        for (GraphBindings::iterator i = bindings.begin(); i != bindings.end(); i++)
+        // Expand the existing partial bindings
+        executeInParallel(partialBindings.size(), [&](uint i)
         {
-            ActorBindings actorBindingCandidates;
-            GraphBindingBase *b = *i;
-
-            // Find all actor bindings for the actor name. Note that the unified
-            // mapping implies that all actors with the same name have the same
-            // actor binding candidates.
-            Actor *a = actorNamesToActors[name].front();
-            actorBindingCandidates = findActorBindingCandidates(b, a);
+            createBindingsOfActor(name, partialBindings[i], expandedBindings[i]);
+        });
 
-            // Binding options available for this actor?
-            if (!actorBindingCandidates.empty())
+        // Collect the new bindings
+        for (uint i = 0; i < expandedBindings.size(); i++)
+        {
+            for (GraphBindings::iterator j = expandedBindings[i].begin();
+                 j != expandedBindings[i].end(); j++)
             {
-                GraphBindingBase *bNew = b->clone();
+                GraphBindingBase *bNew = *j;
+
                 bNew->getPlatformBinding()->setName(newBindings.size());
+                newBindings.push_back(bNew);
+            }
+        }
 
-                // Try all binding candidates
-                for (ActorBindings::iterator j = actorBindingCandidates.begin();
-                     j != actorBindingCandidates.end(); j++)
-                {
-                    ActorBinding ab = *j;
+        // New bindings become bindings
+        bindings = newBindings;
+    }
 
-                    // Try resource allocation for this actor binding
-                    if (allocateActorBinding(bNew, name, ab))
-                    {
-                        // Add binding to the set of solutions
-                        newBindings.push_back(bNew);
+    /**
+     * createBindingsOfActor()
+     * The function adds all possible bindings of the actors with the supplied
+     * name on the platform using the (partial) binding b to the list bindings.
+     * The function takes ownership of binding b. A clone of b is only made when
+     * another candidate remains to be tried; the last candidate is allocated on
+     * binding b itself.
+     */
+    void TileBindingAlgoBase::createBindingsOfActor(CString &name,
+            GraphBindingBase *b, GraphBindings &bindings)
+    {
+        ActorBindings actorBindingCandidates;
+        GraphBindingBase *bNew = NULL;
+        bool ownsBinding = true;
+
+        // Find all actor bindings for the actor name. Note that the unified
+        // mapping implies that all actors with the same name have the same
+        // actor binding candidates.
+        Actor *a = getActorsWithName(name).front();
+        actorBindingCandidates = findActorBindingCandidates(b, a);
+
+        // Try all binding candidates
+        for (ActorBindings::iterator j = actorBindingCandidates.begin();
+             j != actorBindingCandidates.end(); j++)
+        {
+            ActorBinding ab = *j;
 
-                        // Create a new binding based on binding b
-                        bNew = b->clone();
-                        bNew->getPlatformBinding()->setName(newBindings.size());
-                    }
+            // Create a new binding based on binding b (a failed resource
+            // allocation leaves the previous binding to be reused)
+            if (bNew == NULL)
+            {
+                if (next(j) == actorBindingCandidates.end())
+                {
+                    bNew = b;
+                    ownsBinding = false;
                 }
+                else
+                {
+                    bNew = b->clone();
+                }
+            }
 
-                // Cleanup
-                delete bNew;
+            // Try resource allocation for this actor binding
+            if (allocateActorBinding(bNew, name, ab))
+            {
+                // Add binding to the set of solutions
+                bindings.push_back(bNew);
+                bNew = NULL;
             }
         }
 
-        // Cleanup existing bindings
-        for (GraphBindings::iterator i = bindings.begin(); i != bindings.end(); i++)
-            delete(*i);
+        // Cleanup
+        delete bNew;
+        if (ownsBinding)
+            delete b;
+    }
 
-        // New bindings become bindings
-        bindings = newBindings;
+    /**
+     * createBindingsOfChannels()
+     * The function binds all channels of the application using each of the
+     * (partial) bindings in the list bindings and computes the Pareto quantities
+     * of these bindings. Bindings in which some channel cannot be bound are
+     * removed from the list. The bindings are processed in parallel.
+     */
+    void TileBindingAlgoBase::createBindingsOfChannels(GraphBindings &bindings)
+    {
+        vector<GraphBindingBase *> applicationBindings(bindings.begin(),
+                bindings.end());
+        vector<char> validBinding(applicationBindings.size(), true);
+
+        executeInParallel(applicationBindings.size(), [&](uint i)
+        {
+            GraphBindingBase *b = applicationBindings[i];
+
+            // Iterate over the channel names in arbitrary order
+            for (map<CString, Channels>::iterator
+                 k = channelNamesToChannels.begin();
+                 k != channelNamesToChannels.end(); k++)
+            {
+                CString cn = k->first;
+
+                // Try to bind channel with name cn to platform
+                if (!createBindingOfChannel(cn, b))
+                {
+                    // All possible bindings of channel to platfrom have a
+                    // resource conflict. So, binding b cannot be realized
+                    validBinding[i] = false;
+                    return;
+                }
+            }
+
+            // Compute cost of this binding
+            b->computeParetoQuantities(repetitionVectors, false);
+        });
+
+        // Remove the bindings for which channel to platform binding is not
+        // possible
+        bindings.clear();
+        for (uint i = 0; i < applicationBindings.size(); i++)
+        {
+            if (validBinding[i])
+                bindings.push_back(applicationBindings[i]);
+            else
+                delete applicationBindings[i];
+        }
     }
 
     /**
@@ -1140,7 +1292,7 @@ namespace FSMSADF
         // Find all channel bindings for the channel name. Note that the unified
         // mapping implies that all channels with the same name have the same
         // channel binding candidates.
-        Channel *c = channelNamesToChannels[name].front();
+        Channel *c = getChannelsWithName(name).front();
         channelBindingCandidates = findChannelBindingCandidates(b, c);
 
         // No channel binding candidates exist?
@@ -1161,68 +1313,181 @@ namespace FSMSADF
         return false;
     }
 
+    /**
+     * paretoDominates()
+     * The function returns true when the vector of Pareto quantities x dominates
+     * the vector of Pareto quantities y (i.e. no quantity of x is larger than the
+     * corresponding quantity of y).
+     */
+    static bool paretoDominates(const vector<double> &x, const vector<double> &y)
+    {
+        for (uint k = 0; k < x.size(); k++)
+        {
+            if (x[k] > y[k])
+                return false;
+        }
+
+        return true;
+    }
+
     /**
      * paretoMinimizationOfApplicationBindings()
      * The function removes all non-Pareto application bindings from the list of
-     * application bindings. The function implements the Simple Cull algorithm.
+     * application bindings. When a binding has the same Pareto quantities as a
+     * binding further on in the list, only the latter is kept. The order of the
+     * remaining bindings is preserved.
+     *
+     * The function implements a sort-first skyline algorithm. The bindings are
+     * visited in ascending order of the sum of their Pareto quantities. A binding
+     * can only be dominated by a binding with an equal or smaller sum, so every
+     * binding is compared only with the Pareto optimal bindings found before it.
+     * Bindings with equal sums are compared in both directions. When some
+     * quantity is not a number, the sum does not order the bindings and the
+     * Simple Cull algorithm is used instead.
      */
     void TileBindingAlgoBase::paretoMinimizationOfApplicationBindings(
         GraphBindings &applicationBindings)
     {
-        GraphBindings newBindings;
+        vector<GraphBindingBase *> bindings(applicationBindings.begin(),
+                                            applicationBindings.end());
+        const uint nrBindings = bindings.size();
+        vector<vector<double> > values(nrBindings);
+        vector<double> sum(nrBindings, 0);
+        vector<char> paretoOptimal(nrBindings, false);
+        bool ordered = true;
+
+        // Pareto quantities of the bindings
+        for (uint i = 0; i < nrBindings; i++)
+        {
+            values[i] = bindings[i]->getParetoQuantities().getValues();
+            ASSERT(values[i].size() == values[0].size(), "Unequal dimensions.");
 
-        // Iterate over all application bindings
-        while (!applicationBindings.empty())
+            for (uint k = 0; k < values[i].size(); k++)
+                sum[i] += values[i][k];
+
+            if (std::isnan(sum[i]))
+                ordered = false;
+        }
+
+        if (ordered)
         {
-            GraphBindings::iterator i = applicationBindings.begin();
-            GraphBindingBase *c = *i;
-            bool dominated = false;
+            vector<uint> order(nrBindings);
+            vector<uint> skyline;
+
+            // Sort bindings on the sum of their quantities (and on their
+            // position in the list for equal sums)
+            for (uint i = 0; i < nrBindings; i++)
+                order[i] = i;
+            std::sort(order.begin(), order.end(), [&](uint x, uint y)
+            {
+                return sum[x] < sum[y] || (sum[x] == sum[y] && x < y);
+            });
 
-            for (GraphBindings::iterator j = newBindings.begin();
-                 j != newBindings.end();)
+            for (uint i = 0; i < nrBindings; i++)
             {
-                GraphBindingBase *d = *j;
+                const uint c = order[i];
+                bool dominated = false;
 
-                // Check for Pareto dominance
-                if (c->paretoDominates(d))
+                // Is binding c strictly dominated by a Pareto optimal binding?
+                for (uint j = 0; j < skyline.size() && !dominated; j++)
                 {
-                    // Binding d is dominated by c, so d can be removed
-                    delete d;
+                    const uint d = skyline[j];
 
-                    // Remove binding from the list
-                    newBindings.erase(j++);
-                }
-                else if (d->paretoDominates(c))
-                {
-                    // Binding c is dominated by d
-                    dominated = true;
-                    break;
+                    if (paretoDominates(values[d], values[c])
+                        && values[d] != values[c])
+                    {
+                        dominated = true;
+                    }
                 }
-                else
+
+                if (dominated)
+                    continue;
+
+                // Remove the bindings with an equal sum which are dominated by
+                // binding c (this includes equal bindings earlier in the list)
+                for (uint j = skyline.size(); j > 0
+                     && sum[skyline[j - 1]] == sum[c]; j--)
                 {
-                    // Bindings c and d do not dominate each other
-                    j++;
+                    const uint d = skyline[j - 1];
+
+                    if (paretoDominates(values[c], values[d]))
+                    {
+                        paretoOptimal[d] = false;
+                        skyline.erase(skyline.begin() + (j - 1));
+                    }
                 }
-            }
 
-            // Binding c is Pareto optimal?
-            if (!dominated)
-            {
-                // Add binding to the new list
-                newBindings.push_back(c);
+                // Binding c is Pareto optimal (so far)
+                paretoOptimal[c] = true;
+                skyline.push_back(c);
             }
-            else
+        }
+        else
+        {
+            vector<uint> paretoBindings;
+
+            // Simple Cull
+            for (uint c = 0; c < nrBindings; c++)
             {
-                // Binding c is not Pareto optimal; destroy this binding
-                delete c;
+                bool dominated = false;
+
+                for (uint j = 0; j < paretoBindings.size();)
+                {
+                    const uint d = paretoBindings[j];
+
+                    // Check for Pareto dominance
+                    if (paretoDominates(values[c], values[d]))
+                    {
+                        // Binding d is dominated by c, so d can be removed
+                        paretoOptimal[d] = false;
+                        paretoBindings.erase(paretoBindings.begin() + j);
+                    }
+                    else if (paretoDominates(values[d], values[c]))
+                    {
+                        // Binding c is dominated by d
+                        dominated = true;
+                        break;
+                    }
+                    else
+                    {
+                        // Bindings c and d do not dominate each other
+                        j++;
+                    }
+                }
+
+                // Binding c is Pareto optimal?
+                if (!dominated)
+                {
+                    paretoOptimal[c] = true;
+                    paretoBindings.push_back(c);
+                }
             }
+        }
 
-            // Remove binding c from the list
-            applicationBindings.erase(i++);
+        // Keep the Pareto optimal bindings; destroy all other bindings
+        applicationBindings.clear();
+        for (uint i = 0; i < nrBindings; i++)
+        {
+            if (paretoOptimal[i])
+                applicationBindings.push_back(bindings[i]);
+            else
+                delete bindings[i];
         }
+    }
 
-        // The new bindings become the application bindings
-        applicationBindings = newBindings;
+    /**
+     * executeInParallel()
+     * The function executes job(i) for i = 0 .. n-1. The jobs are distributed
+     * over a pool of threads. When a job throws an exception, no new jobs are
+     * started and the exception is rethrown once all threads have finished.
+     */
+    void TileBindingAlgoBase::executeInParallel(const uint n,
+            const std::function<void(uint)> &job) const
+    {
+        CParallelFor(n, nrThreads, [&](uint i, uint)
+        {
+            job(i);
+        });
     }
 
     /**
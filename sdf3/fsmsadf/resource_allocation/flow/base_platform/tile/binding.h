@@ -14,6 +14,7 @@
  *      29-05-09    :   Initial version.
  *      19-04-11    :   Add accessors (M. Koedam)
  *                      Virtual functions, rename to SDF3FlowBase
+ *      17-10-26    :   Parallel binding expansion, skyline Pareto filter.
  * $Id: binding.h,v 1.1 2009-12-23 13:37:22 sander Exp $
  *
  * This program is free software; you can redistribute it and/or modify it
@@ -38,6 +39,7 @@
 #define FSMSADF_RESOURCE_ALLOCATION_FLOW_TILE_BINDING_H_INCLUDED
 
 #include "graph_binding.h"
+#include <functional>
 
 namespace FSMSADF
 {
@@ -108,6 +110,17 @@ namespace FSMSADF
             PlatformBinding *getPlatformBinding(const CString &name) const;
             PlatformBinding *getInitialPlatformBinding() const;
 
+            // Number of threads used to expand the (partial) bindings (0 means
+            // the number of hardware threads)
+            uint getNrThreads() const
+            {
+                return nrThreads;
+            };
+            void setNrThreads(const uint n)
+            {
+                nrThreads = n;
+            };
+
         protected:
             virtual bool isThroughputConstraintSatisfied(PlatformBinding *pb);
             // Throughput
@@ -154,9 +167,32 @@ namespace FSMSADF
             ChannelBinding getChannelBinding(GraphBindingBase *applicationBinding,
                                              const CString &name) const;
 
+            // Actors with the supplied name
+            const Actors &getActorsWithName(const CString &name) const;
+
+            // Scenarios in which the actor appears
+            const Scenarios &getScenariosOfActor(Actor *a) const;
+
+            // Processor candidates of the actors with the supplied name
+            const Processors &getProcessorCandidates(const CString &name) const;
+
+            // Channels with the supplied name
+            const Channels &getChannelsWithName(const CString &name) const;
+
+            // Scenarios in which the channel appears
+            const Scenarios &getScenariosOfChannel(Channel *c) const;
+
             // Create all valid bindings of the actor name to the platform
             void createAllBindingsOfActor(CString &name, GraphBindings &bindings);
 
+            // Create all valid bindings of the actor name using the (partial)
+            // binding b
+            void createBindingsOfActor(CString &name, GraphBindingBase *b,
+                                       GraphBindings &bindings);
+
+            // Bind all channels and compute the Pareto quantities of each binding
+            void createBindingsOfChannels(GraphBindings &bindings);
+
             // Create a binding of the channel name to the platform
             bool createBindingOfChannel(CString &name, GraphBindingBase *b);
 
@@ -164,6 +200,10 @@ namespace FSMSADF
             void paretoMinimizationOfApplicationBindings(
                 GraphBindings &applicationBindings);
 
+            // Execute job(i) for i = 0 .. n-1 on a pool of threads
+            void executeInParallel(const uint n,
+                                   const std::function<void(uint)> &job) const;
+
             // Reduce the number of application bindings
             void reduceApplicationBindings(GraphBindings &applicationBindings,
                                            const uint maxNrAppBindings);
@@ -206,6 +246,9 @@ namespace FSMSADF
 
             // Channels to scenarios
             map<Channel *, Scenarios > channelToScenarios;
+
+            // Number of threads
+            uint nrThreads;
     };
 
 } // End namespace FSMSADF
@@ -14,6 +14,7 @@
  *      25-05-09    :   Initial version.
  *      19-04-11    :   Add accessors (M. Koedam)
  *                      Virtual functions, rename to SDF3FlowBase
+ *      17-10-26    :   Clone without re-extracting the application binding.
  *
  * $Id: graph_binding.cc,v 1.1 2009-12-23 13:37:22 sander Exp $
  *
@@ -130,6 +131,42 @@ namespace FSMSADF
         return d;
     }
 
+    /**
+     * getValues()
+     * The function returns all quantities in a single vector. The processing
+     * loads come first, followed by the memory and communication loads. Within
+     * each group the quantities are ordered on their platform element, so the
+     * vectors of quantities computed on the same platform can be compared
+     * element-wise.
+     */
+    vector<double> GraphBindingBase::ParetoQuantities::getValues() const
+    {
+        vector<double> values;
+
+        values.reserve(processingLoad.size() + memoryLoad.size()
+                       + communicationLoad.size());
+
+        for (map<Processor *, double>::const_iterator i = processingLoad.begin();
+             i != processingLoad.end(); i++)
+        {
+            values.push_back(i->second);
+        }
+
+        for (map<Memory *, double>::const_iterator i = memoryLoad.begin();
+             i != memoryLoad.end(); i++)
+        {
+            values.push_back(i->second);
+        }
+
+        for (map<NetworkInterface *, double>::const_iterator
+             i = communicationLoad.begin(); i != communicationLoad.end(); i++)
+        {
+            values.push_back(i->second);
+        }
+
+        return values;
+    }
+
     /**
      * print()
      * Print quantities to the output stream.
@@ -178,6 +215,19 @@ namespace FSMSADF
         extractApplicationBindingFromPlatformBinding();
     }
 
+    /**
+     * GraphBinding()
+     * Copy constructor. The platform binding of b is cloned. The application
+     * binding is copied from b instead of being extracted again from the cloned
+     * platform binding.
+     */
+    GraphBindingBase::GraphBindingBase(const GraphBindingBase &b)
+        :
+        platformBinding(b.platformBinding->clone(*b.platformBinding))
+    {
+        b.copyInternalsTo(this);
+    }
+
     /**
      * ~GraphBinding()
      * Destructor.
@@ -215,10 +265,7 @@ namespace FSMSADF
      */
     GraphBindingBase *GraphBindingBase::clone() const
     {
-        GraphBindingBase *gb = new GraphBindingBase(platformBinding);
-
-        this->copyInternalsTo(gb);
-        return gb;
+        return new GraphBindingBase(*this);
     }
 
     /**
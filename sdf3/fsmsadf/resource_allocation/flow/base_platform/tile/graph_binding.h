@@ -14,6 +14,7 @@
  *      25-05-09    :   Initial version.
  *      19-04-11    :   Add accessors (M. Koedam)
  *                      Virtual functions, rename to SDF3FlowBase
+ *      17-10-26    :   Clone without re-extracting the application binding.
  *
  * $Id: graph_binding.h,v 1.1 2009-12-23 13:37:22 sander Exp $
  *
@@ -133,6 +134,10 @@ namespace FSMSADF
                     // Euclidean distance
                     double distance(const ParetoQuantities &q) const;
 
+                    // All quantities (processing, memory and communication
+                    // load) in a single vector
+                    vector<double> getValues() const;
+
                     // Print quantities
                     ostream &print(ostream &out) const;
 
@@ -234,6 +239,9 @@ namespace FSMSADF
             ConnectionBinding *getConnectionBinding(Connection *c) const;
 
         protected:
+            // Copy constructor (clones the platform binding of b)
+            GraphBindingBase(const GraphBindingBase &b);
+
             void copyInternalsTo(GraphBindingBase *gb) const;
         private:
 
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      15-04-11    :   Initial version.
+ *      17-10-26    :   EDF scheduling uses the tile binding threads.
  *
  *
  * This program is free software; you can redistribute it and/or modify it
@@ -103,6 +104,10 @@ namespace FSMSADF
         Processors processors;
         CId mappingId = 0;
 
+        // Scenarios are scheduled with the same number of threads as used
+        // for the tile binding
+        edfScheduling.setNrThreads(getNrThreads());
+
         // Create a list with all processors in the platform
         for (Tiles::iterator i = platformGraph->getTiles().begin();
              i != platformGraph->getTiles().end(); i++)
@@ -135,9 +140,16 @@ namespace FSMSADF
         // Create an empty set of new application bindings
         GraphBindings newAppBindings;
 
+        // Sets of application bindings which are left (ab) and of new
+        // application bindings (bbNew) for each application binding in
+        // applicationBindings
+        vector<GraphBindings> ab(applicationBindings.size());
+        vector<GraphBindings> bbNew(applicationBindings.size());
+        uint n = 0;
+
         // For each application binding b in applicationBindings
         for (GraphBindings::iterator i = applicationBindings.begin();
-             i != applicationBindings.end(); i++)
+             i != applicationBindings.end(); i++, n++)
         {
             set<Processor *> usedProcessors;
             GraphBindingBase *b = *i;
@@ -146,9 +158,6 @@ namespace FSMSADF
             logInfo("Creating schedule for binding '" +
                     b->getPlatformBinding()->getName() + "'");
 
-            // Create an empty set of new platform bindings bbNew
-            GraphBindings bbNew;
-
             // Iterate over all scenarios
             for (map<Scenario *, map<Actor *, ActorBinding> >::iterator
                  j = b->getActorBindings().begin();
@@ -240,15 +249,29 @@ namespace FSMSADF
             }
 
             // Add b to the set of application bindings ab
-            GraphBindings ab;
-            ab.push_back(b);
+            ab[n].push_back(b);
+        }
+
+        // While application bindings left in ab. The first application
+        // bindings of all sets ab are scheduled together, so the scenarios of
+        // all these bindings are scheduled in parallel.
+        for (bool left = true; left;)
+        {
+            vector<GraphBindingBase *> scheduled(ab.size(), NULL);
+            vector<PlatformBinding *> pbs;
+            vector<BindingAwareGraphBase *> bgs;
 
-            // While application bindings left in ab
-            while (!ab.empty())
+            left = false;
+            for (n = 0; n < ab.size(); n++)
             {
+                if (ab[n].empty())
+                    continue;
+                left = true;
+
                 // Take first application binding bs from set ab
-                GraphBindingBase *bs = ab.front();
-                ab.pop_front();
+                GraphBindingBase *bs = ab[n].front();
+                ab[n].pop_front();
+                scheduled[n] = bs;
 
                 // Assign TDMA time slices for each scenario associated with the
                 // application graph
@@ -284,11 +307,23 @@ namespace FSMSADF
                     }
                 }
 
-                // Create EDF schedule for the platform binding
-                BindingAwareGraphCompSoCPlatform *bg;
-                bg = new BindingAwareGraphCompSoCPlatform(bs->getPlatformBinding());
-                edfScheduling.schedule(bs->getPlatformBinding(), bg);
-                delete bg;
+                // Binding-aware graph of the platform binding
+                pbs.push_back(bs->getPlatformBinding());
+                bgs.push_back(new BindingAwareGraphCompSoCPlatform(
+                                  bs->getPlatformBinding()));
+            }
+
+            // Create EDF schedules for the platform bindings
+            edfScheduling.schedule(pbs, bgs);
+            for (uint k = 0; k < bgs.size(); k++)
+                delete bgs[k];
+
+            for (n = 0; n < ab.size(); n++)
+            {
+                GraphBindingBase *bs = scheduled[n];
+
+                if (bs == NULL)
+                    continue;
 
                 // Throughput of bs meets throughput constraint?
                 if (isThroughputConstraintSatisfied(bs->getPlatformBinding()))
@@ -299,8 +334,7 @@ namespace FSMSADF
                     bs->computeParetoQuantities(repetitionVectors, true);
 
                     // Add bs to bbNew
-                    bs->getPlatformBinding()->setName(mappingId++);
-                    bbNew.push_back(bs);
+                    bbNew[n].push_back(bs);
 
                     // Clone bs
                     GraphBindingBase *bsNew = bs->clone();
@@ -333,7 +367,7 @@ namespace FSMSADF
 
                     // Is this new binding possible within available timewheels?
                     if (validNewBinding)
-                        ab.push_back(bsNew);
+                        ab[n].push_back(bsNew);
                 }
 
                 else
@@ -370,16 +404,30 @@ namespace FSMSADF
 
                     // Is this new binding possible within available timewheels?
                     if (validNewBinding)
-                        ab.push_back(bsNew);
+                        ab[n].push_back(bsNew);
                 }
             }
+        }
+
+        // For each application binding b in applicationBindings
+        for (n = 0; n < bbNew.size(); n++)
+        {
+            // Name the new bindings in the order in which they were found
+            for (GraphBindings::iterator j = bbNew[n].begin();
+                 j != bbNew[n].end(); j++)
+            {
+                (*j)->getPlatformBinding()->setName(mappingId++);
+            }
 
             // Perform pareto minimization on bbNew
-            paretoMinimizationOfApplicationBindings(bbNew);
+            paretoMinimizationOfApplicationBindings(bbNew[n]);
 
             // Add bbNew to newAppBindings
-            for (GraphBindings::iterator j = bbNew.begin(); j != bbNew.end(); j++)
+            for (GraphBindings::iterator j = bbNew[n].begin();
+                 j != bbNew[n].end(); j++)
+            {
                 newAppBindings.push_back(*j);
+            }
         }
 
         // Select new platform bindings from newAppBindings using heuristic
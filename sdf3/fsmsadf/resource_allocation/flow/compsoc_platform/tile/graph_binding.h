@@ -12,6 +12,7 @@
  *
  *  History         :
  *      19-04-11    :   Initial version.
+ *      17-10-26    :   Clone without re-extracting the application binding.
  *
  *
  * This program is free software; you can redistribute it and/or modify it
@@ -57,6 +58,13 @@ namespace FSMSADF
 
             }
 
+            // Copy constructor
+            GraphBindingCompSoCPlatform(const GraphBindingCompSoCPlatform &b)
+                : GraphBindingBase(b)
+            {
+
+            }
+
             // Destructor
             ~GraphBindingCompSoCPlatform()
             {
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      16-11-11    :   Initial version.
+ *      17-10-26    :   Clone without re-extracting the application binding.
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by the
@@ -45,13 +46,7 @@ namespace FSMSADF
     GraphBindingBase *
     GraphBindingMampsPlatform::clone() const
     {
-        GraphBindingMampsPlatform *gb = new GraphBindingMampsPlatform(
-            getPlatformBinding());
-
-        // Copy internal values to the new instance.
-        this->copyInternalsTo(gb);
-
-        return gb;
+        return new GraphBindingMampsPlatform(*this);
     }
 
 } // End namespace FSMSADF
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      16-11-11    :   Initial version.
+ *      17-10-26    :   Clone without re-extracting the application binding.
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by the
@@ -57,6 +58,13 @@ namespace FSMSADF
 
             }
 
+            // Copy constructor
+            GraphBindingMampsPlatform(const GraphBindingMampsPlatform &b)
+                : GraphBindingBase(b)
+            {
+
+            }
+
             // Destructor
             ~GraphBindingMampsPlatform()
             {
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      19-04-11    :   Initial version.
+ *      17-10-26    :   Clone without re-extracting the application binding.
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by the
@@ -44,13 +45,7 @@ namespace FSMSADF
     GraphBindingBase *
     GraphBindingVirtualPlatform::clone() const
     {
-        GraphBindingVirtualPlatform *gb = new GraphBindingVirtualPlatform(
-            getPlatformBinding());
-
-        // Copy internal values to the new instance.
-        this->copyInternalsTo(gb);
-
-        return gb;
+        return new GraphBindingVirtualPlatform(*this);
     }
 
 } // End namespace FSMSADF
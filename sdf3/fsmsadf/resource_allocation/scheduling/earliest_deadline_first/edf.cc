@@ -12,6 +12,7 @@
  *
  *  History         :
  *      02-06-09    :   Initial version.
+ *      17-10-26    :   Scenarios scheduled in parallel.
  *
  * $Id: edf.cc,v 1.1 2009-12-23 13:37:23 sander Exp $
  *
@@ -48,30 +49,76 @@ namespace FSMSADF
     void EarliestDeadLineFirstScheduling::schedule(PlatformBinding *pb,
             BindingAwareGraphBase *g)
     {
-        // Construct schedule for each scenario in the application graph
-        for (Scenarios::iterator i = g->getScenarios().begin();
-             i != g->getScenarios().end(); i++)
+        schedule(vector<PlatformBinding *>(1, pb),
+                 vector<BindingAwareGraphBase *>(1, g));
+    }
+
+    /**
+     * Create earliest-deadline-first schedule for each scenario graph in each
+     * of the platform bindings. The schedules of platform binding pbs[b] are
+     * created on binding-aware graph gs[b] and added to the processors inside
+     * pbs[b]. The (binding, scenario) pairs are scheduled independently by a
+     * pool of threads; the resulting schedules are assigned to the processors
+     * once all pairs have been scheduled.
+     * @param platform bindings pbs
+     * @param binding aware graphs gs
+     */
+    void EarliestDeadLineFirstScheduling::schedule(
+        const vector<PlatformBinding *> &pbs,
+        const vector<BindingAwareGraphBase *> &gs)
+    {
+        vector< pair<uint, Scenario *> > jobs;
+
+        // Every scenario of every platform binding is a job
+        for (uint b = 0; b < pbs.size(); b++)
         {
-            Scenario *s = *i;
+            for (Scenarios::iterator s = gs[b]->getScenarios().begin();
+                 s != gs[b]->getScenarios().end(); s++)
+            {
+                jobs.push_back(pair<uint, Scenario *>(b, *s));
+            }
+        }
+
+        vector<ScenarioSchedule> schedules(jobs.size());
+
+        CParallelFor(jobs.size(), nrThreads, [&](uint i, uint)
+        {
+            const uint b = jobs[i].first;
+
+            scheduleScenario(pbs[b], gs[b], jobs[i].second, schedules[i]);
+        });
 
-            // Construct schedule for the binding-aware graph in scenario s
-            scheduleScenario(pb, g, s);
+        // Assign the schedules to the processors
+        for (uint i = 0; i < jobs.size(); i++)
+        {
+            PlatformBinding *pb = pbs[jobs[i].first];
+            Scenario *sApp = pb->getApplicationGraph()->getScenario(
+                                 jobs[i].second->getName());
+
+            for (ScenarioSchedule::iterator j = schedules[i].begin();
+                 j != schedules[i].end(); j++)
+            {
+                j->first->setStaticOrderSchedule(sApp, j->second);
+            }
         }
     }
 
     /**
      * scheduleScenario()
      * Create an earliest-deadline-first schedule for the scenario graph
-     * corresponding to scenario s.
+     * corresponding to scenario s. The static-order schedule of every
+     * processor is stored in schedule; the platform binding is not modified.
      */
     void EarliestDeadLineFirstScheduling::scheduleScenario(PlatformBinding *pb,
-            BindingAwareGraphBase *g, Scenario *s)
+            BindingAwareGraphBase *g, Scenario *s, ScenarioSchedule &schedule)
     {
+        map<Actor *, ProcessorBinding *> processorOfActor;
+
         // Find scenario sApp corresponding scenario s in the application graph
         Scenario *sApp = pb->getApplicationGraph()->getScenario(s->getName());
 
         // Create precedence graph based on binding aware graph g
-        PrecedenceGraph *pg = new PrecedenceGraph(s);
+        PrecedenceGraph pg(s);
 
         // Create empty static-order schedule on each processor
         for (TileBindings::iterator i = pb->getTileBindings().begin();
@@ -84,18 +131,14 @@ namespace FSMSADF
                  j = tb->getProcessorBindings().begin();
                  j != tb->getProcessorBindings().end(); j++)
             {
-                ProcessorBinding *pb = *j;
-                StaticOrderSchedule so;
-
-                // Assign empty schedule in scenario s to the processor binding
-                pb->setStaticOrderSchedule(sApp, so);
+                schedule[*j] = StaticOrderSchedule();
             }
         }
 
         // Iterate over all nodes in the precedence graph from highest to lowest
         // deadline
-        for (PrecedenceGraph::Node *n = pg->getEarliestDeadline();
-             n != NULL; n = pg->getEarliestDeadline())
+        for (PrecedenceGraph::Node *n = pg.getEarliestDeadline();
+             n != NULL; n = pg.getEarliestDeadline())
         {
             Actor *a = n->actor;
             Actor *aApp = g->getCorrespondingActorInApplicationGraph(a);
@@ -103,13 +146,25 @@ namespace FSMSADF
             // Actor mapped to a processor
             if (aApp != NULL)
             {
+                map<Actor *, ProcessorBinding *>::iterator iter;
                 ProcessorBinding *p;
 
-                p = pb->getProcessorBindingOfActorInScenario(sApp, aApp);
+                // Processor binding is looked up once per actor
+                iter = processorOfActor.find(aApp);
+                if (iter == processorOfActor.end())
+                {
+                    p = pb->getProcessorBindingOfActorInScenario(sApp, aApp);
+                    processorOfActor[aApp] = p;
+                }
+                else
+                {
+                    p = iter->second;
+                }
+
                 if (p != NULL)
                 {
                     // Get static order schedule of processor p in scenario s
-                    StaticOrderSchedule &so = p->getStaticOrderSchedule(sApp);
+                    StaticOrderSchedule &so = schedule[p];
 
                     // Add actor to end of static order schedule so
                     so.insertActor(so.end(), aApp);
@@ -121,11 +176,8 @@ namespace FSMSADF
             }
 
             // Remove node from precedence graph
-            pg->removeNode(n);
+            pg.removeNode(n);
         }
-
-        // Cleanup
-        delete pg;
     }
 
 } // End namespace FSMSADF
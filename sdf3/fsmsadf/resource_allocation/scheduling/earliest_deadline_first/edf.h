@@ -12,6 +12,7 @@
  *
  *  History         :
  *      02-06-09    :   Initial version.
+ *      17-10-26    :   Scenarios scheduled in parallel.
  *
  * $Id: edf.h,v 1.1 2009-12-23 13:37:23 sander Exp $
  *
@@ -49,7 +50,7 @@ namespace FSMSADF
     {
         public:
             // Constructor
-            EarliestDeadLineFirstScheduling() { };
+            EarliestDeadLineFirstScheduling() : nrThreads(0) { };
 
             // Destructor
             ~EarliestDeadLineFirstScheduling() { };
@@ -57,10 +58,25 @@ namespace FSMSADF
             // Create EDF for all scenario graphs
             void schedule(PlatformBinding *pb, BindingAwareGraphBase *g);
 
+            // Create EDF for all scenario graphs of a set of platform bindings
+            void schedule(const vector<PlatformBinding *> &pbs,
+                          const vector<BindingAwareGraphBase *> &gs);
+
+            // Number of threads used to schedule the scenarios (0 = one per
+            // hardware thread)
+            uint getNrThreads() const { return nrThreads; };
+            void setNrThreads(const uint n) { nrThreads = n; };
+
         private:
+            // Static-order schedule of each processor in one scenario
+            typedef map<ProcessorBinding *, StaticOrderSchedule> ScenarioSchedule;
+
             // Schedule binding-aware graph in scenario s
             void scheduleScenario(PlatformBinding *b, BindingAwareGraphBase *g,
-                                  Scenario *s);
+                                  Scenario *s, ScenarioSchedule &schedule);
+
+        private:
+            uint nrThreads;
     };
 
 } // End namspace FSMSADF
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      02-06-09    :   Initial version.
+ *      17-10-26    :   Ready queue kept as an indexed binary heap.
  *
  * $Id: precedence_graph.cc,v 1.1 2009-12-23 13:37:23 sander Exp $
  *
@@ -43,47 +44,27 @@ namespace FSMSADF
      * Node()
      * Constructor
      */
-    PrecedenceGraph::Node::Node(Actor *a, CId n, Time t)
+    PrecedenceGraph::Node::Node(Actor *a, CId n, Time t, CId i)
         :
         actor(a),
         idx(n),
         actorExecutionTime(t),
         deadline(-1),
-        seen(0)
+        id(i),
+        nrPrevious(0),
+        nrNext(0),
+        readyIdx(UINT_MAX),
+        removed(false)
     {
     }
 
-    /**
-     * updateDeadline()
-     * Update the deadline time of this node to t in case its current deadline
-     * is less then t.
-     */
-    void PrecedenceGraph::Node::updateDeadline(const Time t)
-    {
-        // Time t is smaller then current remaining time
-        if (t + actorExecutionTime <= deadline)
-        {
-            return;
-        }
-
-        // Update the deadline
-        deadline = t + actorExecutionTime;
-
-        // Update the deadline of all nodes which are a predecessor of this node
-        for (Nodes::iterator i = previous.begin(); i != previous.end(); i++)
-        {
-            Node *n = *i;
-            n->updateDeadline(deadline);
-        }
-    }
-
     /**
      * isSchedulable()
      * A node can be scheduled when it has no previous constraints left.
      */
     bool PrecedenceGraph::Node::isSchedulable() const
     {
-        if (previous.empty())
+        if (!removed && nrPrevious == 0)
             return true;
         return false;
     }
@@ -102,22 +83,22 @@ namespace FSMSADF
 
         // Compute repetition vector of the scenario graph
         v = computeRepetitionVector(sg, s);
+        firstNodeOfActor.resize(v.size(), 0);
 
         // Create nodes for each actor in the scenario graph
         for (Actors::iterator i = sg->getActors().begin();
              i != sg->getActors().end(); i++)
         {
             Actor *a = *i;
+            Time t = a->getExecutionTimeOfScenario(s,
+                                                   a->getDefaultProcessorType());
+
+            // Nodes of actor a are stored consecutively
+            firstNodeOfActor[a->getId()] = nodes.size();
 
             // Create as many nodes as repetition vector entries
             for (int j = 0; j < v[a->getId()]; j++)
-            {
-                Node *n = new Node(a, j, a->getExecutionTimeOfScenario(s,
-                                   a->getDefaultProcessorType()));
-
-                // Add node n to the set of nodes
-                nodes.insert(n);
-            }
+                nodes.push_back(new Node(a, j, t, nodes.size()));
         }
 
         // Create precedence constraints between the nodes
@@ -150,180 +131,149 @@ namespace FSMSADF
                     // Destination node
                     Node *dstN = getNode(c->getDstActor(), j - 1);
 
-
-                    // No initial tokens on this edge?
-                    if (t == 0)
+                    // No initial tokens on this edge? (Consecutive tokens of
+                    // a channel often map onto the same pair of nodes.)
+                    if (t == 0 && (srcN->next.empty() || srcN->next.back() != dstN))
                     {
-                        dstN->previous.insert(srcN);
-                        srcN->next.insert(dstN);
+                        dstN->previous.push_back(srcN);
+                        srcN->next.push_back(dstN);
                     }
                 }
             }
         }
 
-        // Validate that the graph is acyclic.
-        // this avoid updateDeadline going into a deadlock.
-        if (cycle_detect())
-        {
-            throw CException("Graph is not acyclic");
-
-        }
+        // Compute deadlines of the nodes (throws when the graph is cyclic)
+        computeDeadlines();
 
-        // Compute deadlines of the nodes (starting from nodes on which no
-        // precedence constraints exist)
+        // Nodes without predecessors can be scheduled
         for (Nodes::iterator i = nodes.begin(); i != nodes.end(); i++)
         {
             Node *n = *i;
 
-            if (n->next.empty())
-            {
-                n->updateDeadline(0);
-            }
+            n->nrPrevious = n->previous.size();
+            n->nrNext = n->next.size();
+
+            if (n->nrPrevious == 0)
+                insertReadyNode(n);
         }
     }
 
     /**
-     * updateThe node (recursive) using DFS.
-     *
-     * @ returns true is graph is cyclic
+     * ~PrecedenceGraph()
+     * Destructor.
      */
-
-    static bool visit(PrecedenceGraph::Node *n)
+    PrecedenceGraph::~PrecedenceGraph()
     {
-        n->seen = 1;
-        for (PrecedenceGraph::Nodes::iterator i = n->previous.begin();
-             i != n->previous.end(); i++)
-        {
-            PrecedenceGraph::Node *c = *i;
-            if (c->seen == 1)
-            {
-                /* found a cycle */
-                return true;
-            }
-            else if (c->seen == 0)
-            {
-                if (visit(c))
-                {
-                    return true;
-                }
-            }
-        }
-        n->seen = 2;
-        return false;
+        for (Nodes::iterator i = nodes.begin(); i != nodes.end(); i++)
+            delete(*i);
     }
+
     /**
-     * This function does a modified depth first search (colored DFS).
-     * All nodes are initially marked white (0).
-     * When a node is encountered, it is marked grey (1),
-     * and when its descendants are completely visited, it is marked black (2).
-     * If a grey node is ever encountered, then there is a cycle.
-     *
-     * @return true is a cycle is detected.
+     * computeDeadlines()
+     * The deadline of a node is its execution time plus the largest deadline
+     * of its successors. The nodes are visited in reverse topological order
+     * (Kahn's algorithm on the successor relation), which visits every node
+     * exactly once. A node that is never visited lies on a cycle, in which
+     * case an exception is thrown.
      */
-    bool PrecedenceGraph::cycle_detect()
+    void PrecedenceGraph::computeDeadlines()
     {
-        // set all nodes white
+        vector<uint> nrNextLeft(nodes.size());
+        Nodes order;
+
+        // Start from nodes on which no precedence constraints exist
+        order.reserve(nodes.size());
         for (Nodes::iterator i = nodes.begin(); i != nodes.end(); i++)
         {
-            (*i)->seen = 0;
+            Node *n = *i;
+
+            nrNextLeft[n->id] = n->next.size();
+            if (n->next.empty())
+                order.push_back(n);
         }
-        //
-        for (Nodes::iterator i = nodes.begin(); i != nodes.end(); i++)
+
+        for (uint i = 0; i < order.size(); i++)
         {
-            Node *n = *i;
-            if (n->seen == 0)
+            Node *n = order[i];
+            Time t = 0;
+
+            for (Nodes::iterator j = n->next.begin(); j != n->next.end(); j++)
             {
-                if (visit(n))
-                {
-                    return true;
-                }
+                if ((*j)->deadline > t)
+                    t = (*j)->deadline;
+            }
+            n->deadline = t + n->actorExecutionTime;
+
+            // Predecessors whose successors are all visited come next
+            for (Nodes::iterator j = n->previous.begin();
+                 j != n->previous.end(); j++)
+            {
+                if (--nrNextLeft[(*j)->id] == 0)
+                    order.push_back(*j);
             }
         }
-        return false;
-    }
 
-    /**
-     * ~PrecedenceGraph()
-     * Destructor.
-     */
-    PrecedenceGraph::~PrecedenceGraph()
-    {
-        for (Nodes::iterator i = nodes.begin(); i != nodes.end(); i++)
-            delete(*i);
+        if (order.size() != nodes.size())
+            throw CException("Graph is not acyclic");
     }
 
     /**
      * getEarliestDeadline()
      * The function returns from the node with the earliest deadline (i.e. largest
-     * value). When the set of nodes is empty, the function returns NULL.
+     * value). When no node is schedulable, the function returns NULL.
      */
     PrecedenceGraph::Node *PrecedenceGraph::getEarliestDeadline() const
     {
-        Node *n = NULL;
-
-        // Iterate over all nodes
-        for (Nodes::iterator i = nodes.begin(); i != nodes.end(); i++)
-        {
-            Node *m = *i;
-
-            // Is this node schedulable?
-            if (m->isSchedulable())
-            {
-                // The deadline of node m is larger then the deadline of node n?
-                if (n == NULL || m->deadline > n->deadline)
-                    n = m;
-            }
-        }
+        if (readyNodes.empty())
+            return NULL;
 
-        return n;
+        return readyNodes.front();
     }
 
     /**
      * removeNode()
      * The function removes the node n from the precedence graph. A node can only
-     * be removed if all its predecessors or succesors have been removed.
+     * be removed if all its predecessors or succesors have been removed. The
+     * node itself is released when the precedence graph is destroyed.
      */
     void PrecedenceGraph::removeNode(Node *n)
     {
+        if (n->removed)
+            throw CException("Node has already been removed.");
+
         // Node has no predecessors
-        if (n->previous.empty())
+        if (n->nrPrevious == 0)
         {
-            // Remove the node from all successor nodes (if any)
+            eraseReadyNode(n);
+
+            // Successors without remaining predecessors become schedulable
             for (Nodes::iterator i = n->next.begin(); i != n->next.end(); i++)
             {
                 Node *m = *i;
 
-                m->previous.erase(n);
+                if (!m->removed && --m->nrPrevious == 0)
+                    insertReadyNode(m);
             }
-
-            // Remove node n from the set of nodes
-            nodes.erase(n);
-
-            // Cleanup
-            delete n;
         }
-        else if (n->next.empty())
+        else if (n->nrNext == 0)
         {
-            // Remove the node from all predecessor nodes (if any)
+            // Remove the node from all predecessor nodes
             for (Nodes::iterator i = n->previous.begin();
                  i != n->previous.end(); i++)
             {
                 Node *m = *i;
 
-                m->next.erase(n);
+                if (!m->removed)
+                    m->nrNext--;
             }
-
-            // Remove node n from the set of nodes
-            nodes.erase(n);
-
-            // Cleanup
-            delete n;
         }
         else
         {
             throw CException("Cannot remove node which has predecessors "
                              "and successors.");
         }
+
+        n->removed = true;
     }
 
     /**
@@ -334,16 +284,118 @@ namespace FSMSADF
     PrecedenceGraph::Node *PrecedenceGraph::getNode(const Actor *a,
             const CId idx) const
     {
-        for (Nodes::iterator i = nodes.begin(); i != nodes.end(); i++)
+        if (a->getId() < firstNodeOfActor.size())
         {
-            Node *n = *i;
+            CId i = firstNodeOfActor[a->getId()] + idx;
 
-            if (n->actor == a && n->idx == idx)
-                return n;
+            if (i < nodes.size() && nodes[i]->actor == a && nodes[i]->idx == idx)
+                return nodes[i];
         }
 
         throw CException("Precedence graph contains no node with idx " + idx);
     }
 
-} // End namespace FSMSADF
+    /**
+     * hasPriority()
+     * Node n precedes node m in the ready queue when it has a larger deadline
+     * or, with equal deadlines, when it was created earlier.
+     */
+    bool PrecedenceGraph::hasPriority(const Node *n, const Node *m) const
+    {
+        if (n->deadline != m->deadline)
+            return n->deadline > m->deadline;
+        return n->id < m->id;
+    }
+
+    /**
+     * insertReadyNode()
+     * The function adds node n to the ready queue.
+     */
+    void PrecedenceGraph::insertReadyNode(Node *n)
+    {
+        n->readyIdx = readyNodes.size();
+        readyNodes.push_back(n);
+        moveReadyNodeUp(n->readyIdx);
+    }
+
+    /**
+     * eraseReadyNode()
+     * The function removes node n from the ready queue.
+     */
+    void PrecedenceGraph::eraseReadyNode(Node *n)
+    {
+        uint i = n->readyIdx;
+        Node *m = readyNodes.back();
 
+        readyNodes.pop_back();
+        n->readyIdx = UINT_MAX;
+
+        // Node n was the last node in the queue?
+        if (m == n)
+            return;
+
+        // Move the last node into the vacated position
+        readyNodes[i] = m;
+        m->readyIdx = i;
+        moveReadyNodeUp(i);
+        moveReadyNodeDown(m->readyIdx);
+    }
+
+    /**
+     * moveReadyNodeUp()
+     * The function moves the node at position i towards the front of the
+     * ready queue until the heap order is restored.
+     */
+    void PrecedenceGraph::moveReadyNodeUp(uint i)
+    {
+        Node *n = readyNodes[i];
+
+        while (i > 0)
+        {
+            uint parent = (i - 1) / 2;
+
+            if (!hasPriority(n, readyNodes[parent]))
+                break;
+
+            readyNodes[i] = readyNodes[parent];
+            readyNodes[i]->readyIdx = i;
+            i = parent;
+        }
+
+        readyNodes[i] = n;
+        n->readyIdx = i;
+    }
+
+    /**
+     * moveReadyNodeDown()
+     * The function moves the node at position i towards the back of the
+     * ready queue until the heap order is restored.
+     */
+    void PrecedenceGraph::moveReadyNodeDown(uint i)
+    {
+        Node *n = readyNodes[i];
+        uint size = readyNodes.size();
+
+        while (2 * i + 1 < size)
+        {
+            uint child = 2 * i + 1;
+
+            if (child + 1 < size
+                && hasPriority(readyNodes[child + 1], readyNodes[child]))
+            {
+                child++;
+            }
+
+            if (!hasPriority(readyNodes[child], n))
+                break;
+
+            readyNodes[i] = readyNodes[child];
+            readyNodes[i]->readyIdx = i;
+            i = child;
+        }
+
+        readyNodes[i] = n;
+        n->readyIdx = i;
+    }
+
+} // End namespace FSMSADF
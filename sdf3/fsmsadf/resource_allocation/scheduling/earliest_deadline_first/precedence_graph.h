@@ -12,6 +12,7 @@
  *
  *  History         :
  *      02-06-09    :   Initial version.
+ *      17-10-26    :   Ready queue kept as an indexed binary heap.
  *
  * $Id: precedence_graph.h,v 1.1 2009-12-23 13:37:23 sander Exp $
  *
@@ -48,6 +49,12 @@ namespace FSMSADF
      * with at least one initial token are removed. Each node is assigned a
      * deadline which represents the longest path of dependencies which needs
      * to be executed from this node till the end of the precedence graph.
+     *
+     * The nodes without remaining predecessors are kept in a ready queue. This
+     * queue is a binary heap ordered on deadline (largest first, ties broken
+     * on creation order), so the node with the earliest deadline is found in
+     * constant time and removing a node costs a logarithmic number of steps
+     * plus the number of its precedence constraints.
      */
     class PrecedenceGraph
     {
@@ -55,8 +62,8 @@ namespace FSMSADF
             // Forward class definition
             class Node;
 
-            // Set of nodes
-            typedef set<Node *> Nodes;
+            // List of nodes
+            typedef vector<Node *> Nodes;
 
             /**
              * Node
@@ -66,14 +73,11 @@ namespace FSMSADF
             {
                 public:
                     // Constructor
-                    Node(Actor *a, CId n, Time t);
+                    Node(Actor *a, CId n, Time t, CId i);
 
                     // Destructor
                     ~Node() {};
 
-                    // Update the deadline of this node
-                    void updateDeadline(const Time t);
-
                     // Node can be scheduled?
                     bool isSchedulable() const;
 
@@ -90,8 +94,18 @@ namespace FSMSADF
                     // Remaining time till completion
                     Time deadline;
 
-                    // for cycle detection (colored DFS)
-                    int seen;
+                    // Position of the node in the precedence graph
+                    CId id;
+
+                    // Number of predecessors and successors not yet removed
+                    uint nrPrevious;
+                    uint nrNext;
+
+                    // Position in the ready queue (UINT_MAX when not queued)
+                    uint readyIdx;
+
+                    // Node removed from the precedence graph?
+                    bool removed;
 
                     // Precedence constraints
                     Nodes previous;
@@ -111,16 +125,29 @@ namespace FSMSADF
             // Remove node n from the acyclic precedence graph
             void removeNode(Node *n);
 
-            //
-            bool cycle_detect();
-
         private:
             // Get node
             Node *getNode(const Actor *a, const CId idx) const;
 
+            // Compute the deadlines of all nodes
+            void computeDeadlines();
+
+            // Ready queue
+            bool hasPriority(const Node *n, const Node *m) const;
+            void insertReadyNode(Node *n);
+            void eraseReadyNode(Node *n);
+            void moveReadyNodeUp(uint i);
+            void moveReadyNodeDown(uint i);
+
         private:
-            // Precedence nodes
+            // Precedence nodes (in creation order)
             Nodes nodes;
+
+            // Position of the first node of each actor
+            vector<CId> firstNodeOfActor;
+
+            // Schedulable nodes (binary heap)
+            Nodes readyNodes;
     };
 
 } // End namspace FSMSADF
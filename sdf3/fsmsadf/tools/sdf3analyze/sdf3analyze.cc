@@ -12,6 +12,7 @@
  *
  *  History         :
  *      21-04-09    :   Initial version.
+ *      17-10-26    :   Number of threads of throughput-statespace.
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by the
@@ -69,7 +70,7 @@ namespace FSMSADF
         out << "       throughput" << endl;
         out << "       isolatescenarios" << endl;
         out << "       mpeigen" << endl;
-        out << "       throughput-statespace" << endl;
+        out << "       throughput-statespace[(<threads>)]" << endl;
         out << "       throughput-mpautomaton" << endl;
         out << "       throughput-mpautomaton-weakconsistency" << endl;
         out << "       criticalscenariosequence-weakconsistency" << endl;
@@ -322,7 +323,8 @@ namespace FSMSADF
             // Measure execution time
             startTimer(&timer);
 
-            thr = throughputAnalysisGraphUsingStateSpace(fsmsadfGraph);
+            thr = throughputAnalysisGraphUsingStateSpace(fsmsadfGraph,
+                    analyze.front().value.empty() ? 1 : (uint)analyze.front().value);
             cout << "Throughput (state-space):          " << thr << endl;
 
             // Measure execution time
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      14-05-09    :   Initial version.
+ *      17-10-26    :   Number of threads of the tile binding algorithm.
  *
  * $Id: sdf3flow.cc,v 1.1.2.3 2010-08-01 17:26:43 mgeilen Exp $
  *
@@ -129,6 +130,9 @@ namespace FSMSADF
         // Set maximum number of platform bindings created in tile binding algorithm
         flow->setMaxNrBindingsTileBindingAlgo(settings.maxNrBindingsTileBindingAlgo);
 
+        // Set number of threads used in tile binding algorithm
+        flow->setNrThreadsTileBindingAlgo(settings.nrThreadsTileBindingAlgo);
+
         // Measure execution time
         startTimer(&timer);
 
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      14-05-09    :   Initial version.
+ *      17-10-26    :   Number of threads of the tile binding algorithm.
  *
  * $Id: settings.cc,v 1.1.2.3 2010-08-01 17:26:44 mgeilen Exp $
  *
@@ -65,6 +66,9 @@ namespace FSMSADF
 
         // Maximum number of platform bindings created in tile binding algorithm
         maxNrBindingsTileBindingAlgo = 1;
+
+        // Number of threads used in tile binding algorithm
+        nrThreadsTileBindingAlgo = 0;
     }
 
     /**
@@ -167,6 +171,7 @@ namespace FSMSADF
         CNode *settingsNode, *sdf3Node, *archGraphNode;
         CNode *platformTypeNode;
         CNode *maxNrBindingsTileBindingAlgoNode;
+        CNode *nrThreadsTileBindingAlgoNode;
         CString name, file, platformTypeString;
         CDoc *settingsDoc;
 
@@ -246,6 +251,18 @@ namespace FSMSADF
                                                maxNrBindingsTileBindingAlgoNode, "n");
         }
 
+        // Number of threads used in tile binding algorithm
+        nrThreadsTileBindingAlgoNode
+            = CGetChildNode(settingsNode, "nrThreadsTileBindingAlgo");
+        if (nrThreadsTileBindingAlgoNode != NULL)
+        {
+            if (!CHasAttribute(nrThreadsTileBindingAlgoNode, "n"))
+                throw CException("Missing attribute on "
+                                 "nrThreadsTileBindingAlgo.");
+            nrThreadsTileBindingAlgo = CGetAttribute(
+                                           nrThreadsTileBindingAlgoNode, "n");
+        }
+
         // Architecture graph
         if (!CHasChildNode(settingsNode, "architectureGraph"))
         {
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      14-05-09    :   Initial version.
+ *      17-10-26    :   Number of threads of the tile binding algorithm.
  *
  * $Id: settings.h,v 1.1.2.4 2010-08-01 17:26:44 mgeilen Exp $
  *
@@ -92,6 +93,9 @@ namespace FSMSADF
             // Maximum number of platform bindings created in tile binding algorithm
             uint maxNrBindingsTileBindingAlgo;
 
+            // Number of threads used in tile binding algorithm
+            uint nrThreadsTileBindingAlgo;
+
             // Application graphs
             CStrings applicationGraphs;
 
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      29-08-06    :   Initial version.
+ *      17-10-26    :   Iterate over the configuration space vector.
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by the
@@ -160,16 +161,15 @@ CSize SADF_Analyse_LongRunBufferOccupancy(SADF_Graph *Graph, CId ChannelType, CI
     CDouble AverageBufferOccupancy = 0;
     CDouble AverageSquaredBufferOccupancy = 0;
 
-    for (SADF_HashedListOfConfigurations::iterator i = TPS->getConfigurationSpace().begin(); i != TPS->getConfigurationSpace().end(); i++)
-        for (SADF_ListOfConfigurations::iterator j = (*i).begin(); j != (*i).end(); j++)
-        {
+    for (SADF_ConfigurationSpace::const_iterator j = TPS->getConfigurationSpace().begin(); j != TPS->getConfigurationSpace().end(); j++)
+    {
 
-            CDouble Temp = EquilibriumDistribution[(*j)->getIdentity()] * (*j)->getLocalResult(0);
+        CDouble Temp = EquilibriumDistribution[(*j)->getIdentity()] * (*j)->getLocalResult(0);
 
-            AverageTime += Temp;
-            AverageBufferOccupancy += Temp * (*j)->getLocalResult(1);
-            AverageSquaredBufferOccupancy += Temp * (*j)->getLocalResult(1) * (*j)->getLocalResult(1);
-        }
+        AverageTime += Temp;
+        AverageBufferOccupancy += Temp * (*j)->getLocalResult(1);
+        AverageSquaredBufferOccupancy += Temp * (*j)->getLocalResult(1) * (*j)->getLocalResult(1);
+    }
 
     delete TPS;
 
@@ -221,18 +221,17 @@ CSize SADF_Analyse_MaximumBufferOccupancy(SADF_Graph *Graph, CId ChannelType, CI
 
     CSize NumberOfConfigurations = TPS->getNumberOfConfigurations();
 
-    for (SADF_HashedListOfConfigurations::iterator i = TPS->getConfigurationSpace().begin(); i != TPS->getConfigurationSpace().end(); i++)
-        for (SADF_ListOfConfigurations::iterator j = (*i).begin(); j != (*i).end(); j++)
-            if (ChannelType == SADF_DATA_CHANNEL)
-            {
-                if ((*j)->getChannelStatus(ChannelID)->getOccupation() > Maximum)
-                    Maximum = (*j)->getChannelStatus(ChannelID)->getOccupation();
-            }
-            else
-            {
-                if ((*j)->getControlStatus(ChannelID)->getOccupation() > Maximum)
-                    Maximum = (*j)->getControlStatus(ChannelID)->getOccupation();
-            }
+    for (SADF_ConfigurationSpace::const_iterator j = TPS->getConfigurationSpace().begin(); j != TPS->getConfigurationSpace().end(); j++)
+        if (ChannelType == SADF_DATA_CHANNEL)
+        {
+            if ((*j)->getChannelStatus(ChannelID)->getOccupation() > Maximum)
+                Maximum = (*j)->getChannelStatus(ChannelID)->getOccupation();
+        }
+        else
+        {
+            if ((*j)->getControlStatus(ChannelID)->getOccupation() > Maximum)
+                Maximum = (*j)->getControlStatus(ChannelID)->getOccupation();
+        }
 
     delete TPS;
 
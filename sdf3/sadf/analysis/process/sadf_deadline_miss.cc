@@ -12,6 +12,7 @@
  *
  *  History         :
  *      29-08-06    :   Initial version.
+ *      17-10-26    :   Iterate over the configuration space vector.
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by the
@@ -109,9 +110,8 @@ CSize SADF_Analyse_PeriodicDeadlineMissProbability(SADF_Graph *Graph, CId Proces
 
     Result = 0;
 
-    for (SADF_HashedListOfConfigurations::iterator i = TPS->getConfigurationSpace().begin(); i != TPS->getConfigurationSpace().end(); i++)
-        for (SADF_ListOfConfigurations::iterator j = (*i).begin(); j != (*i).end(); j++)
-            Result += EquilibriumDistribution[(*j)->getIdentity()] * (*j)->getLocalResult(0);
+    for (SADF_ConfigurationSpace::const_iterator j = TPS->getConfigurationSpace().begin(); j != TPS->getConfigurationSpace().end(); j++)
+        Result += EquilibriumDistribution[(*j)->getIdentity()] * (*j)->getLocalResult(0);
 
     delete TPS;
 
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      29-08-06    :   Initial version.
+ *      17-10-26    :   Iterate over the configuration space vector.
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by the
@@ -135,20 +136,19 @@ CSize SADF_Analyse_LongRunInterFiringLatency(SADF_Graph *Graph, CId ProcessType,
     /*  vector<CDouble> Probabilities;
         vector<CDouble> Values;
 
-       for (SADF_HashedListOfConfigurations::iterator i = TPS->getConfigurationSpace().begin(); i != TPS->getConfigurationSpace().end(); i++)
-            for (SADF_ListOfConfigurations::iterator j = (*i).begin(); j != (*i).end(); j++) {
+       for (SADF_ConfigurationSpace::const_iterator j = TPS->getConfigurationSpace().begin(); j != TPS->getConfigurationSpace().end(); j++) {
 
-                int Index = -1;
-                for (CId x = 0; (Index == -1) && (x != Values.size()); x++)
-                    if (Values[x] == (*j)->getLocalResult(0))
-                        Index = x;
+            int Index = -1;
+            for (CId x = 0; (Index == -1) && (x != Values.size()); x++)
+                if (Values[x] == (*j)->getLocalResult(0))
+                    Index = x;
 
-                if (Index == -1) {
-                    Values.push_back((*j)->getLocalResult(0));
-                    Probabilities.push_back(EquilibriumDistribution[(*j)->getIdentity()]);
-                } else
-                    Probabilities[Index] += EquilibriumDistribution[(*j)->getIdentity()];
-            }
+            if (Index == -1) {
+                Values.push_back((*j)->getLocalResult(0));
+                Probabilities.push_back(EquilibriumDistribution[(*j)->getIdentity()]);
+            } else
+                Probabilities[Index] += EquilibriumDistribution[(*j)->getIdentity()];
+       }
 
         ofstream out;
         CString OutputFileName = "inter_firing_delay_distribution.txt";
@@ -162,12 +162,11 @@ CSize SADF_Analyse_LongRunInterFiringLatency(SADF_Graph *Graph, CId ProcessType,
     Average = 0;
     CDouble AverageSquared = 0;
 
-    for (SADF_HashedListOfConfigurations::iterator i = TPS->getConfigurationSpace().begin(); i != TPS->getConfigurationSpace().end(); i++)
-        for (SADF_ListOfConfigurations::iterator j = (*i).begin(); j != (*i).end(); j++)
-        {
-            Average += EquilibriumDistribution[(*j)->getIdentity()] * (*j)->getLocalResult(0);
-            AverageSquared += EquilibriumDistribution[(*j)->getIdentity()] * (*j)->getLocalResult(1);
-        }
+    for (SADF_ConfigurationSpace::const_iterator j = TPS->getConfigurationSpace().begin(); j != TPS->getConfigurationSpace().end(); j++)
+    {
+        Average += EquilibriumDistribution[(*j)->getIdentity()] * (*j)->getLocalResult(0);
+        AverageSquared += EquilibriumDistribution[(*j)->getIdentity()] * (*j)->getLocalResult(1);
+    }
 
     delete TPS;
 
@@ -204,16 +203,15 @@ CSize SADF_Analyse_ExtreemInterFiringLatency(SADF_Graph *Graph, CId ProcessType,
 
     CSize NumberOfConfigurations = TPS->getNumberOfConfigurations();
 
-    for (SADF_HashedListOfConfigurations::iterator i = TPS->getConfigurationSpace().begin(); i != TPS->getConfigurationSpace().end(); i++)
-        for (SADF_ListOfConfigurations::iterator j = (*i).begin(); j != (*i).end(); j++)
-        {
+    for (SADF_ConfigurationSpace::const_iterator j = TPS->getConfigurationSpace().begin(); j != TPS->getConfigurationSpace().end(); j++)
+    {
 
-            if ((*j)->getLocalResult(2) < Minimum)
-                Minimum = (*j)->getLocalResult(2);
+        if ((*j)->getLocalResult(2) < Minimum)
+            Minimum = (*j)->getLocalResult(2);
 
-            if ((*j)->getLocalResult(3) > Maximum)
-                Maximum = (*j)->getLocalResult(3);
-        }
+        if ((*j)->getLocalResult(3) > Maximum)
+            Maximum = (*j)->getLocalResult(3);
+    }
 
     delete TPS;
 
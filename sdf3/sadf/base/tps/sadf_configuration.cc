@@ -12,6 +12,7 @@
  *
  *  History         :
  *      29-09-06    :   Initial version.
+ *      17-10-26    :   Integer hash key.
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by the
@@ -35,6 +36,7 @@
 #include "sadf_tps.h"
 #include "sadf_kernel_status.h"
 #include "sadf_detector_status.h"
+#include <cstring>
 
 // Constructors
 
@@ -141,39 +143,49 @@ void SADF_Configuration::deleteContent()
 
 // Computation of hash key
 
+static inline CSize SADF_CombineHashKey(CSize Key, CSize Value)
+{
+
+    return Key ^ (Value + 0x9e3779b97f4a7c15ULL + (Key << 6) + (Key >> 2));
+}
+
+static inline CSize SADF_HashValue(CDouble Value)
+{
+
+    CSize Bits;
+
+    if (Value == 0)
+        Value = 0;                      // -0 and 0 are equal
+
+    memcpy(&Bits, &Value, sizeof(Bits));
+
+    return Bits;
+}
+
 void SADF_Configuration::computeHashKey()
 {
 
-    HashKey = getType() * 0.6180339887;
+    // The key combines (a subset of) the values compared by equal()
+
+    HashKey = getType();
 
     for (CId i = 0; i != KernelStatus.size(); i++)
     {
-        HashKey = HashKey * 39164205.20662217 + KernelStatus[i]->getState()->getScenario() * 0.6180339887;
-
-        if (KernelStatus[i]->getRemainingExecutionTime() != SADF_MAX_DOUBLE)
-            HashKey = HashKey * 39164205.20662217 + KernelStatus[i]->getRemainingExecutionTime() * 0.6180339887;
+        HashKey = SADF_CombineHashKey(HashKey, KernelStatus[i]->getState()->getIdentity());
+        HashKey = SADF_CombineHashKey(HashKey, SADF_HashValue(KernelStatus[i]->getRemainingExecutionTime()));
     }
 
     for (CId i = 0; i != DetectorStatus.size(); i++)
     {
-        HashKey = HashKey * 39164205.20662217 + DetectorStatus[i]->getState()->getScenario() * 0.6180339887;
-
-        if (DetectorStatus[i]->getRemainingExecutionTime() != SADF_MAX_DOUBLE)
-            HashKey = HashKey * 39164205.20662217 + DetectorStatus[i]->getRemainingExecutionTime() * 0.6180339887;
-
-        for (CId j = 0; j != DetectorStatus[i]->getState()->getMarkovChainStatus().size(); j++)
-            HashKey = HashKey * 39164205.20662217 + DetectorStatus[i]->getState()->getStateOfMarkovChain(j) * 0.6180339887;
+        HashKey = SADF_CombineHashKey(HashKey, DetectorStatus[i]->getState()->getIdentity());
+        HashKey = SADF_CombineHashKey(HashKey, SADF_HashValue(DetectorStatus[i]->getRemainingExecutionTime()));
     }
 
     for (CId i = 0; i != ChannelStatus.size(); i++)
-    {
-        HashKey = HashKey * 39164205.20662217 + ChannelStatus[i]->getAvailableTokens() * 0.6180339887;
-    }
+        HashKey = SADF_CombineHashKey(HashKey, ChannelStatus[i]->getAvailableTokens());
 
     for (CId i = 0; i != ControlStatus.size(); i++)
-    {
-        HashKey = HashKey * 39164205.20662217 + ControlStatus[i]->getAvailableTokens() * 0.6180339887;
-    }
+        HashKey = SADF_CombineHashKey(HashKey, ControlStatus[i]->getAvailableTokens());
 }
 
 // Functions to access transitions
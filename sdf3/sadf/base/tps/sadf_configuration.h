@@ -12,6 +12,7 @@
  *
  *  History         :
  *      29-09-06    :   Initial version.
+ *      17-10-26    :   Integer hash key; configuration space is a vector.
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by the
@@ -65,7 +66,7 @@ class SADF_Configuration : public SADF_Component
         // Hash key and Step Value
 
         void computeHashKey();
-        CDouble getHashKey() const
+        CSize getHashKey() const
         {
             return HashKey;
         };
@@ -170,7 +171,7 @@ class SADF_Configuration : public SADF_Component
     private:
         // Instance Variables
 
-        CDouble HashKey;
+        CSize HashKey;
         CDouble StepValue;
         CDouble MinimalRemainingExecutionTime;
 
@@ -190,6 +191,6 @@ class SADF_Configuration : public SADF_Component
 // Type definitions
 
 typedef list<SADF_Configuration *> SADF_ListOfConfigurations;
-typedef list<SADF_ListOfConfigurations> SADF_HashedListOfConfigurations;
+typedef vector<SADF_Configuration *> SADF_ConfigurationSpace;
 
 #endif
@@ -12,6 +12,8 @@
  *
  *  History         :
  *      29-09-06    :   Initial version.
+ *      17-10-26    :   Hash table on the configuration space.
+ *      17-10-26    :   Iterative equilibrium distribution of large TPSs.
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by the
@@ -33,6 +35,15 @@
 
 #include "sadf_tps.h"
 
+// Initial number of buckets of the hash table (a power of two)
+
+#define SADF_TPS_INITIAL_BUCKETS    1024
+
+// Largest number of configurations for which the equilibrium distribution is
+// computed with Gaussian elimination; larger TPSs use an iterative solver
+
+#define SADF_TPS_DIRECT_SOLVER_LIMIT    1000
+
 // Functions for constructing detector states
 
 void SADF_ConstructKernelStates(SADF_Graph *Graph, SADF_TPS *TPS, CId KernelID, SADF_KernelState *S)
@@ -168,7 +179,7 @@ void SADF_ConstructDetectorStates(SADF_Graph *Graph, SADF_TPS *TPS, CId Detector
 SADF_TPS::SADF_TPS(SADF_Graph *Graph)
 {
 
-    NumberOfConfigurations = 0;
+    Buckets.resize(SADF_TPS_INITIAL_BUCKETS, SADF_UNDEFINED);
 
     KernelStates.resize(Graph->getNumberOfKernels());
     DetectorStates.resize(Graph->getNumberOfDetectors());
@@ -228,9 +239,25 @@ SADF_TPS::~SADF_TPS()
         for (list<SADF_DetectorState *>::iterator j = DetectorStates[i].begin(); j != DetectorStates[i].end(); j++)
             delete(*j);
 
-    for (SADF_HashedListOfConfigurations::iterator i = ConfigurationSpace.begin(); i != ConfigurationSpace.end(); i++)
-        for (SADF_ListOfConfigurations::iterator j = (*i).begin(); j != (*i).end(); j++)
-            delete *j;
+    for (SADF_ConfigurationSpace::iterator i = ConfigurationSpace.begin(); i != ConfigurationSpace.end(); i++)
+        delete *i;
+}
+
+// Hash table on the configuration space
+
+void SADF_TPS::rebuildHashTable(CSize NumberOfBuckets)
+{
+
+    Buckets.assign(NumberOfBuckets, SADF_UNDEFINED);
+    NextInBucket.resize(ConfigurationSpace.size());
+
+    for (CId i = 0; i != ConfigurationSpace.size(); i++)
+    {
+        CSize Bucket = ConfigurationSpace[i]->getHashKey() & (NumberOfBuckets - 1);
+
+        NextInBucket[i] = Buckets[Bucket];
+        Buckets[Bucket] = i;
+    }
 }
 
 // Access to instance variables
@@ -238,35 +265,32 @@ SADF_TPS::~SADF_TPS()
 void SADF_TPS::addConfiguration(SADF_Configuration *C)
 {
 
-    C->setIdentity((CId) NumberOfConfigurations);
+    CId ID = (CId) ConfigurationSpace.size();
 
-    bool MatchFound = false;
+    C->setIdentity(ID);
+    ConfigurationSpace.push_back(C);
 
-    for (SADF_HashedListOfConfigurations::iterator i = ConfigurationSpace.begin(); !MatchFound && i != ConfigurationSpace.end(); i++)
-        if ((*i).front()->getHashKey() == C->getHashKey())
-        {
-            (*i).push_front(C);
-            MatchFound = true;
-        }
+    // Keep the average length of the chains below one
 
-    if (!MatchFound)
+    if (ConfigurationSpace.size() > Buckets.size())
+        rebuildHashTable(2 * Buckets.size());
+    else
     {
-        SADF_ListOfConfigurations NewListOfConfigurations;
-        NewListOfConfigurations.push_front(C);
-        ConfigurationSpace.push_front(NewListOfConfigurations);
-    }
+        CSize Bucket = C->getHashKey() & (Buckets.size() - 1);
 
-    NumberOfConfigurations++;
+        NextInBucket.push_back(Buckets[Bucket]);
+        Buckets[Bucket] = ID;
+    }
 }
 
 SADF_Configuration *SADF_TPS::inConfigurationSpace(SADF_Configuration *C)
 {
 
-    for (SADF_HashedListOfConfigurations::iterator i = ConfigurationSpace.begin(); i != ConfigurationSpace.end(); i++)
-        if ((*i).front()->getHashKey() == C->getHashKey())
-            for (SADF_ListOfConfigurations::iterator j = (*i).begin(); j != (*i).end(); j++)
-                if ((*j)->equal(C))
-                    return *j;
+    CSize Bucket = C->getHashKey() & (Buckets.size() - 1);
+
+    for (CId i = Buckets[Bucket]; i != SADF_UNDEFINED; i = NextInBucket[i])
+        if (ConfigurationSpace[i]->getHashKey() == C->getHashKey() && ConfigurationSpace[i]->equal(C))
+            return ConfigurationSpace[i];
 
     return NULL;
 }
@@ -274,9 +298,8 @@ SADF_Configuration *SADF_TPS::inConfigurationSpace(SADF_Configuration *C)
 void SADF_TPS::deleteContentOfConfigurations()
 {
 
-    for (SADF_HashedListOfConfigurations::iterator i = ConfigurationSpace.begin(); i != ConfigurationSpace.end(); i++)
-        for (SADF_ListOfConfigurations::iterator j = (*i).begin(); j != (*i).end(); j++)
-            (*j)->deleteContent();
+    for (SADF_ConfigurationSpace::iterator i = ConfigurationSpace.begin(); i != ConfigurationSpace.end(); i++)
+        (*i)->deleteContent();
 }
 
 
@@ -299,12 +322,11 @@ bool SADF_TPS::isSingleStronglyConnectedComponent()
 
     bool SingleStronglyConnectedComponent = true;
 
-    SADF_MarkReachableConfigurations(ConfigurationSpace.front().front());
+    SADF_MarkReachableConfigurations(ConfigurationSpace.front());
 
-    for (SADF_HashedListOfConfigurations::iterator i = ConfigurationSpace.begin(); SingleStronglyConnectedComponent && i != ConfigurationSpace.end(); i++)
-        for (SADF_ListOfConfigurations::iterator j = (*i).begin(); SingleStronglyConnectedComponent && j != (*i).end(); j++)
-            if (!(*j)->isMarked())
-                SingleStronglyConnectedComponent = false;
+    for (SADF_ConfigurationSpace::iterator i = ConfigurationSpace.begin(); SingleStronglyConnectedComponent && i != ConfigurationSpace.end(); i++)
+        if (!(*i)->isMarked())
+            SingleStronglyConnectedComponent = false;
 
     return SingleStronglyConnectedComponent;
 }
@@ -347,45 +369,24 @@ void SADF_TPS::removeTransientConfigurations()
     SADF_FindRecurrencePoints(InitialConfiguration);
     SADF_RemoveTransitionsUntilRecurrencePoints(InitialConfiguration);
 
-    for (SADF_HashedListOfConfigurations::iterator i = ConfigurationSpace.begin(); i != ConfigurationSpace.end();)
-    {
-
-        SADF_HashedListOfConfigurations::iterator n = i;
-        i++;
-
-        for (SADF_ListOfConfigurations::iterator j = (*n).begin(); j != (*n).end();)
-        {
-
-            SADF_ListOfConfigurations::iterator m = j;
-            j++;
-
-            if ((*m)->getTransitions().empty())
-            {
-                NumberOfConfigurations--;
-                delete *m;
-                (*n).erase(m);
-            }
-            else
-            {
-                (*m)->setMarking(false);
-                (*m)->setRelevance(true);
-            }
-        }
-
-        if ((*n).empty())
-            ConfigurationSpace.erase(n);
-    }
-
-    // Reassign identities
+    // Remove configurations without transitions and reassign identities
 
     CId ID = 0;
 
-    for (SADF_HashedListOfConfigurations::iterator i = ConfigurationSpace.begin(); i != ConfigurationSpace.end(); i++)
-        for (SADF_ListOfConfigurations::iterator j = (*i).begin(); j != (*i).end(); j++)
+    for (SADF_ConfigurationSpace::iterator i = ConfigurationSpace.begin(); i != ConfigurationSpace.end(); i++)
+        if ((*i)->getTransitions().empty())
+            delete *i;
+        else
         {
-            (*j)->setIdentity(ID);
+            (*i)->setMarking(false);
+            (*i)->setRelevance(true);
+            (*i)->setIdentity(ID);
+            ConfigurationSpace[ID] = *i;
             ID++;
         }
+
+    ConfigurationSpace.resize(ID);
+    rebuildHashTable(Buckets.size());
 }
 
 // Functions to compute equilibrium distribution
@@ -393,28 +394,63 @@ void SADF_TPS::removeTransientConfigurations()
 vector<CDouble> SADF_TPS::computeEquilibriumDistribution()
 {
 
-    // Initialise augmented matrix
+    CSize NumberOfConfigurations = ConfigurationSpace.size();
 
-    SparseMatrix *Matrix = new SparseMatrix((CId) NumberOfConfigurations);
+    if (NumberOfConfigurations <= SADF_TPS_DIRECT_SOLVER_LIMIT)
+    {
+
+        // Initialise augmented matrix
 
-    for (SADF_HashedListOfConfigurations::iterator i = ConfigurationSpace.begin(); i != ConfigurationSpace.end(); i++)
-        for (SADF_ListOfConfigurations::iterator j = (*i).begin(); j != (*i).end(); j++)
-            for (list<SADF_Transition *>::iterator k = (*j)->getTransitions().begin(); k != (*j)->getTransitions().end(); k++)
+        SparseMatrix *Matrix = new SparseMatrix((CId) NumberOfConfigurations);
+
+        for (SADF_ConfigurationSpace::iterator i = ConfigurationSpace.begin(); i != ConfigurationSpace.end(); i++)
+            for (list<SADF_Transition *>::iterator k = (*i)->getTransitions().begin(); k != (*i)->getTransitions().end(); k++)
                 if ((*k)->getDestination()->getIdentity() < NumberOfConfigurations - 1)
-                    Matrix->set((*k)->getDestination()->getIdentity(), (*j)->getIdentity(), (*k)->getProbability());
+                    Matrix->set((*k)->getDestination()->getIdentity(), (*i)->getIdentity(), (*k)->getProbability());
 
-    for (CId i = 0; i != NumberOfConfigurations + 1; i++)
-    {
+        for (CId i = 0; i != NumberOfConfigurations + 1; i++)
+        {
+
+            Matrix->set((CId) NumberOfConfigurations - 1, i, 1);
 
-        Matrix->set((CId) NumberOfConfigurations - 1, i, 1);
+            if (i < NumberOfConfigurations - 1)
+                Matrix->set(i, i, Matrix->get(i, i) - 1);
+        }
 
-        if (i < NumberOfConfigurations - 1)
-            Matrix->set(i, i, Matrix->get(i, i) - 1);
+        vector<CDouble> EquilibriumDistribution = Matrix->computeEigenVector();
+
+        delete Matrix;
+
+        return EquilibriumDistribution;
     }
 
-    vector<CDouble> EquilibriumDistribution = Matrix->computeEigenVector();
+    // Initialise transition probability matrix
+
+    vector<CSRMatrixEntry> Entries;
+
+    for (SADF_ConfigurationSpace::iterator i = ConfigurationSpace.begin(); i != ConfigurationSpace.end(); i++)
+        for (list<SADF_Transition *>::iterator k = (*i)->getTransitions().begin(); k != (*i)->getTransitions().end(); k++)
+            Entries.push_back(CSRMatrixEntry((*i)->getIdentity(), (*k)->getDestination()->getIdentity(), (*k)->getProbability()));
+
+    CSRMatrix Matrix((CId) NumberOfConfigurations, (CId) NumberOfConfigurations, Entries);
+
+    Entries.clear();
+
+    // Gauss-Seidel, falling back on power iteration if it does not converge
 
-    delete Matrix;
+    vector<CDouble> EquilibriumDistribution;
+
+    StationarySolver Solver;
+    Solver.setNumberOfThreads(0);
+
+    if (!Solver.solve(Matrix, EquilibriumDistribution))
+    {
+
+        Solver.setMethod(StationarySolver::POWER);
+
+        if (!Solver.solve(Matrix, EquilibriumDistribution))
+            throw CException("Error: Computation of equilibrium distribution did not converge.");
+    }
 
     return EquilibriumDistribution;
 }
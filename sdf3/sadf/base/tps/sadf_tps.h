@@ -12,6 +12,7 @@
  *
  *  History         :
  *      29-09-06    :   Initial version.
+ *      17-10-26    :   Hash table on the configuration space.
  *
  * This program is free software; you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by the
@@ -58,14 +59,14 @@ class SADF_TPS
 
         CSize getNumberOfConfigurations() const
         {
-            return NumberOfConfigurations;
+            return ConfigurationSpace.size();
         };
         void addConfiguration(SADF_Configuration *C);
         SADF_Configuration *getInitialConfiguration() const
         {
             return InitialConfiguration;
         };
-        list<SADF_ListOfConfigurations>& getConfigurationSpace()
+        const SADF_ConfigurationSpace& getConfigurationSpace() const
         {
             return ConfigurationSpace;
         };
@@ -96,9 +97,11 @@ class SADF_TPS
         vector<CDouble> computeEquilibriumDistribution();
 
     private:
-        // Instance Variables
+        // Hash table on the configuration space
+
+        void rebuildHashTable(CSize NumberOfBuckets);
 
-        CSize NumberOfConfigurations;
+        // Instance Variables
 
         vector< list<SADF_KernelState *> > KernelStates;
         vector< list<SADF_DetectorState *> > DetectorStates;
@@ -106,7 +109,13 @@ class SADF_TPS
         vector<SADF_DetectorState *> InitialDetectorStates;
 
         SADF_Configuration *InitialConfiguration;
-        SADF_HashedListOfConfigurations ConfigurationSpace;
+        // Configurations indexed on their identity. Configurations with the
+        // same hash key modulo the number of buckets are chained through
+        // NextInBucket, starting at the configuration in Buckets.
+
+        SADF_ConfigurationSpace ConfigurationSpace;
+        vector<CId> Buckets;
+        vector<CId> NextInBucket;
 };
 
 #endif
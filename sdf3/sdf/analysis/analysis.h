@@ -48,6 +48,9 @@
 // Maximum Cycle Mean
 #include "mcm/mcm.h"
 
+// State-space exploration
+#include "statespace/statespace.h"
+
 // Throughput
 #include "throughput/throughput.h"
 
@@ -13,6 +13,10 @@
  *
  *  History         :
  *      24-04-06    :   Initial version.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
+ *      17-10-26    :   Only visit actors whose firing ends or which may have
+ *                      become enabled.
+ *      17-10-26    :   Static-order schedules stepped with loop counters.
  *
  * $Id: bounded_buffer.cc,v 1.1.2.1 2010-04-22 07:18:38 mgeilen Exp $
  *
@@ -152,53 +156,15 @@ namespace SDF
      *****************************************************************************/
 
     /**
-     * clear ()
-     * The function sets the state to zero.
-     */
-    void SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem::State
-    ::clear()
-    {
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            actClk[i].clear();
-        }
-
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            ch[i] = 0;
-        }
-
-        glbClk = 0;
-
-        for (uint i = 0; i < schedulePos.size(); i++)
-        {
-            schedulePos[i] = 0;
-            tdmaPos[i] = 0;
-        }
-    }
-
-    /**
-     * operator= ()
+     * operator== ()
      * The function compares to states and returns true if they are equal.
      */
     bool SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem::State
-    ::operator==(const State &s)
+    ::operator==(const State &s) const
     {
-        if (glbClk != s.glbClk)
+        if (!SDFstateSpaceState::operator==(s))
             return false;
 
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            if (ch[i] != s.ch[i])
-                return false;
-        }
-
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            if (actClk[i] != s.actClk[i])
-                return false;
-        }
-
         for (uint i = 0; i < schedulePos.size(); i++)
         {
             if (schedulePos[i] != s.schedulePos[i] || tdmaPos[i] != s.tdmaPos[i])
@@ -213,35 +179,49 @@ namespace SDF
      * Print the state to the supplied stream.
      */
     void SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem::State
-    ::print(ostream &out)
+    ::print(ostream &out) const
     {
-        out << "### State ###" << endl;
+        SDFstateSpaceState::print(out);
 
-        for (uint i = 0; i < actClk.size(); i++)
+        for (uint i = 0; i < schedulePos.size(); i++)
         {
-            out << "actClk[" << i << "] =";
-
-            for (list<SDFtime>::const_iterator iter = actClk[i].begin();
-                 iter != actClk[i].end(); iter++)
-            {
-                out << " " << (*iter) << ", ";
-            }
-
-            out << endl;
+            out << "tile[" << i << "] = (";
+            out << schedulePos[i].index;
+            out << ", " << tdmaPos[i] << ")" << endl;
         }
+    }
 
-        for (uint i = 0; i < ch.size(); i++)
+    /**
+     * clear ()
+     * The function sets the state to zero.
+     */
+    void SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem::State
+    ::clear()
+    {
+        SDFstateSpaceState::clear();
+
+        for (uint i = 0; i < schedulePos.size(); i++)
         {
-            out << "ch[" << i << "] = " << ch[i] << endl;
+            schedulePos[i] = StaticOrderSchedulePosition();
+            tdmaPos[i] = 0;
         }
+    }
 
-        out << "glbClk = " << glbClk << endl;
+    /**
+     * pack ()
+     * The function packs the state into a sequence of words. The shared part
+     * of the state is followed by the schedule and TDMA wheel positions of all
+     * tiles.
+     */
+    void SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem::State
+    ::pack(vector<SDFstateWord> &s) const
+    {
+        SDFstateSpaceState::pack(s);
 
         for (uint i = 0; i < schedulePos.size(); i++)
         {
-            out << "tile[" << i << "] = (";
-            out << schedulePos[i];
-            out << ", " << tdmaPos[i] << ")" << endl;
+            s.push_back(schedulePos[i].index);
+            s.push_back(tdmaPos[i]);
         }
     }
 
@@ -257,27 +237,21 @@ namespace SDF
     void SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem
     ::initOutputActor()
     {
-        RepetitionVector repVec;
+        const RepetitionVector &repVec = g.getRepetitionVector();
         int min = INT_MAX;
-        SDFactor *a = NULL;
-
-        // Compute repetition vector
-        repVec = computeRepetitionVector(bindingAwareSDFG);
 
         // Select actor with lowest entry in repetition vector as output actor
-        for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-             iter != bindingAwareSDFG->actorsEnd(); iter++)
+        for (CId a = 0; a < g.nrActors(); a++)
         {
-            if (repVec[(*iter)->getId()] < min)
+            if (repVec[a] < min)
             {
-                a = *iter;
-                min = repVec[a->getId()];
+                outputActor = a;
+                min = repVec[a];
             }
         }
 
-        // Set output actor and its repetition vector count
-        outputActor = a;
-        outputActorRepCnt = repVec[outputActor->getId()];
+        // Set output actor repetition vector count
+        outputActorRepCnt = repVec[outputActor];
     }
 
     /**
@@ -291,10 +265,11 @@ namespace SDF
 
         // Check that all actor that are bound to a processors are bound to a
         // processor which has a schedule
-        for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-             iter != bindingAwareSDFG->actorsEnd(); iter++)
+        actorTile.assign(g.nrActors(), ACTOR_NOT_BOUND);
+        for (CId a = 0; a < g.nrActors(); a++)
         {
-            tileId = bindingAwareSDFG->getBindingOfActorToTile(*iter);
+            tileId = bindingAwareSDFG->getBindingOfActorToTile(g.getActor(a));
+            actorTile[a] = tileId;
 
             if (tileId != ACTOR_NOT_BOUND)
             {
@@ -306,62 +281,26 @@ namespace SDF
         }
     }
 
-    /**
-     * storeState ()
-     * The function stores the state s on whenever s is not already in the
-     * list of storedStates. When s is stored, the function returns true. When the
-     * state s is already in the list, the state s is not stored. The function
-     * returns false. The function always sets the pos variable to the position
-     * where the state s is in the list.
-     */
-    bool SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem::storeState(
-        State &s, StatesIter &pos)
-    {
-        // Find state in the list of stored states
-        for (StatesIter iter = storedStates.begin();
-             iter != storedStates.end(); iter++)
-        {
-            State &x = *iter;
-
-            // State s at position iter in the list?
-            if (x == s)
-            {
-                pos = iter;
-                return false;
-            }
-        }
-
-        // State not found, store it at the end of the list
-        storedStates.push_back(s);
-
-        // Added state to the end of the list
-        pos = storedStates.end();
-
-        return true;
-    }
-
     /**
      * computeThroughput ()
      * The function calculates the throughput of the states on the cycle. Its
      * value is equal to the average number of firings of an actor per time unit.
      */
     TDtime SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem
-    ::computeThroughput(const StatesIter cycleIter)
+    ::computeThroughput(const uint cycleIdx)
     {
         int nr_fire = 0;
         TDtime time = 0;
 
         // Check all state from stack till cycle complete
-        for (StatesIter iter = cycleIter; iter != storedStates.end(); iter++)
+        for (uint i = cycleIdx; i < storedStates.size(); i++)
         {
-            State &s = *iter;
-
             // Number of states in cycle is equal to number of iterations
             // in the period
             nr_fire++;
 
             // Time between previous state
-            time += s.glbClk;
+            time += storedStates.glbClk(i);
         }
 
         return (TDtime)(nr_fire) / (time);
@@ -402,15 +341,13 @@ namespace SDF
                     {
                         // All channels from d to c in the SDFG have
                         // storage dependency
-                        for (SDFchannelsIter iter = bindingAwareSDFG->channelsBegin();
-                             iter != bindingAwareSDFG->channelsEnd(); iter++)
+                        for (CId ch = 0; ch < g.nrChannels(); ch++)
                         {
-                            SDFchannel *ch = *iter;
-                            CId srcId = ch->getSrcActor()->getId();
-                            CId dstId = ch->getDstActor()->getId();
-
-                            if (dstId == d && srcId == c)
-                                dep[ch->getId()] = true;
+                            if (g.getDstActor(ch) == d
+                                && g.getSrcActor(ch) == c)
+                            {
+                                dep[ch] = true;
+                            }
                         }
 
                         // Next
@@ -488,8 +425,7 @@ namespace SDF
 #define SOS_POS(p)          currentState.schedulePos[p]
 
 #define SOS(p)              (bindingAwareSDFG->getScheduleOnTile(p))
-#define SOS_ENTRY(p)        (SOS(p).getScheduleEntry(SOS_POS(p)))
-#define SOS_NEXT_POS(p)     (SOS(p).next(SOS_POS(p)))
+#define SOS_ACTOR(p)        (SOS(p).getActor(SOS_POS(p)))
 
 #define CH_TOKENS(c,n)      (CH(c) >= n)
 #define CONSUME(c,n)        CH(c) = CH(c) - n;
@@ -503,32 +439,24 @@ namespace SDF
      * s. Else it returns false.
      */
     bool SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem
-    ::actorReadyToFire(SDFactor *a)
+    ::actorReadyToFire(const CId a)
     {
         // Actor bound to processor?
-        if (bindingAwareSDFG->getBindingOfActorToTile(a) != ACTOR_NOT_BOUND)
+        if (actorTile[a] != ACTOR_NOT_BOUND)
         {
-            uint p = bindingAwareSDFG->getBindingOfActorToTile(a);
+            uint p = actorTile[a];
 
             // Actor not scheduled on processor?
-            if (SOS_ENTRY(p)->actor->getId() != a->getId())
+            if (SOS_ACTOR(p)->getId() != a)
                 return false;
         }
 
         // Check all input ports for tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = g.inPortsBegin(a);
+             p != g.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                if (!CH_TOKENS(c->getId(), p->getRate()))
-                {
-                    return false;
-                }
-            }
+            if (!CH_TOKENS(p->channel, p->rate))
+                return false;
         }
 
         return true;
@@ -541,35 +469,29 @@ namespace SDF
      * position.
      */
     void SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem
-    ::startActorFiring(TimedSDFactor *a)
+    ::startActorFiring(const CId a)
     {
         SDFtime execTime, completionTime, timeTileStartOfSlice, waitingTime;
         int remainingExecTime, nrOfFullRotationsInNonReservedPart;
 
-        // Consume tokens from inputs and space for output tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        // Consume tokens from inputs
+        for (const TimedSDFcompiledGraph::Port *p = g.inPortsBegin(a);
+             p != g.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                CONSUME(c->getId(), p->getRate());
-            }
+            CONSUME(p->channel, p->rate);
         }
 
         // Execution time of the actor
-        execTime = a->getExecutionTime();
+        execTime = g.getExecutionTime(a);
 
         // Compute time needed to complete actor firing
-        if (bindingAwareSDFG->getBindingOfActorToTile(a) == ACTOR_NOT_BOUND)
+        if (actorTile[a] == ACTOR_NOT_BOUND)
         {
             completionTime = execTime;
         }
         else
         {
-            uint p = bindingAwareSDFG->getBindingOfActorToTile(a);
+            uint p = actorTile[a];
 
             // Time wheel has not yet reached start of slice?
             if (currentState.tdmaPos[p]
@@ -615,7 +537,7 @@ namespace SDF
         }
 
         // Add actor firing to the list of active firings of this actor
-        currentState.actClk[a->getId()].push_back(completionTime);
+        currentState.startFiring(a, completionTime);
     }
 
     /**
@@ -624,16 +546,10 @@ namespace SDF
      * the function returns false.
      */
     bool SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem
-    ::actorReadyToEnd(SDFactor *a)
+    ::actorReadyToEnd(const CId a)
     {
-        if (currentState.actClk[a->getId()].empty())
-            return false;
-
-        // First actor firing in sorted list has execution time left?
-        if (currentState.actClk[a->getId()].front() != 0)
-            return false;
-
-        return true;
+        // First actor firing in sorted list has no execution time left?
+        return currentState.readyToEnd(a);
     }
 
     /**
@@ -642,30 +558,24 @@ namespace SDF
      * list of active firings.
      */
     void SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem
-    ::endActorFiring(SDFactor *a)
+    ::endActorFiring(const CId a)
     {
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = g.outPortsBegin(a);
+             p != g.outPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is source of the channel?
-            if (p->getType() == SDFport::Out)
-            {
-                PRODUCE(c->getId(), p->getRate());
-            }
+            PRODUCE(p->channel, p->rate);
         }
 
         // Remove the firing from the list of active actor firings
-        currentState.actClk[a->getId()].pop_front();
+        currentState.endFiring(a);
 
         // Actor bound to processor?
-        if (bindingAwareSDFG->getBindingOfActorToTile(a) != ACTOR_NOT_BOUND)
+        if (actorTile[a] != ACTOR_NOT_BOUND)
         {
-            uint p = bindingAwareSDFG->getBindingOfActorToTile(a);
+            uint p = actorTile[a];
 
             // Advance the schedule to the next state
-            SOS_POS(p) = SOS_NEXT_POS(p);
+            SOS(p).nextPosition(SOS_POS(p));
         }
     }
 
@@ -678,52 +588,57 @@ namespace SDF
     SDFtime SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem
     ::clockStep()
     {
-        SDFtime step = UINT_MAX;
+        SDFtime step;
 
-        // Find maximal time progress
-        for (uint a = 0; a < bindingAwareSDFG->nrActors(); a++)
-        {
-            if (!currentState.actClk[a].empty())
-            {
-                SDFtime actClk = currentState.actClk[a].front();
+        // Progress time till the first firing ends
+        step = currentState.clockStep();
 
-                if (step > actClk)
-                    step = actClk;
-            }
-        }
+        // Still actors ready to end their firing or deadlock?
+        if (step == 0 || step == UINT_MAX)
+            return step;
 
-        // Still actors ready to end their firing?
-        if (step == 0)
-            return 0;
+        // Advance the time wheels
+        for (uint t = 0; t < bindingAwareSDFG->nrTilesInPlatformGraph(); t++)
+        {
+            currentState.tdmaPos[t] = (currentState.tdmaPos[t] + step)
+                                      % bindingAwareSDFG->getTDMAsizeOnTile(t);
+        }
 
-        // Check for progress (i.e. no deadlock)
-        if (step == UINT_MAX)
-            return UINT_MAX;
+        return step;
+    }
 
-        // Lower remaining execution time actors
-        for (uint a = 0; a < bindingAwareSDFG->nrActors(); a++)
+    /**
+     * addCandidates ()
+     * The end of a firing of actor a produces tokens for the consumers of its
+     * output channels and, when a is bound to a tile, advances the static-order
+     * schedule of that tile to its next actor. These actors are added to the
+     * candidates that must be checked for enabling. Storage space is modeled
+     * with tokens, so no other actor can become enabled by this transition.
+     */
+    void SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem
+    ::addCandidates(const CId a, vector<CId> &candidates,
+                    vector<bool> &isCandidate)
+    {
+        for (const CId *b = g.consumersBegin(a); b != g.consumersEnd(a); b++)
         {
-            for (list<SDFtime>::iterator iter = currentState.actClk[a].begin();
-                 iter != currentState.actClk[a].end(); iter++)
+            if (!isCandidate[*b])
             {
-                SDFtime &actFiringTime = *iter;
-
-                // Lower remaining execution time of the actor firing
-                actFiringTime -= step;
+                isCandidate[*b] = true;
+                candidates.push_back(*b);
             }
         }
 
-        // Advance the time wheels
-        for (uint t = 0; t < bindingAwareSDFG->nrTilesInPlatformGraph(); t++)
+        // Actor bound to processor?
+        if (actorTile[a] != ACTOR_NOT_BOUND)
         {
-            currentState.tdmaPos[t] = (currentState.tdmaPos[t] + step)
-                                      % bindingAwareSDFG->getTDMAsizeOnTile(t);
-        }
+            CId b = SOS(actorTile[a]).getActor(SOS_POS(actorTile[a]))->getId();
 
-        // Advance the global clock
-        currentState.glbClk += step;
-
-        return step;
+            if (!isCandidate[b])
+            {
+                isCandidate[b] = true;
+                candidates.push_back(b);
+            }
+        }
     }
 
     /**
@@ -733,39 +648,35 @@ namespace SDF
      * graph.
      */
     void SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem
-    ::findCausalDependencies(SDFactor *a, bool **abstractDepGraph)
+    ::findCausalDependencies(const CId a, bool **abstractDepGraph)
     {
-        // Check all input ports for tokens and output ports for space
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        // Check all input ports for tokens
+        for (const TimedSDFcompiledGraph::Port *p = g.inPortsBegin(a);
+             p != g.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-            SDFactor *srcActor = c->getSrcActor();
-            SDFactor *dstActor = c->getDstActor();
-
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                // Not enough tokens in the previous state?
-                if (!CH_TOKENS_PREV(c->getId(), p->getRate()))
-                {
-                    abstractDepGraph[dstActor->getId()][srcActor->getId()] = true;
-                }
-            }
+            // Not enough tokens in the previous state?
+            if (!CH_TOKENS_PREV(p->channel, p->rate))
+                abstractDepGraph[a][g.getSrcActor(p->channel)] = true;
         }
     }
 
     /**
      * analyzePeriodicPhase ()
      * Analyze the periodic phase of the schedule to find all blocked channels. This
-     * is done using the abstract dependency graph.
+     * is done using the abstract dependency graph. The periodic phase starts
+     * while ending the firings at the current time; endingActors contains the
+     * actors whose firings must still be ended.
      */
     void SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem
-    ::analyzePeriodicPhase(bool *dep, bool *bufferChannels)
+    ::analyzePeriodicPhase(bool *dep, bool *bufferChannels,
+                           const vector<CId> &endingActors)
     {
         State periodicState;
         bool **abstractDepGraph;
         int repCnt;
+        vector<CId> ending;
+        vector<CId> candidates;
+        vector<bool> isCandidate(g.nrActors(), true);
 
         // Current state is a periodic state
         periodicState = currentState;
@@ -787,14 +698,13 @@ namespace SDF
         repCnt = -1;
 
         // Complete the remaining actor firings
-        for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-             iter != bindingAwareSDFG->actorsEnd(); iter++)
+        for (uint i = 0; i < endingActors.size(); i++)
         {
-            SDFactor *a = *iter;
+            CId a = endingActors[i];
 
             while (actorReadyToEnd(a))
             {
-                if (a->getId() == outputActor->getId())
+                if (a == outputActor)
                 {
                     repCnt++;
                     if (repCnt == outputActorRepCnt)
@@ -808,14 +718,17 @@ namespace SDF
             }
         }
 
+        // Initially all actors may be enabled
+        for (CId a = 0; a < g.nrActors(); a++)
+            candidates.push_back(a);
+
         // Fire the actors
         while (true)
         {
             // Start actor firings
-            for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-                 iter != bindingAwareSDFG->actorsEnd(); iter++)
+            for (uint i = 0; i < candidates.size(); i++)
             {
-                TimedSDFactor *a = (TimedSDFactor *)(*iter);
+                CId a = candidates[i];
 
                 // Ready to fire actor a?
                 while (actorReadyToFire(a))
@@ -826,7 +739,10 @@ namespace SDF
                     // Fire actor a
                     startActorFiring(a);
                 }
+
+                isCandidate[a] = false;
             }
+            candidates.clear();
 
             // Clock step
             clockStep();
@@ -838,14 +754,14 @@ namespace SDF
             }
 
             // Finish actor firings
-            for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-                 iter != bindingAwareSDFG->actorsEnd(); iter++)
+            currentState.actorsReadyToEnd(ending);
+            for (uint i = 0; i < ending.size(); i++)
             {
-                SDFactor *a = *iter;
+                CId a = ending[i];
 
                 while (actorReadyToEnd(a))
                 {
-                    if (outputActor->getId() == a->getId())
+                    if (outputActor == a)
                     {
                         repCnt++;
                         if (repCnt == outputActorRepCnt)
@@ -874,6 +790,8 @@ namespace SDF
                     // End the actor firing
                     endActorFiring(a);
                 }
+
+                addCandidates(a, candidates, isCandidate);
             }
         }
     }
@@ -897,24 +815,20 @@ namespace SDF
         }
 
         // Check number of tokens on every channel in the graph
-        for (SDFchannelsIter iter = bindingAwareSDFG->channelsBegin();
-             iter != bindingAwareSDFG->channelsEnd(); iter++)
+        for (CId c = 0; c < g.nrChannels(); c++)
         {
-            SDFchannel *c = *iter;
-            SDFactor *srcActor = c->getSrcActor();
-            SDFactor *dstActor = c->getDstActor();
-            uint procDstActor = bindingAwareSDFG->getBindingOfActorToTile(dstActor);
+            CId srcActor = g.getSrcActor(c);
+            CId dstActor = g.getDstActor(c);
+            uint procDstActor = actorTile[dstActor];
 
             // Destination actor allowed to fire (i.e. not bound to processor or
             // first actor in a schedule?)
             if (procDstActor == ACTOR_NOT_BOUND ||
-                SOS_ENTRY(procDstActor)->actor->getId() == dstActor->getId())
+                SOS_ACTOR(procDstActor)->getId() == dstActor)
             {
                 // Insufficient tokens to fire destination actor
-                if (!CH_TOKENS(c->getId(), c->getDstPort()->getRate()))
-                {
-                    abstractDepGraph[dstActor->getId()][srcActor->getId()] = true;
-                }
+                if (!CH_TOKENS(c, g.getDstRate(c)))
+                    abstractDepGraph[dstActor][srcActor] = true;
             }
         }
 
@@ -930,14 +844,19 @@ namespace SDF
     /**
      * execSDFgraph()
      * Execute the SDF graph till a deadlock is found or a recurrent state.
-     * The throughput is returned.
+     * The throughput is returned. Only the actors whose firing ends at the
+     * current time are visited to end their firings and only the actors
+     * affected by these transitions are checked for enabling.
      */
     TDtime SDFstateSpaceBindingAwareBufferAnalysis::TransitionSystem::execSDFgraph(
         const TBufSize *sp, bool *dep, bool *bufferChannels)
     {
-        StatesIter recurrentState;
+        uint recurrentState;
         SDFtime clkStep;
         int repCnt = 0;
+        vector<CId> endingActors;
+        vector<CId> candidates;
+        vector<bool> isCandidate(g.nrActors(), true);
 
         // Clear the list of stored states
         clearStoredStates();
@@ -1003,10 +922,14 @@ namespace SDF
         // Initial schedules
         for (uint p = 0; p < bindingAwareSDFG->nrTilesInPlatformGraph(); p++)
         {
-            SOS_POS(p) = 0;
+            SOS(p).initPosition(SOS_POS(p));
             TDMA_POS(p) = 0;
         }
 
+        // Initially all actors may be enabled
+        for (CId a = 0; a < g.nrActors(); a++)
+            candidates.push_back(a);
+
         // Fire the actors
         while (true)
         {
@@ -1017,23 +940,26 @@ namespace SDF
             }
 
             // Finish actor firings
-            for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-                 iter != bindingAwareSDFG->actorsEnd(); iter++)
+            currentState.actorsReadyToEnd(endingActors);
+            for (uint i = 0; i < endingActors.size(); i++)
             {
-                SDFactor *a = *iter;
+                CId a = endingActors[i];
 
                 while (actorReadyToEnd(a))
                 {
-                    if (outputActor->getId() == a->getId())
+                    if (outputActor == a)
                     {
                         repCnt++;
                         if (repCnt == outputActorRepCnt)
                         {
                             // Add state to hash of visited states
-                            if (!storeState(currentState, recurrentState))
+                            if (!storedStates.store(currentState, recurrentState))
                             {
                                 // Find storage dependencies in periodic phase
-                                analyzePeriodicPhase(dep, bufferChannels);
+                                endingActors.erase(endingActors.begin(),
+                                                   endingActors.begin() + i);
+                                analyzePeriodicPhase(dep, bufferChannels,
+                                                     endingActors);
 
                                 // Done
                                 return computeThroughput(recurrentState);
@@ -1046,13 +972,14 @@ namespace SDF
                     // End the actor firing
                     endActorFiring(a);
                 }
+
+                addCandidates(a, candidates, isCandidate);
             }
 
             // Start actor firings
-            for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-                 iter != bindingAwareSDFG->actorsEnd(); iter++)
+            for (uint i = 0; i < candidates.size(); i++)
             {
-                TimedSDFactor *a = (TimedSDFactor *)(*iter);
+                CId a = candidates[i];
 
                 // Ready to fire actor a?
                 while (actorReadyToFire(a))
@@ -1060,7 +987,10 @@ namespace SDF
                     // Fire actor a
                     startActorFiring(a);
                 }
+
+                isCandidate[a] = false;
             }
+            candidates.clear();
 
             // Clock step
             clkStep = clockStep();
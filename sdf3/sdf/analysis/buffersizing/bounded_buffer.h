@@ -13,6 +13,9 @@
  *
  *  History         :
  *      24-04-06    :   Initial version.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
+ *      17-10-26    :   Only visit actors whose firing ends or which may have
+ *                      become enabled.
  *
  * $Id: bounded_buffer.h,v 1.1 2008-03-06 10:49:42 sander Exp $
  *
@@ -40,6 +43,8 @@
 
 #include "storage_distribution.h"
 #include "../../resource_allocation/binding_aware_sdfg/binding_aware_sdfg.h"
+#include "../../base/timed/compiled_graph.h"
+#include "../statespace/state.h"
 
 namespace SDF
 {
@@ -82,7 +87,7 @@ namespace SDF
                     /***********************************************************************
                      * State
                      **********************************************************************/
-                    class State
+                    class State : public SDFstateSpaceState
                     {
                         public:
                             // Constructor
@@ -99,35 +104,31 @@ namespace SDF
                             void init(const uint nrActors, const uint nrChannels,
                                       const uint nrTiles)
                             {
-                                actClk.resize(nrActors);
-                                ch.resize(nrChannels);
+                                SDFstateSpaceState::init(nrActors, nrChannels);
                                 schedulePos.resize(nrTiles);
                                 tdmaPos.resize(nrTiles);
                             };
 
                             // Compare states
-                            bool operator==(const State &s);
+                            bool operator==(const State &s) const;
 
                             // Clear state
                             void clear();
 
                             // Output state
-                            void print(ostream &out);
+                            void print(ostream &out) const;
+
+                            // Pack state into a sequence of words
+                            void pack(vector<SDFstateWord> &s) const;
 
                             // State information
-                            vector< list<SDFtime> > actClk;
-                            vector< TBufSize > ch;
-                            unsigned long glbClk;
-                            vector< uint > schedulePos;
+                            vector< StaticOrderSchedulePosition > schedulePos;
                             vector< SDFtime > tdmaPos;
                     };
 
-                    // Sequence of states in transition system
-                    typedef list<State>      States;
-                    typedef States::iterator StatesIter;
-
                     // Constructor
                     TransitionSystem(BindingAwareSDFG *bg)
+                        : g(bg)
                     {
                         bindingAwareSDFG = bg;
                         checkBindingAwareSDFG();
@@ -142,9 +143,6 @@ namespace SDF
                                         bool *bufferChannels);
 
                 private:
-                    // Store state
-                    bool storeState(State &s, StatesIter &pos);
-
                     // Clear list of stored states
                     void clearStoredStates()
                     {
@@ -156,39 +154,48 @@ namespace SDF
                                               bool **abstractDepGraph, bool *dep);
                     void findStorageDependencies(bool **abstractDepGraph, bool *dep,
                                                  bool *bufferChannels);
-                    void findCausalDependencies(SDFactor *a, bool **abstractDepGraph);
-                    void analyzePeriodicPhase(bool *dep, bool *bufferChannels);
+                    void findCausalDependencies(const CId a, bool **abstractDepGraph);
+                    void analyzePeriodicPhase(bool *dep, bool *bufferChannels,
+                                              const vector<CId> &endingActors);
                     void analyzeDeadlock(bool *dep, bool *bufferChannels);
 
                     // Compute throughput from transition system
-                    TDtime computeThroughput(const StatesIter cycleIter);
+                    TDtime computeThroughput(const uint cycleIdx);
 
                     // State transitions
-                    bool actorReadyToFire(SDFactor *a);
-                    void startActorFiring(TimedSDFactor *a);
-                    bool actorReadyToEnd(SDFactor *a);
-                    void endActorFiring(SDFactor *a);
+                    bool actorReadyToFire(const CId a);
+                    void startActorFiring(const CId a);
+                    bool actorReadyToEnd(const CId a);
+                    void endActorFiring(const CId a);
                     SDFtime clockStep();
 
+                    // Actors to check for enabling after a firing of a ends
+                    void addCandidates(const CId a, vector<CId> &candidates,
+                                       vector<bool> &isCandidate);
+
                     // Output actor
                     void initOutputActor();
 
                     // Sanity checks on the binding-aware SDFG
                     void checkBindingAwareSDFG();
 
-                    // Binding-aware SDFG
+                    // Binding-aware SDFG and its compiled view
                     BindingAwareSDFG *bindingAwareSDFG;
+                    TimedSDFcompiledGraph g;
+
+                    // Tile to which every actor is bound (indexed on id)
+                    vector<CId> actorTile;
 
-                    // SDF graph and output actor
-                    SDFactor *outputActor;
+                    // Output actor
+                    CId outputActor;
                     TCnt outputActorRepCnt;
 
                     // Current and previous state
                     State currentState;
                     State previousState;
 
-                    // List of visited states that are stored
-                    States storedStates;
+                    // Visited states that are stored
+                    SDFvisitedStates<State> storedStates;
             };
 
             // Bounds on the search space
@@ -14,6 +14,10 @@
  *      05-04-06    :   Initial version.
  *      27-10-06    :   BFS based version of the trade-off space exploration
  *                      algorithm.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
+ *      17-10-26    :   Parallel exploration of distribution sets.
+ *      17-10-26    :   Only visit actors whose firing ends or which may have
+ *                      become enabled.
  *
  * $Id: buffer.cc,v 1.1.2.1 2010-04-22 07:18:38 mgeilen Exp $
  *
@@ -140,83 +144,66 @@ namespace SDF
      *****************************************************************************/
 
     /**
-     * printState ()
-     * Print the state to the supplied stream.
+     * operator== ()
+     * The function compares to states and returns true if they are equal.
      */
-    void SDFstateSpaceBufferAnalysis::TransitionSystem::State::print(
-        ostream &out)
+    bool SDFstateSpaceBufferAnalysis::TransitionSystem::State
+    ::operator==(const State &s) const
     {
-        out << "### State ###" << endl;
+        if (!SDFstateSpaceState::operator==(s))
+            return false;
 
-        for (uint i = 0; i < actClk.size(); i++)
+        for (uint i = 0; i < sp.size(); i++)
         {
-            out << "actClk[" << i << "] =";
-
-            for (list<SDFtime>::const_iterator iter = actClk[i].begin();
-                 iter != actClk[i].end(); iter++)
-            {
-                out << " " << (*iter) << ", ";
-            }
-
-            out << endl;
+            if (sp[i] != s.sp[i])
+                return false;
         }
 
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            out << "ch[" << i << "] = " << ch[i] << endl;
-        }
+        return true;
+    }
+
+    /**
+     * print ()
+     * Print the state to the supplied stream.
+     */
+    void SDFstateSpaceBufferAnalysis::TransitionSystem::State
+    ::print(ostream &out) const
+    {
+        SDFstateSpaceState::print(out);
 
         for (uint i = 0; i < sp.size(); i++)
         {
-            out << "sp[" << i << "] = " << ch[i] << endl;
+            out << "sp[" << i << "] = " << sp[i] << endl;
         }
-
-        out << "glbClk = " << glbClk << endl;
     }
 
     /**
-     * clearState ()
+     * clear ()
      * The function sets the state to zero.
      */
-    void SDFstateSpaceBufferAnalysis::TransitionSystem::State::clear()
+    void SDFstateSpaceBufferAnalysis::TransitionSystem::State
+    ::clear()
     {
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            actClk[i].clear();
-        }
+        SDFstateSpaceState::clear();
 
-        for (uint i = 0; i < ch.size(); i++)
+        for (uint i = 0; i < sp.size(); i++)
         {
-            ch[i] = 0;
             sp[i] = 0;
         }
-
-        glbClk = 0;
     }
 
     /**
-     * operator== ()
-     * The function compares to states and returns true if they are equal.
+     * pack ()
+     * The function packs the state into a sequence of words. The shared part
+     * of the state is followed by the storage space.
      */
-    bool SDFstateSpaceBufferAnalysis::TransitionSystem::State::operator==(
-        const State &s)
+    void SDFstateSpaceBufferAnalysis::TransitionSystem::State
+    ::pack(vector<SDFstateWord> &s) const
     {
-        if (glbClk != s.glbClk)
-            return false;
-
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            if (ch[i] != s.ch[i] || sp[i] != s.sp[i])
-                return false;
-        }
-
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            if (actClk[i] != s.actClk[i])
-                return false;
-        }
+        SDFstateSpaceState::pack(s);
 
-        return true;
+        for (uint i = 0; i < sp.size(); i++)
+            s.push_back(sp[i]);
     }
 
     /******************************************************************************
@@ -230,60 +217,21 @@ namespace SDF
      */
     void SDFstateSpaceBufferAnalysis::TransitionSystem::initOutputActor()
     {
-        RepetitionVector repVec;
+        const RepetitionVector &repVec = cg.getRepetitionVector();
         int min = INT_MAX;
-        SDFactor *a = NULL;
-
-        // Compute repetition vector
-        repVec = computeRepetitionVector(g);
 
         // Select actor with lowest entry in repetition vector as output actor
-        for (SDFactorsIter iter = g->actorsBegin(); iter != g->actorsEnd(); iter++)
-        {
-            if (repVec[(*iter)->getId()] < min)
-            {
-                a = *iter;
-                min = repVec[a->getId()];
-            }
-        }
-
-        // Set output actor and its repetition vector count
-        outputActor = a;
-        outputActorRepCnt = repVec[outputActor->getId()];
-    }
-
-    /**
-     * storeState ()
-     * The function stores the state s on whenever s is not already in the
-     * list of storedStates. When s is stored, the function returns true. When the
-     * state s is already in the list, the state s is not stored. The function
-     * returns false. The function always sets the pos variable to the position
-     * where the state s is in the list.
-     */
-    bool SDFstateSpaceBufferAnalysis::TransitionSystem::storeState(State &s,
-            StatesIter &pos)
-    {
-        // Find state in the list of stored states
-        for (StatesIter iter = storedStates.begin();
-             iter != storedStates.end(); iter++)
+        for (CId a = 0; a < cg.nrActors(); a++)
         {
-            State &x = *iter;
-
-            // State s at position iter in the list?
-            if (x == s)
+            if (repVec[a] < min)
             {
-                pos = iter;
-                return false;
+                outputActor = a;
+                min = repVec[a];
             }
         }
 
-        // State not found, store it at the end of the list
-        storedStates.push_back(s);
-
-        // Added state to the end of the list
-        pos = storedStates.end();
-
-        return true;
+        // Set output actor repetition vector count
+        outputActorRepCnt = repVec[outputActor];
     }
 
     /**
@@ -292,22 +240,20 @@ namespace SDF
      * value is equal to the average number of firings of an actor per time unit.
      */
     TDtime SDFstateSpaceBufferAnalysis::TransitionSystem::computeThroughput(
-        const StatesIter cycleIter)
+        const uint cycleIdx)
     {
         int nr_fire = 0;
         TDtime time = 0;
 
         // Check all state from stack till cycle complete
-        for (StatesIter iter = cycleIter; iter != storedStates.end(); iter++)
+        for (uint i = cycleIdx; i < storedStates.size(); i++)
         {
-            State &s = *iter;
-
             // Number of states in cycle is equal to number of iterations
             // in the period
             nr_fire++;
 
             // Time between previous state
-            time += s.glbClk;
+            time += storedStates.glbClk(i);
         }
 
         return (TDtime)(nr_fire) / (time);
@@ -347,15 +293,13 @@ namespace SDF
                     {
                         // All channels from d to c in the SDFG have
                         // storage dependency
-                        for (SDFchannelsIter iter = g->channelsBegin();
-                             iter != g->channelsEnd(); iter++)
+                        for (CId ch = 0; ch < cg.nrChannels(); ch++)
                         {
-                            SDFchannel *ch = *iter;
-                            CId srcId = ch->getSrcActor()->getId();
-                            CId dstId = ch->getDstActor()->getId();
-
-                            if (dstId == d && srcId == c)
-                                dep[ch->getId()] = true;
+                            if (cg.getDstActor(ch) == d
+                                && cg.getSrcActor(ch) == c)
+                            {
+                                dep[ch] = true;
+                            }
                         }
 
                         // Next
@@ -440,29 +384,22 @@ namespace SDF
      * s. Else it returns false.
      */
     bool SDFstateSpaceBufferAnalysis::TransitionSystem::actorReadyToFire(
-        SDFactor *a)
+        const CId a)
     {
         // Check all input ports for tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = cg.inPortsBegin(a);
+             p != cg.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
+            if (!CH_TOKENS(p->channel, p->rate))
+                return false;
+        }
 
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                if (!CH_TOKENS(c->getId(), p->getRate()))
-                {
-                    return false;
-                }
-            }
-            else
-            {
-                if (!CH_SPACE(c->getId(), p->getRate()))
-                {
-                    return false;
-                }
-            }
+        // Check all output ports for space
+        for (const TimedSDFcompiledGraph::Port *p = cg.outPortsBegin(a);
+             p != cg.outPortsEnd(a); p++)
+        {
+            if (!CH_SPACE(p->channel, p->rate))
+                return false;
         }
 
         return true;
@@ -475,27 +412,22 @@ namespace SDF
      * position.
      */
     void SDFstateSpaceBufferAnalysis::TransitionSystem::startActorFiring(
-        TimedSDFactor *a)
+        const CId a)
     {
         // Consume tokens from inputs and space for output tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = cg.inPortsBegin(a);
+             p != cg.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                CONSUME(c->getId(), p->getRate());
-            }
-            else
-            {
-                CONSUME_SP(c->getId(), p->getRate());
-            }
+            CONSUME(p->channel, p->rate);
+        }
+        for (const TimedSDFcompiledGraph::Port *p = cg.outPortsBegin(a);
+             p != cg.outPortsEnd(a); p++)
+        {
+            CONSUME_SP(p->channel, p->rate);
         }
 
         // Add actor firing to the list of active firings of this actor
-        currentState.actClk[a->getId()].push_back(a->getExecutionTime());
+        currentState.startFiring(a, cg.getExecutionTime(a));
     }
 
     /**
@@ -503,16 +435,11 @@ namespace SDF
      * The function returns true when the actor is ready to end its firing. Else
      * the function returns false.
      */
-    bool SDFstateSpaceBufferAnalysis::TransitionSystem::actorReadyToEnd(SDFactor *a)
+    bool SDFstateSpaceBufferAnalysis::TransitionSystem::actorReadyToEnd(
+        const CId a)
     {
-        if (currentState.actClk[a->getId()].empty())
-            return false;
-
-        // First actor firing in sorted list has execution time left?
-        if (currentState.actClk[a->getId()].front() != 0)
-            return false;
-
-        return true;
+        // First actor firing in sorted list has no execution time left?
+        return currentState.readyToEnd(a);
     }
 
     /**
@@ -520,26 +447,23 @@ namespace SDF
      * Produce tokens on all output channels and remove the actor firing from the
      * list of active firings.
      */
-    void SDFstateSpaceBufferAnalysis::TransitionSystem::endActorFiring(SDFactor *a)
+    void SDFstateSpaceBufferAnalysis::TransitionSystem::endActorFiring(
+        const CId a)
     {
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        // Produce tokens on outputs and release space of consumed tokens
+        for (const TimedSDFcompiledGraph::Port *p = cg.outPortsBegin(a);
+             p != cg.outPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is source of the channel?
-            if (p->getType() == SDFport::Out)
-            {
-                PRODUCE(c->getId(), p->getRate());
-            }
-            else
-            {
-                PRODUCE_SP(c->getId(), p->getRate());
-            }
+            PRODUCE(p->channel, p->rate);
+        }
+        for (const TimedSDFcompiledGraph::Port *p = cg.inPortsBegin(a);
+             p != cg.inPortsEnd(a); p++)
+        {
+            PRODUCE_SP(p->channel, p->rate);
         }
 
         // Remove the firing from the list of active actor firings
-        currentState.actClk[a->getId()].pop_front();
+        currentState.endFiring(a);
     }
 
     /**
@@ -550,45 +474,41 @@ namespace SDF
      */
     SDFtime SDFstateSpaceBufferAnalysis::TransitionSystem::clockStep()
     {
-        SDFtime step = UINT_MAX;
+        SDFtime step;
+
+        // Progress time till the first firing ends
+        step = currentState.clockStep();
+
+        return step;
+    }
 
-        // Find maximal time progress
-        for (uint a = 0; a < g->nrActors(); a++)
+    /**
+     * addCandidates ()
+     * The end of a firing of actor a produces tokens for the consumers of its
+     * output channels and releases space for the producers of its input
+     * channels. These actors are added to the candidates that must be checked
+     * for enabling. No other actor can become enabled by this transition.
+     */
+    void SDFstateSpaceBufferAnalysis::TransitionSystem::addCandidates(
+        const CId a, vector<CId> &candidates, vector<bool> &isCandidate)
+    {
+        for (const CId *b = cg.consumersBegin(a); b != cg.consumersEnd(a); b++)
         {
-            if (!currentState.actClk[a].empty())
+            if (!isCandidate[*b])
             {
-                SDFtime actClk = currentState.actClk[a].front();
-
-                if (step > actClk)
-                    step = actClk;
+                isCandidate[*b] = true;
+                candidates.push_back(*b);
             }
         }
 
-        // Still actors ready to end their firing?
-        if (step == 0)
-            return 0;
-
-        // Check for progress (i.e. no deadlock)
-        if (step == UINT_MAX)
-            return UINT_MAX;
-
-        // Lower remaining execution time actors
-        for (uint a = 0; a < g->nrActors(); a++)
+        for (const CId *b = cg.producersBegin(a); b != cg.producersEnd(a); b++)
         {
-            for (list<SDFtime>::iterator iter = currentState.actClk[a].begin();
-                 iter != currentState.actClk[a].end(); iter++)
+            if (!isCandidate[*b])
             {
-                SDFtime &actFiringTime = *iter;
-
-                // Lower remaining execution time of the actor firing
-                actFiringTime -= step;
+                isCandidate[*b] = true;
+                candidates.push_back(*b);
             }
         }
-
-        // Advance the global clock
-        currentState.glbClk += step;
-
-        return step;
     }
 
     /**
@@ -598,48 +518,43 @@ namespace SDF
      * graph.
      */
     void SDFstateSpaceBufferAnalysis::TransitionSystem::findCausalDependencies(
-        SDFactor *a, bool **abstractDepGraph)
+        const CId a, bool **abstractDepGraph)
     {
-        // Check all input ports for tokens and output ports for space
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        // Check all input ports for tokens
+        for (const TimedSDFcompiledGraph::Port *p = cg.inPortsBegin(a);
+             p != cg.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-            SDFactor *srcActor = c->getSrcActor();
-            SDFactor *dstActor = c->getDstActor();
-
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                // Not enough tokens in the previous state?
-                if (!CH_TOKENS_PREV(c->getId(), p->getRate()))
-                {
-                    abstractDepGraph[dstActor->getId()][srcActor->getId()] = true;
-                }
-            }
-            else
-            {
-                // Not enough space in the previous state?
-                if (!CH_SPACE_PREV(c->getId(), p->getRate()))
-                {
-                    abstractDepGraph[srcActor->getId()][dstActor->getId()] = true;
-                }
-            }
+            // Not enough tokens in the previous state?
+            if (!CH_TOKENS_PREV(p->channel, p->rate))
+                abstractDepGraph[a][cg.getSrcActor(p->channel)] = true;
+        }
 
+        // Check all output ports for space
+        for (const TimedSDFcompiledGraph::Port *p = cg.outPortsBegin(a);
+             p != cg.outPortsEnd(a); p++)
+        {
+            // Not enough space in the previous state?
+            if (!CH_SPACE_PREV(p->channel, p->rate))
+                abstractDepGraph[a][cg.getDstActor(p->channel)] = true;
         }
     }
 
     /**
      * analyzePeriodicPhase ()
      * Analyze the periodic phase of the schedule to find all blocked channels. This
-     * is done using the abstract dependency graph.
+     * is done using the abstract dependency graph. The periodic phase starts
+     * while ending the firings at the current time; endingActors contains the
+     * actors whose firings must still be ended.
      */
     void SDFstateSpaceBufferAnalysis::TransitionSystem::analyzePeriodicPhase(
-        const TBufSize *sp, bool *dep)
+        const TBufSize *sp, bool *dep, const vector<CId> &endingActors)
     {
         bool **abstractDepGraph;
         State periodicState(g->nrActors(), g->nrChannels());
         int repCnt;
+        vector<CId> ending;
+        vector<CId> candidates;
+        vector<bool> isCandidate(cg.nrActors(), true);
 
         // Current state is a periodic state
         periodicState = currentState;
@@ -661,13 +576,13 @@ namespace SDF
         repCnt = -1;
 
         // Complete the remaining actor firings
-        for (SDFactorsIter iter = g->actorsBegin(); iter != g->actorsEnd(); iter++)
+        for (uint i = 0; i < endingActors.size(); i++)
         {
-            SDFactor *a = *iter;
+            CId a = endingActors[i];
 
             while (actorReadyToEnd(a))
             {
-                if (a->getId() == outputActor->getId())
+                if (a == outputActor)
                 {
                     repCnt++;
                     if (repCnt == outputActorRepCnt)
@@ -681,14 +596,17 @@ namespace SDF
             }
         }
 
+        // Initially all actors may be enabled
+        for (CId a = 0; a < cg.nrActors(); a++)
+            candidates.push_back(a);
+
         // Fire the actors
         while (true)
         {
             // Start actor firings
-            for (SDFactorsIter iter = g->actorsBegin();
-                 iter != g->actorsEnd(); iter++)
+            for (uint i = 0; i < candidates.size(); i++)
             {
-                TimedSDFactor *a = (TimedSDFactor *)(*iter);
+                CId a = candidates[i];
 
                 // Ready to fire actor a?
                 while (actorReadyToFire(a))
@@ -699,7 +617,10 @@ namespace SDF
                     // Fire actor a
                     startActorFiring(a);
                 }
+
+                isCandidate[a] = false;
             }
+            candidates.clear();
 
             // Clock step
             clockStep();
@@ -712,14 +633,14 @@ namespace SDF
             }
 
             // Finish actor firings
-            for (SDFactorsIter iter = g->actorsBegin();
-                 iter != g->actorsEnd(); iter++)
+            currentState.actorsReadyToEnd(ending);
+            for (uint i = 0; i < ending.size(); i++)
             {
-                SDFactor *a = *iter;
+                CId a = ending[i];
 
                 while (actorReadyToEnd(a))
                 {
-                    if (outputActor->getId() == a->getId())
+                    if (outputActor == a)
                     {
                         repCnt++;
                         if (repCnt == outputActorRepCnt)
@@ -747,6 +668,8 @@ namespace SDF
                     // End the actor firing
                     endActorFiring(a);
                 }
+
+                addCandidates(a, candidates, isCandidate);
             }
         }
     }
@@ -770,24 +693,18 @@ namespace SDF
         }
 
         // Check number of tokens on every channel in the graph
-        for (SDFchannelsIter iter = g->channelsBegin();
-             iter != g->channelsEnd(); iter++)
+        for (CId c = 0; c < cg.nrChannels(); c++)
         {
-            SDFchannel *c = *iter;
-            SDFactor *srcActor = c->getSrcActor();
-            SDFactor *dstActor = c->getDstActor();
+            CId srcActor = cg.getSrcActor(c);
+            CId dstActor = cg.getDstActor(c);
 
             // Insufficient tokens to fire destination actor
-            if (!CH_TOKENS(c->getId(), c->getDstPort()->getRate()))
-            {
-                abstractDepGraph[dstActor->getId()][srcActor->getId()] = true;
-            }
+            if (!CH_TOKENS(c, cg.getDstRate(c)))
+                abstractDepGraph[dstActor][srcActor] = true;
 
             // Insufficient space to fire source actor
-            if (!CH_SPACE(c->getId(), c->getSrcPort()->getRate()))
-            {
-                abstractDepGraph[srcActor->getId()][dstActor->getId()] = true;
-            }
+            if (!CH_SPACE(c, cg.getSrcRate(c)))
+                abstractDepGraph[srcActor][dstActor] = true;
         }
 
         // Cycles in the dependency graph indicate storage dependencies
@@ -802,14 +719,19 @@ namespace SDF
     /**
      * execSDFgraph()
      * Execute the SDF graph till a deadlock is found or a recurrent state.
-     * The throughput is returned.
+     * The throughput is returned. Only the actors whose firing ends at the
+     * current time are visited to end their firings and only the actors
+     * affected by these transitions are checked for enabling.
      */
     TDtime SDFstateSpaceBufferAnalysis::TransitionSystem::execSDFgraph(
         const TBufSize *sp, bool *dep)
     {
-        StatesIter recurrentState;
+        uint recurrentState;
         TTime clkStep;
         int repCnt = 0;
+        vector<CId> endingActors;
+        vector<CId> candidates;
+        vector<bool> isCandidate(cg.nrActors(), true);
 
         // Clear the list of stored states
         clearStoredStates();
@@ -821,22 +743,23 @@ namespace SDF
         previousState.clear();
 
         // Initial tokens and space
-        for (SDFchannelsIter iter = g->channelsBegin();
-             iter != g->channelsEnd(); iter++)
+        for (CId c = 0; c < cg.nrChannels(); c++)
         {
-            SDFchannel *c = *iter;
-
             // Not enough space for initial tokens?
-            if (sp[c->getId()] < c->getInitialTokens())
+            if (sp[c] < cg.getInitialTokens(c))
             {
-                dep[c->getId()] = true;
+                dep[c] = true;
                 return 0;
             }
 
-            CH(c->getId()) = c->getInitialTokens();
-            SP(c->getId()) = sp[c->getId()] - c->getInitialTokens();
+            CH(c) = cg.getInitialTokens(c);
+            SP(c) = sp[c] - cg.getInitialTokens(c);
         }
 
+        // Initially all actors may be enabled
+        for (CId a = 0; a < cg.nrActors(); a++)
+            candidates.push_back(a);
+
         // Fire the actors
         while (true)
         {
@@ -848,23 +771,25 @@ namespace SDF
             }
 
             // Finish actor firings
-            for (SDFactorsIter iter = g->actorsBegin();
-                 iter != g->actorsEnd(); iter++)
+            currentState.actorsReadyToEnd(endingActors);
+            for (uint i = 0; i < endingActors.size(); i++)
             {
-                SDFactor *a = *iter;
+                CId a = endingActors[i];
 
                 while (actorReadyToEnd(a))
                 {
-                    if (outputActor->getId() == a->getId())
+                    if (outputActor == a)
                     {
                         repCnt++;
                         if (repCnt == outputActorRepCnt)
                         {
                             // Add state to hash of visited states
-                            if (!storeState(currentState, recurrentState))
+                            if (!storedStates.store(currentState, recurrentState))
                             {
                                 // Find storage dependencies in periodic phase
-                                analyzePeriodicPhase(sp, dep);
+                                endingActors.erase(endingActors.begin(),
+                                                   endingActors.begin() + i);
+                                analyzePeriodicPhase(sp, dep, endingActors);
 
                                 return computeThroughput(recurrentState);
                             }
@@ -876,13 +801,14 @@ namespace SDF
                     // End the actor firing
                     endActorFiring(a);
                 }
+
+                addCandidates(a, candidates, isCandidate);
             }
 
             // Start actor firings
-            for (SDFactorsIter iter = g->actorsBegin();
-                 iter != g->actorsEnd(); iter++)
+            for (uint i = 0; i < candidates.size(); i++)
             {
-                TimedSDFactor *a = (TimedSDFactor *)(*iter);
+                CId a = candidates[i];
 
                 // Ready to fire actor a?
                 while (actorReadyToFire(a))
@@ -890,7 +816,10 @@ namespace SDF
                     // Fire actor a
                     startActorFiring(a);
                 }
+
+                isCandidate[a] = false;
             }
+            candidates.clear();
 
             // Clock step
             clkStep = clockStep();
@@ -933,25 +862,88 @@ namespace SDF
     void SDFstateSpaceBufferAnalysis::deleteStorageDistribution(
         StorageDistribution *d)
     {
+        // Distributions rejected as duplicate are not in the checklist
+        DistributionChecklist::iterator iter = checklist.find(d);
+        if (iter != checklist.end() && *iter == d)
+            checklist.erase(iter);
+
         delete [] d->sp;
         delete [] d->dep;
         delete d;
     }
 
+    /**
+     * StorageDistributionHash ()
+     * Hash of the storage space of all channels in a distribution.
+     */
+    size_t StorageDistributionHash::operator()(
+        const StorageDistribution *d) const
+    {
+        size_t h = 14695981039346656037ULL;
+
+        for (uint c = 0; c < nrChannels; c++)
+        {
+            h ^= (size_t)d->sp[c];
+            h *= 1099511628211ULL;
+        }
+
+        return h;
+    }
+
+    /**
+     * StorageDistributionEqual ()
+     * Two distributions are equal when all channels have the same storage
+     * space.
+     */
+    bool StorageDistributionEqual::operator()(
+        const StorageDistribution *d1, const StorageDistribution *d2) const
+    {
+        for (uint c = 0; c < nrChannels; c++)
+        {
+            if (d1->sp[c] != d2->sp[c])
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * initChecklist ()
+     * Start with an empty checklist for distributions of the graph.
+     */
+    void SDFstateSpaceBufferAnalysis::initChecklist()
+    {
+        uint n = g->nrChannels();
+
+        checklist = DistributionChecklist(64, StorageDistributionHash(n),
+                                          StorageDistributionEqual(n));
+    }
+
+    /**
+     * deleteTransitionSystems ()
+     * Deallocate the transition systems of all threads.
+     */
+    void SDFstateSpaceBufferAnalysis::deleteTransitionSystems()
+    {
+        for (uint t = 0; t < transitionSystems.size(); t++)
+            delete transitionSystems[t];
+        transitionSystems.clear();
+    }
+
     /**
      * execStorageDistribution ()
      * Compute throughput and storage dependencies of the given storage
-     * distribution.
+     * distribution using the transition system ts.
      */
     void SDFstateSpaceBufferAnalysis::execStorageDistribution(
-        StorageDistribution *d)
+        TransitionSystem *ts, StorageDistribution *d)
     {
         // Initialize blocking channels
         for (uint c = 0; c < g->nrChannels(); c++)
             d->dep[c] = false;
 
         // Execute the SDF graph to find its output interval
-        d->thr = transitionSystem->execSDFgraph(d->sp, d->dep);
+        d->thr = ts->execSDFgraph(d->sp, d->dep);
 
         //cerr << d->sz << " " << d->thr << endl;
         //for (uint c = 0; c < g->nrChannels(); c++)
@@ -959,6 +951,27 @@ namespace SDF
         //cerr << endl;
     }
 
+    /**
+     * execStorageDistributions ()
+     * Compute throughput and storage dependencies of all given distributions.
+     * The distributions are distributed over a pool of threads which each
+     * own a transition system. The calling thread is part of the pool.
+     */
+    void SDFstateSpaceBufferAnalysis::execStorageDistributions(
+        const vector<StorageDistribution *> &distributions)
+    {
+        uint n = CNrWorkers(distributions.size(), nrThreads);
+
+        // Transition systems are kept for the next sets
+        while (transitionSystems.size() < n)
+            transitionSystems.push_back(new TransitionSystem(g));
+
+        CParallelFor(distributions.size(), n, [&](uint i, uint t)
+        {
+            execStorageDistribution(transitionSystems[t], distributions[i]);
+        });
+    }
+
     /**
      * minimizeMinStorageDistributions ()
      * The function removes all storage distributions within the supplied
@@ -1041,8 +1054,10 @@ namespace SDF
         StorageDistribution *d)
     {
         StorageDistributionSet *ds, *dsNew;
-        StorageDistribution *di;
-        bool equalDistr;
+
+        // Distribution already in the checklist?
+        if (!checklist.insert(d).second)
+            return false;
 
         // First distribution ever added?
         if (minStorageDistributions == NULL)
@@ -1074,29 +1089,7 @@ namespace SDF
         // Set of storage distribution with same size as d exists?
         if (ds->sz == d->sz)
         {
-
-            // Check that distribution d does not exist in the set
-            di = ds->distributions;
-            while (di != NULL)
-            {
-                equalDistr = true;
-
-                // All channels have same storage space allocation?
-                for (uint c = 0; equalDistr && c < g->nrChannels(); c++)
-                {
-                    if (di->sp[c] != d->sp[c])
-                        equalDistr = false;
-                }
-
-                // Found equal distribution
-                if (equalDistr)
-                    return false;
-
-                // Next
-                di = di->next;
-            }
-
-            // Distribution 'd' not yet in the set, so let's add it
+            // Add d to the set
             ds->distributions->prev = d;
             d->next = ds->distributions;
             ds->distributions = d;
@@ -1142,20 +1135,16 @@ namespace SDF
 
     /**
      * exploreStorageDistribution ()
-     * The function computes the throughput of the storage distribution
-     * 'd' and adds new storage distributions to the list of distributions
-     * which must be checked based on the storage dependencies found in d.
-     * The function also updates the maximal throughput of the set of
-     * storage distributions when needed.
+     * The function adds new storage distributions to the list of distributions
+     * which must be checked based on the storage dependencies found in the
+     * (executed) distribution d. The function also updates the maximal
+     * throughput of the set of storage distributions when needed.
      */
     void SDFstateSpaceBufferAnalysis::exploreStorageDistribution(
         StorageDistributionSet *ds, StorageDistribution *d)
     {
         StorageDistribution *dNew;
 
-        // Compute throughput and storage dependencies
-        execStorageDistribution(d);
-
         // Throughput of d larger then current maximum of the set
         if (d->thr > ds->thr)
             ds->thr = d->thr;
@@ -1203,18 +1192,16 @@ namespace SDF
     void SDFstateSpaceBufferAnalysis::exploreStorageDistributionSet(
         StorageDistributionSet *ds)
     {
-        StorageDistribution *d;
+        vector<StorageDistribution *> distributions;
 
-        // Explore all storage distributions contained in the set
-        d = ds->distributions;
-        while (d != NULL)
-        {
-            // Explore distribution d
-            exploreStorageDistribution(ds, d);
+        // Execute all storage distributions contained in the set
+        for (StorageDistribution *d = ds->distributions; d != NULL; d = d->next)
+            distributions.push_back(d);
+        execStorageDistributions(distributions);
 
-            // Next
-            d = d->next;
-        }
+        // Explore the distributions in the order of the set
+        for (uint i = 0; i < distributions.size(); i++)
+            exploreStorageDistribution(ds, distributions[i]);
 
         // Remove all non-minimal storage distributions from the set
         minimizeStorageDistributionsSet(ds);
@@ -1327,6 +1314,7 @@ namespace SDF
         // is the actual minimal storage distribution for this throughput
         if (minStorageDistributions->thr == 0)
         {
+            checklist.erase(minStorageDistributions->distributions);
             minStorageDistributions->sz = 0;
             minStorageDistributions->distributions->sz = 0;
             for (uint c = 0; c < g->nrChannels(); c++)
@@ -1354,7 +1342,9 @@ namespace SDF
         initBoundsSearchSpace(g);
 
         // Create a transition system
-        transitionSystem = new TransitionSystem(g);
+        deleteTransitionSystems();
+        transitionSystems.push_back(new TransitionSystem(g));
+        initChecklist();
 
         // Search the space
         findMinimalStorageDistributions(thrBound);
@@ -1362,7 +1352,8 @@ namespace SDF
         // Cleanup
         delete [] minSz;
         delete [] minSzStep;
-        delete transitionSystem;
+        deleteTransitionSystems();
+        checklist.clear();
 
         return minStorageDistributions;
     }
@@ -1385,7 +1376,9 @@ namespace SDF
         initBoundsSearchSpace(g);
 
         // Create a transition system
-        transitionSystem = new TransitionSystem(g);
+        deleteTransitionSystems();
+        transitionSystems.push_back(new TransitionSystem(g));
+        initChecklist();
 
         // Construct storage distribution with lower bound storage space
         d = newStorageDistribution();
@@ -1503,6 +1496,7 @@ namespace SDF
         // is the actual minimal storage distribution for this throughput
         if (minStorageDistributions->thr == 0)
         {
+            checklist.erase(minStorageDistributions->distributions);
             minStorageDistributions->sz = 0;
             minStorageDistributions->distributions->sz = 0;
             for (uint c = 0; c < g->nrChannels(); c++)
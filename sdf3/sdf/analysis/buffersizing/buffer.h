@@ -14,6 +14,10 @@
  *      05-04-06    :   Initial version.
  *      27-10-06    :   BFS based version of the trade-off space exploration
  *                      algorithm.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
+ *      17-10-26    :   Parallel exploration of distribution sets.
+ *      17-10-26    :   Only visit actors whose firing ends or which may have
+ *                      become enabled.
  *
  * $Id: buffer.h,v 1.1 2008-03-06 10:49:42 sander Exp $
  *
@@ -39,21 +43,54 @@
 #define SDF_ANALYSIS_STATESPACE_BUFFER_H_INCLUDED
 
 #include "storage_distribution.h"
-#include "../../base/timed/graph.h"
+#include "../../base/timed/compiled_graph.h"
+#include "../statespace/state.h"
+#include <unordered_set>
 namespace SDF
 {
+    /**
+     * StorageDistributionHash
+     * Hash of the storage space of all channels in a distribution.
+     */
+    struct StorageDistributionHash
+    {
+        StorageDistributionHash() : nrChannels(0) {};
+        StorageDistributionHash(const uint n) : nrChannels(n) {};
+        size_t operator()(const StorageDistribution *d) const;
+        uint nrChannels;
+    };
+
+    /**
+     * StorageDistributionEqual
+     * Two distributions are equal when all channels have the same storage
+     * space.
+     */
+    struct StorageDistributionEqual
+    {
+        StorageDistributionEqual() : nrChannels(0) {};
+        StorageDistributionEqual(const uint n) : nrChannels(n) {};
+        bool operator()(const StorageDistribution *d1,
+                        const StorageDistribution *d2) const;
+        uint nrChannels;
+    };
+
     /**
      * Throughput / storage-space trade-off exploration
      * Analyze the trade-offs between storage distributions and throughput (using
      * auto-concurrency). The search ends as soon as the throughput bound (thrBound)
      * is reached. To find the complete pareto-space, the throughput bound should
      * be set to DOUBLE_MAX.
+     *
+     * The distributions of one size are independent. They are executed
+     * concurrently by a pool of threads which each own a transition system.
+     * The results are merged in the order of the distributions, so the
+     * explored space does not depend on the number of threads.
      */
     class SDFstateSpaceBufferAnalysis
     {
         public:
             // Constructor
-            SDFstateSpaceBufferAnalysis() {};
+            SDFstateSpaceBufferAnalysis() : nrThreads(0) {};
 
             // Destructor
             ~SDFstateSpaceBufferAnalysis() {};
@@ -66,6 +103,13 @@ namespace SDF
             void initSearch(TimedSDFgraph *gr);
             StorageDistributionSet *findNextStorageDistributionSet();
 
+            // Number of threads used to execute distributions (0 means the
+            // number of hardware threads)
+            void setNrThreads(const uint n)
+            {
+                nrThreads = n;
+            };
+
         private:
 
             /***************************************************************************
@@ -78,7 +122,7 @@ namespace SDF
                     /***********************************************************************
                      * State
                      **********************************************************************/
-                    class State
+                    class State : public SDFstateSpaceState
                     {
                         public:
                             // Constructor
@@ -93,33 +137,29 @@ namespace SDF
                             // Initialize the state
                             void init(const uint nrActors, const uint nrChannels)
                             {
-                                actClk.resize(nrActors);
-                                ch.resize(nrChannels);
+                                SDFstateSpaceState::init(nrActors, nrChannels);
                                 sp.resize(nrChannels);
                             };
 
                             // Compare states
-                            bool operator==(const State &s);
+                            bool operator==(const State &s) const;
 
                             // Clear state
                             void clear();
 
                             // Output state
-                            void print(ostream &out);
+                            void print(ostream &out) const;
+
+                            // Pack state into a sequence of words
+                            void pack(vector<SDFstateWord> &s) const;
 
                             // State information
-                            vector< list<SDFtime> > actClk;
-                            vector< TBufSize > ch;
                             vector< TBufSize > sp;
-                            unsigned long glbClk;
                     };
 
-                    // Sequence of states in transition system
-                    typedef list<State>      States;
-                    typedef States::iterator StatesIter;
-
                     // Constructor
                     TransitionSystem(TimedSDFgraph *gr)
+                        : cg(gr)
                     {
                         g = gr;
                         initOutputActor();
@@ -132,9 +172,6 @@ namespace SDF
                     TDtime execSDFgraph(const TBufSize *sp, bool *dep);
 
                 private:
-                    // Store state
-                    bool storeState(State &s, StatesIter &pos);
-
                     // Clear list of stored states
                     void clearStoredStates()
                     {
@@ -145,34 +182,43 @@ namespace SDF
                     void dfsVisitDependencies(uint a, int *color, int *pi,
                                               bool **abstractDepGraph, bool *dep);
                     void findStorageDependencies(bool **abstractDepGraph, bool *dep);
-                    void findCausalDependencies(SDFactor *a, bool **abstractDepGraph);
-                    void analyzePeriodicPhase(const TBufSize *sp, bool *dep);
+                    void findCausalDependencies(const CId a,
+                                                bool **abstractDepGraph);
+                    void analyzePeriodicPhase(const TBufSize *sp, bool *dep,
+                                              const vector<CId> &endingActors);
                     void analyzeDeadlock(const TBufSize *sp, bool *dep);
 
                     // Compute throughput from transition system
-                    TDtime computeThroughput(const StatesIter cycleIter);
+                    TDtime computeThroughput(const uint cycleIdx);
 
                     // State transitions
-                    bool actorReadyToFire(SDFactor *a);
-                    void startActorFiring(TimedSDFactor *a);
-                    bool actorReadyToEnd(SDFactor *a);
-                    void endActorFiring(SDFactor *a);
+                    bool actorReadyToFire(const CId a);
+                    void startActorFiring(const CId a);
+                    bool actorReadyToEnd(const CId a);
+                    void endActorFiring(const CId a);
                     SDFtime clockStep();
 
+                    // Actors to check for enabling after a firing of a ends
+                    void addCandidates(const CId a, vector<CId> &candidates,
+                                       vector<bool> &isCandidate);
+
                     // Output actor
                     void initOutputActor();
 
-                    // SDF graph and output actor
+                    // SDF graph and its compiled view
                     TimedSDFgraph *g;
-                    SDFactor *outputActor;
+                    TimedSDFcompiledGraph cg;
+
+                    // Output actor
+                    CId outputActor;
                     TCnt outputActorRepCnt;
 
                     // Current and previous state
                     State currentState;
                     State previousState;
 
-                    // List of visited states that are stored
-                    States storedStates;
+                    // Visited states that are stored
+                    SDFvisitedStates<State> storedStates;
             };
 
             // Bounds on the search space
@@ -185,7 +231,10 @@ namespace SDF
             // Storage distributions
             StorageDistribution *newStorageDistribution();
             void deleteStorageDistribution(StorageDistribution *d);
-            void execStorageDistribution(StorageDistribution *d);
+            void execStorageDistribution(TransitionSystem *ts,
+                                         StorageDistribution *d);
+            void execStorageDistributions(
+                const vector<StorageDistribution *> &distributions);
             void minimizeStorageDistributionsSet(StorageDistributionSet *ds);
             bool addStorageDistributionToChecklist(StorageDistribution *d);
             void exploreStorageDistribution(StorageDistributionSet *ds,
@@ -196,8 +245,17 @@ namespace SDF
             // SDF graph
             TimedSDFgraph *g;
 
-            // Transition system
-            TransitionSystem *transitionSystem;
+            // Transition systems (one per thread)
+            vector<TransitionSystem *> transitionSystems;
+            uint nrThreads;
+            void deleteTransitionSystems();
+
+            // Distributions in the checklist, hashed on their content
+            typedef std::unordered_set<StorageDistribution *,
+                    StorageDistributionHash, StorageDistributionEqual>
+                    DistributionChecklist;
+            DistributionChecklist checklist;
+            void initChecklist();
 
             // Storage distributions
             StorageDistributionSet *minStorageDistributions;
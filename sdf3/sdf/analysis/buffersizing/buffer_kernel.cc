@@ -0,0 +1,574 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   buffer_kernel.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Buffer size analysis with a specialized kernel
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *      17-10-26    :   Maximal throughput with a specialized kernel.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "buffer_kernel.h"
+#include "../../base/algo/repetition_vector.h"
+#include "../throughput/selftimed_throughput.h"
+#include "../../output/buffer_throughput/buffy.h"
+#include "../../../base/cache/cache.h"
+#include "../../../base/log/log.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+namespace SDF
+{
+    /**
+     * BuffyKernel
+     * Signature of the entry point of a kernel (see outputSDFasBuffyKernel).
+     */
+    typedef void (*BuffyKernelReport)(void *context, double outputInterval,
+                                      int distributionSz, const int *sz);
+    typedef int (*BuffyKernel)(BuffyKernelReport report, void *context,
+                               const char **errorMsg);
+    typedef int (*BuffyThroughputKernel)(double *outputInterval,
+                                         const char **errorMsg);
+
+    /**
+     * BuffyKernelResult
+     * Storage distribution sets reported by a kernel.
+     */
+    typedef struct _BuffyKernelResult
+    {
+        uint nrChannels;
+        uint outputActorRepCnt;
+        double outputInterval;
+        StorageDistributionSet *first;
+        StorageDistributionSet *last;
+    } BuffyKernelResult;
+
+    /**
+     * reportStorageDistribution ()
+     * Callback of the kernel. Distributions with the same size and output
+     * interval are reported consecutively and form one set.
+     */
+    static
+    void reportStorageDistribution(void *context, double outputInterval,
+                                   int distributionSz, const int *sz)
+    {
+        BuffyKernelResult *r = (BuffyKernelResult *)context;
+        StorageDistribution *d;
+
+        // Start a new set?
+        if (r->last == NULL || r->last->sz != (TBufSize)distributionSz
+            || r->outputInterval != outputInterval)
+        {
+            StorageDistributionSet *ds = new StorageDistributionSet;
+            ds->thr = 1.0 / (outputInterval * r->outputActorRepCnt);
+            ds->sz = distributionSz;
+            ds->distributions = NULL;
+            ds->next = NULL;
+            ds->prev = r->last;
+            if (r->last != NULL)
+                r->last->next = ds;
+            else
+                r->first = ds;
+            r->last = ds;
+            r->outputInterval = outputInterval;
+        }
+
+        // Append the distribution to the set
+        d = new StorageDistribution;
+        d->sp = new TBufSize [r->nrChannels];
+        d->dep = new bool [r->nrChannels];
+        d->sz = distributionSz;
+        d->thr = r->last->thr;
+        for (uint c = 0; c < r->nrChannels; c++)
+        {
+            d->sp[c] = sz[c];
+            d->dep[c] = false;
+        }
+        d->prev = NULL;
+        d->next = r->last->distributions;
+        if (d->next != NULL)
+            d->next->prev = d;
+        r->last->distributions = d;
+    }
+
+    /**
+     * deleteStorageDistributionSets ()
+     * Deallocate a list of storage distribution sets.
+     */
+    static
+    void deleteStorageDistributionSets(StorageDistributionSet *ds)
+    {
+        while (ds != NULL)
+        {
+            StorageDistributionSet *dt = ds->next;
+
+            while (ds->distributions != NULL)
+            {
+                StorageDistribution *d = ds->distributions;
+                ds->distributions = d->next;
+                delete [] d->sp;
+                delete [] d->dep;
+                delete d;
+            }
+            delete ds;
+            ds = dt;
+        }
+    }
+
+    /**
+     * isAutoConcurrencyFree ()
+     * The function returns true when no actor in the graph can fire
+     * concurrently with itself, i.e. every actor has a self-loop whose tokens
+     * allow only one firing at a time. The buffy model executes each actor at
+     * most once at a time, so only then it has the semantics of the generic
+     * exploration (which uses auto-concurrency).
+     */
+    static
+    bool isAutoConcurrencyFree(TimedSDFgraph *g)
+    {
+        vector<bool> selfLoop(g->nrActors(), false);
+
+        for (SDFchannelsIter iter = g->channelsBegin();
+             iter != g->channelsEnd(); iter++)
+        {
+            SDFchannel *c = *iter;
+
+            if (c->getSrcActor() == c->getDstActor()
+                && c->getInitialTokens() < 2 * c->getSrcPort()->getRate())
+            {
+                selfLoop[c->getSrcActor()->getId()] = true;
+            }
+        }
+
+        for (uint a = 0; a < g->nrActors(); a++)
+        {
+            if (!selfLoop[a])
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * isTrusted ()
+     * The function returns true when the file or directory 'name' exists, is
+     * not a symbolic link, is owned by the effective user and cannot be
+     * written by its group or by others. Only such files may be loaded into
+     * the process.
+     */
+    static
+    bool isTrusted(const CString &name, const bool isDir)
+    {
+        struct stat st;
+
+        if (lstat(name.c_str(), &st) != 0)
+            return false;
+        if (isDir ? !S_ISDIR(st.st_mode) : !S_ISREG(st.st_mode))
+            return false;
+        if (st.st_uid != geteuid())
+            return false;
+        if ((st.st_mode & (S_IWGRP | S_IWOTH)) != 0)
+            return false;
+
+        return true;
+    }
+
+    /**
+     * createCacheDir ()
+     * The function creates the directory 'dir' and any missing parents with
+     * mode 0700. It returns true when the directory can be trusted afterwards.
+     */
+    static
+    bool createCacheDir(const CString &dir)
+    {
+        for (CString::size_type pos = dir.find('/', 1);
+             pos != CString::npos; pos = dir.find('/', pos + 1))
+        {
+            mkdir(dir.substr(0, pos).c_str(), 0700);
+        }
+        mkdir(dir.c_str(), 0700);
+
+        return isTrusted(dir, true);
+    }
+
+    /**
+     * runCompiler ()
+     * The function compiles 'src' into the shared object 'obj'. The compiler
+     * is executed without a shell; only the compiler command itself is split
+     * on white space. Its output is written to the file 'log'. The function
+     * returns true when the compiler succeeds.
+     */
+    static
+    bool runCompiler(const CString &compiler, const CString &src,
+                     const CString &obj, const CString &log)
+    {
+        vector<CString> args;
+        vector<char *> argv;
+        int status;
+        pid_t pid;
+
+        std::istringstream cmd(compiler);
+        for (std::string arg; cmd >> arg;)
+            args.push_back(arg);
+        if (args.empty())
+            return false;
+        args.push_back("-O2");
+        args.push_back("-shared");
+        args.push_back("-fPIC");
+        args.push_back("-o");
+        args.push_back(obj);
+        args.push_back(src);
+
+        for (uint i = 0; i < args.size(); i++)
+            argv.push_back(const_cast<char *>(args[i].c_str()));
+        argv.push_back(NULL);
+
+        int fd = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        if (fd < 0)
+            return false;
+
+        pid = fork();
+        if (pid == 0)
+        {
+            dup2(fd, STDOUT_FILENO);
+            dup2(fd, STDERR_FILENO);
+            close(fd);
+            execvp(argv[0], &argv[0]);
+            _exit(127);
+        }
+        close(fd);
+        if (pid < 0)
+            return false;
+
+        while (waitpid(pid, &status, 0) < 0)
+        {
+            if (errno != EINTR)
+                return false;
+        }
+
+        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+
+    /**
+     * SDFbuffyKernelBufferAnalysis ()
+     * Constructor. Kernels are cached in the directory 'cacheDir'.
+     */
+    SDFbuffyKernelBufferAnalysis::SDFbuffyKernelBufferAnalysis(
+        const CString &cacheDir)
+        : cacheDir(cacheDir), stackSz(100000), hashSz(100000),
+          depStackSz(100000), nrThreads(0), specialized(false)
+    {
+        const char *cxx = getenv("CXX");
+
+        compiler = (cxx != NULL && *cxx != '\0') ? CString(cxx) : CString("c++");
+    }
+
+    /**
+     * defaultCacheDir ()
+     * The function returns the per-user kernel cache: $XDG_CACHE_HOME/sdf3
+     * or ~/.cache/sdf3. An empty string is returned when neither variable is
+     * set.
+     */
+    CString SDFbuffyKernelBufferAnalysis::defaultCacheDir()
+    {
+        const char *xdg = getenv("XDG_CACHE_HOME");
+        const char *home = getenv("HOME");
+
+        if (xdg != NULL && *xdg == '/')
+            return CString(xdg) + "/sdf3";
+        if (home != NULL && *home == '/')
+            return CString(home) + "/.cache/sdf3";
+        return "";
+    }
+
+    /**
+     * getOutputActor ()
+     * The function returns the actor with the lowest entry in the repetition
+     * vector (as done by the generic exploration) and sets 'repCnt' to this
+     * entry. It returns NULL when the graph has no actors.
+     */
+    SDFactor *SDFbuffyKernelBufferAnalysis::getOutputActor(TimedSDFgraph *g,
+            uint &repCnt)
+    {
+        RepetitionVector repVec = computeRepetitionVector(g);
+        SDFactor *outputActor = NULL;
+        int min = INT_MAX;
+
+        for (SDFactorsIter iter = g->actorsBegin(); iter != g->actorsEnd();
+             iter++)
+        {
+            if (repVec[(*iter)->getId()] < min)
+            {
+                outputActor = *iter;
+                min = repVec[(*iter)->getId()];
+            }
+        }
+
+        repCnt = min;
+        return outputActor;
+    }
+
+    /**
+     * getKernel ()
+     * The function returns the name of the shared object that contains the
+     * kernel with the generated model 'src'. A kernel that is not in the cache
+     * is compiled. The cache directory and the kernel must be owned by the
+     * effective user and may not be writable by others. The function returns
+     * an empty string when no trusted kernel is available.
+     */
+    CString SDFbuffyKernelBufferAnalysis::getKernel(const CString &src)
+    {
+        char hex[17];
+
+        if (cacheDir.empty() || !createCacheDir(cacheDir))
+        {
+            logWarning("Kernel cache '" + cacheDir + "' cannot be trusted.");
+            return "";
+        }
+
+        // The hash of the model identifies the structure of the graph
+        CHash key = CHashContent(src.data(), src.size());
+        CString cmd = compiler + " -O2 -shared -fPIC";
+        key = CHashContent(cmd.data(), cmd.size(), key);
+        snprintf(hex, sizeof(hex), "%016llx", key);
+
+        // Kernel in the cache?
+        CString name = cacheDir + "/buffy-" + CString(hex) + ".so";
+        struct stat st;
+        if (lstat(name.c_str(), &st) == 0)
+        {
+            if (isTrusted(name, false))
+                return name;
+            logWarning("Kernel '" + name + "' cannot be trusted.");
+            return "";
+        }
+
+        // Compile the model next to the cache entry, then move it into place
+        // so concurrent processes never load a partial kernel
+        CString tmpName = name + "." + CString(getpid());
+        ofstream srcFile((tmpName + ".cc").c_str());
+        srcFile << src;
+        srcFile.close();
+        if (!srcFile)
+        {
+            logWarning("Cannot write kernel source '" + tmpName + ".cc'.");
+            return "";
+        }
+
+        bool ok = runCompiler(compiler, tmpName + ".cc", tmpName + ".so",
+                              tmpName + ".log")
+                  && rename((tmpName + ".so").c_str(), name.c_str()) == 0;
+
+        remove((tmpName + ".cc").c_str());
+        remove((tmpName + ".log").c_str());
+        if (!ok)
+        {
+            remove((tmpName + ".so").c_str());
+            logWarning("Cannot compile kernel with '" + compiler + "'.");
+            return "";
+        }
+
+        return name;
+    }
+
+    /**
+     * runKernel ()
+     * The function loads the kernel and explores the trade-off space with it.
+     * It returns false when the kernel cannot be loaded or fails.
+     */
+    bool SDFbuffyKernelBufferAnalysis::runKernel(TimedSDFgraph *g,
+            const CString &kernel, const uint outputActorRepCnt,
+            StorageDistributionSet **result)
+    {
+        BuffyKernelResult r;
+        const char *errorMsg = NULL;
+        BuffyKernel entry;
+        void *handle;
+        int status;
+
+        handle = dlopen(kernel.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (handle == NULL)
+        {
+            logWarning("Cannot load kernel '" + kernel + "': "
+                       + CString(dlerror()));
+            return false;
+        }
+
+        entry = (BuffyKernel)dlsym(handle, "sdf3BuffyKernel");
+        if (entry == NULL)
+        {
+            logWarning("No entry point in kernel '" + kernel + "'.");
+            dlclose(handle);
+            return false;
+        }
+
+        r.nrChannels = g->nrChannels();
+        r.outputActorRepCnt = outputActorRepCnt;
+        r.outputInterval = 0;
+        r.first = NULL;
+        r.last = NULL;
+        status = entry(reportStorageDistribution, &r, &errorMsg);
+        if (status != 0)
+        {
+            logWarning("Kernel '" + kernel + "' failed: "
+                       + CString(errorMsg != NULL ? errorMsg : "unknown error"));
+            deleteStorageDistributionSets(r.first);
+            dlclose(handle);
+            return false;
+        }
+        dlclose(handle);
+
+        *result = r.first;
+        return true;
+    }
+
+    /**
+     * runThroughputKernel ()
+     * The function loads the throughput kernel and computes the maximal
+     * throughput with it. It returns false when the kernel cannot be loaded
+     * or fails.
+     */
+    bool SDFbuffyKernelBufferAnalysis::runThroughputKernel(
+        const CString &kernel, const uint outputActorRepCnt, double *thr)
+    {
+        const char *errorMsg = NULL;
+        BuffyThroughputKernel entry;
+        double outputInterval;
+        void *handle;
+        int status;
+
+        handle = dlopen(kernel.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (handle == NULL)
+        {
+            logWarning("Cannot load kernel '" + kernel + "': "
+                       + CString(dlerror()));
+            return false;
+        }
+
+        entry = (BuffyThroughputKernel)dlsym(handle,
+                                             "sdf3BuffyThroughputKernel");
+        if (entry == NULL)
+        {
+            logWarning("No entry point in kernel '" + kernel + "'.");
+            dlclose(handle);
+            return false;
+        }
+
+        status = entry(&outputInterval, &errorMsg);
+        dlclose(handle);
+        if (status != 0)
+        {
+            logWarning("Kernel '" + kernel + "' failed: "
+                       + CString(errorMsg != NULL ? errorMsg : "unknown error"));
+            return false;
+        }
+
+        *thr = 1.0 / (outputInterval * outputActorRepCnt);
+        return true;
+    }
+
+    /**
+     * analyze ()
+     * Analyze the trade-offs between storage distributions and throughput (using
+     * auto-concurrency). The complete pareto-space is explored.
+     */
+    StorageDistributionSet *SDFbuffyKernelBufferAnalysis::analyze(
+        TimedSDFgraph *g)
+    {
+        StorageDistributionSet *result = NULL;
+        SDFactor *outputActor;
+        uint repCnt;
+
+        specialized = false;
+
+        outputActor = getOutputActor(g, repCnt);
+        if (outputActor != NULL && isAutoConcurrencyFree(g))
+        {
+            CString actor = outputActor->getName();
+            std::ostringstream model;
+
+            outputSDFasBuffyKernel(g, model, actor, stackSz, hashSz,
+                                   depStackSz);
+            CString kernel = getKernel(model.str());
+
+            if (!kernel.empty() && runKernel(g, kernel, repCnt, &result))
+            {
+                specialized = true;
+                return result;
+            }
+        }
+
+        // Fall back to the generic exploration
+        SDFstateSpaceBufferAnalysis bufferAnalysisAlgo;
+        bufferAnalysisAlgo.setNrThreads(nrThreads);
+        return bufferAnalysisAlgo.analyze(g);
+    }
+
+    /**
+     * analyzeThroughput ()
+     * The function returns the maximal throughput of the graph (using
+     * auto-concurrency and unconstrained storage space), like
+     * SDFstateSpaceThroughputAnalysis.
+     */
+    double SDFbuffyKernelBufferAnalysis::analyzeThroughput(TimedSDFgraph *g)
+    {
+        SDFactor *outputActor;
+        uint repCnt;
+        double thr;
+
+        specialized = false;
+
+        outputActor = getOutputActor(g, repCnt);
+        if (outputActor != NULL && isAutoConcurrencyFree(g))
+        {
+            CString actor = outputActor->getName();
+            std::ostringstream model;
+
+            outputSDFasBuffyThroughputKernel(g, model, actor, stackSz, hashSz,
+                                             depStackSz);
+            CString kernel = getKernel(model.str());
+
+            if (!kernel.empty() && runThroughputKernel(kernel, repCnt, &thr))
+            {
+                specialized = true;
+                return thr;
+            }
+        }
+
+        // Fall back to the generic exploration
+        SDFstateSpaceThroughputAnalysis thrAnalysisAlgo;
+        return thrAnalysisAlgo.analyze(g);
+    }
+
+}//namespace SDF
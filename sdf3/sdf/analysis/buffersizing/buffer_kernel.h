@@ -0,0 +1,131 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   buffer_kernel.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Buffer size analysis with a specialized kernel
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *      17-10-26    :   Maximal throughput with a specialized kernel.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef SDF_ANALYSIS_BUFFERSIZING_BUFFER_KERNEL_H_INCLUDED
+#define SDF_ANALYSIS_BUFFERSIZING_BUFFER_KERNEL_H_INCLUDED
+
+#include "buffer.h"
+namespace SDF
+{
+    /**
+     * Throughput / storage-space trade-off exploration with a specialized
+     * kernel
+     * The graph is output as a buffy model (see outputSDFasBuffyKernel),
+     * which is compiled with the local C++ compiler into a shared object.
+     * The shared object is stored in a cache directory under the hash of
+     * the generated model, so structurally identical graphs share a kernel.
+     * Cached kernels are only loaded when the directory and the kernel are
+     * owned by the user and not writable by others.
+     * The kernel is loaded into the process to find all minimal storage
+     * distributions. The buffy model does not support auto-concurrency, so
+     * the kernel is only used when every actor has a self-loop that limits
+     * it to one firing at a time. Otherwise, or when no compiler is
+     * available, or the kernel cannot be compiled, loaded or executed, the
+     * generic state-space exploration (SDFstateSpaceBufferAnalysis) is used
+     * instead.
+     * The maximal throughput is found in the same way with the throughput
+     * model (see outputSDFasBuffyThroughputKernel). It falls back to
+     * SDFstateSpaceThroughputAnalysis.
+     */
+    class SDFbuffyKernelBufferAnalysis
+    {
+        public:
+            // Constructor
+            SDFbuffyKernelBufferAnalysis(const CString &cacheDir);
+
+            // Destructor
+            ~SDFbuffyKernelBufferAnalysis() {};
+
+            // Analyze throughput/storage-space trade-off space
+            StorageDistributionSet *analyze(TimedSDFgraph *gr);
+
+            // Maximal throughput (storage space is not constrained)
+            double analyzeThroughput(TimedSDFgraph *gr);
+
+            // Per-user kernel cache ($XDG_CACHE_HOME/sdf3 or ~/.cache/sdf3)
+            static CString defaultCacheDir();
+
+            // Compiler command (default: $CXX or c++)
+            void setCompiler(const CString &cmd)
+            {
+                compiler = cmd;
+            };
+
+            // Size of the state stack, hash table and dependency stack of the
+            // kernel
+            void setStackSize(const unsigned long long sz)
+            {
+                stackSz = sz;
+            };
+            void setHashSize(const unsigned long long sz)
+            {
+                hashSz = sz;
+            };
+            void setDependencyStackSize(const unsigned long long sz)
+            {
+                depStackSz = sz;
+            };
+
+            // Number of threads used by the generic exploration
+            void setNrThreads(const uint n)
+            {
+                nrThreads = n;
+            };
+
+            // Was the last analysis done by a specialized kernel?
+            bool isSpecialized() const
+            {
+                return specialized;
+            };
+
+        private:
+            SDFactor *getOutputActor(TimedSDFgraph *g, uint &repCnt);
+            CString getKernel(const CString &src);
+            bool runKernel(TimedSDFgraph *g, const CString &kernel,
+                           const uint outputActorRepCnt,
+                           StorageDistributionSet **result);
+            bool runThroughputKernel(const CString &kernel,
+                                     const uint outputActorRepCnt, double *thr);
+
+            CString cacheDir;
+            CString compiler;
+            unsigned long long stackSz;
+            unsigned long long hashSz;
+            unsigned long long depStackSz;
+            uint nrThreads;
+            bool specialized;
+    };
+
+}//namespace SDF
+#endif
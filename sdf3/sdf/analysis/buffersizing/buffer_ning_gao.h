@@ -13,6 +13,7 @@
  *
  *  History         :
  *      31-03-08    :   Initial version.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
  *
  * $Id: buffer_ning_gao.h,v 1.2 2008-09-18 07:38:21 sander Exp $
  *
@@ -39,6 +40,8 @@
 
 #include "storage_distribution.h"
 #include "../../base/timed/graph.h"
+#include "../../base/timed/compiled_graph.h"
+#include "../statespace/state.h"
 
 namespace SDF
 {
@@ -70,7 +73,7 @@ namespace SDF
                     /***********************************************************************
                      * State
                      **********************************************************************/
-                    class State
+                    class State : public SDFstateSpaceState
                     {
                         public:
                             // Constructor
@@ -85,33 +88,29 @@ namespace SDF
                             // Initialize the state
                             void init(const uint nrActors, const uint nrChannels)
                             {
-                                actClk.resize(nrActors);
-                                ch.resize(nrChannels);
+                                SDFstateSpaceState::init(nrActors, nrChannels);
                                 sp.resize(nrActors);
                             };
 
                             // Compare states
-                            bool operator==(const State &s);
+                            bool operator==(const State &s) const;
 
                             // Clear state
                             void clear();
 
                             // Output state
-                            void print(ostream &out);
+                            void print(ostream &out) const;
+
+                            // Pack state into a sequence of words
+                            void pack(vector<SDFstateWord> &s) const;
 
                             // State information
-                            vector< list<SDFtime> > actClk;
-                            vector< TBufSize > ch;
                             vector< TBufSize > sp;
-                            unsigned long glbClk;
                     };
 
-                    // Sequence of states in transition system
-                    typedef list<State>      States;
-                    typedef States::iterator StatesIter;
-
                     // Constructor
                     TransitionSystem(TimedSDFgraph *gr)
+                        : cg(gr)
                     {
                         g = gr;
                         initOutputActor();
@@ -125,9 +124,6 @@ namespace SDF
                                         vector<SDFtime> &startTime);
 
                 private:
-                    // Store state
-                    bool storeState(State &s, StatesIter &pos);
-
                     // Clear list of stored states
                     void clearStoredStates()
                     {
@@ -138,35 +134,38 @@ namespace SDF
                     void dfsVisitDependencies(uint a, int *color, int *pi,
                                               bool **abstractDepGraph, bool *dep);
                     void findStorageDependencies(bool **abstractDepGraph, bool *dep);
-                    void findCausalDependencies(SDFactor *a, bool **abstractDepGraph);
+                    void findCausalDependencies(const CId a, bool **abstractDepGraph);
                     void analyzePeriodicPhase(const TBufSize *sp, bool *dep);
                     void analyzeDeadlock(const TBufSize *sp, bool *dep);
 
                     // Compute throughput from transition system
-                    TDtime computeThroughput(const StatesIter cycleIter);
+                    TDtime computeThroughput(const uint cycleIdx);
 
                     // State transitions
-                    bool releaseStorageSpaceSharedOutputBuffer(SDFchannel *c);
-                    bool actorReadyToFire(SDFactor *a);
-                    void startActorFiring(TimedSDFactor *a);
-                    bool actorReadyToEnd(SDFactor *a);
-                    void endActorFiring(SDFactor *a);
+                    bool releaseStorageSpaceSharedOutputBuffer(const CId c);
+                    bool actorReadyToFire(const CId a);
+                    void startActorFiring(const CId a);
+                    bool actorReadyToEnd(const CId a);
+                    void endActorFiring(const CId a);
                     SDFtime clockStep();
 
                     // Output actor
                     void initOutputActor();
 
-                    // SDF graph and output actor
+                    // SDF graph and its compiled view
                     TimedSDFgraph *g;
-                    SDFactor *outputActor;
+                    TimedSDFcompiledGraph cg;
+
+                    // Output actor
+                    CId outputActor;
                     TCnt outputActorRepCnt;
 
                     // Current and previous state
                     State currentState;
                     State previousState;
 
-                    // List of visited states that are stored
-                    States storedStates;
+                    // Visited states that are stored
+                    SDFvisitedStates<State> storedStates;
             };
 
             // Bounds on the search space
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      05-04-06    :   Initial version.
+ *      17-10-26    :   Exploration with a specialized kernel.
  *
  * $Id: buffersizing.h,v 1.2 2008-03-31 13:20:26 sander Exp $
  *
@@ -45,6 +46,15 @@
  */
 #include "buffer.h"
 
+/**
+ * Throughput / storage-space trade-off exploration with a specialized kernel
+ * The buffy model of the graph is compiled into a shared object, which is
+ * cached and loaded to explore the trade-off space. The throughput model is
+ * compiled and cached in the same way to find the maximal throughput. The
+ * generic exploration is used when no compiler is available.
+ */
+#include "buffer_kernel.h"
+
 /**
  * Throughput / storage-space trade-off exploration
  * Analyze the trade-offs between storage distributions and throughput (using
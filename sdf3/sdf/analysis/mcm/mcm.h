@@ -12,6 +12,9 @@
  *
  *  History         :
  *      25-07-05    :   Initial version.
+ *      17-10-26    :   MCM of an SDF graph without an HSDF graph.
+ *      17-10-26    :   MCM with automatic selection of the algorithm.
+ *      17-10-26    :   MCM of a max-plus matrix.
  *
  * $Id: mcm.h,v 1.1.1.1 2007-10-02 10:59:46 sander Exp $
  *
@@ -38,6 +41,13 @@
 
 #include "../../base/timed/graph.h"
 #include "mcmgraph.h"
+#include "mcmhoward.h"
+#include "mcmengine.h"
+
+namespace MaxPlus
+{
+    class Matrix;
+}
 
 namespace SDF
 {
@@ -69,6 +79,38 @@ namespace SDF
      */
     CDouble maximumCycleMeanHoward(TimedSDFgraph *g);
 
+    /**
+     * maximumCycleMeanHoward ()
+     * The function computes the maximum cycle mean of an MCMgraph using Howard's
+     * algorithm. Every visible node must have a visible outgoing edge. Use a
+     * HowardSolver to reuse its workspace over many graphs or to solve a set
+     * of graphs concurrently.
+     */
+    CDouble maximumCycleMeanHoward(MCMgraph *g);
+
+    /**
+     * maximumCycleMeanSDF ()
+     * The function computes the maximum cycle mean of the HSDF graph of a
+     * consistent and deadlock-free SDF graph using Howard's algorithm without
+     * constructing the HSDF graph.
+     */
+    CDouble maximumCycleMeanSDF(TimedSDFgraph *g);
+
+    /**
+     * maximumCycleMeanMaxPlusMatrix ()
+     * The function computes the eigenvalue of a square max-plus matrix, i.e.
+     * the maximum cycle mean of its precedence graph, using Howard's
+     * algorithm. It returns zero when the graph has no cycles.
+     */
+    CDouble maximumCycleMeanMaxPlusMatrix(const MaxPlus::Matrix &m);
+
+    /**
+     * maximumCycleMeanAuto ()
+     * The function computes the maximum cycle mean of a HSDF graph. The
+     * algorithm is selected per strongly connected component by an MCMengine.
+     */
+    CDouble maximumCycleMeanAuto(TimedSDFgraph *g);
+
     /**
      * maximumCycleMeanDasdanGupta ()
      * The function computes the maximum cycle mean of a HSDF graph using
@@ -0,0 +1,306 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   mcmengine.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Maximum cycle mean of sets of MCM graphs with
+ *                      automatic selection of the algorithm
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "mcmengine.h"
+#include "mcm.h"
+#include "mcmyto.h"
+#include "../../base/hsdf/check.h"
+
+#include <math.h>
+#include <limits.h>
+#include <algorithm>
+#include <functional>
+namespace SDF
+{
+    // Largest component which is solved with Karp's algorithm. Karp's
+    // algorithm needs O(n^2) memory and O(nm) time, but has almost no
+    // overhead on small components.
+    static const uint karpMaxNodes = 32;
+
+    /**
+     * forEachParallel ()
+     * The function calls f(i, solver) for all i in [0, n) on a pool of
+     * nrThreads workers which each own a Howard solver. The first exception
+     * raised by any call is rethrown after all workers have finished.
+     */
+    static
+    void forEachParallel(const uint n, const uint nrThreads,
+                         const std::function<void(uint, HowardSolver &)> &f)
+    {
+        vector<HowardSolver> solvers(CNrWorkers(n, nrThreads));
+
+        CParallelFor(n, nrThreads, [&](uint i, uint t)
+        {
+            f(i, solvers[t]);
+        });
+    }
+
+    /**
+     * deleteComponents ()
+     * The function deletes the components of a set of graphs.
+     */
+    static
+    void deleteComponents(vector<MCMgraphs> &components)
+    {
+        for (uint i = 0; i < components.size(); i++)
+        {
+            for (MCMgraphsIter iter = components[i].begin();
+                 iter != components[i].end(); iter++)
+            {
+                delete *iter;
+            }
+            components[i].clear();
+        }
+    }
+
+    /**
+     * computeStatistics ()
+     * The function computes the statistics of the visible nodes and edges of
+     * the graph.
+     */
+    MCMgraphStatistics MCMengine::computeStatistics(MCMgraph *g)
+    {
+        MCMgraphStatistics s;
+        CDouble maxWeight = 0;
+
+        s.nrNodes = g->nrVisibleNodes();
+        s.nrEdges = 0;
+        s.minDelay = 0;
+        s.maxDelay = 0;
+        s.integerWeights = true;
+
+        for (MCMedgesCIter iter = g->getEdges().begin();
+             iter != g->getEdges().end(); iter++)
+        {
+            MCMedge *e = *iter;
+
+            if (!e->visible)
+                continue;
+
+            if (s.nrEdges == 0 || e->d < s.minDelay)
+                s.minDelay = e->d;
+            if (s.nrEdges == 0 || e->d > s.maxDelay)
+                s.maxDelay = e->d;
+            if (e->w != floor(e->w))
+                s.integerWeights = false;
+            if (fabs(e->w) > maxWeight)
+                maxWeight = fabs(e->w);
+
+            s.nrEdges++;
+        }
+
+        // Karp's algorithm sums up to n weights in an int
+        if (maxWeight * (s.nrNodes + 1) >= INT_MAX)
+            s.integerWeights = false;
+
+        return s;
+    }
+
+    /**
+     * selectAlgorithm ()
+     * The function selects the algorithm for a strongly connected graph with
+     * statistics s.
+     */
+    MCMengine::Algorithm MCMengine::selectAlgorithm(const MCMgraphStatistics &s)
+    {
+        if (s.minDelay != 1 || s.maxDelay != 1)
+            return YoungTarjanOrlin;
+
+        if (s.nrNodes <= karpMaxNodes && s.integerWeights)
+            return Karp;
+
+        return Howard;
+    }
+
+    /**
+     * solveComponent ()
+     * The function computes the maximum cycle mean of a strongly connected
+     * component. The nodes of the component are relabeled.
+     */
+    CDouble MCMengine::solveComponent(MCMgraph *c, HowardSolver &howard) const
+    {
+        MCMgraphStatistics s = computeStatistics(c);
+        Algorithm a = algorithm;
+
+        // All MCM algorithms need node ids in the range [0, nrNodes)
+        relabelMCMgraph(c);
+
+        if (a == Auto)
+            a = selectAlgorithm(s);
+
+        if (a != YoungTarjanOrlin && (s.minDelay != 1 || s.maxDelay != 1))
+            throw CException("Only Young-Tarjan-Orlin's algorithm supports "
+                             "edge delays other than one.");
+
+        switch (a)
+        {
+            case Karp:
+                if (!s.integerWeights)
+                    throw CException("Karp's algorithm needs integer edge "
+                                     "weights.");
+                return maximumCycleMeanKarp(c);
+
+            case YoungTarjanOrlin:
+                return maxCycleRatioYoungTarjanOrlin(c);
+
+            default:
+                return howard.solve(c);
+        }
+    }
+
+    /**
+     * solve ()
+     * The function computes the maximum cycle mean of the graph. The strongly
+     * connected components of the graph are solved concurrently. The
+     * visibility of the nodes and edges of the graph is changed as described
+     * for stronglyConnectedMCMgraph.
+     */
+    CDouble MCMengine::solve(MCMgraph *g)
+    {
+        vector<MCMgraph *> graphs(1, g);
+        vector<CDouble> mcm;
+
+        solve(graphs, mcm);
+
+        return mcm[0];
+    }
+
+    /**
+     * solve ()
+     * The function computes the maximum cycle mean of all graphs and stores
+     * the MCM of graphs[i] in mcm[i]. The graphs are split into strongly
+     * connected components which are solved on a pool of worker threads,
+     * largest first. A graph may occur only once in the set.
+     */
+    void MCMengine::solve(const vector<MCMgraph *> &graphs,
+                          vector<CDouble> &mcm)
+    {
+        vector<MCMgraphs> components(graphs.size());
+        vector< std::pair<MCMgraph *, uint> > tasks;
+        vector<uint> order;
+        vector<CDouble> result;
+
+        mcm.assign(graphs.size(), 0);
+
+        try
+        {
+            // Split the graphs into strongly connected components
+            forEachParallel(graphs.size(), nrThreads,
+                            [&](uint i, HowardSolver &)
+            {
+                stronglyConnectedMCMgraph(graphs[i], components[i]);
+            });
+
+            for (uint i = 0; i < graphs.size(); i++)
+            {
+                for (MCMgraphsIter iter = components[i].begin();
+                     iter != components[i].end(); iter++)
+                {
+                    tasks.push_back(std::make_pair(*iter, i));
+                }
+            }
+
+            // Largest components first to balance the load of the workers
+            order.resize(tasks.size());
+            for (uint t = 0; t < tasks.size(); t++)
+            {
+                order[t] = t;
+            }
+            std::stable_sort(order.begin(), order.end(),
+                             [&](uint x, uint y)
+            {
+                return tasks[x].first->getNodes().size()
+                       > tasks[y].first->getNodes().size();
+            });
+
+            // Solve the components
+            result.assign(tasks.size(), 0);
+            forEachParallel(tasks.size(), nrThreads,
+                            [&](uint i, HowardSolver &howard)
+            {
+                uint t = order[i];
+                result[t] = solveComponent(tasks[t].first, howard);
+            });
+
+            for (uint t = 0; t < tasks.size(); t++)
+            {
+                if (result[t] > mcm[tasks[t].second])
+                    mcm[tasks[t].second] = result[t];
+            }
+        }
+        catch (...)
+        {
+            deleteComponents(components);
+            throw;
+        }
+
+        // Cleanup
+        deleteComponents(components);
+    }
+
+    /**
+     * maximumCycleMeanAuto ()
+     * The function computes the maximum cycle mean of a HSDF graph with the
+     * algorithm selected by an MCMengine.
+     */
+    CDouble maximumCycleMeanAuto(TimedSDFgraph *g)
+    {
+        MCMengine engine;
+        MCMgraph *mcmGraph;
+        CDouble mcm;
+
+        // Check that graph g is an HSDF graph
+        if (!isHSDFgraph(g))
+            throw CException("Graph is not an HSDF graph.");
+
+        // Transform the HSDF to a weighted directed graph
+        mcmGraph = transformHSDFtoMCMgraph(g);
+
+        try
+        {
+            mcm = engine.solve(mcmGraph);
+        }
+        catch (...)
+        {
+            delete mcmGraph;
+            throw;
+        }
+
+        // Cleanup
+        delete mcmGraph;
+
+        return mcm;
+    }
+
+}//namespace SDF
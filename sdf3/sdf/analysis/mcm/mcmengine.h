@@ -0,0 +1,126 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   mcmengine.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Maximum cycle mean of sets of MCM graphs with
+ *                      automatic selection of the algorithm
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef SDF_ANALYSIS_MCM_MCMENGINE_H_INCLUDED
+#define SDF_ANALYSIS_MCM_MCMENGINE_H_INCLUDED
+
+#include "mcmhoward.h"
+namespace SDF
+{
+    /**
+     * MCMgraphStatistics
+     * Statistics of the visible nodes and edges of an MCM graph which are used
+     * to select an MCM algorithm.
+     */
+    struct MCMgraphStatistics
+    {
+        uint nrNodes;
+        uint nrEdges;
+        CDouble minDelay;
+        CDouble maxDelay;
+        bool integerWeights;
+    };
+
+    /**
+     * MCMengine
+     * Computes the maximum cycle mean of one or more MCM graphs. Every graph
+     * is split into its strongly connected components. The components of all
+     * graphs are solved independently on a pool of worker threads and the MCM
+     * of a graph is the maximum over its components (zero for an acyclic
+     * graph).
+     *
+     * Each component is solved with Howard's, Karp's or Young-Tarjan-Orlin's
+     * algorithm. In automatic mode, the algorithm is selected on the
+     * statistics of the component. Components with delays other than one
+     * describe a cycle ratio problem, which only Young-Tarjan-Orlin's
+     * algorithm solves. Small components with integer weights are solved
+     * with Karp's algorithm, which has the lowest overhead. All other
+     * components are solved with Howard's algorithm.
+     */
+    class MCMengine
+    {
+        public:
+            // Algorithms
+            enum Algorithm { Auto, Howard, Karp, YoungTarjanOrlin };
+
+            // Constructor
+            MCMengine() : algorithm(Auto), nrThreads(0) {};
+
+            // Destructor
+            ~MCMengine() {};
+
+            // Algorithm (Auto selects it per component)
+            void setAlgorithm(const Algorithm a)
+            {
+                algorithm = a;
+            };
+            Algorithm getAlgorithm() const
+            {
+                return algorithm;
+            };
+
+            // Number of worker threads (0 selects the number of hardware
+            // threads)
+            void setNrThreads(const uint n)
+            {
+                nrThreads = n;
+            };
+            uint getNrThreads() const
+            {
+                return nrThreads;
+            };
+
+            // Maximum cycle mean of a graph
+            CDouble solve(MCMgraph *g);
+
+            // Maximum cycle mean of a set of graphs
+            void solve(const vector<MCMgraph *> &graphs, vector<CDouble> &mcm);
+
+            // Statistics of the visible part of a graph
+            static MCMgraphStatistics computeStatistics(MCMgraph *g);
+
+            // Algorithm for a strongly connected graph
+            static Algorithm selectAlgorithm(const MCMgraphStatistics &s);
+
+        private:
+            // Maximum cycle mean of a strongly connected component
+            CDouble solveComponent(MCMgraph *c, HowardSolver &howard) const;
+
+            // Settings
+            Algorithm algorithm;
+            uint nrThreads;
+    };
+
+}//namespace SDF
+#endif
@@ -13,6 +13,8 @@
  *
  *  History         :
  *      07-11-05    :   Initial version.
+ *      17-10-26    :   Direct SDF to MCM graph conversion and iterative
+ *                      strongly connected components.
  *
  * $Id: mcmgraph.cc,v 1.1.1.1.2.1 2009-11-17 16:31:47 mgeilen Exp $
  *
@@ -37,6 +39,7 @@
 #include "base/base.h"
 #include "mcmgraph.h"
 #include "../../base/hsdf/check.h"
+#include "../../base/timed/compiled_graph.h"
 #include "mcm.h"
 namespace SDF
 {
@@ -454,373 +457,288 @@ namespace SDF
     }
 
     /**
-     * getAdjacentNodes ()
-     * The function returns a list with nodes directly reachable from
-     * node a (in case transpose if false). If transpose is 'true', the
-     * graph is transposed and the function returns a list with nodes
-     * which are directly reachable from a in the transposed graph.
+     * transformSDFtoMCMgraph ()
+     * The function converts an SDF graph into the weighted directed graph
+     * which transformHSDFtoMCMgraph produces for the HSDF graph of g, without
+     * constructing this HSDF graph. Firing i of actor a becomes the node with
+     * id offset(a) + i, where offset(a) is the prefix sum of the repetition
+     * vector. All edges leaving a node have the execution time of its actor as
+     * weight, so of the parallel edges between two nodes only the one with the
+     * fewest initial tokens can be on a critical cycle. The other parallel
+     * edges are not added to the graph.
      */
-    static
-    MCMnodes getAdjacentNodes(MCMnode *a, bool transpose)
+    MCMgraph *transformSDFtoMCMgraph(TimedSDFgraph *g, bool mcmFormulation)
     {
-        MCMnodes nodes;
-
-        if (!transpose)
-        {
-            for (MCMedgesIter iter = a->out.begin(); iter != a->out.end(); iter++)
-            {
-                MCMedge *e = *iter;
-
-                if (e->visible)
-                    nodes.push_back(e->dst);
-            }
-        }
-        else
-        {
-            for (MCMedgesIter iter = a->in.begin(); iter != a->in.end(); iter++)
-            {
-                MCMedge *e = *iter;
-
-                if (e->visible)
-                    nodes.push_back(e->src);
-            }
-        }
+        MCMgraph *mcmGraph = new MCMgraph;
+        TimedSDFcompiledGraph cg(g);
+        const RepetitionVector &repVec = cg.getRepetitionVector();
 
-        return nodes;
-    }
+        // Offset of the nodes of every actor
+        vector<CId> offset(cg.nrActors() + 1, 0);
+        for (CId a = 0; a < cg.nrActors(); a++)
+            offset[a + 1] = offset[a] + repVec[a];
+        CId nrNodes = offset[cg.nrActors()];
 
-    /**
-     * getNextNode ()
-     * The function returns the node from the list of nodes with the highest
-     * order. Its order is set to -1. If all nodes have order -1, a NULL pointer is
-     * returned.
-     */
-    static
-    MCMnode *getNextNode(const MCMnodes &nodes, v_int &order)
-    {
-        MCMnode *a = NULL;
-        int orderA = -1;
+        if (nrNodes == 0)
+            throw CException("Graph is not consistent.");
 
-        // Find actor with largest order
-        for (MCMnodesCIter iter = nodes.begin(); iter != nodes.end(); iter++)
+        // Edges of the HSDF graph grouped on their source node
+        vector<CId> edgeOffset(nrNodes + 1, 0);
+        for (CId c = 0; c < cg.nrChannels(); c++)
         {
-            MCMnode *b = *iter;
+            CId a = cg.getSrcActor(c);
 
-            if (orderA < order[b->id])
-            {
-                a = b;
-                orderA = order[b->id];
-            }
+            for (CId n = offset[a]; n < offset[a + 1]; n++)
+                edgeOffset[n + 1] += cg.getSrcRate(c);
         }
+        for (CId n = 0; n < nrNodes; n++)
+            edgeOffset[n + 1] += edgeOffset[n];
 
-        // All actors have order -1?
-        if (orderA == -1)
-            return NULL;
-
-        return a;
-    }
-
-    /**
-     * dfsVisit ()
-     * The visitor function of the DFS algorithm.
-     */
-    static
-    void dfsVisit(MCMnode *u, int &time, v_int &color, v_int &d, v_int &f,
-                  MCMnode **pi, bool transpose)
-    {
-        // color[u] <- gray
-        color[u->id] = 1;
-
-        // d[u] <- time <- time + 1
-        time++;
-        d[u->id] = time;
-
-        // for each v in Adj(e)
-        MCMnodes adj = getAdjacentNodes(u, transpose);
-        for (MCMnodesIter iter = adj.begin(); iter != adj.end(); iter++)
+        vector<CId> edgeDst(edgeOffset[nrNodes]);
+        vector<uint> edgeTokens(edgeOffset[nrNodes]);
+        vector<CId> edgeFill(edgeOffset.begin(), edgeOffset.end() - 1);
+        for (CId c = 0; c < cg.nrChannels(); c++)
         {
-            MCMnode *v = *iter;
+            uint nA = cg.getSrcRate(c);
+            uint nB = cg.getDstRate(c);
+            uint qA = repVec[cg.getSrcActor(c)];
+            uint qB = repVec[cg.getDstActor(c)];
+            uint d = cg.getInitialTokens(c);
 
-            // do if color[v] = white
-            if (color[v->id] == 0)
+            for (uint i = 0; i < qA; i++)
             {
-                pi[v->id] = u;
-                dfsVisit(v, time, color, d, f, pi, transpose);
-            }
-        }
-
-        // color[u] <- black
-        color[u->id] = 2;
-
-        // f[u] <- time <- time + 1
-        time++;
-        f[u->id] = time;
-    }
-
-    /**
-     * dfsMCMgraph ()
-     * The function performs a depth first search on the graph. The discover
-     * time (d), finish time (f) and predecessor tree (pi) are passed back.
-     * The graph is transposed if the argument 't' is 'true'. Vertices are
-     * considered in decreasing order of f[u].
-     *
-     * The function derives an 'order' vector from the vector 'f'. Actors are
-     * considered in decreasing order according to this vector. When an actor
-     * is visited, its order is set to -1. At the end, all actors must have
-     * order -1 (i.e. all actors are visited).
-     */
-    void dfsMCMgraph(MCMgraph *g, v_int &d, v_int &f, MCMnode **pi, bool transpose)
-    {
-        int time;
-
-        // for each u in G do order[u] <- f[u]
-        v_int order(f);
-
-        // for each u in G do color[u] <- white
-        v_int color(g->nrVisibleNodes(), 0);
-
-        // time <- 0
-        time = 0;
-
-        // for each u in G do pi[u] <- NIL
-        for (uint u = 0; u < g->nrVisibleNodes(); u++)
-            pi[u] = NULL;
-
-        // for each u in G (visit in order given by order)
-        for (MCMnode *a = getNextNode(g->getNodes(), order); a != NULL;
-             a = getNextNode(g->getNodes(), order))
-        {
-            // Mark node as visited
-            order[a->id] = -1;
-
-            // if color[u] = white
-            if (color[a->id] == 0)
-                dfsVisit(a, time, color, d, f, pi, transpose);
-        }
-    }
-
-    /**
-     * addNodeToComponent ()
-     * The function adds a new copy of a node to the component and it
-     * also creates copies for all edges between this node and all nodes
-     * already in the component.
-     */
-    static
-    void addNodeToComponent(MCMnode *n, MCMgraph *comp)
-    {
-        MCMnode *m;
-
-        // Create a copy of n and add it to the component
-        m = new MCMnode(n->id, true);
-        comp->addNode(m);
-
-        // Check all edges of n for inclusion in the component
-        for (MCMedgesIter iter = n->out.begin(); iter != n->out.end(); iter++)
-        {
-            MCMedge *e = *iter;
-
-            if (!e->visible)
-                continue;
+                CId src = offset[cg.getSrcActor(c)] + i;
 
-            // Is destination node in the component?
-            for (MCMnodesCIter iterN = comp->getNodes().begin();
-                 iterN != comp->getNodes().end(); iterN++)
-            {
-                if (e->dst->id == (*iterN)->id)
+                for (uint k = 0; k < nA; k++)
                 {
-                    // Add a copy of the edge to the component
-                    MCMedge *eN = new MCMedge(e->id, e->visible);
-                    eN->d = e->d;
-                    eN->w = e->w;
-                    eN->src = m;
-                    eN->dst = *iterN;
-                    comp->addEdge(eN);
-                    break;
-                }
-            }
-        }
-        for (MCMedgesIter iter = n->in.begin(); iter != n->in.end(); iter++)
-        {
-            MCMedge *e = *iter;
+                    uint n = d + i * nA + k;
+                    CId e = edgeFill[src]++;
 
-            // Is source node in the component?
-            for (MCMnodesCIter iterN = comp->getNodes().begin();
-                 iterN != comp->getNodes().end(); iterN++)
-            {
-                if (e->src->id == (*iterN)->id)
-                {
-                    // Add a copy of the edge to the component
-                    MCMedge *eN = new MCMedge(e->id, e->visible);
-                    eN->d = e->d;
-                    eN->w = e->w;
-                    eN->src = *iterN;
-                    eN->dst = m;
-                    comp->addEdge(eN);
-                    break;
+                    edgeDst[e] = offset[cg.getDstActor(c)]
+                                 + (n % (nB * qB)) / nB;
+                    edgeTokens[e] = n / (nB * qB);
                 }
             }
         }
-    }
 
-    /**
-     * treeVisitChildren ()
-     * The function visits all children of the actor 'u'. The parent-child
-     * relation is given via the vector 'pi'.
-     */
-    static
-    bool treeVisitChildren(MCMgraph *g, MCMnode **pi, MCMnode *u, MCMgraph *comp)
-    {
-        bool children = false;
+        // Nodes
+        vector<MCMnode *> nodes(nrNodes);
+        for (CId n = 0; n < nrNodes; n++)
+        {
+            nodes[n] = new MCMnode(n, true);
+            mcmGraph->addNode(nodes[n]);
+        }
 
-        for (uint i = 0; i < g->getNodes().size(); i++)
+        // Edges (only the one with the fewest tokens between two nodes)
+        vector<CId> lastSrc(nrNodes, nrNodes);
+        vector<CId> minEdge(nrNodes, 0);
+        CId edgeId = 0;
+        for (CId a = 0; a < cg.nrActors(); a++)
         {
-            // Node v points to node u (i.e. v is a child of u)?
-            if (pi[i] != NULL && pi[i]->id == u->id)
+            for (CId u = offset[a]; u < offset[a + 1]; u++)
             {
-                MCMnode *v = NULL;
-
-                for (MCMnodesCIter iter = g->getNodes().begin();
-                     iter != g->getNodes().end(); iter++)
+                for (CId e = edgeOffset[u]; e < edgeOffset[u + 1]; e++)
                 {
-                    if ((*iter)->id == i)
+                    CId v = edgeDst[e];
+
+                    if (lastSrc[v] != u)
                     {
-                        v = *iter;
-                        break;
+                        lastSrc[v] = u;
+                        minEdge[v] = e;
+                    }
+                    else if (edgeTokens[e] < edgeTokens[minEdge[v]])
+                    {
+                        minEdge[v] = e;
                     }
                 }
-                ASSERT(v != NULL, "The must always be a node v.");
 
-                // Add node v to the component
-                v->visible = true;
-                addNodeToComponent(v, comp);
-                children = true;
+                for (CId e = edgeOffset[u]; e < edgeOffset[u + 1]; e++)
+                {
+                    CId v = edgeDst[e];
+
+                    if (minEdge[v] != e)
+                        continue;
 
-                // Find all children of v in the tree
-                treeVisitChildren(g, pi, v, comp);
+                    mcmGraph->addEdge(edgeId++, nodes[u], nodes[v],
+                                      cg.getExecutionTime(a), edgeTokens[e]);
+                }
             }
         }
 
-        return children;
+        // Release the edge arrays before the longest path computation
+        vector<CId>().swap(edgeDst);
+        vector<uint>().swap(edgeTokens);
+
+        // Convert the initial directed weighted graph to the required form
+        if (mcmFormulation)
+            addLongestDelayEdgesToMCMgraph(mcmGraph);
+
+        return mcmGraph;
     }
 
     /**
-     * findComponentsInMCMgraph ()
-     * The function determines the strongly connected components in the graph. To do
-     * this, it performs depth-first walk on the forest given by 'pi'.
+     * stronglyConnectedMCMgraph ()
+     * Extract the strongly connected components from the graph. These components
+     * are returned as a set of MCM graphs. All nodes which belong to at least
+     * one of the strongly connected components are set to visible in the graph g,
+     * all other nodes are made invisible. Also edges between two nodes in (possibly
+     * different) strongly connected components are made visible and all others
+     * invisible. The graph g consists in the end of only nodes which are part of
+     * a strongly connnected component and all the edges between these nodes. Some
+     * MCM algorithms work also on this graph (which reduces the execution time
+     * needed in some of the conversion algorithms).
+     *
+     * The components are found with an iterative version of Tarjan's algorithm
+     * on the visible edges. The components are ordered on their first node in
+     * the graph and contain their nodes and edges in the order of the graph.
      */
-    static
-    void findComponentsInMCMgraph(MCMgraph *g, MCMnode **pi, MCMgraphs &components)
+    void stronglyConnectedMCMgraph(MCMgraph *g, MCMgraphs &components)
     {
-        MCMgraph *comp;
-
-        // Set all node as invisible
-        for (MCMnodesCIter iter = g->getNodes().begin(); iter != g->getNodes().end(); iter++)
+        uint nrNodes = g->getNodes().size();
+        vector<MCMnode *> node(nrNodes, NULL);
+        vector<int> index(nrNodes, -1), lowLink(nrNodes, 0), comp(nrNodes, -1);
+        vector<bool> onStack(nrNodes, false);
+        vector<CId> stack;
+        vector< std::pair<CId, MCMedgesIter> > callStack;
+        int nextIndex = 0, nrComponents = 0;
+
+        // Nodes indexed on their id
+        for (MCMnodesCIter iter = g->getNodes().begin();
+             iter != g->getNodes().end(); iter++)
         {
             MCMnode *n = *iter;
 
-            n->visible = false;
+            if (n->id >= nrNodes || node[n->id] != NULL)
+                throw CException("Node ids of the MCM graph are not unique "
+                                 "in the range [0, nrNodes).");
+            node[n->id] = n;
         }
 
-        // Find the strongly connected component and make all of its nodes visible
-        for (MCMnodesCIter iter = g->getNodes().begin(); iter != g->getNodes().end(); iter++)
+        // Depth-first search from every unvisited node
+        for (CId r = 0; r < nrNodes; r++)
         {
-            MCMnode *n = *iter;
+            if (index[r] != -1)
+                continue;
 
-            if (pi[n->id] == NULL)
+            index[r] = lowLink[r] = nextIndex++;
+            stack.push_back(r);
+            onStack[r] = true;
+            callStack.push_back(std::make_pair(r, node[r]->out.begin()));
+
+            while (!callStack.empty())
             {
-                // Create a new graph for the component
-                comp = new MCMgraph;
+                CId u = callStack.back().first;
+                MCMedgesIter &iter = callStack.back().second;
 
-                // Find all children of n in the tree
-                if (treeVisitChildren(g, pi, n, comp))
+                // Visit the next successor of u
+                if (iter != node[u]->out.end())
                 {
-                    // Node n has children, so it belongs to the strongly
-                    // connected component
-                    n->visible = true;
-                    addNodeToComponent(n, comp);
+                    MCMedge *e = *iter;
+                    CId v = e->dst->id;
+
+                    iter++;
+                    if (!e->visible)
+                        continue;
+
+                    if (index[v] == -1)
+                    {
+                        index[v] = lowLink[v] = nextIndex++;
+                        stack.push_back(v);
+                        onStack[v] = true;
+                        callStack.push_back(std::make_pair(v,
+                                                           node[v]->out.begin()));
+                    }
+                    else if (onStack[v] && index[v] < lowLink[u])
+                    {
+                        lowLink[u] = index[v];
+                    }
+                    continue;
                 }
-                else
+
+                // All successors of u visited; u is root of a component?
+                callStack.pop_back();
+                if (lowLink[u] == index[u])
                 {
-                    // Node n may have a self-loop making it a strongly
-                    // connected component
-                    for (MCMedgesIter iterE = n->in.begin();
-                         iterE != n->in.end(); iterE++)
+                    CId v;
+                    do
                     {
-                        // Is edge a self-loop?
-                        if ((*iterE)->src->id == n->id)
-                        {
-                            n->visible = true;
-                            addNodeToComponent(n, comp);
-                        }
+                        v = stack.back();
+                        stack.pop_back();
+                        onStack[v] = false;
+                        comp[v] = nrComponents;
                     }
+                    while (v != u);
+                    nrComponents++;
                 }
 
-                // Found a strongly connected component (at least one edge)?
-                if (comp->nrVisibleEdges() > 0)
-                    components.push_back(comp);
-                else
-                    delete comp;
+                // Propagate the low-link to the parent of u
+                if (!callStack.empty())
+                {
+                    CId p = callStack.back().first;
+                    if (lowLink[u] < lowLink[p])
+                        lowLink[p] = lowLink[u];
+                }
             }
         }
 
-        // Make all edges to invisible nodes also invisible
-        for (MCMedgesCIter iter = g->getEdges().begin(); iter != g->getEdges().end(); iter++)
+        // A component is strongly connected when it has an edge
+        vector<uint> nrCompEdges(nrComponents, 0);
+        for (MCMedgesCIter iter = g->getEdges().begin();
+             iter != g->getEdges().end(); iter++)
         {
             MCMedge *e = *iter;
 
-            if (e->visible)
-                if (!e->src->visible || !e->dst->visible)
-                    e->visible = false;
+            if (e->visible && comp[e->src->id] == comp[e->dst->id])
+                nrCompEdges[comp[e->src->id]]++;
         }
-    }
 
-    /**
-     * Extract the strongly connected components from the graph. These components
-     * are returned as a set of MCM graphs. All nodes which belong to at least
-     * one of the strongly connected components are set to visible in the graph g,
-     * all other nodes are made invisible. Also edges between two nodes in (possibly
-     * different) strongly connected components are made visible and all others
-     * invisible. The graph g consists in the end of only nodes which are part of
-     * a strongly connnected component and all the edges between these nodes. Some
-     * MCM algorithms work also on this graph (which reduces the execution time
-     * needed in some of the conversion algorithms).
-     */
-    void stronglyConnectedMCMgraph(MCMgraph *g, MCMgraphs &components)
-    {
-        // Initialize
-        v_int d(g->nrVisibleNodes());
-        v_int f(g->nrVisibleNodes(), 0);
-        MCMnode **pi = (MCMnode **)malloc(sizeof(MCMnode *)*g->nrVisibleNodes());
-        ASSERT(pi != NULL, "Failled malloc");
+        // Create the components (in the order of the graph)
+        vector<MCMgraph *> compGraph(nrComponents, NULL);
+        vector<MCMnode *> copy(nrNodes, NULL);
+        for (MCMnodesCIter iter = g->getNodes().begin();
+             iter != g->getNodes().end(); iter++)
+        {
+            MCMnode *n = *iter;
+            int c = comp[n->id];
 
-        // Call dfs(g) to compute f[u] for each u
-        dfsMCMgraph(g, d, f, pi, false);
+            n->visible = (nrCompEdges[c] > 0);
+            if (!n->visible)
+                continue;
 
-        // Call dfs(gT), consider the vertices in order of decreasing f[u]
-        dfsMCMgraph(g, d, f, pi, true);
+            if (compGraph[c] == NULL)
+            {
+                compGraph[c] = new MCMgraph;
+                components.push_back(compGraph[c]);
+            }
 
-        // Component is given by the vertices of the tree in the depth-first forest
-        findComponentsInMCMgraph(g, pi, components);
+            copy[n->id] = new MCMnode(n->id, true);
+            compGraph[c]->addNode(copy[n->id]);
+        }
 
-#if 0
-        // Print the MCM graph in dot-format
-        cerr << "digraph g {" << endl;
-        cerr << "    size=\"7,10\";" << endl;
-        for (MCMedgesIter iter = g->edges.begin(); iter != g->edges.end(); iter++)
+        // Copy the edges inside the components and hide all edges to
+        // invisible nodes
+        for (MCMedgesCIter iter = g->getEdges().begin();
+             iter != g->getEdges().end(); iter++)
         {
             MCMedge *e = *iter;
 
-            if (e->visible)
+            if (!e->visible)
+                continue;
+
+            if (!e->src->visible || !e->dst->visible)
             {
-                cerr << "    " << e->src->id << " -> " << e->dst->id;
-                cerr << " [ label=" << e->w << " ];" << endl;
+                e->visible = false;
+            }
+            else if (comp[e->src->id] == comp[e->dst->id])
+            {
+                MCMedge *eN = new MCMedge(e->id, true);
+                eN->d = e->d;
+                eN->w = e->w;
+                eN->src = copy[e->src->id];
+                eN->dst = copy[e->dst->id];
+                compGraph[comp[e->src->id]]->addEdge(eN);
             }
         }
-        cerr << "}" << endl;
-#endif
-
-        // Cleanup
-        free(pi);
     }
 
     /**
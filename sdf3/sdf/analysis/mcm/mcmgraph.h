@@ -13,6 +13,7 @@
  *
  *  History         :
  *      07-11-05    :   Initial version.
+ *      17-10-26    :   Direct SDF to MCM graph conversion.
  *
  * $Id: mcmgraph.h,v 1.1.1.1.2.2 2010-08-18 07:51:47 mgeilen Exp $
  *
@@ -215,6 +216,15 @@ namespace SDF
      */
     MCMgraph *transformHSDFtoMCMgraph(TimedSDFgraph *g, bool mcmFormulation = true);
 
+    /**
+     * transformSDFtoMCMgraph ()
+     * The function converts an SDF graph into the weighted directed graph of
+     * its HSDF graph (see transformHSDFtoMCMgraph) without constructing the
+     * HSDF graph. Parallel edges which cannot be on a critical cycle are left
+     * out. The graph must be consistent.
+     */
+    MCMgraph *transformSDFtoMCMgraph(TimedSDFgraph *g, bool mcmFormulation = true);
+
     /**
      * Extract the strongly connected components from the graph. These components
      * are returned as a set of MCM graphs. All nodes which belong to at least
@@ -23,6 +23,8 @@
  *
  *  History         :
  *      08-11-05    :   Initial version.
+ *      17-10-26    :   Reentrant solver object with reusable workspace.
+ *      17-10-26    :   MCM of an SDF graph without an HSDF graph.
  *
  * $Id: mcmhoward.cc,v 1.1.1.1 2007-10-02 10:59:46 sander Exp $
  *
@@ -44,13 +46,13 @@
  * what you give them.   Happy coding!
  */
 
-#include "mcmgraph.h"
+#include "mcmhoward.h"
+#include "mcm.h"
 #include "../../base/hsdf/check.h"
 #include "../../base/algo/components.h"
+#include "../../base/timed/compiled_graph.h"
+#include "../maxplus/mpexplore.h"
 
-#include <stdlib.h>
-#include <stddef.h>
-#include <stdio.h>
 #include <math.h>
 namespace SDF
 {
@@ -61,50 +63,12 @@ namespace SDF
 
 #define EPSILON -HUGE_VAL
 
-    static int *ij;
-    static double *a;
-    static int nnodes;
-    static int narcs;
-    static double *chi;
-    static double *v;
-    static int *pi;
-    static int *NIterations;
-    static int *NComponents;
-
-    static int *newpi = NULL; /*  new policy */
-
-    /* The inverse policy is coded by a linearly chained list.
-     * piinv_idx[i]= pointer to the chain of inverses of node i.
-     */
-    static  int *piinv_idx = NULL;
-
-    /* piinv_idx[j]= pointer to the next inverse */
-    static  int *piinv_succ = NULL;
-
-    /* corresponding node  */
-    static  int *piinv_elem = NULL;
-
-    /* piinv_last[i]= last inverse of i */
-    static  int *piinv_last = NULL;
-
-    static  double *c = NULL;
-    static  double *vaux = NULL;
-    static  double *newc = NULL;
-    static  double *newchi = NULL;
-    static  int *visited = NULL;
-    static  int *component = NULL;
-    static  double lambda = 0;
-    static  double epsilon = 0;
-    static  int color = 1;
-
-
     /**
      * Epsilon ()
      * The termination tests are performed up to an epsilon constant, which is fixed
      * heuristically by the following routine.
      */
-    static
-    void Epsilon(double *a, int narcs, double *epsilon)
+    void HowardSolver::Epsilon()
     {
         int i;
         double MAX, MIN;
@@ -120,7 +84,7 @@ namespace SDF
                 MIN = a[i];
         }
 
-        *epsilon = (MAX - MIN) * 0.000000001;
+        epsilon = (MAX - MIN) * 0.000000001;
     }
 
     /**
@@ -130,9 +94,13 @@ namespace SDF
      * maximal weigth starting from i for full random matrices, this choice of
      * initial policy seems to cut the number of iterations by a factor 1.5, by
      * comparison with a random initial policy.
+     *
+     * When usePreviousPolicy is set, the policy of the previous run is kept in
+     * newpi. Every node that still has an arc to its previous successor keeps
+     * that successor (with the arc of maximal weight between both nodes). The
+     * greedy rule is used for all other nodes.
      */
-    static
-    void Initial_Policy()
+    void HowardSolver::Initial_Policy(const bool usePreviousPolicy)
     {
         int i;
 
@@ -150,10 +118,29 @@ namespace SDF
                 vaux[ij[i * 2]] = a[i];
             }
         }
+
+        if (!usePreviousPolicy)
+            return;
+
+        /* visited marks the nodes which keep their previous successor */
+        for (i = 0; i < nnodes; i++)
+            visited[i] = 0;
+
+        for (i = 0; i < narcs; i++)
+        {
+            if (newpi[ij[i * 2]] == ij[i * 2 + 1])
+            {
+                if (visited[ij[i * 2]] == 0 || c[ij[i * 2]] < a[i])
+                {
+                    pi[ij[i * 2]] = ij[i * 2 + 1];
+                    c[ij[i * 2]] = a[i];
+                    visited[ij[i * 2]] = 1;
+                }
+            }
+        }
     }
 
-    static
-    void New_Build_Inverse()
+    void HowardSolver::New_Build_Inverse()
     {
         int i, j, locus;
         int ptr = 0;
@@ -187,8 +174,7 @@ namespace SDF
         }
     }
 
-    static
-    void Init_Depth_First()
+    void HowardSolver::Init_Depth_First()
     {
         int j;
 
@@ -199,16 +185,13 @@ namespace SDF
         }
     }
 
-
-
     /**
      *
      * Given the value of v at initial point i, we compute v[j] for all predecessor
      * j of i, according to the spectral equation, v[j]+ lambda = A(arc from j to i)
      * v[i] the array visited is changed by side effect.
      */
-    static
-    void New_Depth_First_Label(int i)
+    void HowardSolver::New_Depth_First_Label(int i)
     {
         int nexti, a;
         a = piinv_idx[i];
@@ -224,8 +207,7 @@ namespace SDF
         }
     }
 
-    static
-    void Visit_From(int initialpoint, int color)
+    void HowardSolver::Visit_From(int initialpoint, int color)
     {
         int index, newindex, i;
         double weight;
@@ -264,8 +246,7 @@ namespace SDF
      * Value()
      * Computes the value (v,chi) associated with a policy pi.
      */
-    static
-    void Value()
+    void HowardSolver::Value()
     {
         int initialpoint;
         color = 1;
@@ -282,11 +263,10 @@ namespace SDF
         }
         while (initialpoint < nnodes);
 
-        *NComponents = --color;
+        nComponents = --color;
     }
 
-    static
-    void Init_Improve()
+    void HowardSolver::Init_Improve()
     {
         int i;
 
@@ -299,8 +279,7 @@ namespace SDF
         }
     }
 
-    static
-    void First_Order_Improvement(int *improved)
+    void HowardSolver::First_Order_Improvement(int *improved)
     {
         int i;
         for (i = 0; i < narcs; i++)
@@ -315,12 +294,11 @@ namespace SDF
         }
     }
 
-    static
-    void Second_Order_Improvement(int *improved)
+    void HowardSolver::Second_Order_Improvement(int *improved)
     {
         int i;
         double w;
-        if (*NComponents > 1)
+        if (nComponents > 1)
         {
             for (i = 0; i < narcs; i++)
             {
@@ -356,109 +334,68 @@ namespace SDF
         }
     }
 
-    static
-    void Improve(int *improved)
+    void HowardSolver::Improve(int *improved)
     {
         *improved = 0;
         Init_Improve();
 
         /* a first order policy improvement may occur */
-        if (*NComponents > 1)
+        if (nComponents > 1)
             First_Order_Improvement(improved);
 
         if (*improved == 0)
             Second_Order_Improvement(improved);
     }
 
-    static
-    void Allocate_Memory()
-    {
-        newpi = (int *)calloc(nnodes, sizeof(int));
-        piinv_idx = (int *)calloc(nnodes, sizeof(int));
-        piinv_succ = (int *)calloc(nnodes, sizeof(int));
-        piinv_elem = (int *)calloc(nnodes, sizeof(int));
-        piinv_last = (int *)calloc(nnodes, sizeof(int));
-        visited = (int *)calloc(nnodes, sizeof(int));
-        component = (int *)calloc(nnodes, sizeof(int));
-        c = (double *)calloc(nnodes, sizeof(double));
-        newc = (double *)calloc(nnodes, sizeof(double));
-        vaux = (double *)calloc(nnodes, sizeof(double));
-        newchi = (double *)calloc(nnodes, sizeof(double));
-
-        if ((newchi == NULL) || (vaux == NULL) || (newc == NULL) || (c == NULL)
-            || (component == NULL) || (visited == NULL) || (piinv_idx == NULL)
-            || (piinv_succ == NULL) || (piinv_elem == NULL) || (piinv_last == NULL)
-            || (newpi == NULL))
-        {
-            throw CException("Failed allocation memory");
-        }
-    }
-
-    static
-    void Free_Memory()
+    /**
+     * Allocate_Memory ()
+     * The function sizes the workspace for a matrix with nnodes nodes. Buffers
+     * keep their capacity between runs, so a solver that is used for graphs of
+     * similar size does not allocate memory after its first run.
+     */
+    void HowardSolver::Allocate_Memory()
     {
-        free(newpi);
-        free(piinv_idx);
-        free(piinv_succ);
-        free(piinv_elem);
-        free(piinv_last);
-        free(visited);
-        free(component);
-        free(c);
-        free(newc);
-        free(vaux);
-        free(newchi);
+        chi.assign(nnodes, 0);
+        v.assign(nnodes, 0);
+        pi.assign(nnodes, 0);
+        piinv_idx.assign(nnodes, 0);
+        piinv_succ.assign(nnodes, 0);
+        piinv_elem.assign(nnodes, 0);
+        piinv_last.assign(nnodes, 0);
+        visited.assign(nnodes, 0);
+        component.assign(nnodes, 0);
+        c.assign(nnodes, 0);
+        newc.assign(nnodes, 0);
+        vaux.assign(nnodes, 0);
+        newchi.assign(nnodes, 0);
     }
 
-    static void Check_Rows()
+    void HowardSolver::Security_Check()
     {
         int i;
-        int *u = NULL;
-        u = (int *)calloc(nnodes, sizeof(int));
 
-        for (i = 0; i < narcs; i++)
-            u[ij[2 * i]] = 1;
-
-        for (i = 0; i < nnodes; i++)
-        {
-            if (u[i] == 0)
-                throw CException("Failed check on rows in Howard's MCM algorithm.");
-        }
-
-        free(u);
-    }
-
-    static
-    void Security_Check()
-    {
         if (nnodes < 1)
             throw CException("Howard: number of nodes must be a positive integer.");
 
         if (narcs < 1)
             throw CException("Howard: number of arcs must be a positive integer.");
 
-        Check_Rows();
-    }
+        /* every node must have an outgoing arc (visited is used as scratch) */
+        visited.assign(nnodes, 0);
 
-    static
-    void Import_Arguments(int *IJ, double *A, int NNODES, int NARCS, double *CHI,
-                          double *V, int *POLICY, int *NITERATIONS, int *NCOMPONENTS)
-    {
-        ij = IJ;
-        a = A;
-        nnodes = NNODES;
-        narcs = NARCS;
-        chi = CHI;
-        v = V;
-        pi = POLICY;
-        NIterations = NITERATIONS;
-        NComponents = NCOMPONENTS;
+        for (i = 0; i < narcs; i++)
+            visited[ij[2 * i]] = 1;
+
+        for (i = 0; i < nnodes; i++)
+        {
+            if (visited[i] == 0)
+                throw CException("Failed check on rows in Howard's MCM algorithm.");
+        }
     }
 
-    static
-    void Update_Policy()
+    void HowardSolver::Update_Policy()
     {
-        register int i;
+        int i;
 
         for (i = 0; i < nnodes; i++)
         {
@@ -468,21 +405,14 @@ namespace SDF
         }
     }
 
-    static
-    void End_Message()
-    {
-        if (*NIterations == MAX_NIterations)
-            throw CException("Howard: exceeded maximum number of iterations.");
-    }
-
     /**
-     * Howard ()
+     * solve ()
      * Howard Policy Iteration Algorithm for Max Plus Matrices.
      *
      * INPUT of Howard Algorithm:
      *      ij,A,nnodes,narcs : sparse description of a matrix.
      *
-     * OUTPUT:
+     * OUTPUT (available through the solver after the run):
      *      chi cycle time vector
      *      v bias
      *      pi optimal policy
@@ -492,9 +422,6 @@ namespace SDF
      * REQUIRES: O(nnodes) SPACE
      * One iteration requires: O(narcs+nnodes) TIME
      *
-     * The following variables should be defined in the environment from which the
-     * Howard routine is called.
-     *
      * INPUT VARIABLES
      * int NNODES;  number of nodes of the graph
      * int NARCS;   number of arcs of the graph
@@ -504,26 +431,35 @@ namespace SDF
      * double *A;   array of double of size narcs
      *              A[k]=weight of the arc numbered k
      *
-     * OUTPUT VARIABLES
-     * double *V;   array of double of size nnodes (the bias vector)
-     * double *CHI; array of double of size nnodes (the cycle time vector)
-     * int *POLICY; array of integer of size nnodes (an optimal policy)
-     * int NITERATIONS; the number of iterations of the algorithm
-     * int NCOMPONENTS; the number of connected components of the optimal
-     *               policy which is returned.
+     * The matrix must remain valid during the run. With warm start enabled and
+     * a previous run on a matrix with the same number of nodes, the optimal
+     * policy of the previous run is used as initial policy.
      */
-    static
-    void Howard(int *IJ, double *A, int NNODES, int NARCS, double *CHI, double *V,
-                int *POLICY, int *NITERATIONS, int *NCOMPONENTS)
+    void HowardSolver::solve(const int *IJ, const double *A, const int NNODES,
+                             const int NARCS)
     {
         int improved = 0;
-        *NITERATIONS = 0;
+        bool usePreviousPolicy;
+
+        usePreviousPolicy = warmStart && NNODES > 0 && pi.size() == (uint)NNODES;
+
+        ij = IJ;
+        a = A;
+        nnodes = NNODES;
+        narcs = NARCS;
+        nIterations = 0;
 
-        Import_Arguments(IJ, A, NNODES, NARCS, CHI, V, POLICY, NITERATIONS, NCOMPONENTS);
         Security_Check();
+
+        // The policy of the previous run is kept in newpi
+        if (usePreviousPolicy)
+            newpi.swap(pi);
+        else
+            newpi.assign(nnodes, 0);
+
         Allocate_Memory();
-        Epsilon(a, narcs, &epsilon);
-        Initial_Policy();
+        Epsilon();
+        Initial_Policy(usePreviousPolicy);
         New_Build_Inverse();
 
         do
@@ -532,12 +468,15 @@ namespace SDF
             Improve(&improved);
             Update_Policy();
             New_Build_Inverse();
-            (*NIterations)++;
+            nIterations++;
         }
-        while ((improved != 0) && *NIterations < MAX_NIterations);
+        while ((improved != 0) && nIterations < MAX_NIterations);
 
-        End_Message();
-        Free_Memory();
+        if (nIterations == MAX_NIterations)
+        {
+            pi.clear();
+            throw CException("Howard: exceeded maximum number of iterations.");
+        }
     }
 
     /**
@@ -545,10 +484,8 @@ namespace SDF
      * The function converts a weighted directed graph used in the MCM algorithms
      * to a sparse amtrix input for Howard's algorithm.
      */
-    static
-    void convertMCMgraphToMatrix(MCMgraph *g, int *IJ, double *A)
+    void HowardSolver::convertMCMgraphToMatrix(MCMgraph *g)
     {
-        int k = 0;
         uint i = 0, j = 0;
         v_uint mapId(g->getNodes().size());
 
@@ -565,6 +502,9 @@ namespace SDF
             i++;
         }
 
+        graphIJ.clear();
+        graphA.clear();
+
         // Create an entry in the matrices for each edge
         for (MCMedgesCIter iter = g->getEdges().begin(); iter != g->getEdges().end(); iter++)
         {
@@ -573,16 +513,70 @@ namespace SDF
             // Is the edge a existing edge in the graph?
             if (e->visible)
             {
-                IJ[2 * k] = mapId[e->src->id];
-                IJ[2 * k + 1] = mapId[e->dst->id];
-                A[k] = e->w;
-
-                // Next edge
-                k++;
+                graphIJ.push_back(mapId[e->src->id]);
+                graphIJ.push_back(mapId[e->dst->id]);
+                graphA.push_back(e->w);
             }
         }
     }
 
+    /**
+     * solve ()
+     * The function computes the maximum cycle mean of the visible nodes and
+     * edges of an MCM graph using Howard's algorithm. Every visible node must
+     * have a visible outgoing edge.
+     */
+    CDouble HowardSolver::solve(MCMgraph *g)
+    {
+        int nrNodes = g->nrVisibleNodes();
+
+        // Convert the graph to a sparse matrix
+        convertMCMgraphToMatrix(g);
+
+        // Run Howard's algorithm
+        solve(graphA.empty() ? NULL : &graphIJ[0],
+              graphA.empty() ? NULL : &graphA[0], nrNodes, graphA.size());
+
+        return getMaximumCycleMean();
+    }
+
+    /**
+     * getMaximumCycleMean ()
+     * The MCM is equal to maximum entry in the cycle time vector of the last
+     * run.
+     */
+    CDouble HowardSolver::getMaximumCycleMean() const
+    {
+        CDouble mcm = 0;
+
+        for (uint i = 0; i < chi.size(); i++)
+            if (mcm < chi[i])
+                mcm = chi[i];
+
+        return mcm;
+    }
+
+    /**
+     * solve ()
+     * The function computes the maximum cycle mean of all graphs. The graphs
+     * are distributed over a pool of nrThreads worker threads which each own
+     * a solver. When nrThreads is zero, the number of hardware threads is used.
+     * The MCM of graphs[i] is stored in mcm[i]. The first exception raised by
+     * any of the runs is rethrown after all workers have finished.
+     */
+    void HowardSolver::solve(const vector<MCMgraph *> &graphs,
+                             vector<CDouble> &mcm, uint nrThreads)
+    {
+        vector<HowardSolver> solvers(CNrWorkers(graphs.size(), nrThreads));
+
+        mcm.assign(graphs.size(), 0);
+
+        CParallelFor(graphs.size(), nrThreads, [&](uint i, uint t)
+        {
+            mcm[i] = solvers[t].solve(graphs[i]);
+        });
+    }
+
     /**
      * mcmHoward ()
      * The function computes the maximum cycle mean of a HSDF graph using Howard's
@@ -594,9 +588,7 @@ namespace SDF
         CDouble mcm;
         MCMgraphs components;
         MCMgraph *mcmGraph;
-        int nrNodes, nrEdges, nrIterations, nrComponents;
-        double *A, *v, *chi;
-        int *policy, *IJ;
+        HowardSolver solver;
 
         // Transform the HSDF to a weighted directed graph
         mcmGraph = transformHSDFtoMCMgraph(g);
@@ -607,36 +599,10 @@ namespace SDF
         // connected (H)SDF graph.
         stronglyConnectedMCMgraph(mcmGraph, components);
 
-        // Number of nodes and edges in the graph
-        nrNodes = mcmGraph->nrVisibleNodes();
-        nrEdges = mcmGraph->nrVisibleEdges();
-
-        // Allocate memory for matrices
-        IJ = new int [2 * nrEdges];
-        A = new double [nrEdges];
-        v = new double [nrNodes];
-        chi = new double [nrNodes];
-        policy = new int [nrNodes];
-
-        // Convert the graph to a sparse matrix
-        convertMCMgraphToMatrix(mcmGraph, IJ, A);
-
         // Run Howard's algorithm
-        Howard(IJ, A, nrNodes, nrEdges, chi, v, policy, &nrIterations,
-               &nrComponents);
-
-        // The MCM is equal to maximum entry in the cycle time vector
-        mcm = 0;
-        for (int i = 0; i < nrNodes; i++)
-            if (mcm < chi[i])
-                mcm = chi[i];
+        mcm = solver.solve(mcmGraph);
 
         // Cleanup
-        delete [] IJ;
-        delete [] A;
-        delete [] v;
-        delete [] chi;
-        delete [] policy;
         delete mcmGraph;
 
         return mcm;
@@ -664,4 +630,209 @@ namespace SDF
         return mcmGraph;
     }
 
-}//namespace SDF
\ No newline at end of file
+    /**
+     * maximumCycleMeanHoward ()
+     * The function computes the maximum cycle mean of an MCMgraph using Howard's
+     * algorithm.
+     */
+    CDouble maximumCycleMeanHoward(MCMgraph *g)
+    {
+        HowardSolver solver;
+
+        return solver.solve(g);
+    }
+
+    /**
+     * executesIteration ()
+     * The function returns true when all actors of the graph can complete the
+     * number of firings given by the repetition vector, i.e. when the graph
+     * does not deadlock. Only token counts are tracked.
+     */
+    static
+    bool executesIteration(const TimedSDFcompiledGraph &cg)
+    {
+        const RepetitionVector &repVec = cg.getRepetitionVector();
+        vector<uint> tokens(cg.nrChannels());
+        vector<uint> remaining(repVec.begin(), repVec.end());
+        bool progress = true, done = false;
+
+        for (CId c = 0; c < cg.nrChannels(); c++)
+            tokens[c] = cg.getInitialTokens(c);
+
+        while (progress && !done)
+        {
+            progress = false;
+            done = true;
+
+            for (CId a = 0; a < cg.nrActors(); a++)
+            {
+                uint n = remaining[a];
+
+                // Number of firings enabled by the input tokens
+                for (const TimedSDFcompiledGraph::Port *p = cg.inPortsBegin(a);
+                     p != cg.inPortsEnd(a) && n > 0; p++)
+                {
+                    if (tokens[p->channel] / p->rate < n)
+                        n = tokens[p->channel] / p->rate;
+                }
+
+                if (n > 0)
+                {
+                    for (const TimedSDFcompiledGraph::Port *p = cg.inPortsBegin(a);
+                         p != cg.inPortsEnd(a); p++)
+                    {
+                        tokens[p->channel] -= n * p->rate;
+                    }
+                    for (const TimedSDFcompiledGraph::Port *p = cg.outPortsBegin(a);
+                         p != cg.outPortsEnd(a); p++)
+                    {
+                        tokens[p->channel] += n * p->rate;
+                    }
+                    remaining[a] -= n;
+                    progress = true;
+                }
+
+                if (remaining[a] > 0)
+                    done = false;
+            }
+        }
+
+        return done;
+    }
+
+    /**
+     * transformMaxPlusMatrixToMCMgraph ()
+     * The function converts the max-plus matrix of one iteration of an SDF
+     * graph into an MCM graph. Token j becomes node j. Every finite entry
+     * (i,j) becomes an edge from node j to node i with one delay.
+     */
+    static
+    MCMgraph *transformMaxPlusMatrixToMCMgraph(const MaxPlus::Matrix &m)
+    {
+        MCMgraph *mcmGraph = new MCMgraph;
+        vector<MCMnode *> nodes(m.getRows());
+        CId edgeId = 0;
+
+        for (uint i = 0; i < m.getRows(); i++)
+        {
+            nodes[i] = new MCMnode(i, true);
+            mcmGraph->addNode(nodes[i]);
+        }
+
+        for (uint i = 0; i < m.getRows(); i++)
+        {
+            for (uint j = 0; j < m.getCols(); j++)
+            {
+                MPTime w = m.get(i, j);
+
+                if (!MP_ISMINUSINFINITY(w))
+                    mcmGraph->addEdge(edgeId++, nodes[j], nodes[i], w, 1);
+            }
+        }
+
+        return mcmGraph;
+    }
+
+    /**
+     * mcmCyclicPart ()
+     * The function computes the maximum cycle mean of the strongly connected
+     * components of an MCM graph using Howard's algorithm. Only nodes on a
+     * cycle have an outgoing edge in Howard's algorithm, so all other nodes
+     * are hidden first. The result is zero when the graph has no cycles.
+     */
+    static
+    CDouble mcmCyclicPart(MCMgraph *mcmGraph)
+    {
+        MCMgraphs components;
+        HowardSolver solver;
+        CDouble mcm;
+
+        stronglyConnectedMCMgraph(mcmGraph, components);
+
+        if (components.empty())
+            mcm = 0;
+        else
+            mcm = solver.solve(mcmGraph);
+
+        // Cleanup
+        for (MCMgraphsIter iter = components.begin();
+             iter != components.end(); iter++)
+        {
+            delete *iter;
+        }
+
+        return mcm;
+    }
+
+    /**
+     * maximumCycleMeanSDF ()
+     * The function computes the maximum cycle mean of the HSDF graph of an SDF
+     * graph using Howard's algorithm without constructing the HSDF graph. The
+     * MCM graph is built directly from the SDF graph, or from the max-plus
+     * matrix of one iteration when this matrix has fewer entries than the
+     * HSDF graph has channels.
+     */
+    CDouble maximumCycleMeanSDF(TimedSDFgraph *g)
+    {
+        TimedSDFcompiledGraph cg(g);
+        const RepetitionVector &repVec = cg.getRepetitionVector();
+        MCMgraph *mcmGraph;
+        CDouble mcm, nrTokens = 0, nrHSDFchannels = 0;
+
+        if (cg.nrActors() == 0 || repVec[0] == 0)
+            throw CException("Graph is not consistent.");
+
+        if (!executesIteration(cg))
+            throw CException("Graph deadlocks.");
+
+        // Size of the max-plus matrix and of the HSDF graph
+        for (CId c = 0; c < cg.nrChannels(); c++)
+        {
+            nrTokens += cg.getInitialTokens(c);
+            nrHSDFchannels += (CDouble)repVec[cg.getSrcActor(c)]
+                              * cg.getSrcRate(c);
+        }
+
+        if (nrTokens * nrTokens < nrHSDFchannels)
+        {
+            MaxPlusAnalysis::GraphDecoration::Graph G(g);
+            MaxPlusAnalysis::Exploration mpe;
+
+            mpe.G = &G;
+            mpe.g = g;
+            MaxPlus::Matrix *m = mpe.convertToMaxPlusMatrix();
+            mcmGraph = transformMaxPlusMatrixToMCMgraph(*m);
+            delete m;
+        }
+        else
+        {
+            mcmGraph = transformSDFtoMCMgraph(g);
+        }
+
+        mcm = mcmCyclicPart(mcmGraph);
+
+        // Cleanup
+        delete mcmGraph;
+
+        return mcm;
+    }
+
+    /**
+     * maximumCycleMeanMaxPlusMatrix ()
+     * The function computes the maximum cycle mean of the precedence graph of
+     * a square max-plus matrix, i.e. its eigenvalue, using Howard's
+     * algorithm. It returns zero when the graph has no cycles.
+     */
+    CDouble maximumCycleMeanMaxPlusMatrix(const MaxPlus::Matrix &m)
+    {
+        MCMgraph *mcmGraph;
+        CDouble mcm;
+
+        mcmGraph = transformMaxPlusMatrixToMCMgraph(m);
+        mcm = mcmCyclicPart(mcmGraph);
+        delete mcmGraph;
+
+        return mcm;
+    }
+
+}//namespace SDF
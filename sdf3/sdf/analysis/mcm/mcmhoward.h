@@ -0,0 +1,172 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   mcmhoward.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Reentrant solver object for Howard's MCM algorithm.
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef SDF_ANALYSIS_MCM_MCMHOWARD_H_INCLUDED
+#define SDF_ANALYSIS_MCM_MCMHOWARD_H_INCLUDED
+
+#include "mcmgraph.h"
+namespace SDF
+{
+    /**
+     * HowardSolver
+     * Howard's policy iteration algorithm for max-plus matrices. All state of
+     * the algorithm is kept in the solver object, so different solvers can be
+     * used concurrently from different threads. The workspace of a solver is
+     * reused between runs. When warm start is enabled, a run starts from the
+     * optimal policy of the previous run (as far as that policy is admissible
+     * for the new matrix) instead of from the greedy initial policy. This
+     * reduces the number of iterations when a sequence of similar graphs is
+     * solved (e.g. graphs that differ only in their edge weights).
+     */
+    class HowardSolver
+    {
+        public:
+            // Constructor
+            HowardSolver() : nnodes(0), narcs(0), nIterations(0),
+                nComponents(0), lambda(0), epsilon(0), color(1),
+                warmStart(false) {};
+
+            // Destructor
+            ~HowardSolver() {};
+
+            // Start a run from the policy of the previous run
+            void setWarmStart(const bool flag)
+            {
+                warmStart = flag;
+            };
+            bool getWarmStart() const
+            {
+                return warmStart;
+            };
+
+            // Maximum cycle mean of the visible nodes and edges of a graph
+            CDouble solve(MCMgraph *g);
+
+            // Howard's algorithm on a sparse matrix (see mcmhoward.cc)
+            void solve(const int *IJ, const double *A, const int NNODES,
+                       const int NARCS);
+
+            // Results of the last run
+            const vector<double> &getCycleTimeVector() const
+            {
+                return chi;
+            };
+            const vector<double> &getBias() const
+            {
+                return v;
+            };
+            const vector<int> &getPolicy() const
+            {
+                return pi;
+            };
+            int getNrIterations() const
+            {
+                return nIterations;
+            };
+            int getNrComponents() const
+            {
+                return nComponents;
+            };
+            CDouble getMaximumCycleMean() const;
+
+            // Maximum cycle mean of a set of graphs using nrThreads threads
+            // (0 selects the number of hardware threads)
+            static void solve(const vector<MCMgraph *> &graphs,
+                              vector<CDouble> &mcm, uint nrThreads = 0);
+
+        private:
+            // Steps of the algorithm
+            void Security_Check();
+            void Allocate_Memory();
+            void Epsilon();
+            void Initial_Policy(const bool usePreviousPolicy);
+            void New_Build_Inverse();
+            void Init_Depth_First();
+            void New_Depth_First_Label(int i);
+            void Visit_From(int initialpoint, int color);
+            void Value();
+            void Init_Improve();
+            void First_Order_Improvement(int *improved);
+            void Second_Order_Improvement(int *improved);
+            void Improve(int *improved);
+            void Update_Policy();
+
+            // Conversion of an MCM graph to a sparse matrix
+            void convertMCMgraphToMatrix(MCMgraph *g);
+
+            // Sparse matrix
+            const int *ij;
+            const double *a;
+            int nnodes;
+            int narcs;
+
+            // Sparse matrix of the last converted MCM graph
+            vector<int> graphIJ;
+            vector<double> graphA;
+
+            // Cycle time vector, bias and policy
+            vector<double> chi;
+            vector<double> v;
+            vector<int> pi;
+            int nIterations;
+            int nComponents;
+
+            // New policy
+            vector<int> newpi;
+
+            // The inverse policy is coded by a linearly chained list.
+            // piinv_idx[i]= pointer to the chain of inverses of node i,
+            // piinv_succ[j]= pointer to the next inverse, piinv_elem[j]=
+            // corresponding node and piinv_last[i]= last inverse of i.
+            vector<int> piinv_idx;
+            vector<int> piinv_succ;
+            vector<int> piinv_elem;
+            vector<int> piinv_last;
+
+            // Workspace
+            vector<double> c;
+            vector<double> vaux;
+            vector<double> newc;
+            vector<double> newchi;
+            vector<int> visited;
+            vector<int> component;
+            double lambda;
+            double epsilon;
+            int color;
+
+            // Start from the policy of the previous run
+            bool warmStart;
+    };
+
+}//namespace SDF
+#endif
@@ -19,6 +19,7 @@
  *
  *  History         :
  *      08-11-05    :   Initial version.
+ *      17-10-26    :   Subtree update state is thread-local.
  *
  * $Id: mcmyto.cc,v 1.1.1.1.2.1 2009-03-20 20:35:29 sander Exp $
  *
@@ -271,8 +272,10 @@ namespace SDF
         free(h->items);
     }
 
-    static long update_level;
-    static node *upd_nodes;
+    // State of update_subtree (one per thread, so that graphs can be
+    // solved concurrently)
+    static thread_local long update_level;
+    static thread_local node *upd_nodes;
 
     /**
      * update_subtree ()
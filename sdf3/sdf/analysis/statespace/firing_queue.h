@@ -0,0 +1,130 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   firing_queue.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Queue of active actor firings
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef SDF_ANALYSIS_STATESPACE_FIRING_QUEUE_H_INCLUDED
+#define SDF_ANALYSIS_STATESPACE_FIRING_QUEUE_H_INCLUDED
+
+#include "../../base/timed/graph.h"
+
+namespace SDF
+{
+    /**
+     * SDFfiringQueue
+     * Active firings of one actor in the order in which they were started. Each
+     * firing is represented by the absolute time at which it ends. The firings
+     * are kept in a flat ring buffer whose capacity is a power of two, so a
+     * state-space exploration does not allocate a list node for every firing
+     * it starts.
+     */
+    class SDFfiringQueue
+    {
+        public:
+            // Constructor
+            SDFfiringQueue() : head(0), count(0) {};
+
+            // Destructor
+            ~SDFfiringQueue() {};
+
+            // Number of active firings
+            bool empty() const
+            {
+                return count == 0;
+            };
+            uint size() const
+            {
+                return count;
+            };
+
+            // Access to the firings (0 is the oldest firing)
+            unsigned long &front()
+            {
+                return buf[head];
+            };
+            unsigned long front() const
+            {
+                return buf[head];
+            };
+            unsigned long &operator[](const uint i)
+            {
+                return buf[(head + i) & (buf.size() - 1)];
+            };
+            unsigned long operator[](const uint i) const
+            {
+                return buf[(head + i) & (buf.size() - 1)];
+            };
+
+            // Add a firing after the newest firing
+            void push_back(const unsigned long t)
+            {
+                if (count == buf.size())
+                    grow();
+
+                buf[(head + count) & (buf.size() - 1)] = t;
+                count++;
+            };
+
+            // Remove the oldest firing
+            void pop_front()
+            {
+                head = (head + 1) & (buf.size() - 1);
+                count--;
+            };
+
+            // Remove all firings
+            void clear()
+            {
+                head = 0;
+                count = 0;
+            };
+
+        private:
+            // Double the capacity of the ring buffer
+            void grow()
+            {
+                vector<unsigned long> b(buf.empty() ? 4 : 2 * buf.size());
+
+                for (uint i = 0; i < count; i++)
+                    b[i] = (*this)[i];
+
+                buf.swap(b);
+                head = 0;
+            };
+
+            // Ring buffer
+            vector<unsigned long> buf;
+            uint head;
+            uint count;
+    };
+
+}//namespace SDF
+#endif
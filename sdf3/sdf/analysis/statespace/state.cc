@@ -0,0 +1,223 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   state.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Shared state of the SDF state-space explorations
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "state.h"
+
+namespace SDF
+{
+    /**
+     * operator== ()
+     * The function compares to states and returns true if they are equal.
+     */
+    bool SDFstateSpaceState::operator==(const SDFstateSpaceState &s) const
+    {
+        if (glbClk != s.glbClk)
+            return false;
+
+        for (uint i = 0; i < ch.size(); i++)
+        {
+            if (ch[i] != s.ch[i])
+                return false;
+        }
+
+        for (uint i = 0; i < actClk.size(); i++)
+        {
+            if (actClk[i].size() != s.actClk[i].size())
+                return false;
+
+            for (uint j = 0; j < actClk[i].size(); j++)
+            {
+                if (remainingTime(i, j) != s.remainingTime(i, j))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * clear ()
+     * The function sets the state to zero.
+     */
+    void SDFstateSpaceState::clear()
+    {
+        for (uint i = 0; i < actClk.size(); i++)
+        {
+            actClk[i].clear();
+        }
+
+        for (uint i = 0; i < ch.size(); i++)
+        {
+            ch[i] = 0;
+        }
+
+        events.clear();
+        glbClk = 0;
+        now = 0;
+    }
+
+    /**
+     * print ()
+     * Print the state to the supplied stream.
+     */
+    void SDFstateSpaceState::print(ostream &out) const
+    {
+        out << "### State ###" << endl;
+
+        for (uint i = 0; i < actClk.size(); i++)
+        {
+            out << "actClk[" << i << "] =";
+
+            for (uint j = 0; j < actClk[i].size(); j++)
+            {
+                out << " " << remainingTime(i, j) << ", ";
+            }
+
+            out << endl;
+        }
+
+        for (uint i = 0; i < ch.size(); i++)
+        {
+            out << "ch[" << i << "] = " << ch[i] << endl;
+        }
+
+        out << "glbClk = " << glbClk << endl;
+    }
+
+    /**
+     * pack ()
+     * The function packs the state into a sequence of words. The global clock
+     * is stored in the first word, followed by the channel contents and, for
+     * every actor, the number of active firings and their remaining times.
+     */
+    void SDFstateSpaceState::pack(vector<SDFstateWord> &s) const
+    {
+        s.clear();
+        s.push_back(glbClk);
+
+        for (uint i = 0; i < ch.size(); i++)
+            s.push_back(ch[i]);
+
+        for (uint i = 0; i < actClk.size(); i++)
+        {
+            s.push_back(actClk[i].size());
+
+            for (uint j = 0; j < actClk[i].size(); j++)
+                s.push_back(remainingTime(i, j));
+        }
+    }
+
+    /**
+     * dropStaleEvents ()
+     * The function removes events from the top of the event queue whose actor
+     * has no longer a first firing that ends at the time of the event.
+     */
+    void SDFstateSpaceState::dropStaleEvents()
+    {
+        while (!events.empty())
+        {
+            const Event &e = events.front();
+
+            if (!actClk[e.second].empty() && actClk[e.second].front() == e.first)
+                break;
+
+            std::pop_heap(events.begin(), events.end(), std::greater<Event>());
+            events.pop_back();
+        }
+    }
+
+    /**
+     * clockStep ()
+     * The function progresses time till the first end of firing transition
+     * becomes enabled, but with at most maxStep time-units. The time step is
+     * returned. In case of deadlock, the time step is equal to UINT_MAX.
+     */
+    SDFtime SDFstateSpaceState::clockStep(SDFtime maxStep)
+    {
+        SDFtime step = maxStep;
+
+        // Find maximal time progress
+        dropStaleEvents();
+        if (!events.empty())
+        {
+            unsigned long end = events.front().first;
+
+            if (end <= now)
+                step = 0;
+            else if (step > end - now)
+                step = end - now;
+        }
+
+        // Still actors ready to end their firing?
+        if (step == 0)
+            return 0;
+
+        // Check for progress (i.e. no deadlock)
+        if (step == UINT_MAX)
+            return UINT_MAX;
+
+        // Advance the clocks
+        now += step;
+        glbClk += step;
+
+        return step;
+    }
+
+    /**
+     * actorsReadyToEnd ()
+     * The function returns the actors that have a firing which ends at the
+     * current time. The actors are sorted on their id and the events of their
+     * first firings are removed from the event queue; endFiring() adds the
+     * event of the next firing of an actor.
+     */
+    void SDFstateSpaceState::actorsReadyToEnd(vector<CId> &actors)
+    {
+        actors.clear();
+
+        while (true)
+        {
+            dropStaleEvents();
+
+            if (events.empty() || events.front().first > now)
+                break;
+
+            actors.push_back(events.front().second);
+            std::pop_heap(events.begin(), events.end(), std::greater<Event>());
+            events.pop_back();
+        }
+
+        std::sort(actors.begin(), actors.end());
+        actors.erase(std::unique(actors.begin(), actors.end()), actors.end());
+    }
+
+}//namespace SDF
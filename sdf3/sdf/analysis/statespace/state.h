@@ -0,0 +1,230 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   state.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Shared state of the SDF state-space explorations
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef SDF_ANALYSIS_STATESPACE_STATE_H_INCLUDED
+#define SDF_ANALYSIS_STATESPACE_STATE_H_INCLUDED
+
+#include "firing_queue.h"
+#include "state_store.h"
+#include <algorithm>
+#include <functional>
+
+namespace SDF
+{
+    /**
+     * SDFstateSpaceState
+     * The part of a state that is shared by all state-space explorations: the
+     * active firings of every actor, the tokens in every channel and the time
+     * since the previously stored state. An exploration that needs additional
+     * state information (e.g. storage space or schedule positions) derives
+     * its state from this class and extends clear(), print() and pack().
+     *
+     * Active firings are kept as absolute end times. The first firing of every
+     * actor that has active firings is also kept in a min-heap on its end
+     * time, so a clock step only inspects the earliest firing and does not
+     * touch the other firings. Entries of the heap are removed lazily: an
+     * entry whose actor has no longer a first firing with the same end time
+     * is discarded when it reaches the top of the heap. Two states are equal
+     * when their remaining execution times are equal; the absolute clock is
+     * not part of the state.
+     */
+    class SDFstateSpaceState
+    {
+        public:
+            // Constructor
+            SDFstateSpaceState(const uint nrActors = 0, const uint nrChannels = 0)
+            {
+                init(nrActors, nrChannels);
+            };
+
+            // Destructor
+            ~SDFstateSpaceState() {};
+
+            // Initialize the state
+            void init(const uint nrActors, const uint nrChannels)
+            {
+                actClk.resize(nrActors);
+                ch.resize(nrChannels);
+                glbClk = 0;
+                now = 0;
+            };
+
+            // Compare states
+            bool operator==(const SDFstateSpaceState &s) const;
+
+            // Clear state
+            void clear();
+
+            // Output state
+            void print(ostream &out) const;
+
+            // Pack state into a sequence of words
+            void pack(vector<SDFstateWord> &s) const;
+
+            // Progress time till the first firing ends (at most maxStep)
+            SDFtime clockStep(SDFtime maxStep = UINT_MAX);
+
+            // Start a firing of actor a which takes execTime time-units
+            void startFiring(const CId a, const SDFtime execTime)
+            {
+                if (actClk[a].empty())
+                    pushEvent(now + execTime, a);
+
+                actClk[a].push_back(now + execTime);
+            };
+
+            // Is the first firing of actor a ending at the current time?
+            bool readyToEnd(const CId a) const
+            {
+                return !actClk[a].empty() && actClk[a].front() <= now;
+            };
+
+            // End the first firing of actor a
+            void endFiring(const CId a)
+            {
+                actClk[a].pop_front();
+
+                if (!actClk[a].empty())
+                    pushEvent(actClk[a].front(), a);
+            };
+
+            // Remaining execution time of the i-th firing of actor a
+            SDFtime remainingTime(const CId a, const uint i) const
+            {
+                return actClk[a][i] > now ? actClk[a][i] - now : 0;
+            };
+
+            // Actors with a firing that ends at the current time
+            void actorsReadyToEnd(vector<CId> &actors);
+
+            // State information
+            vector<SDFfiringQueue> actClk;
+            vector<TBufSize> ch;
+            unsigned long glbClk;
+
+        private:
+            // Event in the queue of first firings
+            typedef pair<unsigned long, CId> Event;
+
+            // Add an event to the queue
+            void pushEvent(const unsigned long end, const CId a)
+            {
+                events.push_back(Event(end, a));
+                std::push_heap(events.begin(), events.end(),
+                               std::greater<Event>());
+            };
+
+            // Remove events of firings which are no longer first firings
+            void dropStaleEvents();
+
+            // Absolute time
+            unsigned long now;
+
+            // Min-heap of first firings on their end time
+            vector<Event> events;
+    };
+
+    /**
+     * SDFvisitedStates
+     * Hashed set of the states visited by a state-space exploration. The state
+     * type is the policy that defines the semantics of the exploration; it must
+     * provide a pack() function which stores the global clock in the first word
+     * of the packed state. States are numbered in the order in which they are
+     * stored, so the states on a recurrent cycle are the states from the index
+     * of the recurrent state up to the last stored state.
+     */
+    template <class State>
+    class SDFvisitedStates
+    {
+        public:
+            // Constructor
+            SDFvisitedStates() {};
+
+            // Destructor
+            ~SDFvisitedStates() {};
+
+            // Store state s (returns false when s was already stored)
+            bool store(const State &s, uint &pos)
+            {
+                s.pack(packedState);
+
+                return states.insert(&packedState[0], packedState.size(),
+                                     SDFstateStore::fingerprint(&packedState[0],
+                                             packedState.size()), pos);
+            };
+
+            // Remove all stored states
+            void clear()
+            {
+                states.clear();
+            };
+
+            // Number of stored states
+            uint size() const
+            {
+                return states.size();
+            };
+
+            // Time between state idx and its predecessor
+            unsigned long glbClk(const uint idx) const
+            {
+                return states.getState(idx)[0];
+            };
+
+            // Length of the cycle starting in state idx
+            unsigned long lengthOfCycle(const uint idx) const
+            {
+                unsigned long time = 0;
+
+                for (uint i = idx; i < size(); i++)
+                    time += glbClk(i);
+
+                return time;
+            };
+
+            // Number of states on the cycle starting in state idx
+            uint statesOnCycle(const uint idx) const
+            {
+                return size() - idx;
+            };
+
+        private:
+            // Stored states
+            SDFstateStore states;
+
+            // Buffer used to pack a state
+            vector<SDFstateWord> packedState;
+    };
+
+}//namespace SDF
+#endif
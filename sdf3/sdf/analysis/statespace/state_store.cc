@@ -0,0 +1,154 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   state_store.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Hashed store of visited states
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "state_store.h"
+#include <string.h>
+
+// Initial number of slots in the hash table (must be a power of two)
+#define STATE_STORE_INIT_SLOTS  1024
+
+namespace SDF
+{
+    /**
+     * SDFstateStore ()
+     * Constructor.
+     */
+    SDFstateStore::SDFstateStore()
+    {
+        clear();
+    }
+
+    /**
+     * clear ()
+     * The function removes all states from the store.
+     */
+    void SDFstateStore::clear()
+    {
+        arena.clear();
+        offsets.clear();
+        offsets.push_back(0);
+        fingerprints.clear();
+        table.assign(STATE_STORE_INIT_SLOTS, 0);
+        mask = STATE_STORE_INIT_SLOTS - 1;
+    }
+
+    /**
+     * fingerprint ()
+     * The function computes the fingerprint of a packed state.
+     */
+    ulong SDFstateStore::fingerprint(const SDFstateWord *s, const uint length)
+    {
+        ulong h = length;
+
+        for (uint i = 0; i < length; i++)
+            h = fingerprint(h, s[i]);
+
+        return h;
+    }
+
+    /**
+     * equal ()
+     * The function returns true when the state stored at index idx is equal to
+     * the packed state s.
+     */
+    bool SDFstateStore::equal(const uint idx, const SDFstateWord *s,
+                              const uint length) const
+    {
+        if (getStateLength(idx) != length)
+            return false;
+
+        return memcmp(getState(idx), s, length * sizeof(SDFstateWord)) == 0;
+    }
+
+    /**
+     * rehash ()
+     * The function resizes the hash table to nrSlots slots and reinserts all
+     * stored states.
+     */
+    void SDFstateStore::rehash(const uint nrSlots)
+    {
+        table.assign(nrSlots, 0);
+        mask = nrSlots - 1;
+
+        for (uint i = 0; i < size(); i++)
+        {
+            uint slot = fingerprints[i] & mask;
+
+            while (table[slot] != 0)
+                slot = (slot + 1) & mask;
+
+            table[slot] = i + 1;
+        }
+    }
+
+    /**
+     * insert ()
+     * The function stores the packed state s (of the given length) whenever s
+     * is not already in the store. When s is stored, the function returns true.
+     * When s is already in the store, the function returns false. The function
+     * always sets idx to the index of the state s in the store.
+     */
+    bool SDFstateStore::insert(const SDFstateWord *s, const uint length,
+                               const ulong fingerprint, uint &idx)
+    {
+        uint slot = fingerprint & mask;
+
+        // Linear probing till the state or an empty slot is found
+        while (table[slot] != 0)
+        {
+            uint i = table[slot] - 1;
+
+            if (fingerprints[i] == fingerprint && equal(i, s, length))
+            {
+                idx = i;
+                return false;
+            }
+
+            slot = (slot + 1) & mask;
+        }
+
+        // State not found, append it to the arena
+        idx = size();
+        arena.insert(arena.end(), s, s + length);
+        offsets.push_back(arena.size());
+        fingerprints.push_back(fingerprint);
+        table[slot] = idx + 1;
+
+        // Keep load factor of the table below 1/2
+        if (2 * size() > table.size())
+            rehash(2 * table.size());
+
+        return true;
+    }
+
+}//namespace SDF
@@ -0,0 +1,117 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   state_store.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Hashed store of visited states
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef SDF_ANALYSIS_STATESPACE_STATE_STORE_H_INCLUDED
+#define SDF_ANALYSIS_STATESPACE_STATE_STORE_H_INCLUDED
+
+#include "../../basic_types.h"
+#include "../../../base/basic_types.h"
+
+namespace SDF
+{
+    // Word from which packed states are built
+    typedef unsigned long SDFstateWord;
+
+    /**
+     * SDFstateStore
+     * Set of visited states used by the state-space explorations. A state is
+     * packed by the caller into a sequence of words. All stored states are kept
+     * back-to-back in one contiguous arena and are indexed through a flat
+     * open-addressing hash table on their fingerprint. States are numbered in
+     * the order in which they are inserted, which allows an analysis to walk
+     * the states on a recurrent cycle (i.e. from the index of the recurrent
+     * state up to the last stored state).
+     */
+    class SDFstateStore
+    {
+        public:
+            // Constructor
+            SDFstateStore();
+
+            // Destructor
+            ~SDFstateStore() {};
+
+            // Remove all stored states
+            void clear();
+
+            // Insert a packed state
+            bool insert(const SDFstateWord *s, const uint length,
+                        const ulong fingerprint, uint &idx);
+
+            // Number of stored states
+            uint size() const
+            {
+                return fingerprints.size();
+            };
+
+            // Access to stored states
+            const SDFstateWord *getState(const uint idx) const
+            {
+                return &arena[offsets[idx]];
+            };
+            uint getStateLength(const uint idx) const
+            {
+                return offsets[idx + 1] - offsets[idx];
+            };
+
+            // Fingerprint computation
+            static ulong fingerprint(const SDFstateWord *s, const uint length);
+            static ulong fingerprint(ulong h, const SDFstateWord w)
+            {
+                h ^= w + 0x9e3779b97f4a7c15UL + (h << 6) + (h >> 2);
+                h ^= h >> 33;
+                h *= 0xff51afd7ed558ccdUL;
+                h ^= h >> 33;
+                return h;
+            };
+
+        private:
+            // Resize the hash table
+            void rehash(const uint nrSlots);
+
+            // Equality of stored state and packed state
+            bool equal(const uint idx, const SDFstateWord *s,
+                       const uint length) const;
+
+            // Packed states
+            vector<SDFstateWord> arena;
+            vector<size_t> offsets;
+            vector<ulong> fingerprints;
+
+            // Hash table (slot contains state index + 1, 0 marks empty slot)
+            vector<uint> table;
+            uint mask;
+    };
+
+}//namespace SDF
+#endif
@@ -0,0 +1,52 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   statespace.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Shared state-space exploration support
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef SDF_ANALYSIS_STATESPACE_STATESPACE_H_INCLUDED
+#define SDF_ANALYSIS_STATESPACE_STATESPACE_H_INCLUDED
+
+/**
+ * Hashed store of visited states
+ * Packed states are kept in a contiguous arena and are found back through an
+ * open-addressing hash table on their fingerprint.
+ */
+#include "state_store.h"
+
+/**
+ * Shared state of the state-space explorations
+ * The active firings, channel contents and global clock of a state together
+ * with a hashed set of visited states that is parameterized with the state
+ * type of an exploration.
+ */
+#include "state.h"
+
+#endif
@@ -0,0 +1,819 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   maxplus_throughput.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Throughput calculation from the max-plus matrix of
+ *                      an SDFG
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "maxplus_throughput.h"
+#include "deadlock.h"
+#include "../maxplus/mpexplore.h"
+#include "../mcm/mcm.h"
+#include "../../base/algo/components.h"
+
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <limits.h>
+#include <math.h>
+
+namespace SDF
+{
+    /******************************************************************************
+     * Eigenvalue
+     *****************************************************************************/
+
+    /**
+     * Maximal number of power iterations per strongly connected component is
+     * POWER_ITERATIONS_BASE plus POWER_ITERATIONS_PER_ROW times its number of
+     * rows. Components which do not become periodic within this bound are
+     * handled by the MCM analysis.
+     */
+#define POWER_ITERATIONS_BASE       1000
+#define POWER_ITERATIONS_PER_ROW    10
+
+    /**
+     * Relative tolerance used to compare normalized iterates.
+     */
+#define POWER_ITERATION_TOLERANCE   1e-9
+
+    /**
+     * hashVector ()
+     * Hash of a normalized max-plus vector. Elements are rounded to a
+     * precision well above the tolerance used to compare iterates, so
+     * vectors that compare equal almost always have the same hash.
+     */
+    static
+    size_t hashVector(const MaxPlus::Vector &v)
+    {
+        size_t h = v.getSize();
+
+        for (uint i = 0; i < v.getSize(); i++)
+        {
+            long long e;
+
+            if (MaxPlus::MP_ISMINUSINFINITY(v.get(i)))
+                e = LLONG_MIN;
+            else
+                e = (long long)floor(v.get(i) * 1e6 + 0.5);
+
+            h = h * 1000003 ^ (size_t)e;
+        }
+
+        return h;
+    }
+
+    /**
+     * equalVectors ()
+     * The function returns true when both max-plus vectors have the same
+     * -inf elements and their finite elements differ at most tolerance.
+     */
+    static
+    bool equalVectors(const MaxPlus::Vector &a, const MaxPlus::Vector &b,
+                      CDouble tolerance)
+    {
+        for (uint i = 0; i < a.getSize(); i++)
+        {
+            bool infA = MaxPlus::MP_ISMINUSINFINITY(a.get(i));
+            bool infB = MaxPlus::MP_ISMINUSINFINITY(b.get(i));
+
+            if (infA != infB)
+                return false;
+
+            if (!infA && fabs(a.get(i) - b.get(i)) > tolerance)
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * eigenvalueIrreducible ()
+     * The function computes the eigenvalue of an irreducible max-plus matrix
+     * by power iteration from the zero vector. The iterates are normalized
+     * on their largest element. Once an iterate equals an earlier one (within
+     * a tolerance relative to the largest element of the matrix), the
+     * sequence is periodic and the eigenvalue is the average growth over the
+     * period. The iterates of an irreducible matrix always become periodic,
+     * but with non-integer elements rounding may hide the period and the
+     * transient can be long. When no period is found within a bounded number
+     * of iterations, the eigenvalue is computed as the MCM of the matrix.
+     */
+    static
+    CDouble eigenvalueIrreducible(const MaxPlus::Matrix &m)
+    {
+        const uint maxNrIterations = POWER_ITERATIONS_BASE
+                                     + POWER_ITERATIONS_PER_ROW * m.getRows();
+        const CDouble tolerance = POWER_ITERATION_TOLERANCE
+                                  * (1 + fabs(m.largestFiniteElement()));
+        vector<MaxPlus::Vector *> iterates;
+        vector<CDouble> time;
+        multimap<size_t, uint> index;
+        CDouble lambda = 0;
+        bool periodic = false;
+
+        iterates.push_back(new MaxPlus::Vector(m.getRows(), 0));
+        time.push_back(0);
+        index.insert(make_pair(hashVector(*iterates[0]), 0));
+
+        while (iterates.size() <= maxNrIterations)
+        {
+            MaxPlus::Vector *x = m.mpmultiply(*iterates.back());
+            CDouble norm = x->norm();
+
+            // All paths ended, i.e. the matrix has no cycles
+            if (MaxPlus::MP_ISMINUSINFINITY(norm))
+            {
+                delete x;
+                periodic = true;
+                break;
+            }
+
+            x->add(MPTime(-norm), x);
+
+            // Iterate seen before?
+            size_t h = hashVector(*x);
+            for (multimap<size_t, uint>::iterator iter = index.lower_bound(h);
+                 iter != index.end() && iter->first == h; iter++)
+            {
+                uint j = iter->second;
+
+                if (equalVectors(*x, *iterates[j], tolerance))
+                {
+                    lambda = (time.back() + norm - time[j])
+                             / (iterates.size() - j);
+                    periodic = true;
+                    break;
+                }
+            }
+
+            if (periodic)
+            {
+                delete x;
+                break;
+            }
+
+            index.insert(make_pair(h, (uint)iterates.size()));
+            time.push_back(time.back() + norm);
+            iterates.push_back(x);
+        }
+
+        // Cleanup
+        for (uint i = 0; i < iterates.size(); i++)
+            delete iterates[i];
+
+        // No period found within the bound
+        if (!periodic)
+            lambda = maximumCycleMeanMaxPlusMatrix(m);
+
+        return lambda;
+    }
+
+    /**
+     * stronglyConnectedComponents ()
+     * The function returns the strongly connected components of the
+     * precedence graph of a square max-plus matrix, which has an edge from j
+     * to i for every finite element (i,j). Components without a cycle are
+     * omitted. The components are found with Tarjan's algorithm using an
+     * explicit stack.
+     */
+    static
+    void stronglyConnectedComponents(const MaxPlus::Matrix &m,
+                                     vector< list<uint> > &components)
+    {
+        const uint N = m.getRows();
+        vector<uint> order(N, UINT_MAX), lowLink(N, 0), nextCol(N, 0);
+        vector<bool> onStack(N, false);
+        vector<uint> stack, path;
+        uint nrVisited = 0;
+
+        for (uint root = 0; root < N; root++)
+        {
+            if (order[root] != UINT_MAX)
+                continue;
+
+            path.push_back(root);
+            order[root] = lowLink[root] = nrVisited++;
+            stack.push_back(root);
+            onStack[root] = true;
+
+            while (!path.empty())
+            {
+                uint i = path.back();
+
+                // Visit the next successor of i
+                if (nextCol[i] < N)
+                {
+                    uint j = nextCol[i]++;
+
+                    if (MaxPlus::MP_ISMINUSINFINITY(m.get(i, j)))
+                        continue;
+
+                    if (order[j] == UINT_MAX)
+                    {
+                        order[j] = lowLink[j] = nrVisited++;
+                        stack.push_back(j);
+                        onStack[j] = true;
+                        path.push_back(j);
+                    }
+                    else if (onStack[j] && order[j] < lowLink[i])
+                    {
+                        lowLink[i] = order[j];
+                    }
+                    continue;
+                }
+
+                // All successors visited; i is the root of a component?
+                path.pop_back();
+                if (!path.empty() && lowLink[i] < lowLink[path.back()])
+                    lowLink[path.back()] = lowLink[i];
+
+                if (lowLink[i] == order[i])
+                {
+                    list<uint> component;
+                    uint j;
+
+                    do
+                    {
+                        j = stack.back();
+                        stack.pop_back();
+                        onStack[j] = false;
+                        component.push_back(j);
+                    }
+                    while (j != i);
+
+                    if (component.size() > 1
+                        || !MaxPlus::MP_ISMINUSINFINITY(m.get(i, i)))
+                    {
+                        components.push_back(component);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * eigenvaluePowerIteration ()
+     * The function computes the eigenvalue of a square max-plus matrix by
+     * power iteration. The normalized iterates of a reducible matrix need
+     * not become periodic, so the eigenvalue is computed as the maximum of
+     * the eigenvalues of the strongly connected components. The function
+     * returns zero when the matrix has no cycles.
+     */
+    CDouble SDFmaxPlusThroughputAnalysis::eigenvaluePowerIteration(
+        const MaxPlus::Matrix &m)
+    {
+        vector< list<uint> > components;
+        CDouble lambda = 0;
+
+        stronglyConnectedComponents(m, components);
+
+        for (uint i = 0; i < components.size(); i++)
+        {
+            MaxPlus::Matrix *c = m.getSubMatrix(components[i]);
+            CDouble lambdaC = eigenvalueIrreducible(*c);
+            delete c;
+
+            if (i == 0 || lambdaC > lambda)
+                lambda = lambdaC;
+        }
+
+        return lambda;
+    }
+
+    /**
+     * eigenvalue ()
+     * The function computes the eigenvalue of a square max-plus matrix with
+     * the selected method. It returns zero when the matrix has no cycles.
+     */
+    CDouble SDFmaxPlusThroughputAnalysis::eigenvalue(
+        const MaxPlus::Matrix &m) const
+    {
+        if (method == PowerIteration)
+            return eigenvaluePowerIteration(m);
+
+        return maximumCycleMeanMaxPlusMatrix(m);
+    }
+
+    /******************************************************************************
+     * SDF
+     *****************************************************************************/
+
+    /**
+     * analyze ()
+     * Compute the throughput of an SDF graph for unconstrained buffer sizes and
+     * using auto-concurrency. The max-plus matrix of one iteration of the graph
+     * is computed with a symbolic execution of the iteration. The throughput
+     * is the inverse of its eigenvalue, which is the time of one iteration in
+     * the periodic regime.
+     */
+    TDtime SDFmaxPlusThroughputAnalysis::analyze(TimedSDFgraph *g)
+    {
+        SDFstateSpaceDeadlockAnalysis deadlockAnalysisAlgo;
+        MaxPlus::Matrix *m;
+        CDouble lambda;
+
+        // The symbolic execution needs an input on every actor
+        for (SDFactorsIter iter = g->actorsBegin();
+             iter != g->actorsEnd(); iter++)
+        {
+            SDFactor *a = *iter;
+            bool hasInput = false;
+
+            for (SDFportsIter iterP = a->portsBegin();
+                 iterP != a->portsEnd(); iterP++)
+            {
+                if ((*iterP)->getType() == SDFport::In)
+                    hasInput = true;
+            }
+
+            if (!hasInput)
+                throw CException("Actor without input in max-plus throughput "
+                                 "analysis.");
+        }
+
+        // No tokens flow through a deadlocked graph
+        if (!deadlockAnalysisAlgo.isDeadlockFree(g))
+            return 0;
+
+        // Max-plus matrix of one iteration
+        MaxPlusAnalysis::GraphDecoration::Graph G(g);
+        MaxPlusAnalysis::Exploration mpe;
+        mpe.G = &G;
+        mpe.g = g;
+        m = mpe.convertToMaxPlusMatrix();
+
+        lambda = eigenvalue(*m);
+        delete m;
+
+        if (lambda <= 0)
+            return TDTIME_MAX;
+
+        return 1.0 / lambda;
+    }
+
+    /******************************************************************************
+     * Binding-aware SDF
+     *****************************************************************************/
+
+    /**
+     * BindingAwareExecution
+     * Execution of a binding-aware SDFG in which every firing completes
+     * immediately. Actors bound to a processor fire in the order of the
+     * static-order schedule of the processor. The execution proceeds in
+     * rounds in which every actor fires as often as it is enabled, so the
+     * state at the start of a round determines the rest of the execution.
+     *
+     * In symbolic mode, every token and every processor carries a max-plus
+     * vector that expresses its time (the production time of the token or
+     * the end of the last firing on the processor) in the times of the tokens
+     * and processors at the start of the symbolic execution. Tokens produced
+     * by the same firing share their vector.
+     */
+    class BindingAwareExecution
+    {
+        public:
+            typedef std::shared_ptr<MaxPlus::Vector> Time;
+
+            // Constructor
+            BindingAwareExecution(BindingAwareSDFG *bg,
+                                  const TimedSDFcompiledGraph &cg,
+                                  const vector<CId> &actorTile)
+                : bg(bg), g(cg), actorTile(actorTile), symbolic(false),
+                  nrVariables(0)
+            {
+                reset();
+            };
+
+            // Return to the initial state of the graph
+            void reset()
+            {
+                tokens.resize(g.nrChannels());
+                for (CId c = 0; c < g.nrChannels(); c++)
+                    tokens[c] = g.getInitialTokens(c);
+                schedulePos.resize(bg->nrTilesInPlatformGraph());
+                for (uint t = 0; t < schedulePos.size(); t++)
+                    bg->getScheduleOnTile(t).initPosition(schedulePos[t]);
+                nrFirings.assign(g.nrActors(), 0);
+                symbolic = false;
+                fifo.clear();
+                tileTime.clear();
+            };
+
+            // Start a symbolic execution in the current state
+            void startSymbolicExecution();
+
+            // Fire all enabled actors (returns false on deadlock)
+            bool round();
+
+            // Max-plus matrix of the symbolic execution
+            MaxPlus::Matrix *getMatrix() const;
+
+            // Discrete state: token counts followed by schedule positions
+            vector<uint> getState() const
+            {
+                vector<uint> s(tokens);
+                for (uint t = 0; t < schedulePos.size(); t++)
+                    s.push_back(schedulePos[t].index);
+                return s;
+            };
+
+            // Number of firings of an actor since the last reset
+            unsigned long long getNrFirings(const CId a) const
+            {
+                return nrFirings[a];
+            };
+
+        private:
+            bool actorReadyToFire(const CId a);
+            void fire(const CId a);
+
+            // Graph
+            BindingAwareSDFG *bg;
+            const TimedSDFcompiledGraph &g;
+            const vector<CId> &actorTile;
+
+            // Discrete state
+            vector<uint> tokens;
+            vector<StaticOrderSchedulePosition> schedulePos;
+            vector<unsigned long long> nrFirings;
+
+            // Symbolic state
+            bool symbolic;
+            vector< std::deque<Time> > fifo;
+            vector<Time> tileTime;
+            uint nrVariables;
+    };
+
+    /**
+     * startSymbolicExecution ()
+     * Every token in the channels (in FIFO order) and every processor with a
+     * schedule becomes a variable of the symbolic execution.
+     */
+    void BindingAwareExecution::startSymbolicExecution()
+    {
+        uint v = 0;
+
+        symbolic = true;
+        nrVariables = 0;
+        for (CId c = 0; c < g.nrChannels(); c++)
+            nrVariables += tokens[c];
+        for (uint t = 0; t < schedulePos.size(); t++)
+        {
+            if (!bg->getScheduleOnTile(t).empty())
+                nrVariables++;
+        }
+
+        fifo.assign(g.nrChannels(), std::deque<Time>());
+        for (CId c = 0; c < g.nrChannels(); c++)
+        {
+            for (uint i = 0; i < tokens[c]; i++)
+            {
+                Time x(new MaxPlus::Vector(nrVariables));
+                x->put(v++, 0);
+                fifo[c].push_back(x);
+            }
+        }
+
+        tileTime.assign(schedulePos.size(), Time());
+        for (uint t = 0; t < schedulePos.size(); t++)
+        {
+            if (!bg->getScheduleOnTile(t).empty())
+            {
+                tileTime[t] = Time(new MaxPlus::Vector(nrVariables));
+                tileTime[t]->put(v++, 0);
+            }
+        }
+    }
+
+    /**
+     * putRow ()
+     * Copy a vector into a row of a max-plus matrix.
+     */
+    static
+    void putRow(MaxPlus::Matrix *m, const uint r, const MaxPlus::Vector &v)
+    {
+        for (uint c = 0; c < v.getSize(); c++)
+            m->put(r, c, v.get(c));
+    }
+
+    /**
+     * getMatrix ()
+     * Row i of the matrix is the time of the variable i of the current state
+     * expressed in the variables at the start of the symbolic execution. The
+     * variables of both states match when their discrete states are equal.
+     */
+    MaxPlus::Matrix *BindingAwareExecution::getMatrix() const
+    {
+        MaxPlus::Matrix *m = new MaxPlus::Matrix(nrVariables);
+        uint r = 0;
+
+        for (CId c = 0; c < g.nrChannels(); c++)
+        {
+            for (uint i = 0; i < fifo[c].size(); i++, r++)
+                putRow(m, r, *fifo[c][i]);
+        }
+        for (uint t = 0; t < tileTime.size(); t++)
+        {
+            if (tileTime[t])
+                putRow(m, r++, *tileTime[t]);
+        }
+
+        return m;
+    }
+
+    /**
+     * actorReadyToFire ()
+     * The function returns true when the actor has sufficient input tokens and
+     * the schedule of its processor (if any) is at the actor.
+     */
+    bool BindingAwareExecution::actorReadyToFire(const CId a)
+    {
+        if (actorTile[a] != ACTOR_NOT_BOUND)
+        {
+            StaticOrderSchedule &s = bg->getScheduleOnTile(actorTile[a]);
+            SDFactor *e = s.getActor(schedulePos[actorTile[a]]);
+
+            if (e == NULL || e->getId() != a)
+                return false;
+        }
+
+        for (const TimedSDFcompiledGraph::Port *p = g.inPortsBegin(a);
+             p != g.inPortsEnd(a); p++)
+        {
+            if (tokens[p->channel] < p->rate)
+                return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * fire ()
+     * Fire actor a. In symbolic mode, the firing starts at the maximum of the
+     * times of its input tokens and of the end of the previous firing on its
+     * processor.
+     */
+    void BindingAwareExecution::fire(const CId a)
+    {
+        const CId t = actorTile[a];
+        Time start, end;
+
+        if (symbolic)
+        {
+            start = Time(new MaxPlus::Vector(nrVariables));
+            if (t != ACTOR_NOT_BOUND)
+                start->maximum(tileTime[t].get(), start.get());
+        }
+
+        for (const TimedSDFcompiledGraph::Port *p = g.inPortsBegin(a);
+             p != g.inPortsEnd(a); p++)
+        {
+            tokens[p->channel] -= p->rate;
+
+            if (start)
+            {
+                std::deque<Time> &f = fifo[p->channel];
+                const MaxPlus::Vector *previous = NULL;
+
+                for (uint i = 0; i < p->rate; i++)
+                {
+                    if (f.front().get() != previous)
+                    {
+                        previous = f.front().get();
+                        start->maximum(previous, start.get());
+                    }
+                    f.pop_front();
+                }
+            }
+        }
+
+        if (start)
+        {
+            end = start;
+            end->add(MPTime(g.getExecutionTime(a)), end.get());
+            if (t != ACTOR_NOT_BOUND)
+                tileTime[t] = end;
+        }
+
+        for (const TimedSDFcompiledGraph::Port *p = g.outPortsBegin(a);
+             p != g.outPortsEnd(a); p++)
+        {
+            tokens[p->channel] += p->rate;
+
+            if (end)
+                fifo[p->channel].insert(fifo[p->channel].end(), p->rate, end);
+        }
+
+        if (t != ACTOR_NOT_BOUND)
+            bg->getScheduleOnTile(t).nextPosition(schedulePos[t]);
+
+        nrFirings[a]++;
+    }
+
+    /**
+     * round ()
+     * Fire every actor as often as it is enabled, in the order of the actor
+     * ids. The function returns false when no actor could fire.
+     */
+    bool BindingAwareExecution::round()
+    {
+        bool progress = false;
+
+        for (CId a = 0; a < g.nrActors(); a++)
+        {
+            while (actorReadyToFire(a))
+            {
+                fire(a);
+                progress = true;
+            }
+        }
+
+        return progress;
+    }
+
+    /**
+     * isExact ()
+     * The function returns true when the max-plus analysis of the
+     * binding-aware SDFG is exact, i.e. when the TDMA wheel of every
+     * processor to which an actor is bound is completely reserved for the
+     * application.
+     */
+    bool SDFmaxPlusThroughputAnalysis::isExact(BindingAwareSDFG *bg)
+    {
+        for (SDFactorsIter iter = bg->actorsBegin();
+             iter != bg->actorsEnd(); iter++)
+        {
+            CId t = bg->getBindingOfActorToTile(*iter);
+
+            if (t != ACTOR_NOT_BOUND
+                && bg->getTDMAsliceOnTile(t) != bg->getTDMAsizeOnTile(t))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * analyze ()
+     * Compute the throughput of an SDFG mapped to an architecture platform
+     * in which the actors bound to a processor are fired in the order of its
+     * static-order schedule and the TDMA wheels are completely reserved. The
+     * execution is first performed without time, once per iteration of the
+     * actor with the smallest repetition vector entry, till a recurrent state
+     * is found. The execution between both occurrences of this state is then
+     * repeated symbolically to obtain its max-plus matrix. The throughput
+     * follows from the eigenvalue of this matrix and the number of
+     * iterations in between. The results match those of
+     * SDFstateSpaceBindingAwareThroughputAnalysis.
+     */
+    TDtime SDFmaxPlusThroughputAnalysis::analyze(BindingAwareSDFG *bg,
+            vector<double> &tileUtilization)
+    {
+        map< vector<uint>, pair<uint, unsigned long long> > storedStates;
+        map< vector<uint>, pair<uint, unsigned long long> >::iterator recurrent;
+        unsigned long long nrIters, nrItersPeriod;
+        uint nrCheckpoints, firstCheckpoint, lastCheckpoint;
+        CId outputActor = 0;
+        MaxPlus::Matrix *m;
+        CDouble lambda;
+        TDtime thr;
+
+        // Check that the application graph is a strongly connected graph
+        if (!isStronglyConnectedGraph(bg))
+            throw CException("Graph is not strongly connected.");
+
+        if (!isExact(bg))
+            throw CException("TDMA wheel not completely reserved in max-plus "
+                             "throughput analysis.");
+
+        TimedSDFcompiledGraph cg(bg);
+        const RepetitionVector &repVec = cg.getRepetitionVector();
+
+        tileUtilization.assign(bg->nrTilesInPlatformGraph(), 0);
+
+        // Actors bound to a processor need a schedule
+        vector<CId> actorTile(cg.nrActors(), ACTOR_NOT_BOUND);
+        for (CId a = 0; a < cg.nrActors(); a++)
+        {
+            actorTile[a] = bg->getBindingOfActorToTile(cg.getActor(a));
+
+            if (actorTile[a] != ACTOR_NOT_BOUND
+                && bg->getScheduleOnTile(actorTile[a]).empty())
+            {
+                throw CException("Actor mapped to processor without schedule.");
+            }
+        }
+
+        // Iterations are counted on the actor with the lowest entry in the
+        // repetition vector
+        for (CId a = 0; a < cg.nrActors(); a++)
+        {
+            if (repVec[a] < repVec[outputActor])
+                outputActor = a;
+        }
+
+        // Execute the graph till a recurrent state
+        BindingAwareExecution execution(bg, cg, actorTile);
+        nrCheckpoints = 0;
+        nrIters = 0;
+        storedStates[execution.getState()] = make_pair(nrCheckpoints, nrIters);
+        while (true)
+        {
+            if (!execution.round())
+                return 0;
+
+            if (execution.getNrFirings(outputActor) / repVec[outputActor]
+                > nrIters)
+            {
+                nrIters = execution.getNrFirings(outputActor)
+                          / repVec[outputActor];
+                nrCheckpoints++;
+
+                recurrent = storedStates.find(execution.getState());
+                if (recurrent != storedStates.end())
+                    break;
+
+                storedStates[execution.getState()]
+                    = make_pair(nrCheckpoints, nrIters);
+            }
+        }
+        nrItersPeriod = nrIters - recurrent->second.second;
+
+        // Execute the periodic part symbolically
+        lastCheckpoint = nrCheckpoints;
+        firstCheckpoint = recurrent->second.first;
+        execution.reset();
+        nrCheckpoints = 0;
+        nrIters = 0;
+        if (firstCheckpoint == 0)
+            execution.startSymbolicExecution();
+        while (nrCheckpoints < lastCheckpoint)
+        {
+            execution.round();
+
+            if (execution.getNrFirings(outputActor) / repVec[outputActor]
+                > nrIters)
+            {
+                nrIters = execution.getNrFirings(outputActor)
+                          / repVec[outputActor];
+                nrCheckpoints++;
+
+                if (nrCheckpoints == firstCheckpoint)
+                    execution.startSymbolicExecution();
+            }
+        }
+
+        m = execution.getMatrix();
+        lambda = eigenvalue(*m);
+        delete m;
+
+        if (lambda <= 0)
+            return TDTIME_MAX;
+
+        thr = (TDtime)nrItersPeriod / lambda;
+
+        // The processor utilization in the periodic regime
+        for (CId a = 0; a < cg.nrActors(); a++)
+        {
+            if (actorTile[a] != ACTOR_NOT_BOUND)
+            {
+                tileUtilization[actorTile[a]] += cg.getExecutionTime(a)
+                                                 * repVec[a] * thr;
+            }
+        }
+
+        return thr;
+    }
+
+}//namespace SDF
@@ -0,0 +1,100 @@
+/*
+ *  Eindhoven University of Technology
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   maxplus_throughput.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Throughput calculation from the max-plus matrix of
+ *                      an SDFG
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef SDF_ANALYSIS_THROUGHPUT_MAXPLUS_THROUGHPUT_H_INCLUDED
+#define SDF_ANALYSIS_THROUGHPUT_MAXPLUS_THROUGHPUT_H_INCLUDED
+
+#include "../../resource_allocation/binding_aware_sdfg/binding_aware_sdfg.h"
+#include "../../base/timed/compiled_graph.h"
+#include "../../../base/maxplus/maxplus.h"
+
+namespace SDF
+{
+    /**
+     * Max-plus throughput analysis
+     * Computes the throughput of an SDFG from the max-plus matrix of one
+     * period of its self-timed execution. The matrix has a row and a column
+     * for every token (and every processor) in the graph, so its size does
+     * not depend on the repetition vector. The throughput follows from the
+     * eigenvalue of the matrix, which is computed with Howard's policy
+     * iteration or with power iteration.
+     *
+     * The analysis of a binding-aware SDFG includes the static-order
+     * schedules of the processors. It is exact only when the TDMA wheel of
+     * every processor to which actors are bound is completely reserved (see
+     * isExact), as the TDMA arbitration is not linear in max-plus algebra.
+     */
+    class SDFmaxPlusThroughputAnalysis
+    {
+        public:
+            // Eigenvalue algorithms
+            enum Method { Howard, PowerIteration };
+
+            // Constructor
+            SDFmaxPlusThroughputAnalysis(const Method m = Howard)
+                : method(m) {};
+
+            // Destructor
+            ~SDFmaxPlusThroughputAnalysis() {};
+
+            // Eigenvalue algorithm
+            void setMethod(const Method m)
+            {
+                method = m;
+            };
+            Method getMethod() const
+            {
+                return method;
+            };
+
+            // Analyze throughput of the graph
+            TDtime analyze(TimedSDFgraph *g);
+
+            // Analyze throughput of a binding-aware graph
+            TDtime analyze(BindingAwareSDFG *bg, vector<double> &tileUtilization);
+
+            // Can the binding-aware graph be analyzed without TDMA wheels?
+            static bool isExact(BindingAwareSDFG *bg);
+
+        private:
+            // Eigenvalue of a max-plus matrix (zero when it has no cycles)
+            CDouble eigenvalue(const MaxPlus::Matrix &m) const;
+            static CDouble eigenvaluePowerIteration(const MaxPlus::Matrix &m);
+
+            // Settings
+            Method method;
+    };
+
+}//namespace SDF
+#endif
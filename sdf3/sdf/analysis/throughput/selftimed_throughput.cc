@@ -12,6 +12,7 @@
  *
  *  History         :
  *      10-10-07    :   Initial version.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
  *
  * $Id: selftimed_throughput.cc,v 1.1.2.1 2010-04-22 07:18:40 mgeilen Exp $
  *
@@ -41,84 +42,6 @@ namespace SDF
 
     //#define _PRINT_STATESPACE
 
-    /******************************************************************************
-     * State
-     *****************************************************************************/
-
-    /**
-     * printState ()
-     * Print the state to the supplied stream.
-     */
-    void SDFstateSpaceThroughputAnalysis::TransitionSystem::State::print(
-        ostream &out)
-    {
-        out << "### State ###" << endl;
-
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            out << "actClk[" << i << "] =";
-
-            for (list<SDFtime>::const_iterator iter = actClk[i].begin();
-                 iter != actClk[i].end(); iter++)
-            {
-                out << " " << (*iter) << ", ";
-            }
-
-            out << endl;
-        }
-
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            out << "ch[" << i << "] = " << ch[i] << endl;
-        }
-
-        out << "glbClk = " << glbClk << endl;
-    }
-
-    /**
-     * clearState ()
-     * The function sets the state to zero.
-     */
-    void SDFstateSpaceThroughputAnalysis::TransitionSystem::State::clear()
-    {
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            actClk[i].clear();
-        }
-
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            ch[i] = 0;
-        }
-
-        glbClk = 0;
-    }
-
-    /**
-     * operator== ()
-     * The function compares to states and returns true if they are equal.
-     */
-    bool SDFstateSpaceThroughputAnalysis::TransitionSystem::State::operator==(
-        const State &s)
-    {
-        if (glbClk != s.glbClk)
-            return false;
-
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            if (ch[i] != s.ch[i])
-                return false;
-        }
-
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            if (actClk[i] != s.actClk[i])
-                return false;
-        }
-
-        return true;
-    }
-
     /******************************************************************************
      * Transition system
      *****************************************************************************/
@@ -130,84 +53,43 @@ namespace SDF
      */
     void SDFstateSpaceThroughputAnalysis::TransitionSystem::initOutputActor()
     {
-        RepetitionVector repVec;
+        const RepetitionVector &repVec = g.getRepetitionVector();
         int min = INT_MAX;
-        SDFactor *a = NULL;
-
-        // Compute repetition vector
-        repVec = computeRepetitionVector(g);
 
         // Select actor with lowest entry in repetition vector as output actor
-        for (SDFactorsIter iter = g->actorsBegin(); iter != g->actorsEnd(); iter++)
+        for (CId a = 0; a < g.nrActors(); a++)
         {
-            if (repVec[(*iter)->getId()] < min)
+            if (repVec[a] < min)
             {
-                a = *iter;
-                min = repVec[a->getId()];
+                outputActor = a;
+                min = repVec[a];
             }
         }
 
-        // Set output actor and its repetition vector count
-        outputActor = a->getId();
+        // Set output actor repetition vector count
         outputActorRepCnt = repVec[outputActor];
     }
 
-    /**
-     * storeState ()
-     * The function stores the state s on whenever s is not already in the
-     * list of storedStates. When s is stored, the function returns true. When the
-     * state s is already in the list, the state s is not stored. The function
-     * returns false. The function always sets the pos variable to the position
-     * where the state s is in the list.
-     */
-    bool SDFstateSpaceThroughputAnalysis::TransitionSystem::storeState(State &s,
-            StatesIter &pos)
-    {
-        // Find state in the list of stored states
-        for (StatesIter iter = storedStates.begin();
-             iter != storedStates.end(); iter++)
-        {
-            State &x = *iter;
-
-            // State s at position iter in the list?
-            if (x == s)
-            {
-                pos = iter;
-                return false;
-            }
-        }
-
-        // State not found, store it at the end of the list
-        storedStates.push_back(s);
-
-        // Added state to the end of the list
-        pos = storedStates.end();
-
-        return true;
-    }
-
     /**
      * computeThroughput ()
      * The function calculates the throughput of the states on the cycle. Its
      * value is equal to the average number of firings of an actor per time unit.
      */
     TDtime SDFstateSpaceThroughputAnalysis::TransitionSystem::computeThroughput(
-        const StatesIter cycleIter)
+        const uint cycleIdx)
     {
         int nr_fire = 0;
         TDtime time = 0;
 
         // Check all state from stack till cycle complete
-        for (StatesIter iter = cycleIter; iter != storedStates.end(); iter++)
+        for (uint i = cycleIdx; i < storedStates.size(); i++)
         {
-            State &s = *iter;
-
             // Number of states in cycle is equal to number of iterations
             // in the period
             nr_fire++;
 
             // Time between previous state
-            time += s.glbClk;
+            time += storedStates.glbClk(i);
         }
 
         return (TDtime)(nr_fire) / (time);
@@ -230,22 +112,14 @@ namespace SDF
      * s. Else it returns false.
      */
     bool SDFstateSpaceThroughputAnalysis::TransitionSystem::actorReadyToFire(
-        SDFactor *a)
+        const CId a)
     {
         // Check all input ports for tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = g.inPortsBegin(a);
+             p != g.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                if (!CH_TOKENS(c->getId(), p->getRate()))
-                {
-                    return false;
-                }
-            }
+            if (!CH_TOKENS(p->channel, p->rate))
+                return false;
         }
 
         return true;
@@ -258,26 +132,20 @@ namespace SDF
      * position.
      */
     void SDFstateSpaceThroughputAnalysis::TransitionSystem::startActorFiring(
-        TimedSDFactor *a)
+        const CId a)
     {
-        // Consume tokens from inputs and space for output tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        // Consume tokens from inputs
+        for (const TimedSDFcompiledGraph::Port *p = g.inPortsBegin(a);
+             p != g.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                CONSUME(c->getId(), p->getRate());
-            }
+            CONSUME(p->channel, p->rate);
         }
 
         // Add actor firing to the list of active firings of this actor
-        currentState.actClk[a->getId()].push_back(a->getExecutionTime());
+        currentState.startFiring(a, g.getExecutionTime(a));
 
 #ifdef _PRINT_STATESPACE
-        cout << "start: " << a->getName() << endl;
+        cout << "start: " << g.getActor(a)->getName() << endl;
 #endif
     }
 
@@ -287,16 +155,10 @@ namespace SDF
      * the function returns false.
      */
     bool SDFstateSpaceThroughputAnalysis::TransitionSystem::actorReadyToEnd(
-        SDFactor *a)
+        const CId a)
     {
-        if (currentState.actClk[a->getId()].empty())
-            return false;
-
-        // First actor firing in sorted list has execution time left?
-        if (currentState.actClk[a->getId()].front() != 0)
-            return false;
-
-        return true;
+        // First actor firing in sorted list has no execution time left?
+        return currentState.readyToEnd(a);
     }
 
     /**
@@ -305,25 +167,19 @@ namespace SDF
      * list of active firings.
      */
     void SDFstateSpaceThroughputAnalysis::TransitionSystem::endActorFiring(
-        SDFactor *a)
+        const CId a)
     {
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = g.outPortsBegin(a);
+             p != g.outPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is source of the channel?
-            if (p->getType() == SDFport::Out)
-            {
-                PRODUCE(c->getId(), p->getRate());
-            }
+            PRODUCE(p->channel, p->rate);
         }
 
         // Remove the firing from the list of active actor firings
-        currentState.actClk[a->getId()].pop_front();
+        currentState.endFiring(a);
 
 #ifdef _PRINT_STATESPACE
-        cout << "end:   " << a->getName() << endl;
+        cout << "end:   " << g.getActor(a)->getName() << endl;
 #endif
     }
 
@@ -335,43 +191,10 @@ namespace SDF
      */
     SDFtime SDFstateSpaceThroughputAnalysis::TransitionSystem::clockStep()
     {
-        SDFtime step = UINT_MAX;
-
-        // Find maximal time progress
-        for (uint a = 0; a < g->nrActors(); a++)
-        {
-            if (!currentState.actClk[a].empty())
-            {
-                SDFtime actClk = currentState.actClk[a].front();
-
-                if (step > actClk)
-                    step = actClk;
-            }
-        }
-
-        // Still actors ready to end their firing?
-        if (step == 0)
-            return 0;
-
-        // Check for progress (i.e. no deadlock)
-        if (step == UINT_MAX)
-            return UINT_MAX;
-
-        // Lower remaining execution time actors
-        for (uint a = 0; a < g->nrActors(); a++)
-        {
-            for (list<SDFtime>::iterator iter = currentState.actClk[a].begin();
-                 iter != currentState.actClk[a].end(); iter++)
-            {
-                SDFtime &actFiringTime = *iter;
+        SDFtime step;
 
-                // Lower remaining execution time of the actor firing
-                actFiringTime -= step;
-            }
-        }
-
-        // Advance the global clock
-        currentState.glbClk += step;
+        // Progress time till the first firing ends
+        step = currentState.clockStep();
 
 #ifdef _PRINT_STATESPACE
         cout << "clk:   " << step << endl;
@@ -383,31 +206,36 @@ namespace SDF
     /**
      * execSDFgraph()
      * Execute the SDF graph till a deadlock is found or a recurrent state.
-     * The throughput is returned.
+     * The throughput is returned. Only the actors whose firing ends at the
+     * current time are visited to end their firings (in order of their id)
+     * and only the consumers of the channels to which these actors produced
+     * tokens are checked for enabling.
      */
     TDtime SDFstateSpaceThroughputAnalysis::TransitionSystem::execSDFgraph()
     {
-        StatesIter recurrentState;
+        uint recurrentState;
         SDFtime clkStep;
         int repCnt = 0;
+        vector<CId> endingActors;
+        vector<CId> candidates;
+        vector<bool> isCandidate(g.nrActors(), true);
 
         // Clear the list of stored states
         clearStoredStates();
 
         // Create initial state
-        currentState.init(g->nrActors(), g->nrChannels());
+        currentState.init(g.nrActors(), g.nrChannels());
         currentState.clear();
-        previousState.init(g->nrActors(), g->nrChannels());
+        previousState.init(g.nrActors(), g.nrChannels());
         previousState.clear();
 
         // Initial tokens and space
-        for (SDFchannelsIter iter = g->channelsBegin();
-             iter != g->channelsEnd(); iter++)
-        {
-            SDFchannel *c = *iter;
+        for (CId c = 0; c < g.nrChannels(); c++)
+            CH(c) = g.getInitialTokens(c);
 
-            CH(c->getId()) = c->getInitialTokens();
-        }
+        // Initially all actors may be enabled
+        for (CId a = 0; a < g.nrActors(); a++)
+            candidates.push_back(a);
 
 #ifdef _PRINT_STATESPACE
         cout << "### start statespace exploration" << endl;
@@ -417,20 +245,20 @@ namespace SDF
         while (true)
         {
             // Store partial state to check for progress
-            for (uint i = 0; i < g->nrChannels(); i++)
+            for (uint i = 0; i < g.nrChannels(); i++)
             {
                 previousState.ch[i] = currentState.ch[i];
             }
 
             // Finish actor firings
-            for (SDFactorsIter iter = g->actorsBegin();
-                 iter != g->actorsEnd(); iter++)
+            currentState.actorsReadyToEnd(endingActors);
+            for (uint i = 0; i < endingActors.size(); i++)
             {
-                SDFactor *a = *iter;
+                CId a = endingActors[i];
 
                 while (actorReadyToEnd(a))
                 {
-                    if (outputActor == a->getId())
+                    if (outputActor == a)
                     {
                         repCnt++;
                         if (repCnt == outputActorRepCnt)
@@ -439,7 +267,7 @@ namespace SDF
                             currentState.print(cout);
 #endif
                             // Add state to hash of visited states
-                            if (!storeState(currentState, recurrentState))
+                            if (!storedStates.store(currentState, recurrentState))
                             {
 #ifdef _PRINT_STATESPACE
                                 cout << "### end statespace exploration" << endl;
@@ -454,13 +282,23 @@ namespace SDF
                     // End the actor firing
                     endActorFiring(a);
                 }
+
+                // Consumers of the produced tokens may have become enabled
+                for (const CId *b = g.consumersBegin(a);
+                     b != g.consumersEnd(a); b++)
+                {
+                    if (!isCandidate[*b])
+                    {
+                        isCandidate[*b] = true;
+                        candidates.push_back(*b);
+                    }
+                }
             }
 
             // Start actor firings
-            for (SDFactorsIter iter = g->actorsBegin();
-                 iter != g->actorsEnd(); iter++)
+            for (uint i = 0; i < candidates.size(); i++)
             {
-                TimedSDFactor *a = (TimedSDFactor *)(*iter);
+                CId a = candidates[i];
 
                 // Ready to fire actor a?
                 while (actorReadyToFire(a))
@@ -468,7 +306,10 @@ namespace SDF
                     // Fire actor a
                     startActorFiring(a);
                 }
+
+                isCandidate[a] = false;
             }
+            candidates.clear();
 
             // Clock step
             clkStep = clockStep();
@@ -492,14 +333,26 @@ namespace SDF
      * using auto-concurrency using a state-space traversal.
      */
     TDtime SDFstateSpaceThroughputAnalysis::analyze(TimedSDFgraph *g)
+    {
+        TimedSDFcompiledGraph cg(g);
+
+        return analyze(cg);
+    }
+
+    /**
+     * analyze ()
+     * Compute the throughput of an SDF graph for unconstrained buffer sizes and
+     * using auto-concurrency using a state-space traversal. The graph is given
+     * by its compiled view.
+     */
+    TDtime SDFstateSpaceThroughputAnalysis::analyze(
+        const TimedSDFcompiledGraph &cg)
     {
         SDFstateSpaceThroughputAnalysis thrAnalysisAlgo;
-        RepetitionVector repVec;
+        const RepetitionVector &repVec = cg.getRepetitionVector();
+        TimedSDFgraph *g = cg.getGraph();
         TDtime thr;
 
-        // Compute repetition vector
-        repVec = computeRepetitionVector(g);
-
         // Check that the graph gr is a strongly connected graph
         if (!isStronglyConnectedGraph(g))
         {
@@ -570,7 +423,7 @@ namespace SDF
         }
 
         // Create a transition system
-        TransitionSystem transitionSystem(g);
+        TransitionSystem transitionSystem(cg);
 
         // Find the maximal throughput
         thr = transitionSystem.execSDFgraph();
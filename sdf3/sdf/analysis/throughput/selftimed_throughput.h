@@ -12,6 +12,7 @@
  *
  *  History         :
  *      10-10-07    :   Initial version.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
  *
  * $Id: selftimed_throughput.h,v 1.1 2008-03-06 10:49:44 sander Exp $
  *
@@ -36,7 +37,8 @@
 #ifndef SDF_ANALYSIS_STATESPACE_SELFTIMED_THROUGHPUT_H_INCLUDED
 #define SDF_ANALYSIS_STATESPACE_SELFTIMED_THROUGHPUT_H_INCLUDED
 
-#include "../../base/timed/graph.h"
+#include "../../base/timed/compiled_graph.h"
+#include "../statespace/state.h"
 namespace SDF
 {
     /**
@@ -55,6 +57,7 @@ namespace SDF
 
             // Analyze throughput of the graph
             TDtime analyze(TimedSDFgraph *g);
+            TDtime analyze(const TimedSDFcompiledGraph &g);
 
         private:
 
@@ -65,51 +68,13 @@ namespace SDF
             {
                 public:
 
-                    /***********************************************************************
-                     * State
-                     **********************************************************************/
-                    class State
-                    {
-                        public:
-                            // Constructor
-                            State(const uint nrActors = 0, const uint nrChannels = 0)
-                            {
-                                init(nrActors, nrChannels);
-                            };
-
-                            // Destructor
-                            ~State() {};
-
-                            // Initialize the state
-                            void init(const uint nrActors, const uint nrChannels)
-                            {
-                                actClk.resize(nrActors);
-                                ch.resize(nrChannels);
-                            };
-
-                            // Compare states
-                            bool operator==(const State &s);
-
-                            // Clear state
-                            void clear();
-
-                            // Output state
-                            void print(ostream &out);
-
-                            // State information
-                            vector< list<SDFtime> > actClk;
-                            vector< TBufSize > ch;
-                            unsigned long glbClk;
-                    };
-
-                    // Sequence of states in transition system
-                    typedef list<State>      States;
-                    typedef States::iterator StatesIter;
+                    // State of the transition system
+                    typedef SDFstateSpaceState State;
 
                     // Constructor
-                    TransitionSystem(TimedSDFgraph *gr)
+                    TransitionSystem(const TimedSDFcompiledGraph &gr)
+                        : g(gr)
                     {
-                        g = gr;
                         initOutputActor();
                     };
 
@@ -120,9 +85,6 @@ namespace SDF
                     TDtime execSDFgraph();
 
                 private:
-                    // Store state
-                    bool storeState(State &s, StatesIter &pos);
-
                     // Clear list of stored states
                     void clearStoredStates()
                     {
@@ -130,20 +92,20 @@ namespace SDF
                     };
 
                     // Compute throughput from transition system
-                    TDtime computeThroughput(const StatesIter cycleIter);
+                    TDtime computeThroughput(const uint cycleIdx);
 
                     // State transitions
-                    bool actorReadyToFire(SDFactor *a);
-                    void startActorFiring(TimedSDFactor *a);
-                    bool actorReadyToEnd(SDFactor *a);
-                    void endActorFiring(SDFactor *a);
+                    bool actorReadyToFire(const CId a);
+                    void startActorFiring(const CId a);
+                    bool actorReadyToEnd(const CId a);
+                    void endActorFiring(const CId a);
                     SDFtime clockStep();
 
                     // Output actor
                     void initOutputActor();
 
                     // SDF graph and output actor
-                    TimedSDFgraph *g;
+                    const TimedSDFcompiledGraph &g;
                     CId outputActor;
                     TCnt outputActorRepCnt;
 
@@ -151,8 +113,8 @@ namespace SDF
                     State currentState;
                     State previousState;
 
-                    // List of visited states that are stored
-                    States storedStates;
+                    // Visited states that are stored
+                    SDFvisitedStates<State> storedStates;
             };
     };
 }//namespace SDF
@@ -13,6 +13,7 @@
  *
  *  History         :
  *      31-03-08    :   Initial version.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
  *
  * $Id: static_periodic_ning_gao.cc,v 1.1.2.2 2010-04-24 23:52:43 mgeilen Exp $
  *
@@ -44,93 +45,66 @@ namespace SDF
      *****************************************************************************/
 
     /**
-     * printState ()
-     * Print the state to the supplied stream.
+     * operator== ()
+     * The function compares to states and returns true if they are equal.
      */
-    void SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem::State::print(
-        ostream &out)
+    bool SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem::State
+    ::operator==(const State &s) const
     {
-        out << "### State ###" << endl;
+        if (!SDFstateSpaceState::operator==(s))
+            return false;
 
-        for (uint i = 0; i < actClk.size(); i++)
+        for (uint i = 0; i < sp.size(); i++)
         {
-            out << "actClk[" << i << "] =";
-
-            for (list<SDFtime>::const_iterator iter = actClk[i].begin();
-                 iter != actClk[i].end(); iter++)
-            {
-                out << " " << (*iter) << ", ";
-            }
-
-            out << endl;
+            if (sp[i] != s.sp[i])
+                return false;
         }
 
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            out << "ch[" << i << "] = " << ch[i] << endl;
-        }
+        return true;
+    }
+
+    /**
+     * print ()
+     * Print the state to the supplied stream.
+     */
+    void SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem::State
+    ::print(ostream &out) const
+    {
+        SDFstateSpaceState::print(out);
 
         for (uint i = 0; i < sp.size(); i++)
         {
-            out << "sp[" << i << "] = " << ch[i] << endl;
+            out << "sp[" << i << "] = " << sp[i] << endl;
         }
-
-        out << "glbClk = " << glbClk << endl;
     }
 
     /**
-     * clearState ()
+     * clear ()
      * The function sets the state to zero.
      */
-    void SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem::State::clear()
+    void SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem::State
+    ::clear()
     {
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            actClk[i].clear();
-        }
-
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            ch[i] = 0;
-        }
+        SDFstateSpaceState::clear();
 
         for (uint i = 0; i < sp.size(); i++)
         {
             sp[i] = 0;
         }
-
-        glbClk = 0;
     }
 
     /**
-     * operator== ()
-     * The function compares to states and returns true if they are equal.
+     * pack ()
+     * The function packs the state into a sequence of words. The shared part
+     * of the state is followed by the storage space.
      */
-    bool SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem::State
-    ::operator==(const State &s)
+    void SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem::State
+    ::pack(vector<SDFstateWord> &s) const
     {
-        if (glbClk != s.glbClk)
-            return false;
-
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            if (ch[i] != s.ch[i])
-                return false;
-        }
+        SDFstateSpaceState::pack(s);
 
         for (uint i = 0; i < sp.size(); i++)
-        {
-            if (sp[i] != s.sp[i])
-                return false;
-        }
-
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            if (actClk[i] != s.actClk[i])
-                return false;
-        }
-
-        return true;
+            s.push_back(sp[i]);
     }
 
     /******************************************************************************
@@ -144,60 +118,21 @@ namespace SDF
      */
     void SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem::initOutputActor()
     {
-        RepetitionVector repVec;
+        const RepetitionVector &repVec = cg.getRepetitionVector();
         int min = INT_MAX;
-        SDFactor *a = NULL;
-
-        // Compute repetition vector
-        repVec = computeRepetitionVector(g);
 
         // Select actor with lowest entry in repetition vector as output actor
-        for (SDFactorsIter iter = g->actorsBegin(); iter != g->actorsEnd(); iter++)
+        for (CId a = 0; a < cg.nrActors(); a++)
         {
-            if (repVec[(*iter)->getId()] < min)
+            if (repVec[a] < min)
             {
-                a = *iter;
-                min = repVec[a->getId()];
+                outputActor = a;
+                min = repVec[a];
             }
         }
 
-        // Set output actor and its repetition vector count
-        outputActor = a;
-        outputActorRepCnt = repVec[outputActor->getId()];
-    }
-
-    /**
-     * storeState ()
-     * The function stores the state s on whenever s is not already in the
-     * list of storedStates. When s is stored, the function returns true. When the
-     * state s is already in the list, the state s is not stored. The function
-     * returns false. The function always sets the pos variable to the position
-     * where the state s is in the list.
-     */
-    bool SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem::storeState(
-        State &s, StatesIter &pos)
-    {
-        // Find state in the list of stored states
-        for (StatesIter iter = storedStates.begin();
-             iter != storedStates.end(); iter++)
-        {
-            State &x = *iter;
-
-            // State s at position iter in the list?
-            if (x == s)
-            {
-                pos = iter;
-                return false;
-            }
-        }
-
-        // State not found, store it at the end of the list
-        storedStates.push_back(s);
-
-        // Added state to the end of the list
-        pos = storedStates.end();
-
-        return true;
+        // Set output actor repetition vector count
+        outputActorRepCnt = repVec[outputActor];
     }
 
     /**
@@ -206,22 +141,20 @@ namespace SDF
      * value is equal to the average number of firings of an actor per time unit.
      */
     TDtime SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem
-    ::computeThroughput(const StatesIter cycleIter)
+    ::computeThroughput(const uint cycleIdx)
     {
         int nr_fire = 0;
         TDtime time = 0;
 
         // Check all state from stack till cycle complete
-        for (StatesIter iter = cycleIter; iter != storedStates.end(); iter++)
+        for (uint i = cycleIdx; i < storedStates.size(); i++)
         {
-            State &s = *iter;
-
             // Number of states in cycle is equal to number of iterations
             // in the period
             nr_fire++;
 
             // Time between previous state
-            time += s.glbClk;
+            time += storedStates.glbClk(i);
         }
 
         return (TDtime)(nr_fire) / (time);
@@ -249,25 +182,20 @@ namespace SDF
      * of the channel 'c' contain less tokens then the channel 'c'.
      */
     bool SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem
-    ::releaseStorageSpaceSharedOutputBuffer(SDFchannel *c)
+    ::releaseStorageSpaceSharedOutputBuffer(const CId c)
     {
-        SDFactor *a = c->getSrcActor();
+        CId a = cg.getSrcActor(c);
 
         // Check all output ports for tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = cg.outPortsBegin(a);
+             p != cg.outPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-
-            // Actor is source of the channel?
-            if (p->getType() == SDFport::Out)
+            // Is this channel not channel c?
+            if (p->channel != c)
             {
-                // Is this channel not channel c?
-                if (p->getChannel()->getId() != c->getId())
-                {
-                    // Does this channel contain at least as many tokens as c?
-                    if (CH(p->getChannel()->getId()) >= CH(c->getId()))
-                        return false;
-                }
+                // Does this channel contain at least as many tokens as c?
+                if (CH(p->channel) >= CH(c))
+                    return false;
             }
         }
 
@@ -280,29 +208,22 @@ namespace SDF
      * s. Else it returns false.
      */
     bool SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem::actorReadyToFire(
-        SDFactor *a)
+        const CId a)
     {
         // Check all input ports for tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = cg.inPortsBegin(a);
+             p != cg.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
+            if (!CH_TOKENS(p->channel, p->rate))
+                return false;
+        }
 
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                if (!CH_TOKENS(c->getId(), p->getRate()))
-                {
-                    return false;
-                }
-            }
-            else
-            {
-                if (!CH_SPACE(c->getSrcActor()->getId(), p->getRate()))
-                {
-                    return false;
-                }
-            }
+        // Check all output ports for space in the output buffer
+        for (const TimedSDFcompiledGraph::Port *p = cg.outPortsBegin(a);
+             p != cg.outPortsEnd(a); p++)
+        {
+            if (!CH_SPACE(a, p->rate))
+                return false;
         }
 
         return true;
@@ -315,46 +236,36 @@ namespace SDF
      * position.
      */
     void SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem::startActorFiring(
-        TimedSDFactor *a)
+        const CId a)
     {
-        bool consumedOutputSpace = false;
-
-        // Consume tokens from inputs and space for output tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        // Consume tokens from inputs
+        for (const TimedSDFcompiledGraph::Port *p = cg.inPortsBegin(a);
+             p != cg.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
+            // Space must be produced in case this is the last channel
+            // to consume the token from the shared output buffer connected
+            // to the source of the channel. This condition is met when all
+            // outgoing channels of the source actor of the channel 'c' contain
+            // less tokens then the channel 'c' contains before the upcoming
+            // consumption.
+            if (releaseStorageSpaceSharedOutputBuffer(p->channel))
             {
-                // Space must be produced in case this is the last channel
-                // to consume the token from the shared output buffer connected
-                // to the source of the channel. This condition is met when all
-                // outgoing channels of the source actor of the channel 'c' contain
-                // less tokens then the channel 'c' contains before the upcoming
-                // consumption.
-                if (releaseStorageSpaceSharedOutputBuffer(c))
-                {
-                    PRODUCE_SP(c->getSrcActor()->getId(), p->getRate());
-                }
-
-                // Consume the tokens from the channel
-                CONSUME(c->getId(), p->getRate());
-            }
-            else
-            {
-                // No space consumed for the output yet?
-                if (!consumedOutputSpace)
-                {
-                    CONSUME_SP(c->getSrcActor()->getId(), p->getRate());
-                    consumedOutputSpace = true;
-                }
+                PRODUCE_SP(cg.getSrcActor(p->channel), p->rate);
             }
+
+            // Consume the tokens from the channel
+            CONSUME(p->channel, p->rate);
+        }
+
+        // Consume space for the output tokens (once, all output channels
+        // share the output buffer)
+        if (cg.outPortsBegin(a) != cg.outPortsEnd(a))
+        {
+            CONSUME_SP(a, cg.outPortsBegin(a)->rate);
         }
 
         // Add actor firing to the list of active firings of this actor
-        currentState.actClk[a->getId()].push_back(a->getExecutionTime());
+        currentState.startFiring(a, cg.getExecutionTime(a));
     }
 
     /**
@@ -363,16 +274,10 @@ namespace SDF
      * the function returns false.
      */
     bool SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem::actorReadyToEnd(
-        SDFactor *a)
+        const CId a)
     {
-        if (currentState.actClk[a->getId()].empty())
-            return false;
-
-        // First actor firing in sorted list has execution time left?
-        if (currentState.actClk[a->getId()].front() != 0)
-            return false;
-
-        return true;
+        // First actor firing in sorted list has no execution time left?
+        return currentState.readyToEnd(a);
     }
 
     /**
@@ -381,22 +286,16 @@ namespace SDF
      * list of active firings.
      */
     void SDFstateSpaceThroughputAnalysisNingGao::TransitionSystem::endActorFiring(
-        SDFactor *a)
+        const CId a)
     {
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = cg.outPortsBegin(a);
+             p != cg.outPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is source of the channel?
-            if (p->getType() == SDFport::Out)
-            {
-                PRODUCE(c->getId(), p->getRate());
-            }
+            PRODUCE(p->channel, p->rate);
         }
 
         // Remove the firing from the list of active actor firings
-        currentState.actClk[a->getId()].pop_front();
+        currentState.endFiring(a);
     }
 
     /**
@@ -411,48 +310,19 @@ namespace SDF
     {
         SDFtime step = UINT_MAX;
 
-        // Find maximal time progress
+        // Find maximal time progress till the next firing of an actor
         for (uint a = 0; a < g->nrActors(); a++)
         {
             SDFtime actClk;
 
-            if (!currentState.actClk[a].empty())
-            {
-                actClk = currentState.actClk[a].front();
-
-                if (step > actClk)
-                    step = actClk;
-            }
-
             // Time till next firing of the actor
             actClk = startTime[a] + fireCnt[a] * period - (SDFtime) globalTime;
             if (step > actClk)
                 step = actClk;
         }
 
-        // Still actors ready to end their firing?
-        if (step == 0)
-            return 0;
-
-        // Check for progress (i.e. no deadlock)
-        if (step == UINT_MAX)
-            return UINT_MAX;
-
-        // Lower remaining execution time actors
-        for (uint a = 0; a < g->nrActors(); a++)
-        {
-            for (list<SDFtime>::iterator iter = currentState.actClk[a].begin();
-                 iter != currentState.actClk[a].end(); iter++)
-            {
-                SDFtime &actFiringTime = *iter;
-
-                // Lower remaining execution time of the actor firing
-                actFiringTime -= step;
-            }
-        }
-
-        // Advance the global clock
-        currentState.glbClk += step;
+        // Progress time till the first firing ends or an actor starts
+        step = currentState.clockStep(step);
 
         return step;
     }
@@ -467,7 +337,7 @@ namespace SDF
     {
         bool startedActorFiring, actorWaitingToFire;
         vector<uint> fireCnt(g->nrActors(), 0);
-        StatesIter recurrentState;
+        uint recurrentState;
         TTime globalTime = 0;
         TTime clkStep;
         int repCnt = 0;
@@ -489,48 +359,40 @@ namespace SDF
         }
 
         // Initial tokens and space
-        for (SDFchannelsIter iter = g->channelsBegin();
-             iter != g->channelsEnd(); iter++)
+        for (CId c = 0; c < cg.nrChannels(); c++)
         {
-            SDFchannel *c = *iter;
+            CId srcActor = cg.getSrcActor(c);
 
             // Not enough space for initial tokens?
-            if (sp[c->getSrcActor()->getId()] < c->getInitialTokens())
+            if (sp[srcActor] < cg.getInitialTokens(c))
             {
                 return 0;
             }
 
-            CH(c->getId()) = c->getInitialTokens();
+            CH(c) = cg.getInitialTokens(c);
 
             // Decrease storage space of the actor when current storage space more
             // then room offered by assigned storage space minus the number of
             // tokens in channel c
-            if (SP(c->getSrcActor()->getId())
-                > sp[c->getSrcActor()->getId()] - c->getInitialTokens())
-            {
-                SP(c->getSrcActor()->getId()) = sp[c->getSrcActor()->getId()]
-                                                - c->getInitialTokens();
-            }
+            if (SP(srcActor) > sp[srcActor] - cg.getInitialTokens(c))
+                SP(srcActor) = sp[srcActor] - cg.getInitialTokens(c);
         }
 
         // Fire the actors
         while (true)
         {
             // Finish actor firings
-            for (SDFactorsIter iter = g->actorsBegin();
-                 iter != g->actorsEnd(); iter++)
+            for (CId a = 0; a < cg.nrActors(); a++)
             {
-                SDFactor *a = *iter;
-
                 while (actorReadyToEnd(a))
                 {
-                    if (outputActor->getId() == a->getId())
+                    if (outputActor == a)
                     {
                         repCnt++;
                         if (repCnt == outputActorRepCnt)
                         {
                             // Add state to hash of visited states
-                            if (!storeState(currentState, recurrentState))
+                            if (!storedStates.store(currentState, recurrentState))
                             {
 
                                 // Compute throughput
@@ -553,14 +415,10 @@ namespace SDF
                 startedActorFiring = false;
                 actorWaitingToFire = false;
 
-                for (SDFactorsIter iter = g->actorsBegin();
-                     iter != g->actorsEnd(); iter++)
+                for (CId a = 0; a < cg.nrActors(); a++)
                 {
-                    TimedSDFactor *a = (TimedSDFactor *)(*iter);
-                    CId aId = a->getId();
-
                     // Should actor fire at this point in time?
-                    while (startTime[aId] + fireCnt[aId] * period == globalTime)
+                    while (startTime[a] + fireCnt[a] * period == globalTime)
                     {
                         // Actor not ready to fire?
                         if (!actorReadyToFire(a))
@@ -572,7 +430,7 @@ namespace SDF
                         // Fire actor a
                         startActorFiring(a);
                         startedActorFiring = true;
-                        fireCnt[aId]++;
+                        fireCnt[a]++;
                     }
                 }
             }
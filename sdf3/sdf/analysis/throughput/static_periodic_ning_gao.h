@@ -13,6 +13,7 @@
  *
  *  History         :
  *      31-03-08    :   Initial version.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
  *
  * $Id: static_periodic_ning_gao.h,v 1.1 2008-09-18 07:35:13 sander Exp $
  *
@@ -39,6 +40,8 @@
 
 #include "../buffersizing/storage_distribution.h"
 #include "../../base/timed/graph.h"
+#include "../../base/timed/compiled_graph.h"
+#include "../statespace/state.h"
 
 namespace SDF
 {
@@ -71,7 +74,7 @@ namespace SDF
                     /***********************************************************************
                      * State
                      **********************************************************************/
-                    class State
+                    class State : public SDFstateSpaceState
                     {
                         public:
                             // Constructor
@@ -86,33 +89,29 @@ namespace SDF
                             // Initialize the state
                             void init(const uint nrActors, const uint nrChannels)
                             {
-                                actClk.resize(nrActors);
-                                ch.resize(nrChannels);
+                                SDFstateSpaceState::init(nrActors, nrChannels);
                                 sp.resize(nrActors);
                             };
 
                             // Compare states
-                            bool operator==(const State &s);
+                            bool operator==(const State &s) const;
 
                             // Clear state
                             void clear();
 
                             // Output state
-                            void print(ostream &out);
+                            void print(ostream &out) const;
+
+                            // Pack state into a sequence of words
+                            void pack(vector<SDFstateWord> &s) const;
 
                             // State information
-                            vector< list<SDFtime> > actClk;
-                            vector< TBufSize > ch;
                             vector< TBufSize > sp;
-                            unsigned long glbClk;
                     };
 
-                    // Sequence of states in transition system
-                    typedef list<State>      States;
-                    typedef States::iterator StatesIter;
-
                     // Constructor
                     TransitionSystem(TimedSDFgraph *gr)
+                        : cg(gr)
                     {
                         g = gr;
                         initOutputActor();
@@ -126,9 +125,6 @@ namespace SDF
                                         vector<SDFtime> &startTime);
 
                 private:
-                    // Store state
-                    bool storeState(State &s, StatesIter &pos);
-
                     // Clear list of stored states
                     void clearStoredStates()
                     {
@@ -136,30 +132,33 @@ namespace SDF
                     };
 
                     // Compute throughput from transition system
-                    TDtime computeThroughput(const StatesIter cycleIter);
+                    TDtime computeThroughput(const uint cycleIdx);
 
                     // State transitions
-                    bool releaseStorageSpaceSharedOutputBuffer(SDFchannel *c);
-                    bool actorReadyToFire(SDFactor *a);
-                    void startActorFiring(TimedSDFactor *a);
-                    bool actorReadyToEnd(SDFactor *a);
-                    void endActorFiring(SDFactor *a);
+                    bool releaseStorageSpaceSharedOutputBuffer(const CId c);
+                    bool actorReadyToFire(const CId a);
+                    void startActorFiring(const CId a);
+                    bool actorReadyToEnd(const CId a);
+                    void endActorFiring(const CId a);
                     SDFtime clockStep(vector<SDFtime> &startTime, vector<uint> &fireCnt,
                                       SDFtime &period, TTime &globalTime);
 
                     // Output actor
                     void initOutputActor();
 
-                    // SDF graph and output actor
+                    // SDF graph and its compiled view
                     TimedSDFgraph *g;
-                    SDFactor *outputActor;
+                    TimedSDFcompiledGraph cg;
+
+                    // Output actor
+                    CId outputActor;
                     TCnt outputActorRepCnt;
 
                     // Current state
                     State currentState;
 
-                    // List of visited states that are stored
-                    States storedStates;
+                    // Visited states that are stored
+                    SDFvisitedStates<State> storedStates;
             };
 
             // SDF graph
@@ -15,6 +15,10 @@
  *
  *  History         :
  *      24-04-06    :   Initial version.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
+ *      17-10-26    :   Only visit actors whose firing ends or which may have
+ *                      become enabled.
+ *      17-10-26    :   Static-order schedules stepped with loop counters.
  *
  * $Id: tdma_schedule.cc,v 1.2.2.1 2010-04-22 07:18:41 mgeilen Exp $
  *
@@ -49,53 +53,15 @@ namespace SDF
      *****************************************************************************/
 
     /**
-     * clear ()
-     * The function sets the state to zero.
-     */
-    void SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem::State
-    ::clear()
-    {
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            actClk[i].clear();
-        }
-
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            ch[i] = 0;
-        }
-
-        glbClk = 0;
-
-        for (uint i = 0; i < schedulePos.size(); i++)
-        {
-            schedulePos[i] = 0;
-            tdmaPos[i] = 0;
-        }
-    }
-
-    /**
-     * operator= ()
+     * operator== ()
      * The function compares to states and returns true if they are equal.
      */
     bool SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem::State
-    ::operator==(const State &s)
+    ::operator==(const State &s) const
     {
-        if (glbClk != s.glbClk)
+        if (!SDFstateSpaceState::operator==(s))
             return false;
 
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            if (ch[i] != s.ch[i])
-                return false;
-        }
-
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            if (actClk[i] != s.actClk[i])
-                return false;
-        }
-
         for (uint i = 0; i < schedulePos.size(); i++)
         {
             if (schedulePos[i] != s.schedulePos[i] || tdmaPos[i] != s.tdmaPos[i])
@@ -110,35 +76,49 @@ namespace SDF
      * Print the state to the supplied stream.
      */
     void SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem::State
-    ::print(ostream &out)
+    ::print(ostream &out) const
     {
-        out << "### State ###" << endl;
+        SDFstateSpaceState::print(out);
 
-        for (uint i = 0; i < actClk.size(); i++)
+        for (uint i = 0; i < schedulePos.size(); i++)
         {
-            out << "actClk[" << i << "] =";
-
-            for (list<SDFtime>::const_iterator iter = actClk[i].begin();
-                 iter != actClk[i].end(); iter++)
-            {
-                out << " " << (*iter) << ", ";
-            }
-
-            out << endl;
+            out << "tile[" << i << "] = (";
+            out << schedulePos[i].index;
+            out << ", " << tdmaPos[i] << ")" << endl;
         }
+    }
+
+    /**
+     * clear ()
+     * The function sets the state to zero.
+     */
+    void SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem::State
+    ::clear()
+    {
+        SDFstateSpaceState::clear();
 
-        for (uint i = 0; i < ch.size(); i++)
+        for (uint i = 0; i < schedulePos.size(); i++)
         {
-            out << "ch[" << i << "] = " << ch[i] << endl;
+            schedulePos[i] = StaticOrderSchedulePosition();
+            tdmaPos[i] = 0;
         }
+    }
 
-        out << "glbClk = " << glbClk << endl;
+    /**
+     * pack ()
+     * The function packs the state into a sequence of words. The shared part
+     * of the state is followed by the schedule and TDMA wheel positions of all
+     * tiles.
+     */
+    void SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem::State
+    ::pack(vector<SDFstateWord> &s) const
+    {
+        SDFstateSpaceState::pack(s);
 
         for (uint i = 0; i < schedulePos.size(); i++)
         {
-            out << "tile[" << i << "] = (";
-            out << schedulePos[i];
-            out << ", " << tdmaPos[i] << ")" << endl;
+            s.push_back(schedulePos[i].index);
+            s.push_back(tdmaPos[i]);
         }
     }
 
@@ -154,27 +134,21 @@ namespace SDF
     void SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem
     ::initOutputActor()
     {
-        RepetitionVector repVec;
+        const RepetitionVector &repVec = g.getRepetitionVector();
         int min = INT_MAX;
-        SDFactor *a = NULL;
-
-        // Compute repetition vector
-        repVec = computeRepetitionVector(bindingAwareSDFG);
 
         // Select actor with lowest entry in repetition vector as output actor
-        for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-             iter != bindingAwareSDFG->actorsEnd(); iter++)
+        for (CId a = 0; a < g.nrActors(); a++)
         {
-            if (repVec[(*iter)->getId()] < min)
+            if (repVec[a] < min)
             {
-                a = *iter;
-                min = repVec[a->getId()];
+                outputActor = a;
+                min = repVec[a];
             }
         }
 
-        // Set output actor and its repetition vector count
-        outputActor = a;
-        outputActorRepCnt = repVec[outputActor->getId()];
+        // Set output actor repetition vector count
+        outputActorRepCnt = repVec[outputActor];
     }
 
     /**
@@ -188,10 +162,11 @@ namespace SDF
 
         // Check that all actor that are bound to a processors are bound to a
         // processor which has a schedule
-        for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-             iter != bindingAwareSDFG->actorsEnd(); iter++)
+        actorTile.assign(g.nrActors(), ACTOR_NOT_BOUND);
+        for (CId a = 0; a < g.nrActors(); a++)
         {
-            tileId = bindingAwareSDFG->getBindingOfActorToTile(*iter);
+            tileId = bindingAwareSDFG->getBindingOfActorToTile(g.getActor(a));
+            actorTile[a] = tileId;
 
             if (tileId != ACTOR_NOT_BOUND)
             {
@@ -203,62 +178,26 @@ namespace SDF
         }
     }
 
-    /**
-     * storeState ()
-     * The function stores the state s on whenever s is not already in the
-     * list of storedStates. When s is stored, the function returns true. When the
-     * state s is already in the list, the state s is not stored. The function
-     * returns false. The function always sets the pos variable to the position
-     * where the state s is in the list.
-     */
-    bool SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem::storeState(
-        State &s, StatesIter &pos)
-    {
-        // Find state in the list of stored states
-        for (StatesIter iter = storedStates.begin();
-             iter != storedStates.end(); iter++)
-        {
-            State &x = *iter;
-
-            // State s at position iter in the list?
-            if (x == s)
-            {
-                pos = iter;
-                return false;
-            }
-        }
-
-        // State not found, store it at the end of the list
-        storedStates.push_back(s);
-
-        // Added state to the end of the list
-        pos = storedStates.end();
-
-        return true;
-    }
-
     /**
      * computeThroughput ()
      * The function calculates the throughput of the states on the cycle. Its
      * value is equal to the average number of firings of an actor per time unit.
      */
     TDtime SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem
-    ::computeThroughput(const StatesIter cycleIter)
+    ::computeThroughput(const uint cycleIdx)
     {
         int nr_fire = 0;
         TDtime time = 0;
 
         // Check all state from stack till cycle complete
-        for (StatesIter iter = cycleIter; iter != storedStates.end(); iter++)
+        for (uint i = cycleIdx; i < storedStates.size(); i++)
         {
-            State &s = *iter;
-
             // Number of states in cycle is equal to number of iterations
             // in the period
             nr_fire++;
 
             // Time between previous state
-            time += s.glbClk;
+            time += storedStates.glbClk(i);
         }
 
         return (TDtime)(nr_fire) / (time);
@@ -270,10 +209,10 @@ namespace SDF
      * during the periodic part of the execution.
      */
     void SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem
-    ::computeTileUtilization(const StatesIter recurrentState,
+    ::computeTileUtilization(const uint recurrentState,
                              vector<double> &tileUtilization)
     {
-        RepetitionVector repVec = computeRepetitionVector(bindingAwareSDFG);
+        const RepetitionVector &repVec = g.getRepetitionVector();
         double nrItersInPeriod = 0;
         double lengthOfPeriod = 0;
 
@@ -283,33 +222,28 @@ namespace SDF
             tileUtilization[t] = 0;
 
         // Check all state from stack till cycle complete
-        for (StatesIter iter = recurrentState;
-             iter != storedStates.end(); iter++)
+        for (uint i = recurrentState; i < storedStates.size(); i++)
         {
-            State &s = *iter;
-
             // Number of states in cycle is equal to number of iterations
             // in the period
             nrItersInPeriod++;
 
             // Time between previous state
-            lengthOfPeriod += s.glbClk;
+            lengthOfPeriod += storedStates.glbClk(i);
         }
 
         // The activity of a processor is given by the sum of execution time of the
         // actors executed on the processor multiplied with the number of
         // invocations of an actor per iteration and the number of iterations per
         // period.
-        for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-             iter != bindingAwareSDFG->actorsEnd(); iter++)
+        for (CId a = 0; a < g.nrActors(); a++)
         {
-            TimedSDFactor *a = (TimedSDFactor *)(*iter);
-            uint t = bindingAwareSDFG->getBindingOfActorToTile(a);
+            uint t = actorTile[a];
 
             if (t != ACTOR_NOT_BOUND)
             {
                 tileUtilization[t] = tileUtilization[t]
-                                     + a->getExecutionTime() * repVec[a->getId()] * nrItersInPeriod;
+                                     + g.getExecutionTime(a) * repVec[a] * nrItersInPeriod;
             }
         }
 
@@ -327,8 +261,7 @@ namespace SDF
 #define SOS_POS(p)          currentState.schedulePos[p]
 
 #define SOS(p)              (bindingAwareSDFG->getScheduleOnTile(p))
-#define SOS_ENTRY(p)        (SOS(p).getScheduleEntry(SOS_POS(p)))
-#define SOS_NEXT_POS(p)     (SOS(p).next(SOS_POS(p)))
+#define SOS_ACTOR(p)        (SOS(p).getActor(SOS_POS(p)))
 
 #define CH_TOKENS(c,n)      (CH(c) >= n)
 #define CONSUME(c,n)        CH(c) = CH(c) - n;
@@ -342,32 +275,24 @@ namespace SDF
      * s. Else it returns false.
      */
     bool SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem
-    ::actorReadyToFire(SDFactor *a)
+    ::actorReadyToFire(const CId a)
     {
         // Actor bound to processor?
-        if (bindingAwareSDFG->getBindingOfActorToTile(a) != ACTOR_NOT_BOUND)
+        if (actorTile[a] != ACTOR_NOT_BOUND)
         {
-            uint p = bindingAwareSDFG->getBindingOfActorToTile(a);
+            uint p = actorTile[a];
 
             // Actor not scheduled on processor?
-            if (SOS_ENTRY(p)->actor->getId() != a->getId())
+            if (SOS_ACTOR(p)->getId() != a)
                 return false;
         }
 
         // Check all input ports for tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = g.inPortsBegin(a);
+             p != g.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                if (!CH_TOKENS(c->getId(), p->getRate()))
-                {
-                    return false;
-                }
-            }
+            if (!CH_TOKENS(p->channel, p->rate))
+                return false;
         }
 
         return true;
@@ -380,35 +305,29 @@ namespace SDF
      * position.
      */
     void SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem
-    ::startActorFiring(TimedSDFactor *a)
+    ::startActorFiring(const CId a)
     {
         SDFtime execTime, completionTime, timeTileStartOfSlice, waitingTime;
         int remainingExecTime, nrOfFullRotationsInNonReservedPart;
 
-        // Consume tokens from inputs and space for output tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        // Consume tokens from inputs
+        for (const TimedSDFcompiledGraph::Port *p = g.inPortsBegin(a);
+             p != g.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                CONSUME(c->getId(), p->getRate());
-            }
+            CONSUME(p->channel, p->rate);
         }
 
         // Execution time of the actor
-        execTime = a->getExecutionTime();
+        execTime = g.getExecutionTime(a);
 
         // Compute time needed to complete actor firing
-        if (bindingAwareSDFG->getBindingOfActorToTile(a) == ACTOR_NOT_BOUND)
+        if (actorTile[a] == ACTOR_NOT_BOUND)
         {
             completionTime = execTime;
         }
         else
         {
-            uint p = bindingAwareSDFG->getBindingOfActorToTile(a);
+            uint p = actorTile[a];
 
             // Time wheel has not yet reached start of slice?
             if (currentState.tdmaPos[p]
@@ -454,10 +373,10 @@ namespace SDF
         }
 
         // Add actor firing to the list of active firings of this actor
-        currentState.actClk[a->getId()].push_back(completionTime);
+        currentState.startFiring(a, completionTime);
 
 #ifdef _PRINT_STATESPACE
-        cout << "start: " << a->getName() << endl;
+        cout << "start: " << g.getActor(a)->getName() << endl;
 #endif
     }
 
@@ -467,16 +386,10 @@ namespace SDF
      * the function returns false.
      */
     bool SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem
-    ::actorReadyToEnd(SDFactor *a)
+    ::actorReadyToEnd(const CId a)
     {
-        if (currentState.actClk[a->getId()].empty())
-            return false;
-
-        // First actor firing in sorted list has execution time left?
-        if (currentState.actClk[a->getId()].front() != 0)
-            return false;
-
-        return true;
+        // First actor firing in sorted list has no execution time left?
+        return currentState.readyToEnd(a);
     }
 
     /**
@@ -485,34 +398,28 @@ namespace SDF
      * list of active firings.
      */
     void SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem
-    ::endActorFiring(SDFactor *a)
+    ::endActorFiring(const CId a)
     {
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = g.outPortsBegin(a);
+             p != g.outPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is source of the channel?
-            if (p->getType() == SDFport::Out)
-            {
-                PRODUCE(c->getId(), p->getRate());
-            }
+            PRODUCE(p->channel, p->rate);
         }
 
         // Remove the firing from the list of active actor firings
-        currentState.actClk[a->getId()].pop_front();
+        currentState.endFiring(a);
 
         // Actor bound to processor?
-        if (bindingAwareSDFG->getBindingOfActorToTile(a) != ACTOR_NOT_BOUND)
+        if (actorTile[a] != ACTOR_NOT_BOUND)
         {
-            uint p = bindingAwareSDFG->getBindingOfActorToTile(a);
+            uint p = actorTile[a];
 
             // Advance the schedule to the next state
-            SOS_POS(p) = SOS_NEXT_POS(p);
+            SOS(p).nextPosition(SOS_POS(p));
         }
 
 #ifdef _PRINT_STATESPACE
-        cout << "end:   " << a->getName() << endl;
+        cout << "end:   " << g.getActor(a)->getName() << endl;
 #endif
     }
 
@@ -525,40 +432,14 @@ namespace SDF
     SDFtime SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem
     ::clockStep()
     {
-        SDFtime step = UINT_MAX;
-
-        // Find maximal time progress
-        for (uint a = 0; a < bindingAwareSDFG->nrActors(); a++)
-        {
-            if (!currentState.actClk[a].empty())
-            {
-                SDFtime actClk = currentState.actClk[a].front();
-
-                if (step > actClk)
-                    step = actClk;
-            }
-        }
+        SDFtime step;
 
-        // Still actors ready to end their firing?
-        if (step == 0)
-            return 0;
+        // Progress time till the first firing ends
+        step = currentState.clockStep();
 
-        // Check for progress (i.e. no deadlock)
-        if (step == UINT_MAX)
-            return UINT_MAX;
-
-        // Lower remaining execution time actors
-        for (uint a = 0; a < bindingAwareSDFG->nrActors(); a++)
-        {
-            for (list<SDFtime>::iterator iter = currentState.actClk[a].begin();
-                 iter != currentState.actClk[a].end(); iter++)
-            {
-                SDFtime &actFiringTime = *iter;
-
-                // Lower remaining execution time of the actor firing
-                actFiringTime -= step;
-            }
-        }
+        // Still actors ready to end their firing or deadlock?
+        if (step == 0 || step == UINT_MAX)
+            return step;
 
         // Advance the time wheels
         for (uint t = 0; t < bindingAwareSDFG->nrTilesInPlatformGraph(); t++)
@@ -567,9 +448,6 @@ namespace SDF
                                       % bindingAwareSDFG->getTDMAsizeOnTile(t);
         }
 
-        // Advance the global clock
-        currentState.glbClk += step;
-
 #ifdef _PRINT_STATESPACE
         cout << "clk:   " << step << endl;
 #endif
@@ -577,47 +455,84 @@ namespace SDF
         return step;
     }
 
+    /**
+     * addCandidates ()
+     * The end of a firing of actor a produces tokens for the consumers of its
+     * output channels and, when a is bound to a tile, advances the static-order
+     * schedule of that tile to its next actor. Only these actors can become
+     * enabled by this transition.
+     */
+    void SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem
+    ::addCandidates(const CId a, vector<CId> &candidates,
+                    vector<bool> &isCandidate)
+    {
+        for (const CId *b = g.consumersBegin(a); b != g.consumersEnd(a); b++)
+        {
+            if (!isCandidate[*b])
+            {
+                isCandidate[*b] = true;
+                candidates.push_back(*b);
+            }
+        }
+
+        // Actor bound to processor?
+        if (actorTile[a] != ACTOR_NOT_BOUND)
+        {
+            CId b = SOS(actorTile[a]).getActor(SOS_POS(actorTile[a]))->getId();
+
+            if (!isCandidate[b])
+            {
+                isCandidate[b] = true;
+                candidates.push_back(b);
+            }
+        }
+    }
+
     /**
      * execSDFgraph()
      * Execute the SDF graph till a deadlock is found or a recurrent state.
-     * The throughput is returned.
+     * The throughput is returned. Only the actors whose firing ends at the
+     * current time are visited to end their firings and only the actors
+     * affected by these transitions are checked for enabling.
      */
     TDtime SDFstateSpaceBindingAwareThroughputAnalysis::TransitionSystem
     ::execSDFgraph(vector<double> &tileUtilization)
     {
-        StatesIter recurrentState;
+        uint recurrentState;
         SDFtime clkStep;
         int repCnt = 0;
+        vector<CId> endingActors;
+        vector<CId> candidates;
+        vector<bool> isCandidate(g.nrActors(), true);
 
         // Clear the list of stored states
         clearStoredStates();
 
         // Create initial state
-        currentState.init(bindingAwareSDFG->nrActors(),
-                          bindingAwareSDFG->nrChannels(),
+        currentState.init(g.nrActors(),
+                          g.nrChannels(),
                           bindingAwareSDFG->nrTilesInPlatformGraph());
         currentState.clear();
-        previousState.init(bindingAwareSDFG->nrActors(),
-                           bindingAwareSDFG->nrChannels(),
+        previousState.init(g.nrActors(),
+                           g.nrChannels(),
                            bindingAwareSDFG->nrTilesInPlatformGraph());
         previousState.clear();
 
         // Initial tokens
-        for (SDFchannelsIter iter = bindingAwareSDFG->channelsBegin();
-             iter != bindingAwareSDFG->channelsEnd(); iter++)
-        {
-            SDFchannel *c = *iter;
-
-            CH(c->getId()) = c->getInitialTokens();
-        }
+        for (CId c = 0; c < g.nrChannels(); c++)
+            CH(c) = g.getInitialTokens(c);
 
         // Initial schedules
         for (uint p = 0; p < bindingAwareSDFG->nrTilesInPlatformGraph(); p++)
         {
-            SOS_POS(p) = 0;
+            SOS(p).initPosition(SOS_POS(p));
             TDMA_POS(p) = 0;
         }
 
+        // Initially all actors may be enabled
+        for (CId a = 0; a < g.nrActors(); a++)
+            candidates.push_back(a);
+
 #ifdef _PRINT_STATESPACE
         cout << "### start statespace exploration" << endl;
 #endif
@@ -626,20 +541,20 @@ namespace SDF
         while (true)
         {
             // Store partial state to check for progress
-            for (uint i = 0; i < bindingAwareSDFG->nrChannels(); i++)
+            for (uint i = 0; i < g.nrChannels(); i++)
             {
                 previousState.ch[i] = currentState.ch[i];
             }
 
             // Finish actor firings
-            for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-                 iter != bindingAwareSDFG->actorsEnd(); iter++)
+            currentState.actorsReadyToEnd(endingActors);
+            for (uint i = 0; i < endingActors.size(); i++)
             {
-                SDFactor *a = *iter;
+                CId a = endingActors[i];
 
                 while (actorReadyToEnd(a))
                 {
-                    if (outputActor->getId() == a->getId())
+                    if (outputActor == a)
                     {
                         repCnt++;
                         if (repCnt == outputActorRepCnt)
@@ -648,7 +563,7 @@ namespace SDF
                             currentState.print(cout);
 #endif
                             // Add state to hash of visited states
-                            if (!storeState(currentState, recurrentState))
+                            if (!storedStates.store(currentState, recurrentState))
                             {
                                 computeTileUtilization(recurrentState,
                                                        tileUtilization);
@@ -668,13 +583,14 @@ namespace SDF
                     // End the actor firing
                     endActorFiring(a);
                 }
+
+                addCandidates(a, candidates, isCandidate);
             }
 
             // Start actor firings
-            for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-                 iter != bindingAwareSDFG->actorsEnd(); iter++)
+            for (uint i = 0; i < candidates.size(); i++)
             {
-                TimedSDFactor *a = (TimedSDFactor *)(*iter);
+                CId a = candidates[i];
 
                 // Ready to fire actor a?
                 while (actorReadyToFire(a))
@@ -682,7 +598,10 @@ namespace SDF
                     // Fire actor a
                     startActorFiring(a);
                 }
+
+                isCandidate[a] = false;
             }
+            candidates.clear();
 
             // Clock step
             clkStep = clockStep();
@@ -719,8 +638,12 @@ namespace SDF
         if (!isStronglyConnectedGraph(bg))
             throw CException("Graph is not strongly connected.");
 
+        // Compile the graph (execution times of the TDMA actors may differ
+        // between calls)
+        TimedSDFcompiledGraph cg(bg);
+
         // Create a transition system
-        TransitionSystem transitionSystem(bg);
+        TransitionSystem transitionSystem(bg, cg);
 
         // Find the maximal throughput
         thr = transitionSystem.execSDFgraph(tileUtilization);
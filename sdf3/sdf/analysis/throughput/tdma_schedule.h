@@ -15,6 +15,9 @@
  *
  *  History         :
  *      24-04-06    :   Initial version.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
+ *      17-10-26    :   Only visit actors whose firing ends or which may have
+ *                      become enabled.
  *
  * $Id: tdma_schedule.h,v 1.1 2008-03-06 10:49:44 sander Exp $
  *
@@ -40,6 +43,8 @@
 #define SDF_ANALYSIS_STATESPACE_TDMA_SCHEDULE_H_INCLUDED
 
 #include "../../resource_allocation/binding_aware_sdfg/binding_aware_sdfg.h"
+#include "../../base/timed/compiled_graph.h"
+#include "../statespace/state.h"
 
 namespace SDF
 {
@@ -76,7 +81,7 @@ namespace SDF
                     /***********************************************************************
                      * State
                      **********************************************************************/
-                    class State
+                    class State : public SDFstateSpaceState
                     {
                         public:
                             // Constructor
@@ -93,35 +98,32 @@ namespace SDF
                             void init(const uint nrActors, const uint nrChannels,
                                       const uint nrTiles)
                             {
-                                actClk.resize(nrActors);
-                                ch.resize(nrChannels);
+                                SDFstateSpaceState::init(nrActors, nrChannels);
                                 schedulePos.resize(nrTiles);
                                 tdmaPos.resize(nrTiles);
                             };
 
                             // Compare states
-                            bool operator==(const State &s);
+                            bool operator==(const State &s) const;
 
                             // Clear state
                             void clear();
 
                             // Output state
-                            void print(ostream &out);
+                            void print(ostream &out) const;
+
+                            // Pack state into a sequence of words
+                            void pack(vector<SDFstateWord> &s) const;
 
                             // State information
-                            vector< list<SDFtime> > actClk;
-                            vector< TBufSize > ch;
-                            unsigned long glbClk;
-                            vector< uint > schedulePos;
+                            vector< StaticOrderSchedulePosition > schedulePos;
                             vector< SDFtime > tdmaPos;
                     };
 
-                    // Sequence of states in transition system
-                    typedef list<State>      States;
-                    typedef States::iterator StatesIter;
-
                     // Constructor
-                    TransitionSystem(BindingAwareSDFG *bg)
+                    TransitionSystem(BindingAwareSDFG *bg,
+                                     const TimedSDFcompiledGraph &cg)
+                        : g(cg)
                     {
                         bindingAwareSDFG = bg;
                         checkBindingAwareSDFG();
@@ -135,9 +137,6 @@ namespace SDF
                     TDtime execSDFgraph(vector<double> &tileUtilization);
 
                 private:
-                    // Store state
-                    bool storeState(State &s, StatesIter &pos);
-
                     // Clear list of stored states
                     void clearStoredStates()
                     {
@@ -145,38 +144,46 @@ namespace SDF
                     };
 
                     // Compute throughput from transition system
-                    TDtime computeThroughput(const StatesIter cycleIter);
+                    TDtime computeThroughput(const uint cycleIdx);
 
                     // Utilization of tiles in the platform by the application
-                    void computeTileUtilization(const StatesIter recurrentState,
+                    void computeTileUtilization(const uint recurrentState,
                                                 vector<double> &tileUtilization);
 
                     // State transitions
-                    bool actorReadyToFire(SDFactor *a);
-                    void startActorFiring(TimedSDFactor *a);
-                    bool actorReadyToEnd(SDFactor *a);
-                    void endActorFiring(SDFactor *a);
+                    bool actorReadyToFire(const CId a);
+                    void startActorFiring(const CId a);
+                    bool actorReadyToEnd(const CId a);
+                    void endActorFiring(const CId a);
                     SDFtime clockStep();
 
+                    // Actors to check for enabling after a firing of a ends
+                    void addCandidates(const CId a, vector<CId> &candidates,
+                                       vector<bool> &isCandidate);
+
                     // Output actor
                     void initOutputActor();
 
                     // Sanity checks on the binding-aware SDFG
                     void checkBindingAwareSDFG();
 
-                    // Binding-aware SDFG
+                    // Binding-aware SDFG and its compiled view
                     BindingAwareSDFG *bindingAwareSDFG;
+                    const TimedSDFcompiledGraph &g;
+
+                    // Tile to which every actor is bound (indexed on id)
+                    vector<CId> actorTile;
 
-                    // SDF graph and output actor
-                    SDFactor *outputActor;
+                    // Output actor
+                    CId outputActor;
                     TCnt outputActorRepCnt;
 
                     // Current and previous state
                     State currentState;
                     State previousState;
 
-                    // List of visited states that are stored
-                    States storedStates;
+                    // Visited states that are stored
+                    SDFvisitedStates<State> storedStates;
             };
     };
 
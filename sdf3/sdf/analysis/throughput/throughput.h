@@ -68,6 +68,14 @@
  * operational semantics of Ning and Gao.
  */
 #include "static_periodic_ning_gao.h"
+
+/**
+ * Max-plus throughput analysis
+ * Computes the throughput of an SDFG, or of an SDFG mapped to a platform with
+ * completely reserved TDMA wheels, from the eigenvalue of the max-plus matrix
+ * of its self-timed execution.
+ */
+#include "maxplus_throughput.h"
 namespace SDF
 {
 
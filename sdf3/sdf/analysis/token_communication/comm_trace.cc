@@ -65,7 +65,7 @@ namespace SDF
 
         for (uint i = 0; i < schedulePos.size(); i++)
         {
-            schedulePos[i] = 0;
+            schedulePos[i] = StaticOrderSchedulePosition();
             tdmaPos[i] = 0;
         }
     }
@@ -133,7 +133,7 @@ namespace SDF
         for (uint i = 0; i < schedulePos.size(); i++)
         {
             out << "tile[" << i << "] = (";
-            out << schedulePos[i];
+            out << schedulePos[i].index;
             out << ", " << tdmaPos[i] << ")" << endl;
         }
     }
@@ -818,8 +818,7 @@ namespace SDF
 #define SOS_POS(p)          currentState.schedulePos[p]
 
 #define SOS(p)              (bindingAwareSDFG->getScheduleOnTile(p))
-#define SOS_ENTRY(p)        (SOS(p).getScheduleEntry(SOS_POS(p)))
-#define SOS_NEXT_POS(p)     (SOS(p).next(SOS_POS(p)))
+#define SOS_ACTOR(p)        (SOS(p).getActor(SOS_POS(p)))
 
 #define CH_TOKENS(c,n)      (CH(c) >= n)
 #define CONSUME(c,n)        CH(c) = CH(c) - n;
@@ -863,7 +862,7 @@ namespace SDF
             uint p = bindingAwareSDFG->getBindingOfActorToTile(a);
 
             // Actor not scheduled on processor?
-            if (SOS_ENTRY(p)->actor->getId() != a->getId())
+            if (SOS_ACTOR(p)->getId() != a->getId())
                 return false;
         }
 
@@ -1034,7 +1033,7 @@ namespace SDF
             uint p = bindingAwareSDFG->getBindingOfActorToTile(a);
 
             // Advance the schedule to the next state
-            SOS_POS(p) = SOS_NEXT_POS(p);
+            SOS(p).nextPosition(SOS_POS(p));
         }
     }
 
@@ -1136,7 +1135,7 @@ namespace SDF
         // Initial schedules
         for (uint p = 0; p < bindingAwareSDFG->nrTilesInPlatformGraph(); p++)
         {
-            SOS_POS(p) = 0;
+            SOS(p).initPosition(SOS_POS(p));
             TDMA_POS(p) = 0;
         }
 
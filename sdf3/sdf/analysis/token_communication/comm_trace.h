@@ -108,7 +108,7 @@ namespace SDF
                             vector< list<SDFtime> > actClk;
                             vector< TBufSize > ch;
                             unsigned long glbClk;
-                            vector< uint > schedulePos;
+                            vector< StaticOrderSchedulePosition > schedulePos;
                             vector< SDFtime > tdmaPos;
                     };
 
@@ -0,0 +1,155 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   compiled_graph.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Compiled (CSR) view of a timed SDF graph
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "compiled_graph.h"
+#include <algorithm>
+namespace SDF
+{
+    /**
+     * TimedSDFcompiledGraph ()
+     * Constructor. The function compiles the graph g into its CSR view. Ports
+     * which are not connected to a channel are left out.
+     */
+    TimedSDFcompiledGraph::TimedSDFcompiledGraph(TimedSDFgraph *g)
+        : graph(g)
+    {
+        uint nrActors = g->nrActors();
+        uint nrChannels = g->nrChannels();
+
+        actors.assign(nrActors, NULL);
+        executionTime.assign(nrActors, 0);
+        portOffset.assign(nrActors + 1, 0);
+        outPortOffset.assign(nrActors, 0);
+        consumerOffset.assign(nrActors + 1, 0);
+        producerOffset.assign(nrActors + 1, 0);
+
+        initialTokens.assign(nrChannels, 0);
+        srcActor.assign(nrChannels, 0);
+        dstActor.assign(nrChannels, 0);
+        srcRate.assign(nrChannels, 0);
+        dstRate.assign(nrChannels, 0);
+
+        // Actors
+        for (SDFactorsIter iter = g->actorsBegin(); iter != g->actorsEnd();
+             iter++)
+        {
+            TimedSDFactor *a = (TimedSDFactor *)(*iter);
+
+            if (a->getId() >= nrActors)
+                throw CException("Actor '" + a->getName() + "' has an id "
+                                 "outside the range of actor ids.");
+
+            actors[a->getId()] = a;
+            executionTime[a->getId()] = a->getExecutionTime();
+        }
+
+        // Channels
+        for (SDFchannelsIter iter = g->channelsBegin();
+             iter != g->channelsEnd(); iter++)
+        {
+            SDFchannel *c = *iter;
+
+            if (c->getId() >= nrChannels)
+                throw CException("Channel '" + c->getName() + "' has an id "
+                                 "outside the range of channel ids.");
+
+            initialTokens[c->getId()] = c->getInitialTokens();
+            srcActor[c->getId()] = c->getSrcActor()->getId();
+            dstActor[c->getId()] = c->getDstActor()->getId();
+            srcRate[c->getId()] = c->getSrcPort()->getRate();
+            dstRate[c->getId()] = c->getDstPort()->getRate();
+        }
+
+        // Ports (input ports first), consumers and producers of every actor
+        for (CId a = 0; a < nrActors; a++)
+        {
+            if (actors[a] == NULL)
+                throw CException("Actor ids of the graph are not contiguous.");
+
+            portOffset[a] = ports.size();
+            for (int pass = 0; pass < 2; pass++)
+            {
+                SDFport::SDFportType type = (pass == 0 ? SDFport::In
+                                             : SDFport::Out);
+
+                if (pass == 1)
+                    outPortOffset[a] = ports.size();
+
+                for (SDFportsIter iter = actors[a]->portsBegin();
+                     iter != actors[a]->portsEnd(); iter++)
+                {
+                    SDFport *p = *iter;
+                    Port port;
+
+                    if (p->getType() != type || p->getChannel() == NULL)
+                        continue;
+
+                    port.channel = p->getChannel()->getId();
+                    port.rate = p->getRate();
+                    ports.push_back(port);
+                }
+            }
+
+            consumerOffset[a] = consumers.size();
+            for (uint i = outPortOffset[a]; i < ports.size(); i++)
+            {
+                CId b = dstActor[ports[i].channel];
+
+                if (std::find(consumers.begin() + consumerOffset[a],
+                              consumers.end(), b) == consumers.end())
+                {
+                    consumers.push_back(b);
+                }
+            }
+
+            producerOffset[a] = producers.size();
+            for (uint i = portOffset[a]; i < outPortOffset[a]; i++)
+            {
+                CId b = srcActor[ports[i].channel];
+
+                if (std::find(producers.begin() + producerOffset[a],
+                              producers.end(), b) == producers.end())
+                {
+                    producers.push_back(b);
+                }
+            }
+        }
+        portOffset[nrActors] = ports.size();
+        consumerOffset[nrActors] = consumers.size();
+        producerOffset[nrActors] = producers.size();
+
+        // Repetition vector
+        repetitionVector = computeRepetitionVector(g);
+    }
+
+}//namespace SDF
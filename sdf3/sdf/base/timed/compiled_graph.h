@@ -0,0 +1,201 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   compiled_graph.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Compiled (CSR) view of a timed SDF graph
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef SDF_BASE_TIMED_COMPILED_GRAPH_H_INCLUDED
+#define SDF_BASE_TIMED_COMPILED_GRAPH_H_INCLUDED
+
+#include "graph.h"
+#include "../algo/repetition_vector.h"
+namespace SDF
+{
+    /**
+     * TimedSDFcompiledGraph
+     * Immutable view of a timed SDF graph in compressed-sparse-row form. The
+     * ports of all actors are stored in one contiguous array, ordered on the
+     * id of their actor. The ports of an actor start with its input ports,
+     * followed by its output ports. Every port is stored as the id of its
+     * channel and its rate. The view also contains the execution time of
+     * every actor (on its default processor), the initial tokens, source and
+     * destination of every channel, the repetition vector, the consumers
+     * of the output channels and the producers of the input channels of
+     * every actor.
+     *
+     * The view is a snapshot of the graph at the moment it is constructed.
+     * Later changes to the graph (e.g. execution times) are not visible in
+     * the view. Actors and channels are identified by their id, which must
+     * be in the range 0 to nrActors()-1 and 0 to nrChannels()-1.
+     */
+    class TimedSDFcompiledGraph
+    {
+        public:
+            // Port of an actor
+            struct Port
+            {
+                CId channel;
+                SDFrate rate;
+            };
+
+            // Constructor
+            TimedSDFcompiledGraph(TimedSDFgraph *g);
+
+            // Destructor
+            ~TimedSDFcompiledGraph() {};
+
+            // Graph
+            TimedSDFgraph *getGraph() const
+            {
+                return graph;
+            };
+            uint nrActors() const
+            {
+                return actors.size();
+            };
+            uint nrChannels() const
+            {
+                return initialTokens.size();
+            };
+
+            // Actor with id a
+            TimedSDFactor *getActor(const CId a) const
+            {
+                return actors[a];
+            };
+
+            // Input ports of actor a
+            const Port *inPortsBegin(const CId a) const
+            {
+                return ports.data() + portOffset[a];
+            };
+            const Port *inPortsEnd(const CId a) const
+            {
+                return ports.data() + outPortOffset[a];
+            };
+
+            // Output ports of actor a
+            const Port *outPortsBegin(const CId a) const
+            {
+                return ports.data() + outPortOffset[a];
+            };
+            const Port *outPortsEnd(const CId a) const
+            {
+                return ports.data() + portOffset[a + 1];
+            };
+
+            // Actors consuming tokens from the output channels of actor a
+            const CId *consumersBegin(const CId a) const
+            {
+                return consumers.data() + consumerOffset[a];
+            };
+            const CId *consumersEnd(const CId a) const
+            {
+                return consumers.data() + consumerOffset[a + 1];
+            };
+
+            // Actors producing tokens on the input channels of actor a
+            const CId *producersBegin(const CId a) const
+            {
+                return producers.data() + producerOffset[a];
+            };
+            const CId *producersEnd(const CId a) const
+            {
+                return producers.data() + producerOffset[a + 1];
+            };
+
+            // Execution time of actor a
+            SDFtime getExecutionTime(const CId a) const
+            {
+                return executionTime[a];
+            };
+
+            // Channel c
+            uint getInitialTokens(const CId c) const
+            {
+                return initialTokens[c];
+            };
+            CId getSrcActor(const CId c) const
+            {
+                return srcActor[c];
+            };
+            CId getDstActor(const CId c) const
+            {
+                return dstActor[c];
+            };
+            SDFrate getSrcRate(const CId c) const
+            {
+                return srcRate[c];
+            };
+            SDFrate getDstRate(const CId c) const
+            {
+                return dstRate[c];
+            };
+
+            // Repetition vector (all zero for an inconsistent graph)
+            const RepetitionVector &getRepetitionVector() const
+            {
+                return repetitionVector;
+            };
+
+        private:
+            // Graph
+            TimedSDFgraph *graph;
+
+            // Actors indexed on their id
+            vector<TimedSDFactor *> actors;
+
+            // Ports of all actors
+            vector<uint> portOffset;
+            vector<uint> outPortOffset;
+            vector<Port> ports;
+
+            // Consumers of the output channels of all actors
+            vector<uint> consumerOffset;
+            vector<CId> consumers;
+
+            // Producers of the input channels of all actors
+            vector<uint> producerOffset;
+            vector<CId> producers;
+
+            // Actor properties
+            vector<SDFtime> executionTime;
+            RepetitionVector repetitionVector;
+
+            // Channel properties
+            vector<uint> initialTokens;
+            vector<CId> srcActor;
+            vector<CId> dstActor;
+            vector<SDFrate> srcRate;
+            vector<SDFrate> dstRate;
+    };
+
+}//namespace SDF
+#endif
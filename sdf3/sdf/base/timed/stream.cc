@@ -0,0 +1,801 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   stream.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Streaming construction and binary cache of timed
+ *                      SDF graphs
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "stream.h"
+
+// Kind of the cache entries
+#define TIMED_SDFG_CACHE_KIND   "timedsdf"
+
+namespace SDF
+{
+    /**
+     * TimedSDFgraphSAXHandler
+     * Constructs a timed SDFG from the events of the streaming parser. Each
+     * open element has a context that determines how its children are
+     * interpreted. Like the DOM-based construction, only the first occurrence
+     * of a singular child element (e.g. executionTime) is used.
+     */
+    class TimedSDFgraphSAXHandler : public CSAXHandler
+    {
+        public:
+            // Constructor
+            TimedSDFgraphSAXHandler(const CString &filename, const CString &module)
+                : filename(filename), module(module), graph(NULL),
+                  actor(NULL), channel(NULL), processor(NULL),
+                  applicationGraphFound(false), done(false) {};
+
+            // Destructor
+            ~TimedSDFgraphSAXHandler()
+            {
+                delete graph;
+            };
+
+            // Events
+            void startElement(const CString &name, const CSAXAttributes &attr);
+            void endElement(const CString &name);
+            void characters(const char *ch, const int len);
+            bool isDone() const
+            {
+                return done;
+            };
+
+            // Constructed graph (ownership passes to the caller)
+            TimedSDFgraph *release();
+
+        private:
+            // Element contexts
+            enum Context { Ignore, Root, ApplicationGraph, Sdf, Actor,
+                           SdfProperties, ActorProperties, ActorProcessor,
+                           ProcessorMemory,
+                           ChannelProperties, GraphProperties, TimeConstraints,
+                           Throughput
+                         };
+
+            // Channel whose ports are connected at the end of the graph
+            typedef struct _ChannelEnds
+            {
+                TimedSDFchannel *channel;
+                CString srcActor, srcPort, dstActor, dstPort;
+            } ChannelEnds;
+
+            Context startChild(const Context parent, const CString &name,
+                               const bool first, const CSAXAttributes &attr);
+            void connectChannels();
+            TimedSDFactor *findActor(const CString &name) const;
+
+            // File
+            CString filename;
+            CString module;
+
+            // Open elements
+            vector<Context> contexts;
+            vector<set<CString> > children;
+
+            // Graph under construction
+            TimedSDFgraph *graph;
+            map<CString, TimedSDFactor *> actors;
+            map<CString, TimedSDFchannel *> channels;
+            list<ChannelEnds> channelEnds;
+            TimedSDFactor *actor;
+            TimedSDFchannel *channel;
+            TimedSDFactor::Processor *processor;
+            CString throughput;
+
+            // Progress
+            bool applicationGraphFound;
+            bool done;
+    };
+
+    /**
+     * startElement ()
+     * The function handles the start of an element.
+     */
+    void TimedSDFgraphSAXHandler::startElement(const CString &name,
+            const CSAXAttributes &attr)
+    {
+        Context c;
+
+        if (contexts.empty())
+        {
+            c = startChild(Ignore, name, true, attr);
+        }
+        else
+        {
+            bool first = children.back().insert(name).second;
+            c = startChild(contexts.back(), name, first, attr);
+        }
+
+        contexts.push_back(c);
+        children.push_back(set<CString>());
+    }
+
+    /**
+     * startChild ()
+     * The function handles the start of an element inside an element with
+     * the given context. It returns the context of the new element.
+     */
+    TimedSDFgraphSAXHandler::Context TimedSDFgraphSAXHandler::startChild(
+        const Context parent, const CString &name, const bool first,
+        const CSAXAttributes &attr)
+    {
+        SDFcomponent component;
+
+        // Root element
+        if (contexts.empty())
+        {
+            if (attr.getAttribute("type") != module)
+            {
+                throw CException("Root element in file '" + filename + "' is not "
+                                 "of type '" + module + "'.");
+            }
+            return Root;
+        }
+
+        switch (parent)
+        {
+            case Root:
+                if (name == "applicationGraph" && first)
+                {
+                    applicationGraphFound = true;
+                    return ApplicationGraph;
+                }
+                break;
+
+            case ApplicationGraph:
+                if (name == "sdf" && first)
+                {
+                    graph = new TimedSDFgraph();
+
+                    if (!attr.hasAttribute("name"))
+                        throw CException("Invalid SDF graph, missing graph name.");
+                    graph->setName(attr.getAttribute("name"));
+
+                    if (!attr.hasAttribute("type"))
+                        throw CException("Invalid SDF graph, missing graph type.");
+                    graph->setType(attr.getAttribute("type"));
+
+                    return Sdf;
+                }
+                else if (name == "sdfProperties" && first)
+                {
+                    if (graph == NULL)
+                    {
+                        throw CException("Element 'sdfProperties' must follow "
+                                         "element 'sdf' in '" + filename + "'.");
+                    }
+                    return SdfProperties;
+                }
+                break;
+
+            case Sdf:
+                if (name == "actor")
+                {
+                    component = SDFcomponent(graph, graph->nrActors());
+                    actor = graph->createActor(component);
+
+                    if (!attr.hasAttribute("name"))
+                        throw CException("Invalid SDF graph, missing actor name.");
+                    actor->setName(attr.getAttribute("name"));
+
+                    if (!attr.hasAttribute("type"))
+                        throw CException("Invalid SDF graph, missing actor type.");
+                    actor->setType(attr.getAttribute("type"));
+
+                    actors.insert(make_pair(actor->getName(), actor));
+
+                    return Actor;
+                }
+                else if (name == "channel")
+                {
+                    ChannelEnds ends;
+
+                    component = SDFcomponent(graph, graph->nrChannels());
+                    ends.channel = graph->createChannel(component);
+
+                    if (!attr.hasAttribute("name"))
+                        throw CException("Invalid SDF graph, missing channel name.");
+                    ends.channel->setName(attr.getAttribute("name"));
+
+                    if (attr.hasAttribute("initialTokens"))
+                        ends.channel->setInitialTokens(attr.getAttribute("initialTokens"));
+
+                    if (!attr.hasAttribute("srcActor"))
+                        throw CException("Invalid SDF graph, missing channel srcActor.");
+                    ends.srcActor = attr.getAttribute("srcActor");
+
+                    if (!attr.hasAttribute("srcPort"))
+                        throw CException("Invalid SDF graph, missing channel srcPort.");
+                    ends.srcPort = attr.getAttribute("srcPort");
+
+                    if (!attr.hasAttribute("dstActor"))
+                        throw CException("Invalid SDF graph, missing channel dstActor.");
+                    ends.dstActor = attr.getAttribute("dstActor");
+
+                    if (!attr.hasAttribute("dstPort"))
+                        throw CException("Invalid SDF graph, missing channel dstPort.");
+                    ends.dstPort = attr.getAttribute("dstPort");
+
+                    channels.insert(make_pair(ends.channel->getName(), ends.channel));
+                    channelEnds.push_back(ends);
+                }
+                break;
+
+            case Actor:
+                if (name == "port")
+                {
+                    component = SDFcomponent(actor, actor->nrPorts());
+                    SDFport *p = new SDFport(component);
+
+                    if (!attr.hasAttribute("name"))
+                        throw CException("Invalid SDF graph, missing port name.");
+                    p->setName(attr.getAttribute("name"));
+
+                    if (!attr.hasAttribute("type"))
+                        throw CException("Invalid SDF graph, missing port type.");
+                    p->setType(attr.getAttribute("type"));
+
+                    if (!attr.hasAttribute("rate"))
+                        throw CException("Invalid SDF graph, missing port rate.");
+                    p->setRate(attr.getAttribute("rate"));
+
+                    actor->addPort(p);
+                }
+                break;
+
+            case SdfProperties:
+                if (name == "actorProperties")
+                {
+                    if (!attr.hasAttribute("actor"))
+                        throw CException("Missing 'actor' in 'actorProperties'");
+                    actor = findActor(attr.getAttribute("actor"));
+                    return ActorProperties;
+                }
+                else if (name == "channelProperties")
+                {
+                    if (!attr.hasAttribute("channel"))
+                        throw CException("Missing 'channel' in 'channelProperties'");
+
+                    map<CString, TimedSDFchannel *>::const_iterator iter;
+                    iter = channels.find(attr.getAttribute("channel"));
+                    if (iter == channels.end())
+                    {
+                        throw CException("Graph '" + graph->getName()
+                                         + "' has no channel '"
+                                         + attr.getAttribute("channel") + "'.");
+                    }
+                    channel = iter->second;
+
+                    return ChannelProperties;
+                }
+                else if (name == "graphProperties")
+                {
+                    return GraphProperties;
+                }
+                break;
+
+            case ActorProperties:
+                if (name == "processor")
+                {
+                    if (!attr.hasAttribute("type"))
+                        throw CException("Processor must have a type");
+                    processor = actor->addProcessor(attr.getAttribute("type"));
+
+                    if (attr.hasAttribute("default"))
+                        actor->setDefaultProcessor(processor->type);
+
+                    return ActorProcessor;
+                }
+                break;
+
+            case ActorProcessor:
+                if (name == "executionTime" && first)
+                {
+                    if (!attr.hasAttribute("time"))
+                        throw CException("Execution time not specified");
+                    processor->execTime = attr.getAttribute("time");
+                }
+                else if (name == "memory" && first)
+                {
+                    return ProcessorMemory;
+                }
+                break;
+
+            case ProcessorMemory:
+                if (name == "stateSize" && first)
+                {
+                    if (!attr.hasAttribute("max"))
+                        throw CException("No maximum state size given.");
+
+                    int sz = attr.getAttribute("max");
+                    processor->stateSize = sz;
+                }
+                break;
+
+            case ChannelProperties:
+                if (name == "bufferSize" && first)
+                {
+                    TimedSDFchannel::BufferSize bufferSize;
+
+                    bufferSize.sz = SDF_INFINITE_SIZE;
+                    bufferSize.src = SDF_INFINITE_SIZE;
+                    bufferSize.dst = SDF_INFINITE_SIZE;
+                    bufferSize.mem = SDF_INFINITE_SIZE;
+
+                    if (attr.hasAttribute("sz"))
+                        bufferSize.sz = attr.getAttribute("sz");
+                    if (attr.hasAttribute("src"))
+                        bufferSize.src = attr.getAttribute("src");
+                    if (attr.hasAttribute("dst"))
+                        bufferSize.dst = attr.getAttribute("dst");
+                    if (attr.hasAttribute("mem"))
+                        bufferSize.mem = attr.getAttribute("mem");
+
+                    channel->setBufferSize(bufferSize);
+                }
+                else if (name == "tokenSize" && first)
+                {
+                    if (attr.hasAttribute("sz"))
+                    {
+                        int sz = attr.getAttribute("sz");
+                        channel->setTokenSize(sz);
+                    }
+                }
+                else if (name == "tokenType" && first)
+                {
+                    if (attr.hasAttribute("type"))
+                        channel->setTokenType(attr.getAttribute("type"));
+                }
+                else if (name == "bandwidth" && first)
+                {
+                    if (attr.hasAttribute("min"))
+                    {
+                        double sz = attr.getAttribute("min");
+                        channel->setMinBandwidth(sz);
+                    }
+                }
+                else if (name == "latency" && first)
+                {
+                    if (attr.hasAttribute("min"))
+                    {
+                        int sz = attr.getAttribute("min");
+                        channel->setMinLatency(sz);
+                    }
+                }
+                break;
+
+            case GraphProperties:
+                if (name == "timeConstraints")
+                    return TimeConstraints;
+                break;
+
+            case TimeConstraints:
+                if (name == "throughput" && first)
+                {
+                    throughput = "";
+                    return Throughput;
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        return Ignore;
+    }
+
+    /**
+     * endElement ()
+     * The function handles the end of an element.
+     */
+    void TimedSDFgraphSAXHandler::endElement(const CString &name)
+    {
+        Context c = contexts.back();
+
+        contexts.pop_back();
+        children.pop_back();
+
+        if (c == Sdf)
+            connectChannels();
+        else if (c == Throughput)
+            graph->setThroughputConstraint((double)(throughput));
+        else if (c == ApplicationGraph)
+            done = true;
+    }
+
+    /**
+     * characters ()
+     * The function collects the content of the throughput constraint.
+     */
+    void TimedSDFgraphSAXHandler::characters(const char *ch, const int len)
+    {
+        for (vector<Context>::reverse_iterator iter = contexts.rbegin();
+             iter != contexts.rend(); iter++)
+        {
+            if (*iter == Throughput)
+            {
+                throughput.append(ch, len);
+                return;
+            }
+            if (*iter != Ignore)
+                return;
+        }
+    }
+
+    /**
+     * findActor ()
+     * The function returns the actor with the given name.
+     */
+    TimedSDFactor *TimedSDFgraphSAXHandler::findActor(const CString &name) const
+    {
+        map<CString, TimedSDFactor *>::const_iterator iter = actors.find(name);
+
+        if (iter == actors.end())
+        {
+            throw CException("Graph '" + graph->getName() + "' has no actor '"
+                             + name + "'.");
+        }
+
+        return iter->second;
+    }
+
+    /**
+     * connectChannels ()
+     * The function connects all channels to their ports. This is done at the
+     * end of the graph, so channels may precede the actors they connect.
+     */
+    void TimedSDFgraphSAXHandler::connectChannels()
+    {
+        for (list<ChannelEnds>::iterator iter = channelEnds.begin();
+             iter != channelEnds.end(); iter++)
+        {
+            ChannelEnds &ends = *iter;
+
+            ends.channel->connectSrc(findActor(ends.srcActor)->getPort(ends.srcPort));
+            ends.channel->connectDst(findActor(ends.dstActor)->getPort(ends.dstPort));
+        }
+
+        channelEnds.clear();
+    }
+
+    /**
+     * release ()
+     * The function returns the constructed graph. The caller becomes the
+     * owner of the graph.
+     */
+    TimedSDFgraph *TimedSDFgraphSAXHandler::release()
+    {
+        TimedSDFgraph *g = graph;
+
+        if (!applicationGraphFound)
+            throw CException("No application graph in '" + filename + "'.");
+
+        if (graph == NULL)
+            throw CException("Invalid xml file - missing 'sdf' node");
+
+        graph = NULL;
+
+        return g;
+    }
+
+    /**
+     * streamTimedSDFgraph ()
+     * The function constructs the application graph of an SDF3 file directly
+     * from the events of the streaming XML parser.
+     */
+    TimedSDFgraph *streamTimedSDFgraph(const CString &filename,
+                                       const CString &module)
+    {
+        TimedSDFgraphSAXHandler handler(filename, module);
+
+        CParseStream(filename, handler);
+
+        return handler.release();
+    }
+
+    /**
+     * streamTimedSDFgraph ()
+     * The function constructs the application graph of an SDF3 document in
+     * memory directly from the events of the streaming XML parser.
+     */
+    TimedSDFgraph *streamTimedSDFgraph(const char *buffer, const size_t size,
+                                       const CString &filename, const CString &module)
+    {
+        TimedSDFgraphSAXHandler handler(filename, module);
+
+        CParseStream(buffer, size, filename, handler);
+
+        return handler.release();
+    }
+
+    /**
+     * writeTimedSDFgraph ()
+     * The function writes the binary representation of a timed SDFG. Actors,
+     * ports and channels are written in order together with their ids.
+     */
+    void writeTimedSDFgraph(TimedSDFgraph *g, CBinaryWriter &out)
+    {
+        SDFthroughput thr = g->getThroughputConstraint();
+
+        // Graph
+        out.putString(g->getName());
+        out.putString(g->getType());
+        out.putUInt(thr.isFraction() ? 1 : 0);
+        if (thr.isFraction())
+        {
+            out.putULong(thr.numerator());
+            out.putULong(thr.denominator());
+        }
+        else
+        {
+            out.putDouble(thr.value());
+        }
+
+        // Actors
+        out.putUInt(g->nrActors());
+        for (SDFactorsIter iter = g->actorsBegin(); iter != g->actorsEnd(); iter++)
+        {
+            TimedSDFactor *a = (TimedSDFactor *)(*iter);
+
+            out.putUInt(a->getId());
+            out.putString(a->getName());
+            out.putString(a->getType());
+            out.putString(a->getDefaultProcessor());
+
+            // Ports
+            out.putUInt(a->nrPorts());
+            for (SDFportsIter pIter = a->portsBegin(); pIter != a->portsEnd(); pIter++)
+            {
+                SDFport *p = *pIter;
+
+                out.putUInt(p->getId());
+                out.putString(p->getName());
+                out.putUInt(p->getType());
+                out.putUInt(p->getRate());
+            }
+
+            // Processors
+            out.putUInt(a->nrProcessors());
+            for (TimedSDFactor::ProcessorsIter pIter = a->processorsBegin();
+                 pIter != a->processorsEnd(); pIter++)
+            {
+                TimedSDFactor::Processor *p = *pIter;
+
+                out.putString(p->type);
+                out.putUInt(p->execTime);
+                out.putULong(p->stateSize);
+            }
+        }
+
+        // Channels
+        out.putUInt(g->nrChannels());
+        for (SDFchannelsIter iter = g->channelsBegin();
+             iter != g->channelsEnd(); iter++)
+        {
+            TimedSDFchannel *c = (TimedSDFchannel *)(*iter);
+            SDFport *src = c->getSrcPort();
+            SDFport *dst = c->getDstPort();
+            TimedSDFchannel::BufferSize bufferSize = c->getBufferSize();
+
+            out.putUInt(c->getId());
+            out.putString(c->getName());
+            out.putUInt(c->getInitialTokens());
+
+            // Ports (CID_MAX when not connected)
+            out.putUInt(src == NULL ? CID_MAX : src->getActor()->getId());
+            out.putUInt(src == NULL ? CID_MAX : src->getId());
+            out.putUInt(dst == NULL ? CID_MAX : dst->getActor()->getId());
+            out.putUInt(dst == NULL ? CID_MAX : dst->getId());
+
+            // Properties
+            out.putUInt(bufferSize.sz);
+            out.putUInt(bufferSize.src);
+            out.putUInt(bufferSize.dst);
+            out.putUInt(bufferSize.mem);
+            out.putUInt(c->getTokenSize());
+            out.putString(c->getTokenType());
+            out.putDouble(c->getMinBandwidth());
+            out.putUInt(c->getMinLatency());
+        }
+    }
+
+    /**
+     * readPort ()
+     * The function returns the port with the given id on the actor with the
+     * given id, or NULL when the ids are CID_MAX.
+     */
+    static SDFport *readPort(CBinaryReader &in,
+                             map<CId, TimedSDFactor *> &actors)
+    {
+        CId actorId = in.getUInt();
+        CId portId = in.getUInt();
+
+        if (actorId == CID_MAX)
+            return NULL;
+
+        map<CId, TimedSDFactor *>::iterator iter = actors.find(actorId);
+        if (iter == actors.end())
+            throw CException("Invalid binary SDF graph, unknown actor.");
+
+        return iter->second->getPort(portId);
+    }
+
+    /**
+     * readTimedSDFgraph ()
+     * The function constructs a timed SDFG from its binary representation.
+     */
+    TimedSDFgraph *readTimedSDFgraph(CBinaryReader &in)
+    {
+        map<CId, TimedSDFactor *> actors;
+        SDFcomponent component;
+        TimedSDFgraph *g;
+        uint nrActors, nrPorts, nrProcessors, nrChannels;
+
+        g = new TimedSDFgraph();
+
+        try
+        {
+            // Graph
+            g->setName(in.getString());
+            g->setType(in.getString());
+            if (in.getUInt() != 0)
+            {
+                long long num = in.getULong();
+                long long den = in.getULong();
+                g->setThroughputConstraint(CFraction((int)num, (int)den));
+            }
+            else
+            {
+                g->setThroughputConstraint(CFraction(in.getDouble()));
+            }
+
+            // Actors
+            nrActors = in.getUInt();
+            for (uint i = 0; i < nrActors; i++)
+            {
+                component = SDFcomponent(g, in.getUInt());
+                TimedSDFactor *a = g->createActor(component);
+                a->setName(in.getString());
+                a->setType(in.getString());
+                a->setDefaultProcessor(in.getString());
+                actors[a->getId()] = a;
+
+                // Ports
+                nrPorts = in.getUInt();
+                for (uint j = 0; j < nrPorts; j++)
+                {
+                    component = SDFcomponent(a, in.getUInt());
+                    SDFport *p = a->createPort(component);
+                    p->setName(in.getString());
+                    p->setType((SDFport::SDFportType)in.getUInt());
+                    p->setRate(in.getUInt());
+                }
+
+                // Processors
+                nrProcessors = in.getUInt();
+                for (uint j = 0; j < nrProcessors; j++)
+                {
+                    TimedSDFactor::Processor *p = a->addProcessor(in.getString());
+                    p->execTime = in.getUInt();
+                    p->stateSize = in.getULong();
+                }
+            }
+
+            // Channels
+            nrChannels = in.getUInt();
+            for (uint i = 0; i < nrChannels; i++)
+            {
+                TimedSDFchannel::BufferSize bufferSize;
+
+                component = SDFcomponent(g, in.getUInt());
+                TimedSDFchannel *c = g->createChannel(component);
+                c->setName(in.getString());
+                c->setInitialTokens(in.getUInt());
+
+                SDFport *src = readPort(in, actors);
+                SDFport *dst = readPort(in, actors);
+                if (src != NULL)
+                    c->connectSrc(src);
+                if (dst != NULL)
+                    c->connectDst(dst);
+
+                bufferSize.sz = in.getUInt();
+                bufferSize.src = in.getUInt();
+                bufferSize.dst = in.getUInt();
+                bufferSize.mem = in.getUInt();
+                c->setBufferSize(bufferSize);
+                c->setTokenSize(in.getUInt());
+                c->setTokenType(in.getString());
+                c->setMinBandwidth(in.getDouble());
+                c->setMinLatency(in.getUInt());
+            }
+
+            if (!in.atEnd())
+                throw CException("Invalid binary SDF graph, trailing data.");
+        }
+        catch (CException &e)
+        {
+            delete g;
+            throw;
+        }
+
+        return g;
+    }
+
+    /**
+     * loadTimedSDFgraph ()
+     * The function constructs the application graph of an SDF3 file. When a
+     * cache is given, the graph is read from the cache entry of the file
+     * contents if present; otherwise the file is streamed and the entry is
+     * added to the cache.
+     */
+    TimedSDFgraph *loadTimedSDFgraph(const CString &filename,
+                                     const CString &module, const CBinaryCache *cache)
+    {
+        CMappedFile file, entry;
+        CBinaryReader payload;
+        CBinaryWriter out;
+        TimedSDFgraph *g;
+        CHash key;
+
+        if (cache == NULL)
+            return streamTimedSDFgraph(filename, module);
+
+        if (!file.open(filename))
+            throw CException("Failed loading application from '" + filename + "'.");
+
+        // The entry depends on the contents of the file and the module type
+        key = CHashContent(file.getData(), file.getSize());
+        key = CHashContent(module.data(), module.size(), key);
+
+        if (cache->find(TIMED_SDFG_CACHE_KIND, key, entry, payload))
+        {
+            try
+            {
+                return readTimedSDFgraph(payload);
+            }
+            catch (CException &e)
+            {
+                logWarning("Ignoring invalid cache entry for '" + filename + "'.");
+            }
+        }
+
+        g = streamTimedSDFgraph(file.getData(), file.getSize(), filename, module);
+
+        writeTimedSDFgraph(g, out);
+        cache->store(TIMED_SDFG_CACHE_KIND, key, out);
+
+        return g;
+    }
+
+}//namespace SDF
@@ -0,0 +1,78 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   stream.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Streaming construction and binary cache of timed
+ *                      SDF graphs
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef SDF_BASE_TIMED_STREAM_H_INCLUDED
+#define SDF_BASE_TIMED_STREAM_H_INCLUDED
+
+#include "graph.h"
+
+namespace SDF
+{
+    /**
+     * streamTimedSDFgraph ()
+     * The function constructs the application graph (sdf and sdfProperties)
+     * of an SDF3 file directly from the events of the streaming XML parser.
+     * The result is identical to TimedSDFgraph::construct, but no document
+     * tree is built and parsing stops after the application graph. The root
+     * element must be of the given module type.
+     */
+    TimedSDFgraph *streamTimedSDFgraph(const CString &filename,
+                                       const CString &module);
+    TimedSDFgraph *streamTimedSDFgraph(const char *buffer, const size_t size,
+                                       const CString &filename, const CString &module);
+
+    /**
+     * writeTimedSDFgraph ()
+     * The function writes the binary representation of a timed SDFG.
+     */
+    void writeTimedSDFgraph(TimedSDFgraph *g, CBinaryWriter &out);
+
+    /**
+     * readTimedSDFgraph ()
+     * The function constructs a timed SDFG from its binary representation.
+     */
+    TimedSDFgraph *readTimedSDFgraph(CBinaryReader &in);
+
+    /**
+     * loadTimedSDFgraph ()
+     * The function constructs the application graph of an SDF3 file. When a
+     * cache is given, the graph is read from the cache entry of the file
+     * contents if present; otherwise the file is streamed and the entry is
+     * added to the cache.
+     */
+    TimedSDFgraph *loadTimedSDFgraph(const CString &filename,
+                                     const CString &module, const CBinaryCache *cache = NULL);
+
+}//namespace SDF
+#endif
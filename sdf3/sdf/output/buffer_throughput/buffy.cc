@@ -12,6 +12,8 @@
  *
  *  History         :
  *      29-03-02    :   Initial version.
+ *      17-10-26    :   Buffy model as a loadable kernel.
+ *      17-10-26    :   Throughput model as a loadable kernel.
  *
  * $Id: buffy.cc,v 1.1.1.1.2.1 2010-04-22 07:18:41 mgeilen Exp $
  *
@@ -133,6 +135,29 @@ namespace SDF
         return ub;
     }
 
+    /**
+     * getMinimalChannelSz ()
+     * Lower bound on the storage space of a channel (as used by the generic
+     * storage distribution exploration).
+     */
+    static
+    uint getMinimalChannelSz(SDFchannel *ch)
+    {
+        uint p = ch->getSrcPort()->getRate();
+        uint c = ch->getDstPort()->getRate();
+        uint t = ch->getInitialTokens();
+        uint lb;
+
+        lb = p + c - gcd(p, c) + t % gcd(p, c);
+        lb = (lb > t ? lb : t);
+
+        // A self-edge must hold the tokens it produces and its initial tokens
+        if (ch->getSrcActor()->getId() == ch->getDstActor()->getId())
+            lb = p + (c > t ? c : t);
+
+        return lb;
+    }
+
     static
     void printMinimalChannelSz(TimedSDFgraph *g, ostream &out)
     {
@@ -141,15 +166,7 @@ namespace SDF
         for (SDFchannelsIter iter = g->channelsBegin(); iter != g->channelsEnd();
              iter++)
         {
-            SDFchannel *ch = *iter;
-            SDFport *srcPort = ch->getSrcPort();
-            SDFport *dstPort = ch->getDstPort();
-            uint p = srcPort->getRate();
-            uint c = dstPort->getRate();
-            uint t = ch->getInitialTokens();
-            uint lb;
-
-            lb = p + c - gcd(p, c) + t % gcd(p, c);
+            uint lb = getMinimalChannelSz(*iter);
 
             if (first)
             {
@@ -172,14 +189,7 @@ namespace SDF
         for (SDFchannelsIter iter = g->channelsBegin(); iter != g->channelsEnd();
              iter++)
         {
-            SDFchannel *ch = *iter;
-            SDFport *srcPort = ch->getSrcPort();
-            SDFport *dstPort = ch->getDstPort();
-            uint p = srcPort->getRate();
-            uint c = dstPort->getRate();
-            uint t = ch->getInitialTokens();
-
-            lb += p + c - gcd(p, c) + t % gcd(p, c);
+            lb += getMinimalChannelSz(*iter);
         }
 
         return lb;
@@ -232,7 +242,11 @@ namespace SDF
         out << "#define HASH_TABLE_SIZE         " << hashSz << endl;
         out << "#define DEPENDENCY_STACK_SIZE   " << depStackSz << endl;
         out << "" << endl;
-        out << "typedef short TBufSize;" << endl;
+        // Storage space which does not fit in a short needs a larger type
+        if (getUbDistributionSz(g) > SHRT_MAX)
+            out << "typedef int TBufSize;" << endl;
+        else
+            out << "typedef short TBufSize;" << endl;
         out << "typedef double TTime;" << endl;
         out << endl;
         out << "#define TTIME_MAX INT_MAX" << endl;
@@ -247,9 +261,11 @@ namespace SDF
     }
 
     static
-    void printMiscFunctions(ostream &out)
+    void printMiscFunctions(ostream &out, bool kernel)
     {
         out << "#include <math.h>" << endl;
+        out << "#include <string.h>" << endl;
+        out << "#include <limits.h>" << endl;
         out << "#include <iostream>" << endl;
         out << "#include <assert.h>" << endl;
         out << "" << endl;
@@ -258,6 +274,33 @@ namespace SDF
         out << "using std::cerr;" << endl;
         out << "using std::endl;" << endl;
         out << "" << endl;
+
+        if (kernel)
+        {
+            out << "/**" << endl;
+            out << " * KernelError" << endl;
+            out << " * Error raised inside the kernel. It is caught by the entry point," << endl;
+            out << " * so the process that loaded the kernel keeps running." << endl;
+            out << " */" << endl;
+            out << "typedef struct _KernelError" << endl;
+            out << "{" << endl;
+            out << "    const char *msg;" << endl;
+            out << "    int errorno;" << endl;
+            out << "} KernelError;" << endl;
+            out << "" << endl;
+            out << "/**" << endl;
+            out << " * exit ()" << endl;
+            out << " * Abort the kernel with an error message." << endl;
+            out << " */" << endl;
+            out << "void exit(const char *msg, const int errorno)" << endl;
+            out << "{" << endl;
+            out << "    KernelError e = { msg, errorno };" << endl;
+            out << "    throw e;" << endl;
+            out << "}" << endl;
+            out << "" << endl;
+            return;
+        }
+
         out << "/**" << endl;
         out << " * exit ()" << endl;
         out << " * Exit the program with an error message." << endl;
@@ -472,6 +515,13 @@ namespace SDF
         out << "HashSlot **hashTable;" << endl;
         out << "" << endl;
         out << "/**" << endl;
+        out << " * usedHashKeys" << endl;
+        out << " * Keys of the non-empty slots in the hash table (used to clear it)." << endl;
+        out << " */" << endl;
+        out << "HashKey *usedHashKeys;" << endl;
+        out << "HashKey nrUsedHashKeys;" << endl;
+        out << "" << endl;
+        out << "/**" << endl;
         out << " * createHashTable ()" << endl;
         out << " * The function constructs a hash table." << endl;
         out << " */" << endl;
@@ -484,6 +534,12 @@ namespace SDF
         out << "    " << endl;
         out << "    for (int i = 0; i < HASH_TABLE_SIZE; i++)" << endl;
         out << "        hashTable[i] = INVALID_HASH_KEY;" << endl;
+        out << "    " << endl;
+        out << "    usedHashKeys = (HashKey*)malloc(sizeof(HashKey)*HASH_TABLE_SIZE);" << endl;
+        out << "    nrUsedHashKeys = 0;" << endl;
+        out << "    " << endl;
+        out << "    if (usedHashKeys == NULL)" << endl;
+        out << "        exit(\"Failed creating hash table.\", 1);" << endl;
         out << "}" << endl;
         out << "" << endl;
         out << "/**" << endl;
@@ -504,6 +560,7 @@ namespace SDF
         out << "    }" << endl;
         out << "" << endl;
         out << "    free(hashTable);" << endl;
+        out << "    free(usedHashKeys);" << endl;
         out << "}" << endl;
         out << "" << endl;
         out << "/**" << endl;
@@ -514,8 +571,10 @@ namespace SDF
         out << "{" << endl;
         out << "    HashSlot *s_cur, *s_next;" << endl;
         out << "    " << endl;
-        out << "    for (int i = 0; i < HASH_TABLE_SIZE; i++)" << endl;
+        out << "    for (HashKey k = 0; k < nrUsedHashKeys; k++)" << endl;
         out << "    {" << endl;
+        out << "        HashKey i = usedHashKeys[k];" << endl;
+        out << "        " << endl;
         out << "        for (s_cur = hashTable[i]; s_cur != INVALID_HASH_KEY; s_cur = s_next)" << endl;
         out << "        {" << endl;
         out << "            s_next = s_cur->next;" << endl;
@@ -524,6 +583,7 @@ namespace SDF
         out << "        " << endl;
         out << "        hashTable[i] = INVALID_HASH_KEY;" << endl;
         out << "    }" << endl;
+        out << "    nrUsedHashKeys = 0;" << endl;
         out << "}" << endl;
         out << "" << endl;
         out << "/**" << endl;
@@ -564,6 +624,10 @@ namespace SDF
         out << "    slot->value = value;" << endl;
         out << "    slot->next = hashTable[key];" << endl;
         out << "    " << endl;
+        out << "    // Remember the slot, so it is cleared with the table" << endl;
+        out << "    if (slot->next == INVALID_HASH_KEY)" << endl;
+        out << "        usedHashKeys[nrUsedHashKeys++] = key;" << endl;
+        out << "    " << endl;
         out << "    // Insert the stack position in the hash table" << endl;
         out << "    hashTable[key] = slot;" << endl;
         out << "}" << endl;
@@ -1196,6 +1260,38 @@ namespace SDF
         out << "" << endl;
     }
 
+    /**
+     * printSkipIdleTimeSteps ()
+     * Output code which advances the clocks over the time steps in which no
+     * actor firing ends. Tokens and space only change when a firing ends, so
+     * no firing can start in these time steps either. The first 'keep' time
+     * steps before the next end of a firing are still executed.
+     */
+    static
+    void printSkipIdleTimeSteps(ostream &out, const uint keep)
+    {
+        out << "        " << endl;
+        out << "        // Skip the time steps in which no actor firing ends" << endl;
+        out << "        TTime step = TTIME_MAX;" << endl;
+        out << "        for (int a = 0; a < SDF_NUM_ACTORS; a++)" << endl;
+        out << "        {" << endl;
+        out << "            if (ACT_CLK(a) > 0 && ACT_CLK(a) < step)" << endl;
+        out << "                step = ACT_CLK(a);" << endl;
+        out << "        }" << endl;
+        out << "        if (step != TTIME_MAX && step > " << keep << ")" << endl;
+        out << "        {" << endl;
+        out << "            step = step - " << keep << ";" << endl;
+        out << "            for (int a = 0; a < SDF_NUM_ACTORS; a++)" << endl;
+        out << "            {" << endl;
+        out << "                if (ACT_CLK(a) > 0)" << endl;
+        out << "                    ACT_CLK(a) = ACT_CLK(a) - step;" << endl;
+        out << "            }" << endl;
+        out << "            GLB_CLK = GLB_CLK + step;" << endl;
+        out << "            copyState(prevState, sdfState);" << endl;
+        out << "            copyState(prevStateP, sdfState);" << endl;
+        out << "        }" << endl;
+    }
+
     static
     void printAnalyzePeriodicPhase(TimedSDFgraph *g, ostream &out, CString &outputActor)
     {
@@ -1435,6 +1531,7 @@ namespace SDF
             out << "        }" << endl;
         }
 
+        printSkipIdleTimeSteps(out, 2);
         out << "    }" << endl;
         out << "    " << endl;
         out << "    // Print all dependencies" << endl;
@@ -1762,6 +1859,7 @@ namespace SDF
         out << "        " << endl;
         out << "        // Store state to find actor activity in periodic phase" << endl;
         out << "        copyState(prevStateP, sdfState);" << endl;
+        printSkipIdleTimeSteps(out, 1);
         out << "    }" << endl;
         out << "}" << endl;
         out << "" << endl;
@@ -1790,6 +1888,7 @@ namespace SDF
         out << "    bool block[SDF_NUM_CHANNELS];" << endl;
         out << "    struct _Distribution *next;" << endl;
         out << "    struct _Distribution *check;" << endl;
+        out << "    struct _Distribution *checkNext;" << endl;
         out << "} Distribution;" << endl;
         out << "" << endl;
         out << "typedef struct _MinStorageDistr" << endl;
@@ -1814,6 +1913,28 @@ namespace SDF
         out << "Distribution *checkedDistributions = NULL;" << endl;
         out << "" << endl;
         out << "/**" << endl;
+        out << " * checkedDistributionsHash" << endl;
+        out << " * Checked distributions, hashed on their channel sizes." << endl;
+        out << " */" << endl;
+        out << "#define CHECKED_HASH_SIZE 65536" << endl;
+        out << "Distribution *checkedDistributionsHash[CHECKED_HASH_SIZE];" << endl;
+        out << "" << endl;
+        out << "/**" << endl;
+        out << " * hashDistribution ()" << endl;
+        out << " * The function returns the slot of a distribution in the hash of checked" << endl;
+        out << " * distributions." << endl;
+        out << " */" << endl;
+        out << "unsigned int hashDistribution(const Distribution *d)" << endl;
+        out << "{" << endl;
+        out << "    unsigned long long h = 14695981039346656037ULL;" << endl;
+        out << "    " << endl;
+        out << "    for (int c = 0; c < SDF_NUM_CHANNELS; c++)" << endl;
+        out << "        h = (h ^ (unsigned int)d->sz[c]) * 1099511628211ULL;" << endl;
+        out << "    " << endl;
+        out << "    return (unsigned int)(h % CHECKED_HASH_SIZE);" << endl;
+        out << "}" << endl;
+        out << "" << endl;
+        out << "/**" << endl;
         out << " * execDistribution ()" << endl;
         out << " * Execute one distribution." << endl;
         out << " */" << endl;
@@ -2008,7 +2129,7 @@ namespace SDF
         out << " */" << endl;
         out << "bool checkedDistribution(Distribution *d)" << endl;
         out << "{" << endl;
-        out << "    Distribution *dist = checkedDistributions;" << endl;
+        out << "    Distribution *dist = checkedDistributionsHash[hashDistribution(d)];" << endl;
         out << "    " << endl;
         out << "    while (dist != NULL)" << endl;
         out << "    {" << endl;
@@ -2029,7 +2150,7 @@ namespace SDF
         out << "            return true;" << endl;
         out << "           " << endl;
         out << "        // Next distribution" << endl;
-        out << "        dist = dist->check;" << endl;
+        out << "        dist = dist->checkNext;" << endl;
         out << "    }" << endl;
         out << "    " << endl;
         out << "    return false;" << endl;
@@ -2049,6 +2170,8 @@ namespace SDF
         out << "    // Add d to list of checked distributions" << endl;
         out << "    d->check = checkedDistributions;" << endl;
         out << "    checkedDistributions = d;" << endl;
+        out << "    d->checkNext = checkedDistributionsHash[hashDistribution(d)];" << endl;
+        out << "    checkedDistributionsHash[hashDistribution(d)] = d;" << endl;
         out << "    " << endl;
         out << "    // Compute output interval of this distribution" << endl;
         out << "    execDistribution(d);" << endl;
@@ -2378,13 +2501,332 @@ namespace SDF
         out << "}" << endl;
     }
 
+    static
+    void printKernel(TimedSDFgraph *g, ostream &out)
+    {
+        bool first = true;
+
+        out << "/**" << endl;
+        out << " * selfEdge" << endl;
+        out << " * Channels which are self-edges (they are never enlarged)." << endl;
+        out << " */" << endl;
+        out << "bool selfEdge[] = ";
+        for (SDFchannelsIter iter = g->channelsBegin(); iter != g->channelsEnd();
+             iter++)
+        {
+            SDFchannel *ch = *iter;
+            bool selfEdge = ch->getSrcActor()->getId() == ch->getDstActor()->getId();
+
+            out << (first ? "{" : ", ") << (selfEdge ? "true" : "false");
+            first = false;
+        }
+        out << "};" << endl;
+        out << "" << endl;
+        out << "/**" << endl;
+        out << " * sizeSets" << endl;
+        out << " * Distributions which must still be checked, indexed on their size." << endl;
+        out << " */" << endl;
+        out << "Distribution **sizeSets = NULL;" << endl;
+        out << "" << endl;
+        out << "/**" << endl;
+        out << " * addDistributionToChecklist ()" << endl;
+        out << " * The function adds the distribution d to the set of distributions with" << endl;
+        out << " * the same size, unless it has been added before. In that case, the" << endl;
+        out << " * function returns false." << endl;
+        out << " */" << endl;
+        out << "bool addDistributionToChecklist(Distribution *d)" << endl;
+        out << "{" << endl;
+        out << "    if (checkedDistribution(d))" << endl;
+        out << "        return false;" << endl;
+        out << "" << endl;
+        out << "    // Add d to list of checked distributions" << endl;
+        out << "    d->check = checkedDistributions;" << endl;
+        out << "    checkedDistributions = d;" << endl;
+        out << "    d->checkNext = checkedDistributionsHash[hashDistribution(d)];" << endl;
+        out << "    checkedDistributionsHash[hashDistribution(d)] = d;" << endl;
+        out << "" << endl;
+        out << "    if (d->size > UB_DISTRIBUTION_SZ)" << endl;
+        out << "        exit(\"Distribution exceeds ub_distribution_sz.\", 1);" << endl;
+        out << "" << endl;
+        out << "    // Add d to the set of distributions with the same size" << endl;
+        out << "    d->next = sizeSets[d->size - LB_DISTRIBUTION_SZ];" << endl;
+        out << "    sizeSets[d->size - LB_DISTRIBUTION_SZ] = d;" << endl;
+        out << "" << endl;
+        out << "    return true;" << endl;
+        out << "}" << endl;
+        out << "" << endl;
+        out << "/**" << endl;
+        out << " * exploreMinimalStorageDistributions ()" << endl;
+        out << " * The function computes all minimal storage distributions. The sets of" << endl;
+        out << " * distributions are explored in order of increasing size, till the lower" << endl;
+        out << " * bound on the output interval is reached. Only channels with a storage" << endl;
+        out << " * dependency (other than self-edges) are enlarged. This is the exploration" << endl;
+        out << " * of the generic (non-compiled) buffer sizing algorithm." << endl;
+        out << " */" << endl;
+        out << "void exploreMinimalStorageDistributions()" << endl;
+        out << "{" << endl;
+        out << "    MinStorageDistr *last = NULL;" << endl;
+        out << "    Distribution *d;" << endl;
+        out << "" << endl;
+        out << "    // Find lower bound of the output interval" << endl;
+        out << "    lbOutputInterval = findLbOutputInterval();" << endl;
+        out << "" << endl;
+        out << "    // Create distribution with lower bound" << endl;
+        out << "    sizeSets = new Distribution*[UB_DISTRIBUTION_SZ - LB_DISTRIBUTION_SZ + 1];" << endl;
+        out << "    for (int s = 0; s <= UB_DISTRIBUTION_SZ - LB_DISTRIBUTION_SZ; s++)" << endl;
+        out << "        sizeSets[s] = NULL;" << endl;
+        out << "    d = new Distribution;" << endl;
+        out << "    d->size = LB_DISTRIBUTION_SZ;" << endl;
+        out << "    for (int c = 0; c < SDF_NUM_CHANNELS; c++)" << endl;
+        out << "        d->sz[c] = minSz[c];" << endl;
+        out << "    addDistributionToChecklist(d);" << endl;
+        out << "" << endl;
+        out << "    for (int s = LB_DISTRIBUTION_SZ; s <= UB_DISTRIBUTION_SZ; s++)" << endl;
+        out << "    {" << endl;
+        out << "        TTime outputInterval = TTIME_MAX;" << endl;
+        out << "        MinStorageDistr *m;" << endl;
+        out << "        Distribution *tail = NULL;" << endl;
+        out << "" << endl;
+        out << "        if (sizeSets[s - LB_DISTRIBUTION_SZ] == NULL)" << endl;
+        out << "            continue;" << endl;
+        out << "" << endl;
+        out << "        // Execute all distributions of this size and enlarge the channels" << endl;
+        out << "        // which have a storage dependency" << endl;
+        out << "        for (d = sizeSets[s - LB_DISTRIBUTION_SZ]; d != NULL; d = d->next)" << endl;
+        out << "        {" << endl;
+        out << "            execDistribution(d);" << endl;
+        out << "" << endl;
+        out << "            if (d->outputInterval < outputInterval)" << endl;
+        out << "                outputInterval = d->outputInterval;" << endl;
+        out << "" << endl;
+        out << "            for (int c = 0; c < SDF_NUM_CHANNELS; c++)" << endl;
+        out << "            {" << endl;
+        out << "                if (!d->block[c] || selfEdge[c])" << endl;
+        out << "                    continue;" << endl;
+        out << "" << endl;
+        out << "                Distribution *dn = new Distribution;" << endl;
+        out << "                dn->size = d->size + minSzStep[c];" << endl;
+        out << "                for (int ch = 0; ch < SDF_NUM_CHANNELS; ch++)" << endl;
+        out << "                    dn->sz[ch] = d->sz[ch];" << endl;
+        out << "                dn->sz[c] += minSzStep[c];" << endl;
+        out << "" << endl;
+        out << "                if (!addDistributionToChecklist(dn))" << endl;
+        out << "                    delete dn;" << endl;
+        out << "            }" << endl;
+        out << "        }" << endl;
+        out << "" << endl;
+        out << "        // Distributions of this size are minimal unless a smaller set has" << endl;
+        out << "        // the same output interval" << endl;
+        out << "        if (last == NULL || last->outputInterval != outputInterval)" << endl;
+        out << "        {" << endl;
+        out << "            m = new MinStorageDistr;" << endl;
+        out << "            m->size = s;" << endl;
+        out << "            m->outputInterval = outputInterval;" << endl;
+        out << "            m->distributions = NULL;" << endl;
+        out << "            m->next = NULL;" << endl;
+        out << "            m->prev = last;" << endl;
+        out << "            if (last != NULL)" << endl;
+        out << "                last->next = m;" << endl;
+        out << "            else" << endl;
+        out << "                minStorageDistributions = m;" << endl;
+        out << "            last = m;" << endl;
+        out << "" << endl;
+        out << "            // Keep the distributions with the smallest output interval" << endl;
+        out << "            for (d = sizeSets[s - LB_DISTRIBUTION_SZ]; d != NULL; d = d->next)" << endl;
+        out << "            {" << endl;
+        out << "                if (d->outputInterval != outputInterval)" << endl;
+        out << "                    continue;" << endl;
+        out << "" << endl;
+        out << "                if (tail != NULL)" << endl;
+        out << "                    tail->next = d;" << endl;
+        out << "                else" << endl;
+        out << "                    m->distributions = d;" << endl;
+        out << "                tail = d;" << endl;
+        out << "            }" << endl;
+        out << "            tail->next = NULL;" << endl;
+        out << "        }" << endl;
+        out << "" << endl;
+        out << "        // Lower bound output interval reached?" << endl;
+        out << "        if (outputInterval == lbOutputInterval)" << endl;
+        out << "            break;" << endl;
+        out << "    }" << endl;
+        out << "" << endl;
+        out << "    // The distribution <0,...,0> is the minimal distribution for a deadlock" << endl;
+        out << "    if (minStorageDistributions->outputInterval == TTIME_MAX)" << endl;
+        out << "    {" << endl;
+        out << "        minStorageDistributions->size = 0;" << endl;
+        out << "        minStorageDistributions->distributions->size = 0;" << endl;
+        out << "        for (int c = 0; c < SDF_NUM_CHANNELS; c++)" << endl;
+        out << "            minStorageDistributions->distributions->sz[c] = 0;" << endl;
+        out << "    }" << endl;
+        out << "}" << endl;
+        out << "" << endl;
+        out << "/**" << endl;
+        out << " * KernelReport" << endl;
+        out << " * Callback through which the kernel reports a minimal storage" << endl;
+        out << " * distribution (i.e. its output interval, size and channel sizes). The" << endl;
+        out << " * output interval of a deadlocking distribution is HUGE_VAL." << endl;
+        out << " */" << endl;
+        out << "typedef void (*KernelReport)(void *context, double outputInterval," << endl;
+        out << "        int distributionSz, const int *sz);" << endl;
+        out << "" << endl;
+        out << "/**" << endl;
+        out << " * sdf3BuffyKernel ()" << endl;
+        out << " * Find all minimal storage distributions and report them in order" << endl;
+        out << " * of increasing size. The function returns zero on success. On an" << endl;
+        out << " * error, it returns the error number and sets 'errorMsg'." << endl;
+        out << " */" << endl;
+        out << "extern \"C\" int sdf3BuffyKernel(KernelReport report, void *context," << endl;
+        out << "        const char **errorMsg)" << endl;
+        out << "{" << endl;
+        out << "    int status = 0;" << endl;
+        out << "" << endl;
+        out << "    // The kernel may be loaded more than once, reset its search state" << endl;
+        out << "    minStorageDistributions = NULL;" << endl;
+        out << "    checkedDistributions = NULL;" << endl;
+        out << "    memset(checkedDistributionsHash, 0, sizeof(checkedDistributionsHash));" << endl;
+        out << "    sizeSets = NULL;" << endl;
+        out << "    lbOutputInterval = LB_OUTPUT_INTERVAL;" << endl;
+        out << "    maxStackPtr = 0;" << endl;
+        out << "    stack = NULL;" << endl;
+        out << "    hashTable = NULL;" << endl;
+        out << "    dependencyStack = NULL;" << endl;
+        out << "" << endl;
+        out << "    try" << endl;
+        out << "    {" << endl;
+        out << "        // Check bounds" << endl;
+        out << "        if (LB_DISTRIBUTION_SZ > UB_DISTRIBUTION_SZ)" << endl;
+        out << "            exit(\"lb_distributin_sz > ub_distribution_sz\", 1);" << endl;
+        out << "" << endl;
+        out << "        // Create hash and stack" << endl;
+        out << "        createStack();" << endl;
+        out << "        createHashTable();" << endl;
+        out << "        createDependencyStack();" << endl;
+        out << "" << endl;
+        out << "        // Search the space" << endl;
+        out << "        exploreMinimalStorageDistributions();" << endl;
+        out << "" << endl;
+        out << "        // Report all minimal storage distributions" << endl;
+        out << "        for (MinStorageDistr *p = minStorageDistributions; p != NULL;" << endl;
+        out << "                p = p->next)" << endl;
+        out << "        {" << endl;
+        out << "            double outputInterval = p->outputInterval;" << endl;
+        out << "" << endl;
+        out << "            if (p->outputInterval == TTIME_MAX)" << endl;
+        out << "                outputInterval = HUGE_VAL;" << endl;
+        out << "" << endl;
+        out << "            for (Distribution *d = p->distributions; d != NULL; d = d->next)" << endl;
+        out << "            {" << endl;
+        out << "                int sz[SDF_NUM_CHANNELS];" << endl;
+        out << "" << endl;
+        out << "                for (int c = 0; c < SDF_NUM_CHANNELS; c++)" << endl;
+        out << "                    sz[c] = d->sz[c];" << endl;
+        out << "                report(context, outputInterval, p->size, sz);" << endl;
+        out << "            }" << endl;
+        out << "        }" << endl;
+        out << "    }" << endl;
+        out << "    catch (KernelError &e)" << endl;
+        out << "    {" << endl;
+        out << "        *errorMsg = e.msg;" << endl;
+        out << "        status = e.errorno;" << endl;
+        out << "    }" << endl;
+        out << "    catch (std::bad_alloc &e)" << endl;
+        out << "    {" << endl;
+        out << "        *errorMsg = \"Out of memory.\";" << endl;
+        out << "        status = 1;" << endl;
+        out << "    }" << endl;
+        out << "" << endl;
+        out << "    // Cleanup (all distributions are on the list of checked distributions)" << endl;
+        out << "    while (minStorageDistributions != NULL)" << endl;
+        out << "    {" << endl;
+        out << "        MinStorageDistr *p = minStorageDistributions;" << endl;
+        out << "        minStorageDistributions = p->next;" << endl;
+        out << "        delete p;" << endl;
+        out << "    }" << endl;
+        out << "    while (checkedDistributions != NULL)" << endl;
+        out << "    {" << endl;
+        out << "        Distribution *d = checkedDistributions;" << endl;
+        out << "        checkedDistributions = d->check;" << endl;
+        out << "        delete d;" << endl;
+        out << "    }" << endl;
+        out << "    delete [] sizeSets;" << endl;
+        out << "    if (stack != NULL)" << endl;
+        out << "        destroyStack();" << endl;
+        out << "    if (hashTable != NULL)" << endl;
+        out << "        destroyHashTable();" << endl;
+        out << "    if (dependencyStack != NULL)" << endl;
+        out << "        destroyDependencyStack();" << endl;
+        out << "" << endl;
+        out << "    return status;" << endl;
+        out << "}" << endl;
+    }
+
+    static
+    void printThroughputKernel(ostream &out)
+    {
+        out << "/**" << endl;
+        out << " * sdf3BuffyThroughputKernel ()" << endl;
+        out << " * Find the output interval of the graph when every channel has its" << endl;
+        out << " * maximal size (i.e. the maximal throughput). The output interval of a" << endl;
+        out << " * deadlocking graph is HUGE_VAL. The function returns zero on success." << endl;
+        out << " * On an error, it returns the error number and sets 'errorMsg'." << endl;
+        out << " */" << endl;
+        out << "extern \"C\" int sdf3BuffyThroughputKernel(double *outputInterval," << endl;
+        out << "        const char **errorMsg)" << endl;
+        out << "{" << endl;
+        out << "    int status = 0;" << endl;
+        out << "" << endl;
+        out << "    // The kernel may be loaded more than once, reset its search state" << endl;
+        out << "    maxStackPtr = 0;" << endl;
+        out << "    stack = NULL;" << endl;
+        out << "    hashTable = NULL;" << endl;
+        out << "    dependencyStack = NULL;" << endl;
+        out << "" << endl;
+        out << "    try" << endl;
+        out << "    {" << endl;
+        out << "        // Create hash and stack" << endl;
+        out << "        createStack();" << endl;
+        out << "        createHashTable();" << endl;
+        out << "        createDependencyStack();" << endl;
+        out << "" << endl;
+        out << "        // Find the maximal throughput" << endl;
+        out << "        TTime lbOutputInterval = findLbOutputInterval();" << endl;
+        out << "" << endl;
+        out << "        if (lbOutputInterval == TTIME_MAX)" << endl;
+        out << "            *outputInterval = HUGE_VAL;" << endl;
+        out << "        else" << endl;
+        out << "            *outputInterval = lbOutputInterval;" << endl;
+        out << "    }" << endl;
+        out << "    catch (KernelError &e)" << endl;
+        out << "    {" << endl;
+        out << "        *errorMsg = e.msg;" << endl;
+        out << "        status = e.errorno;" << endl;
+        out << "    }" << endl;
+        out << "    catch (std::bad_alloc &e)" << endl;
+        out << "    {" << endl;
+        out << "        *errorMsg = \"Out of memory.\";" << endl;
+        out << "        status = 1;" << endl;
+        out << "    }" << endl;
+        out << "" << endl;
+        out << "    // Cleanup" << endl;
+        out << "    if (stack != NULL)" << endl;
+        out << "        destroyStack();" << endl;
+        out << "    if (hashTable != NULL)" << endl;
+        out << "        destroyHashTable();" << endl;
+        out << "    if (dependencyStack != NULL)" << endl;
+        out << "        destroyDependencyStack();" << endl;
+        out << "" << endl;
+        out << "    return status;" << endl;
+        out << "}" << endl;
+    }
+
     extern
     void outputSDFasBuffyModel(TimedSDFgraph *g, ostream &out,
                                CString &outputActor, unsigned long long stackSz,
                                unsigned long long hashSz, unsigned long long depStackSz)
     {
         printDefinitions(g, out, stackSz, hashSz, depStackSz);
-        printMiscFunctions(out);
+        printMiscFunctions(out, false);
         printState(out);
         printStack(out);
         printHash(out);
@@ -2400,7 +2842,7 @@ namespace SDF
                                          unsigned long long hashSz, unsigned long long depStackSz)
     {
         printDefinitions(g, out, stackSz, hashSz, depStackSz);
-        printMiscFunctions(out);
+        printMiscFunctions(out, false);
         printState(out);
         printStack(out);
         printHash(out);
@@ -2409,4 +2851,36 @@ namespace SDF
         printDistribution(out);
         printMain(out, false);
     }
+
+    extern
+    void outputSDFasBuffyKernel(TimedSDFgraph *g, ostream &out,
+                                CString &outputActor, unsigned long long stackSz,
+                                unsigned long long hashSz, unsigned long long depStackSz)
+    {
+        printDefinitions(g, out, stackSz, hashSz, depStackSz);
+        printMiscFunctions(out, true);
+        printState(out);
+        printStack(out);
+        printHash(out);
+        printDependencies(out);
+        printSdf(g, out, outputActor);
+        printDistribution(out);
+        printKernel(g, out);
+    }
+
+    extern
+    void outputSDFasBuffyThroughputKernel(TimedSDFgraph *g, ostream &out,
+                                          CString &outputActor, unsigned long long stackSz,
+                                          unsigned long long hashSz, unsigned long long depStackSz)
+    {
+        printDefinitions(g, out, stackSz, hashSz, depStackSz);
+        printMiscFunctions(out, true);
+        printState(out);
+        printStack(out);
+        printHash(out);
+        printDependencies(out);
+        printSdf(g, out, outputActor);
+        printDistribution(out);
+        printThroughputKernel(out);
+    }
 }//namespace SDF
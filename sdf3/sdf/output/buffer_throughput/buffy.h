@@ -12,6 +12,8 @@
  *
  *  History         :
  *      29-03-02    :   Initial version.
+ *      17-10-26    :   Buffy model as a loadable kernel.
+ *      17-10-26    :   Throughput model as a loadable kernel.
  *
  * $Id: buffy.h,v 1.1.1.1 2007-10-02 10:59:46 sander Exp $
  *
@@ -58,6 +60,28 @@ namespace SDF
                                          CString &output_actor, unsigned long long stackSz,
                                          unsigned long long hashSz, unsigned long long depStackSz);
 
+    /**
+     * outputSDFasBuffyKernel ()
+     * Output the SDF graph as a buffy model that is compiled into a shared
+     * object. Instead of a main function, the model has an entry point
+     * 'sdf3BuffyKernel' which reports all minimal storage distributions
+     * through a callback.
+     */
+    void outputSDFasBuffyKernel(TimedSDFgraph *g, ostream &out,
+                                CString &output_actor, unsigned long long stackSz,
+                                unsigned long long hashSz, unsigned long long depStackSz);
+
+    /**
+     * outputSDFasBuffyThroughputKernel ()
+     * Output the SDF graph as the buffy model of outputSDFasBuffyModelThroughput
+     * that is compiled into a shared object. Instead of a main function, the
+     * model has an entry point 'sdf3BuffyThroughputKernel' which returns the
+     * lower bound on the output interval.
+     */
+    void outputSDFasBuffyThroughputKernel(TimedSDFgraph *g, ostream &out,
+                                          CString &output_actor, unsigned long long stackSz,
+                                          unsigned long long hashSz, unsigned long long depStackSz);
+
     /**
      * outputSDFasStateSpaceThroughputModel ()
      * Output the SDF graph as a buffy model to find the maximal
@@ -1334,14 +1334,16 @@ namespace SDF
                 out << endl;
 
                 out << "<p><b class='header'>Static-order schedule:</b> " << endl;
-                for (uint i = 0; i != s.size(); i++)
+                vector<SDFactor *> actors;
+                s.unroll(actors);
+                for (uint i = 0; i != actors.size(); i++)
                 {
                     if (s.getStartPeriodicSchedule() == i)
                         out << "<b>(</b>";
 
-                    out << s.getScheduleEntry(i)->actor->getName();
+                    out << actors[i]->getName();
 
-                    if (i + 1 == s.size())
+                    if (i + 1 == actors.size())
                         out << "<b>)</b>";
                     else
                         out << ", ";
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      27-02-08    :   Initial version.
+ *      17-10-26    :   Update of TDMA slices without reconstruction.
  *
  * $Id: binding_aware_sdfg.cc,v 1.3.2.1 2010-04-25 02:08:51 mgeilen Exp $
  *
@@ -56,9 +57,41 @@ namespace SDF
         extractChannelMapping(constrainedSDFG, platformGraph);
 
         // Create a binding-aware SDFG
+        this->flowType = flowType;
         constructBindingAwareSDFG(constrainedSDFG, platformGraph, flowType);
     }
 
+    /**
+     * setTDMAsliceOnTile ()
+     * The function changes the TDMA time slice of the application on a tile
+     * without constructing the binding-aware SDFG again. The execution time of
+     * the actors which model the synchronization with the TDMA wheel of the
+     * tile is updated. The function returns false when the structure of the
+     * graph depends on the new slice. In the NSoC flow, this is the case when
+     * the slice changes from (or to) the complete TDMA wheel, because no
+     * synchronization is modeled for a complete wheel. The graph is not
+     * changed in that case.
+     */
+    bool BindingAwareSDFG::setTDMAsliceOnTile(CId tileId, SDFtime slice)
+    {
+        if (flowType == SDFflowTypeNSoC && (tdmaSize[tileId] > slice)
+            != (tdmaSize[tileId] > tdmaSlice[tileId]))
+        {
+            return false;
+        }
+
+        tdmaSlice[tileId] = slice;
+
+        for (uint i = 0; i < tdmaActors[tileId].size(); i++)
+        {
+            TimedSDFactor *a = tdmaActors[tileId][i];
+
+            a->getProcessor("tdma")->execTime = tdmaSize[tileId] - slice;
+        }
+
+        return true;
+    }
+
     /**
      * extractActorMapping ()
      * The function extracts the actor binding and scheduling from the platform
@@ -76,6 +109,7 @@ namespace SDF
         schedule.resize(nrTiles);
         tdmaSize.resize(nrTiles);
         tdmaSlice.resize(nrTiles);
+        tdmaActors.resize(nrTiles);
 
         // Initialize actor bindings
         for (uint i = 0; i < constrainedSDFG->nrActors(); i++)
@@ -292,6 +326,7 @@ namespace SDF
             tdma.stateSize = 0;
             d->addProcessor(&tdma);
             d->setDefaultProcessor("tdma");
+            tdmaActors[cn->getDstTile()->getId()].push_back(d);
 
             // The channel ch must be split in 3 channels connected to actor c and d
             g->createChannel(c, 1, d, 1, 0);
@@ -566,6 +601,7 @@ namespace SDF
         tdmaSrcSync.stateSize = 0;
         tdmaSrcSyncActor->addProcessor(&tdmaSrcSync);
         tdmaSrcSyncActor->setDefaultProcessor("tdma");
+        tdmaActors[cn->getSrcTile()->getId()].push_back(tdmaSrcSyncActor);
 
         // Create an actor to model TDMA synchronization on the dst processor
         tdmaDstSyncActor = (TimedSDFactor *)g->createActor();
@@ -576,6 +612,7 @@ namespace SDF
         tdmaDstSync.stateSize = 0;
         tdmaDstSyncActor->addProcessor(&tdmaDstSync);
         tdmaDstSyncActor->setDefaultProcessor("tdma");
+        tdmaActors[cn->getDstTile()->getId()].push_back(tdmaDstSyncActor);
 
         // Create channel from source actor to semaphore latency actor
         chSrcSemaphoreActor = (TimedSDFchannel *) g->createChannel(srcActor,
@@ -629,19 +666,7 @@ namespace SDF
         // latency actor (this actor must be placed directly in front of the dst
         // actor).
         StaticOrderSchedule &s = schedule[cn->getDstTile()->getId()];
-
-        for (StaticOrderScheduleEntryIter entry = s.begin();
-             entry != s.end(); entry++)
-        {
-            if (entry->actor->getId() == dstActor->getId())
-            {
-                // Add schedule entry to the schedule
-                entry = s.insertActor(entry, communicationLatencyActor);
-
-                // Skip over newly added entry
-                entry++;
-            }
-        }
+        s.insertActorBefore(dstActor, communicationLatencyActor);
     }
 
     /**
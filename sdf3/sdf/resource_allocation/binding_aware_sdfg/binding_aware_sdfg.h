@@ -12,6 +12,7 @@
  *
  *  History         :
  *      27-02-08    :   Initial version.
+ *      17-10-26    :   Update of TDMA slices without reconstruction.
  *
  * $Id: binding_aware_sdfg.h,v 1.3 2008-03-06 13:59:05 sander Exp $
  *
@@ -91,6 +92,7 @@ namespace SDF
             {
                 return tdmaSlice[tileId];
             };
+            bool setTDMAsliceOnTile(CId tileId, SDFtime slice);
 
             // Number of tiles in the platform graph
             uint nrTilesInPlatformGraph() const
@@ -139,6 +141,12 @@ namespace SDF
             // Timewheels and slices
             vector< SDFtime > tdmaSize;
             vector< SDFtime > tdmaSlice;
+
+            // Actors modeling the synchronization with the TDMA wheel of a tile
+            vector< vector<TimedSDFactor *> > tdmaActors;
+
+            // Flow used to model the binding
+            SDFflowType flowType;
     };
 }//namespace SDF
 #endif
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      07-02-07    :   Initial version.
+ *      17-10-26    :   Option to complete the flow after time-slice allocation.
  *
  * $Id: flow.cc,v 1.4 2008-03-20 16:16:18 sander Exp $
  *
@@ -51,15 +52,45 @@ namespace SDF
         xmlAppGraph(xmlAppGraph),
         xmlArchGraph(xmlArchGraph),
         xmlSystemUsage(xmlSystemUsage)
+    {
+        init(createAppGraph(xmlAppGraph), createPlatformGraph(xmlArchGraph));
+    }
+
+    /**
+     * SDF3Flow ()
+     * Constructor. The flow works on the supplied application and platform
+     * graph and deletes them when it is destroyed. The XML description of the
+     * architecture is only used by the NoC mapping.
+     */
+    SDF3Flow::SDF3Flow(SDFflowType type, TimedSDFgraph *appGraph,
+                       PlatformGraph *platformGraph, CNode *xmlArchGraph,
+                       CNode *xmlSystemUsage)
+        :
+        flowType(type),
+        xmlAppGraph(NULL),
+        xmlArchGraph(xmlArchGraph),
+        xmlSystemUsage(xmlSystemUsage)
+    {
+        init(appGraph, platformGraph);
+    }
+
+    /**
+     * init ()
+     * The function puts the flow in its initial state.
+     */
+    void SDF3Flow::init(TimedSDFgraph *app, PlatformGraph *platform)
     {
         // Run flow in one go
         stepMode = false;
 
+        // Terminate the program after the TDMA time-slice allocation
+        completeAfterTimeSlices = false;
+
         // Application graph
-        appGraph = createAppGraph(xmlAppGraph);
+        appGraph = app;
 
         // Platform graph
-        platformGraph = createPlatformGraph(xmlArchGraph);
+        platformGraph = platform;
         setSystemUsagePlatformGraph(platformGraph, xmlSystemUsage);
 
         // Tile binding and scheduling algorithm
@@ -213,7 +244,12 @@ namespace SDF
 
                 case FlowAllocateTDMAtimeSlices:
                     allocateTDMAtimeSlices();
-                    exit(0);
+                    if (!getCompleteAfterTimeSlices())
+                        exit(0);
+                    if (getStateOfFlow() == FlowOptimizeStorageSpaceAllocations)
+                        setNextStateOfFlow(FlowCompleted);
+                    else
+                        setNextStateOfFlow(FlowFailed);
                     break;
 
                 case FlowOptimizeStorageSpaceAllocations:
@@ -12,6 +12,8 @@
  *
  *  History         :
  *      07-02-07    :   Initial version.
+ *      17-10-26    :   Option to complete the flow after time-slice allocation.
+ *      17-10-26    :   Binary copy of the custom tile binding.
  *
  * $Id: flow.h,v 1.5 2008-03-20 16:16:18 sander Exp $
  *
@@ -76,6 +78,11 @@ namespace SDF
             SDF3Flow(SDFflowType type, CNode *xmlAppGraph, CNode *xmlArchGraph,
                      CNode *xmlSystemUsage);
 
+            // Constructor (the flow takes ownership of the graphs)
+            SDF3Flow(SDFflowType type, TimedSDFgraph *appGraph,
+                     PlatformGraph *platformGraph, CNode *xmlArchGraph,
+                     CNode *xmlSystemUsage);
+
             // Destructor
             ~SDF3Flow();
 
@@ -98,6 +105,17 @@ namespace SDF
                 stepMode = flag;
             };
 
+            // Complete the flow after the TDMA time-slice allocation instead
+            // of terminating the program at that point
+            bool getCompleteAfterTimeSlices() const
+            {
+                return completeAfterTimeSlices;
+            };
+            void setCompleteAfterTimeSlices(bool flag)
+            {
+                completeAfterTimeSlices = flag;
+            };
+
             // Settings for tile binding and scheduling phase
             void setTileMappingAlgo(TileMapping *a)
             {
@@ -116,9 +134,11 @@ namespace SDF
             void outputMappingAsHTML();
 
             void setCustomTileBinding(CString _binding) { tileBinding = _binding; }
+            void setBinaryTileBindingFile(CString _file) { tileBindingBinary = _file; }
 
         protected:
             CString tileBinding = "N/A";
+            CString tileBindingBinary = "N/A";
 
         private:
             // Application graph
@@ -147,6 +167,9 @@ namespace SDF
             };
 
         private:
+            // Initialization of the flow state
+            void init(TimedSDFgraph *app, PlatformGraph *platform);
+
             void useCustomTileBinding();
 
             // Steps of the design flow
@@ -179,6 +202,9 @@ namespace SDF
             // Run flow step-by-step
             bool stepMode;
 
+            // Complete the flow after the TDMA time-slice allocation
+            bool completeAfterTimeSlices;
+
             // XML description of the application and architecture
             CNode *xmlAppGraph;
             CNode *xmlArchGraph;
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      07-02-07    :   Initial version.
+ *      17-10-26    :   Binary copy of the custom tile binding.
  *
  * $Id: tile.cc,v 1.2 2008-03-06 10:49:44 sander Exp $
  *
@@ -39,6 +40,7 @@ namespace SDF
     void SDF3Flow::useCustomTileBinding()
     {
         tileMapping->setCustomTileBinding(tileBinding);
+        tileMapping->setBinaryTileBindingFile(tileBindingBinary);
     }
 
     /**
@@ -12,6 +12,7 @@
  *
  *  History         :
  *      30-03-06    :   Initial version.
+ *      17-10-26    :   Schedules may contain loops.
  *
  * $Id: graph.cc,v 1.2.2.1 2010-04-25 02:08:51 mgeilen Exp $
  *
@@ -463,20 +464,8 @@ namespace SDF
         {
             CNode *scheduleNode = CGetChildNode(procNode, "schedule");
 
-            // Construct states of the schedule
-            for (CNode *stateNode = CGetChildNode(scheduleNode, "state");
-                 stateNode != NULL; stateNode = CNextNode(stateNode, "state"))
-            {
-                // Add the actor to the schedule
-                s.appendActor(g->getActor(CGetAttribute(stateNode, "actor")));
-
-                // Is this schedule entry the start of the periodic regime?
-                if (CHasAttribute(stateNode, "startOfPeriodicRegime")
-                    && CGetAttribute(stateNode, "startOfPeriodicRegime") == "true")
-                {
-                    s.setStartPeriodicSchedule(s.size() - 1);
-                }
-            }
+            // Construct states of the schedule (unrolling its loops)
+            s.constructFromXML(g, scheduleNode);
 
             // Link schedule to processor
             p->setSchedule(s);
@@ -0,0 +1,802 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   stream.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Streaming construction and binary cache of
+ *                      platform graphs
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *      17-10-26    :   Network description of the NoC allocation.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "stream.h"
+
+// Kind of the cache entries
+#define PLATFORM_GRAPH_CACHE_KIND   "platform"
+#define NETWORK_CACHE_KIND          "network"
+
+namespace SDF
+{
+    /**
+     * PlatformGraphSAXHandler
+     * Constructs a platform graph from the events of the streaming parser.
+     * Like constructPlatformGraph, only the first processor, memory and
+     * network interface of a tile are used.
+     */
+    class PlatformGraphSAXHandler : public CSAXHandler
+    {
+        public:
+            // Constructor
+            PlatformGraphSAXHandler(const CString &filename, const CString &module)
+                : filename(filename), module(module), graph(NULL), tile(NULL),
+                  processor(NULL), arbitrationFound(false), done(false) {};
+
+            // Destructor
+            ~PlatformGraphSAXHandler()
+            {
+                delete graph;
+            };
+
+            // Events
+            void startElement(const CString &name, const CSAXAttributes &attr);
+            void endElement(const CString &name);
+            bool isDone() const
+            {
+                return done;
+            };
+
+            // Constructed graph (ownership passes to the caller)
+            PlatformGraph *release();
+
+        private:
+            // Element contexts
+            enum Context { Ignore, Root, ArchitectureGraph, ArchTile,
+                           TileProcessor
+                         };
+
+            // Connection whose tiles are set at the end of the graph
+            typedef struct _ConnectionEnds
+            {
+                Connection *connection;
+                CString srcTile, dstTile;
+            } ConnectionEnds;
+
+            Context startChild(const Context parent, const CString &name,
+                               const bool first, const CSAXAttributes &attr);
+            void connectTiles();
+
+            // File
+            CString filename;
+            CString module;
+
+            // Open elements
+            vector<Context> contexts;
+            vector<set<CString> > children;
+
+            // Graph under construction
+            PlatformGraph *graph;
+            map<CString, Tile *> tiles;
+            list<ConnectionEnds> connectionEnds;
+            Tile *tile;
+            Processor *processor;
+            bool arbitrationFound;
+
+            // Progress
+            bool done;
+    };
+
+    /**
+     * startElement ()
+     * The function handles the start of an element.
+     */
+    void PlatformGraphSAXHandler::startElement(const CString &name,
+            const CSAXAttributes &attr)
+    {
+        Context c;
+
+        if (contexts.empty())
+        {
+            c = startChild(Ignore, name, true, attr);
+        }
+        else
+        {
+            bool first = children.back().insert(name).second;
+            c = startChild(contexts.back(), name, first, attr);
+        }
+
+        contexts.push_back(c);
+        children.push_back(set<CString>());
+    }
+
+    /**
+     * startChild ()
+     * The function handles the start of an element inside an element with
+     * the given context. It returns the context of the new element.
+     */
+    PlatformGraphSAXHandler::Context PlatformGraphSAXHandler::startChild(
+        const Context parent, const CString &name, const bool first,
+        const CSAXAttributes &attr)
+    {
+        CSize nrConnections, inBandwidth, outBandwidth;
+        NetworkInterface *ni;
+        Memory *m;
+
+        // Root element
+        if (contexts.empty())
+        {
+            if (attr.getAttribute("type") != module)
+            {
+                throw CException("Root element in file '" + filename + "' is not "
+                                 "of type '" + module + "'.");
+            }
+            return Root;
+        }
+
+        switch (parent)
+        {
+            case Root:
+                if (name == "architectureGraph" && first)
+                {
+                    if (!attr.hasAttribute("name"))
+                        throw CException("Architecture graph must have a name");
+                    ArchComponent component = ArchComponent(NULL, 0,
+                                                            attr.getAttribute("name"));
+                    graph = new PlatformGraph(component);
+
+                    return ArchitectureGraph;
+                }
+                break;
+
+            case ArchitectureGraph:
+                if (name == "tile")
+                {
+                    if (!attr.hasAttribute("name"))
+                        throw CException("Tile must have a name");
+                    tile = graph->createTile(attr.getAttribute("name"));
+                    tiles.insert(make_pair(tile->getName(), tile));
+
+                    return ArchTile;
+                }
+                else if (name == "connection")
+                {
+                    ConnectionEnds ends;
+
+                    if (!attr.hasAttribute("name"))
+                        throw CException("Connection must have a name");
+                    ends.connection = graph->createConnection(attr.getAttribute("name"));
+
+                    if (!attr.hasAttribute("delay"))
+                        throw CException("Connection must have a delay");
+                    ends.connection->setLatency(attr.getAttribute("delay"));
+
+                    if (!attr.hasAttribute("srcTile"))
+                        throw CException("Connection must have a srcTile");
+                    ends.srcTile = attr.getAttribute("srcTile");
+
+                    if (!attr.hasAttribute("dstTile"))
+                        throw CException("Connection must have a dstTile");
+                    ends.dstTile = attr.getAttribute("dstTile");
+
+                    connectionEnds.push_back(ends);
+                }
+                break;
+
+            case ArchTile:
+                if (name == "processor" && first)
+                {
+                    if (!attr.hasAttribute("name"))
+                        throw CException("Processor must have a name.");
+                    processor = tile->createProcessor(attr.getAttribute("name"));
+                    if (!attr.hasAttribute("type"))
+                        throw CException("Processor must have a type.");
+                    processor->setType(attr.getAttribute("type"));
+                    arbitrationFound = false;
+
+                    return TileProcessor;
+                }
+                else if (name == "memory" && first)
+                {
+                    if (!attr.hasAttribute("name"))
+                        throw CException("Memory must have a name.");
+                    m = tile->createMemory(attr.getAttribute("name"));
+                    if (!attr.hasAttribute("size"))
+                        throw CException("Memory must have a size.");
+                    m->setSize(attr.getAttribute("size"));
+                }
+                else if (name == "networkInterface" && first)
+                {
+                    if (!attr.hasAttribute("name"))
+                        throw CException("Network interface  must have a name.");
+                    ni = tile->createNetworkInterface(attr.getAttribute("name"));
+                    if (!attr.hasAttribute("nrConnections"))
+                        throw CException("Network interface must have nrConnections.");
+                    nrConnections = attr.getAttribute("nrConnections");
+                    if (!attr.hasAttribute("inBandwidth"))
+                        throw CException("Network interface must have inBandwidth.");
+                    inBandwidth = attr.getAttribute("inBandwidth");
+                    if (!attr.hasAttribute("outBandwidth"))
+                        throw CException("Network interface must have outBandwidth.");
+                    outBandwidth = attr.getAttribute("outBandwidth");
+                    ni->setConnections(nrConnections, (double) inBandwidth,
+                                       (double) outBandwidth);
+                }
+                break;
+
+            case TileProcessor:
+                if (name == "arbitration" && first)
+                {
+                    arbitrationFound = true;
+                    if (attr.getAttribute("type") != "TDMA")
+                        throw CException("Only TDMA arbitration supported.");
+                    if (!attr.hasAttribute("wheelsize"))
+                        throw CException("TDMA arbitration needs wheelsize.");
+                    processor->setTimewheelSize(attr.getAttribute("wheelsize"));
+                }
+                break;
+
+            default:
+                break;
+        }
+
+        return Ignore;
+    }
+
+    /**
+     * endElement ()
+     * The function handles the end of an element.
+     */
+    void PlatformGraphSAXHandler::endElement(const CString &name)
+    {
+        Context c = contexts.back();
+
+        contexts.pop_back();
+        children.pop_back();
+
+        if (c == TileProcessor && !arbitrationFound)
+        {
+            throw CException("Processor must have arbitration mechanism.");
+        }
+        else if (c == ArchitectureGraph)
+        {
+            connectTiles();
+            done = true;
+        }
+    }
+
+    /**
+     * connectTiles ()
+     * The function connects all connections to their tiles. This is done at
+     * the end of the graph, so connections may precede the tiles they connect.
+     */
+    void PlatformGraphSAXHandler::connectTiles()
+    {
+        map<CString, Tile *>::iterator t;
+
+        for (list<ConnectionEnds>::iterator iter = connectionEnds.begin();
+             iter != connectionEnds.end(); iter++)
+        {
+            ConnectionEnds &ends = *iter;
+
+            t = tiles.find(ends.srcTile);
+            if (t == tiles.end())
+                throw CException("srcTile does not exist.");
+            ends.connection->setSrcTile(t->second);
+            t->second->addOutConnection(ends.connection);
+
+            t = tiles.find(ends.dstTile);
+            if (t == tiles.end())
+                throw CException("dstTile does not exist.");
+            ends.connection->setDstTile(t->second);
+            t->second->addInConnection(ends.connection);
+        }
+
+        connectionEnds.clear();
+    }
+
+    /**
+     * release ()
+     * The function returns the constructed graph (NULL if the file contains no
+     * architecture graph). The caller becomes the owner of the graph.
+     */
+    PlatformGraph *PlatformGraphSAXHandler::release()
+    {
+        PlatformGraph *g = graph;
+
+        graph = NULL;
+
+        return g;
+    }
+
+    /**
+     * streamPlatformGraph ()
+     * The function constructs the architecture graph of an SDF3 file directly
+     * from the events of the streaming XML parser.
+     */
+    PlatformGraph *streamPlatformGraph(const CString &filename,
+                                       const CString &module)
+    {
+        PlatformGraphSAXHandler handler(filename, module);
+
+        CParseStream(filename, handler);
+
+        return handler.release();
+    }
+
+    /**
+     * streamPlatformGraph ()
+     * The function constructs the architecture graph of an SDF3 document in
+     * memory directly from the events of the streaming XML parser.
+     */
+    PlatformGraph *streamPlatformGraph(const char *buffer, const size_t size,
+                                       const CString &filename, const CString &module)
+    {
+        PlatformGraphSAXHandler handler(filename, module);
+
+        CParseStream(buffer, size, filename, handler);
+
+        return handler.release();
+    }
+
+    /**
+     * writePlatformGraph ()
+     * The function writes the binary representation of a platform graph
+     * (NULL is allowed). Tiles are referred to by their position.
+     */
+    void writePlatformGraph(PlatformGraph *g, CBinaryWriter &out)
+    {
+        map<Tile *, uint> position;
+        uint nrTiles = 0;
+
+        out.putUInt(g == NULL ? 0 : 1);
+        if (g == NULL)
+            return;
+
+        // Graph
+        out.putString(g->getName());
+
+        // Tiles
+        out.putUInt(g->nrTiles());
+        for (TilesIter iter = g->tilesBegin(); iter != g->tilesEnd(); iter++)
+        {
+            Tile *t = *iter;
+            Processor *p = t->getProcessor();
+            Memory *m = t->getMemory();
+            NetworkInterface *ni = t->getNetworkInterface();
+
+            position[t] = nrTiles++;
+            out.putString(t->getName());
+
+            out.putUInt(p == NULL ? 0 : 1);
+            if (p != NULL)
+            {
+                out.putString(p->getName());
+                out.putString(p->getType());
+                out.putULong(p->getTimewheelSize());
+            }
+
+            out.putUInt(m == NULL ? 0 : 1);
+            if (m != NULL)
+            {
+                out.putString(m->getName());
+                out.putULong(m->getSize());
+            }
+
+            out.putUInt(ni == NULL ? 0 : 1);
+            if (ni != NULL)
+            {
+                out.putString(ni->getName());
+                out.putULong(ni->getNrConnections());
+                out.putDouble(ni->getInBandwidth());
+                out.putDouble(ni->getOutBandwidth());
+            }
+        }
+
+        // Connections
+        out.putUInt(distance(g->connectionsBegin(), g->connectionsEnd()));
+        for (ConnectionsIter iter = g->connectionsBegin();
+             iter != g->connectionsEnd(); iter++)
+        {
+            Connection *c = *iter;
+
+            out.putString(c->getName());
+            out.putULong(c->getLatency());
+            out.putUInt(c->getSrcTile() == NULL ? CID_MAX : position[c->getSrcTile()]);
+            out.putUInt(c->getDstTile() == NULL ? CID_MAX : position[c->getDstTile()]);
+        }
+    }
+
+    /**
+     * readPlatformGraph ()
+     * The function constructs a platform graph from its binary representation.
+     */
+    PlatformGraph *readPlatformGraph(CBinaryReader &in)
+    {
+        vector<Tile *> tiles;
+        PlatformGraph *g;
+        uint nrTiles, nrConnections, pos;
+
+        if (in.getUInt() == 0)
+        {
+            if (!in.atEnd())
+                throw CException("Invalid binary platform graph, trailing data.");
+            return NULL;
+        }
+
+        ArchComponent component = ArchComponent(NULL, 0, in.getString());
+        g = new PlatformGraph(component);
+
+        try
+        {
+            // Tiles
+            nrTiles = in.getUInt();
+            for (uint i = 0; i < nrTiles; i++)
+            {
+                Tile *t = g->createTile(in.getString());
+                tiles.push_back(t);
+
+                if (in.getUInt() != 0)
+                {
+                    Processor *p = t->createProcessor(in.getString());
+                    p->setType(in.getString());
+                    p->setTimewheelSize(in.getULong());
+                }
+
+                if (in.getUInt() != 0)
+                {
+                    Memory *m = t->createMemory(in.getString());
+                    m->setSize(in.getULong());
+                }
+
+                if (in.getUInt() != 0)
+                {
+                    NetworkInterface *ni = t->createNetworkInterface(in.getString());
+                    CSize nrConnections = in.getULong();
+                    double inBandwidth = in.getDouble();
+                    double outBandwidth = in.getDouble();
+                    ni->setConnections(nrConnections, inBandwidth, outBandwidth);
+                }
+            }
+
+            // Connections
+            nrConnections = in.getUInt();
+            for (uint i = 0; i < nrConnections; i++)
+            {
+                Connection *c = g->createConnection(in.getString());
+                c->setLatency(in.getULong());
+
+                pos = in.getUInt();
+                if (pos != CID_MAX)
+                {
+                    if (pos >= tiles.size())
+                        throw CException("Invalid binary platform graph, unknown tile.");
+                    c->setSrcTile(tiles[pos]);
+                    tiles[pos]->addOutConnection(c);
+                }
+
+                pos = in.getUInt();
+                if (pos != CID_MAX)
+                {
+                    if (pos >= tiles.size())
+                        throw CException("Invalid binary platform graph, unknown tile.");
+                    c->setDstTile(tiles[pos]);
+                    tiles[pos]->addInConnection(c);
+                }
+            }
+
+            if (!in.atEnd())
+                throw CException("Invalid binary platform graph, trailing data.");
+        }
+        catch (CException &e)
+        {
+            delete g;
+            throw;
+        }
+
+        return g;
+    }
+
+    /**
+     * loadPlatformGraph ()
+     * The function constructs the architecture graph of an SDF3 file. When a
+     * cache is given, the graph is read from the cache entry of the file
+     * contents if present; otherwise the file is streamed and the entry is
+     * added to the cache.
+     */
+    PlatformGraph *loadPlatformGraph(const CString &filename,
+                                     const CString &module, const CBinaryCache *cache)
+    {
+        CMappedFile file, entry;
+        CBinaryReader payload;
+        CBinaryWriter out;
+        PlatformGraph *g;
+        CHash key;
+
+        if (cache == NULL)
+            return streamPlatformGraph(filename, module);
+
+        if (!file.open(filename))
+            throw CException("Failed loading architecture from '" + filename + "'.");
+
+        // The entry depends on the contents of the file and the module type
+        key = CHashContent(file.getData(), file.getSize());
+        key = CHashContent(module.data(), module.size(), key);
+
+        if (cache->find(PLATFORM_GRAPH_CACHE_KIND, key, entry, payload))
+        {
+            try
+            {
+                return readPlatformGraph(payload);
+            }
+            catch (CException &e)
+            {
+                logWarning("Ignoring invalid cache entry for '" + filename + "'.");
+            }
+        }
+
+        g = streamPlatformGraph(file.getData(), file.getSize(), filename, module);
+
+        writePlatformGraph(g, out);
+        cache->store(PLATFORM_GRAPH_CACHE_KIND, key, out);
+
+        return g;
+    }
+
+    /**
+     * NetworkSAXHandler
+     * Records the elements of an architecture graph that are used by the NoC
+     * allocation: the architectureGraph element, its tiles (name only) and its
+     * network element with all its children. Every element is written to the
+     * binary form as a start (1, name, attributes) and an end (0) marker.
+     */
+    class NetworkSAXHandler : public CSAXHandler
+    {
+        public:
+            // Constructor
+            NetworkSAXHandler(const CString &filename, const CString &module,
+                              CBinaryWriter &out)
+                : filename(filename), module(module), out(out),
+                  found(false), done(false) {};
+
+            // Events
+            void startElement(const CString &name, const CSAXAttributes &attr);
+            void endElement(const CString &name);
+            bool isDone() const
+            {
+                return done;
+            };
+
+        private:
+            // Element contexts
+            enum Context { Ignore, Root, ArchitectureGraph, Network };
+
+            // File
+            CString filename;
+            CString module;
+
+            // Binary form
+            CBinaryWriter &out;
+
+            // Open elements
+            vector<Context> contexts;
+
+            // Progress
+            bool found;
+            bool done;
+    };
+
+    /**
+     * startElement ()
+     * The function handles the start of an element.
+     */
+    void NetworkSAXHandler::startElement(const CString &name,
+                                         const CSAXAttributes &attr)
+    {
+        Context c = Ignore;
+
+        if (contexts.empty())
+        {
+            if (attr.getAttribute("type") != module)
+            {
+                throw CException("Root element in file '" + filename + "' is not "
+                                 "of type '" + module + "'.");
+            }
+            contexts.push_back(Root);
+            return;
+        }
+
+        switch (contexts.back())
+        {
+            case Root:
+                if (name == "architectureGraph" && !found)
+                {
+                    found = true;
+                    c = ArchitectureGraph;
+                }
+                break;
+
+            case ArchitectureGraph:
+                if (name == "tile")
+                {
+                    out.putUInt(1);
+                    out.putString(name);
+                    out.putUInt(attr.hasAttribute("name") ? 1 : 0);
+                    if (attr.hasAttribute("name"))
+                    {
+                        out.putString("name");
+                        out.putString(attr.getAttribute("name"));
+                    }
+                    out.putUInt(0);
+                }
+                else if (name == "network")
+                {
+                    c = Network;
+                }
+                break;
+
+            case Network:
+                c = Network;
+                break;
+
+            default:
+                break;
+        }
+
+        if (c != Ignore)
+        {
+            out.putUInt(1);
+            out.putString(name);
+            out.putUInt(attr.size());
+            for (int i = 0; i < attr.size(); i++)
+            {
+                out.putString(attr.getName(i));
+                out.putString(attr.getValue(i));
+            }
+        }
+
+        contexts.push_back(c);
+    }
+
+    /**
+     * endElement ()
+     * The function handles the end of an element.
+     */
+    void NetworkSAXHandler::endElement(const CString &name)
+    {
+        Context c = contexts.back();
+
+        contexts.pop_back();
+
+        if (c == ArchitectureGraph || c == Network)
+            out.putUInt(0);
+
+        if (c == ArchitectureGraph)
+            done = true;
+    }
+
+    /**
+     * readArchitectureNetwork ()
+     * The function constructs the architectureGraph element from its binary
+     * form. It returns NULL when the form is empty.
+     */
+    static CNode *readArchitectureNetwork(CBinaryReader &in)
+    {
+        vector<CNode *> elements;
+        CNode *root = NULL;
+
+        if (in.atEnd())
+            return NULL;
+
+        do
+        {
+            if (in.getUInt() != 0)
+            {
+                CNode *n = CNewNode(in.getString());
+                uint nrAttributes = in.getUInt();
+
+                for (uint i = 0; i < nrAttributes; i++)
+                {
+                    CString attrName = in.getString();
+                    CAddAttribute(n, attrName, in.getString());
+                }
+
+                if (elements.empty())
+                {
+                    if (root != NULL)
+                        throw CException("Invalid binary network, more roots.");
+                    root = n;
+                }
+                else
+                {
+                    CAddNode(elements.back(), n);
+                }
+                elements.push_back(n);
+            }
+            else
+            {
+                if (elements.empty())
+                    throw CException("Invalid binary network, unmatched end.");
+                elements.pop_back();
+            }
+        }
+        while (!elements.empty());
+
+        if (!in.atEnd())
+            throw CException("Invalid binary network, trailing data.");
+
+        return root;
+    }
+
+    /**
+     * loadArchitectureNetwork ()
+     * The function returns the architectureGraph element with the tiles and
+     * the network of an SDF3 file. When a cache is given, the binary form is
+     * read from the cache entry of the file contents if present; otherwise the
+     * file is streamed and the entry is added to the cache.
+     */
+    CNode *loadArchitectureNetwork(const CString &filename,
+                                   const CString &module, const CBinaryCache *cache)
+    {
+        CMappedFile file, entry;
+        CBinaryReader payload;
+        CBinaryWriter out;
+        CHash key;
+
+        if (!file.open(filename))
+            throw CException("Failed loading architecture from '" + filename + "'.");
+
+        if (cache != NULL)
+        {
+            // The entry depends on the contents of the file and the module type
+            key = CHashContent(file.getData(), file.getSize());
+            key = CHashContent(module.data(), module.size(), key);
+
+            if (cache->find(NETWORK_CACHE_KIND, key, entry, payload))
+            {
+                try
+                {
+                    return readArchitectureNetwork(payload);
+                }
+                catch (CException &e)
+                {
+                    logWarning("Ignoring invalid cache entry for '" + filename
+                               + "'.");
+                }
+            }
+        }
+
+        NetworkSAXHandler handler(filename, module, out);
+        CParseStream(file.getData(), file.getSize(), filename, handler);
+
+        if (cache != NULL)
+            cache->store(NETWORK_CACHE_KIND, key, out);
+
+        CBinaryReader in(out.getBuffer().data(), out.getBuffer().size());
+
+        return readArchitectureNetwork(in);
+    }
+
+}//namespace SDF
@@ -0,0 +1,92 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   stream.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Streaming construction and binary cache of
+ *                      platform graphs
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef SDF_RESOURCE_ALLOCATION_MPSOC_ARCH_STREAM_H_INCLUDED
+#define SDF_RESOURCE_ALLOCATION_MPSOC_ARCH_STREAM_H_INCLUDED
+
+#include "graph.h"
+
+namespace SDF
+{
+    /**
+     * streamPlatformGraph ()
+     * The function constructs the architecture graph of an SDF3 file directly
+     * from the events of the streaming XML parser. The result is identical to
+     * constructPlatformGraph, but no document tree is built and parsing stops
+     * after the architecture graph. The function returns NULL when the file
+     * contains no architecture graph. The root element must be of the given
+     * module type.
+     */
+    PlatformGraph *streamPlatformGraph(const CString &filename,
+                                       const CString &module);
+    PlatformGraph *streamPlatformGraph(const char *buffer, const size_t size,
+                                       const CString &filename, const CString &module);
+
+    /**
+     * writePlatformGraph ()
+     * The function writes the binary representation of a platform graph
+     * (NULL is allowed).
+     */
+    void writePlatformGraph(PlatformGraph *g, CBinaryWriter &out);
+
+    /**
+     * readPlatformGraph ()
+     * The function constructs a platform graph from its binary representation.
+     */
+    PlatformGraph *readPlatformGraph(CBinaryReader &in);
+
+    /**
+     * loadPlatformGraph ()
+     * The function constructs the architecture graph of an SDF3 file. When a
+     * cache is given, the graph is read from the cache entry of the file
+     * contents if present; otherwise the file is streamed and the entry is
+     * added to the cache.
+     */
+    PlatformGraph *loadPlatformGraph(const CString &filename,
+                                     const CString &module, const CBinaryCache *cache = NULL);
+
+    /**
+     * loadArchitectureNetwork ()
+     * The function returns the part of the architecture graph of an SDF3 file
+     * that is used by the NoC allocation: an architectureGraph element with
+     * the names of its tiles and its network element. The element is built
+     * from the events of the streaming XML parser. When a cache is given, it
+     * is read from or added to the cache like the platform graph. The
+     * function returns NULL when the file contains no architecture graph.
+     */
+    CNode *loadArchitectureNetwork(const CString &filename,
+                                   const CString &module, const CBinaryCache *cache = NULL);
+
+}//namespace SDF
+#endif
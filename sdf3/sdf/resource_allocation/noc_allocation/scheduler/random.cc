@@ -12,6 +12,7 @@
  *
  *  History         :
  *      06-01-06    :   Initial version.
+ *      17-10-26    :   Random number generator per thread.
  *
  * $Id: random.cc,v 1.1.2.1 2010-04-25 02:08:52 mgeilen Exp $
  *
@@ -37,7 +38,7 @@
 namespace SDF
 {
     // Random number generator
-    static MTRand mtRand;
+    static thread_local MTRand mtRand;
 
     /**
      * random ()
@@ -13,6 +13,10 @@
  *
  *  History         :
  *      24-04-06    :   Initial version.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
+ *      17-10-26    :   Only visit actors whose firing ends or which may have
+ *                      become enabled.
+ *      17-10-26    :   Schedules emitted as loops.
  *
  * $Id: list_scheduler.cc,v 1.5 2008-03-06 13:59:05 sander Exp $
  *
@@ -46,89 +50,58 @@ namespace SDF
      *****************************************************************************/
 
     /**
-     * clear ()
-     * The function sets the state to zero.
+     * operator== ()
+     * The function compares to states and returns true if they are equal.
      */
-    void SDFstateSpaceListScheduler::TransitionSystem::State::clear()
+    bool SDFstateSpaceListScheduler::TransitionSystem::State
+    ::operator==(const State &s) const
     {
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            actClk[i].clear();
-        }
-
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            ch[i] = 0;
-        }
+        return SDFstateSpaceState::operator==(s);
+    }
 
-        glbClk = 0;
+    /**
+     * print ()
+     * Print the state to the supplied stream.
+     */
+    void SDFstateSpaceListScheduler::TransitionSystem::State
+    ::print(ostream &out) const
+    {
+        SDFstateSpaceState::print(out);
 
         for (uint i = 0; i < schedulePos.size(); i++)
         {
-            schedulePos[i] = 0;
-            tdmaPos[i] = 0;
+            out << "tile[" << i << "] = (";
+            out << schedulePos[i];
+            out << ", " << tdmaPos[i] << ")" << endl;
         }
     }
 
     /**
-     * operator= ()
-     * The function compares to states and returns true if they are equal.
+     * clear ()
+     * The function sets the state to zero.
      */
-    bool SDFstateSpaceListScheduler::TransitionSystem::State::operator==(
-        const State &s)
+    void SDFstateSpaceListScheduler::TransitionSystem::State
+    ::clear()
     {
-        if (glbClk != s.glbClk)
-            return false;
+        SDFstateSpaceState::clear();
 
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            if (ch[i] != s.ch[i])
-                return false;
-        }
-
-        for (uint i = 0; i < actClk.size(); i++)
+        for (uint i = 0; i < schedulePos.size(); i++)
         {
-            if (actClk[i] != s.actClk[i])
-                return false;
+            schedulePos[i] = 0;
+            tdmaPos[i] = 0;
         }
-
-        return true;
     }
 
     /**
-     * print ()
-     * Print the state to the supplied stream.
+     * pack ()
+     * The function packs the state into a sequence of words. The schedules are
+     * constructed during the exploration, so the schedule and TDMA wheel
+     * positions are not part of the packed state.
      */
-    void SDFstateSpaceListScheduler::TransitionSystem::State::print(ostream &out)
+    void SDFstateSpaceListScheduler::TransitionSystem::State
+    ::pack(vector<SDFstateWord> &s) const
     {
-        out << "### State ###" << endl;
-
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            out << "actClk[" << i << "] =";
-
-            for (list<SDFtime>::const_iterator iter = actClk[i].begin();
-                 iter != actClk[i].end(); iter++)
-            {
-                out << " " << (*iter) << ", ";
-            }
-
-            out << endl;
-        }
-
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            out << "ch[" << i << "] = " << ch[i] << endl;
-        }
-
-        out << "glbClk = " << glbClk << endl;
-
-        for (uint i = 0; i < schedulePos.size(); i++)
-        {
-            out << "tile[" << i << "] = (";
-            out << schedulePos[i];
-            out << ", " << tdmaPos[i] << ")" << endl;
-        }
+        SDFstateSpaceState::pack(s);
     }
 
     /******************************************************************************
@@ -142,73 +115,36 @@ namespace SDF
      */
     void SDFstateSpaceListScheduler::TransitionSystem::initOutputActor()
     {
-        RepetitionVector repVec;
+        const RepetitionVector &repVec = g.getRepetitionVector();
         int min = INT_MAX;
-        SDFactor *a = NULL;
-
-        // Compute repetition vector
-        repVec = computeRepetitionVector(bindingAwareSDFG);
 
         // Select actor with lowest entry in repetition vector as output actor
-        for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-             iter != bindingAwareSDFG->actorsEnd(); iter++)
+        for (CId a = 0; a < g.nrActors(); a++)
         {
-            if (repVec[(*iter)->getId()] < min)
+            if (repVec[a] < min)
             {
-                a = *iter;
-                min = repVec[a->getId()];
+                outputActor = a;
+                min = repVec[a];
             }
         }
 
-        // Set output actor and its repetition vector count
-        outputActor = a;
-        outputActorRepCnt = repVec[outputActor->getId()];
+        // Set output actor repetition vector count
+        outputActorRepCnt = repVec[outputActor];
     }
 
     /**
      * initStaticOrderSchedules ()
-     * The function assigns empty static-order schedules to the processors.
+     * The function assigns empty static-order schedules to the processors and
+     * records the tile to which every actor is bound.
      */
     void SDFstateSpaceListScheduler::TransitionSystem::initStaticOrderSchedules()
     {
-        StaticOrderSchedule s;
-
         for (uint t = 0; t < bindingAwareSDFG->nrTilesInPlatformGraph(); t++)
             bindingAwareSDFG->getScheduleOnTile(t).clear();
-    }
-
-    /**
-     * storeState ()
-     * The function stores the state s on whenever s is not already in the
-     * list of storedStates. When s is stored, the function returns true. When the
-     * state s is already in the list, the state s is not stored. The function
-     * returns false. The function always sets the pos variable to the position
-     * where the state s is in the list.
-     */
-    bool SDFstateSpaceListScheduler::TransitionSystem::storeState(State &s,
-            StatesIter &pos)
-    {
-        // Find state in the list of stored states
-        for (StatesIter iter = storedStates.begin();
-             iter != storedStates.end(); iter++)
-        {
-            State &x = *iter;
-
-            // State s at position iter in the list?
-            if (x == s)
-            {
-                pos = iter;
-                return false;
-            }
-        }
-
-        // State not found, store it at the end of the list
-        storedStates.push_back(s);
-
-        // Added state to the end of the list
-        pos = storedStates.end();
 
-        return true;
+        actorTile.assign(g.nrActors(), ACTOR_NOT_BOUND);
+        for (CId a = 0; a < g.nrActors(); a++)
+            actorTile[a] = bindingAwareSDFG->getBindingOfActorToTile(g.getActor(a));
     }
 
     /**
@@ -217,22 +153,20 @@ namespace SDF
      * value is equal to the average number of firings of an actor per time unit.
      */
     TDtime SDFstateSpaceListScheduler::TransitionSystem::computeThroughput(
-        const StatesIter cycleIter)
+        const uint cycleIdx)
     {
         int nr_fire = 0;
         TDtime time = 0;
 
         // Check all state from stack till cycle complete
-        for (StatesIter iter = cycleIter; iter != storedStates.end(); iter++)
+        for (uint i = cycleIdx; i < storedStates.size(); i++)
         {
-            State &s = *iter;
-
             // Number of states in cycle is equal to number of iterations
             // in the period
             nr_fire++;
 
             // Time between previous state
-            time += s.glbClk;
+            time += storedStates.glbClk(i);
         }
 
         return (TDtime)(nr_fire) / (time);
@@ -247,8 +181,6 @@ namespace SDF
 #define SOS_POS(p)          currentState.schedulePos[p]
 
 #define SOS(p)              (bindingAwareSDFG->getScheduleOnTile(p))
-#define SOS_ENTRY(p)        (SOS(p).getScheduleEntry(SOS_POS(p)))
-#define SOS_NEXT_POS(p)     (SOS(p).next(SOS_POS(p)))
 
 #define CH_TOKENS(c,n)      (CH(c) >= n)
 #define CONSUME(c,n)        CH(c) = CH(c) - n;
@@ -261,35 +193,27 @@ namespace SDF
      * The function returns true when the actor is ready to fire in state
      * s. Else it returns false.
      */
-    bool SDFstateSpaceListScheduler::TransitionSystem::actorReadyToFire(SDFactor *a)
+    bool SDFstateSpaceListScheduler::TransitionSystem::actorReadyToFire(const CId a)
     {
         // Actor bound to processor?
-        if (bindingAwareSDFG->getBindingOfActorToTile(a) != ACTOR_NOT_BOUND)
+        if (actorTile[a] != ACTOR_NOT_BOUND)
         {
-            uint p = bindingAwareSDFG->getBindingOfActorToTile(a);
+            uint p = actorTile[a];
 
             // Processor is not idle or actor is not first in readyList?
             if (!procIdle[p] || actorReadyList[p].empty()
-                || actorReadyList[p].front()->getId() != a->getId())
+                || actorReadyList[p].front() != a)
             {
                 return false;
             }
         }
 
         // Check all input ports for tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = g.inPortsBegin(a);
+             p != g.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                if (!CH_TOKENS(c->getId(), p->getRate()))
-                {
-                    return false;
-                }
-            }
+            if (!CH_TOKENS(p->channel, p->rate))
+                return false;
         }
 
         return true;
@@ -302,35 +226,29 @@ namespace SDF
      * position.
      */
     void SDFstateSpaceListScheduler::TransitionSystem::startActorFiring(
-        TimedSDFactor *a)
+        const CId a)
     {
         SDFtime execTime, completionTime, timeTileStartOfSlice, waitingTime;
         int remainingExecTime, nrOfFullRotationsInNonReservedPart;
 
-        // Consume tokens from inputs and space for output tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        // Consume tokens from inputs
+        for (const TimedSDFcompiledGraph::Port *p = g.inPortsBegin(a);
+             p != g.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                CONSUME(c->getId(), p->getRate());
-            }
+            CONSUME(p->channel, p->rate);
         }
 
         // Execution time of the actor
-        execTime = a->getExecutionTime();
+        execTime = g.getExecutionTime(a);
 
         // Compute time needed to complete actor firing
-        if (bindingAwareSDFG->getBindingOfActorToTile(a) == ACTOR_NOT_BOUND)
+        if (actorTile[a] == ACTOR_NOT_BOUND)
         {
             completionTime = execTime;
         }
         else
         {
-            uint p = bindingAwareSDFG->getBindingOfActorToTile(a);
+            uint p = actorTile[a];
 
             // Time wheel has not yet reached start of slice?
             if (currentState.tdmaPos[p]
@@ -381,14 +299,14 @@ namespace SDF
             actorReadyList[p].pop_front();
 
             // Add actor to schedule of the processor
-            bindingAwareSDFG->getScheduleOnTile(p).appendActor(a);
+            bindingAwareSDFG->getScheduleOnTile(p).appendActor(g.getActor(a));
 
             // Store last point of schedule in the state
             SOS_POS(p) = bindingAwareSDFG->getScheduleOnTile(p).size() - 1;
         }
 
         // Add actor firing to the list of active firings of this actor
-        currentState.actClk[a->getId()].push_back(completionTime);
+        currentState.startFiring(a, completionTime);
     }
 
     /**
@@ -396,16 +314,10 @@ namespace SDF
      * The function returns true when the actor is ready to end its firing. Else
      * the function returns false.
      */
-    bool SDFstateSpaceListScheduler::TransitionSystem::actorReadyToEnd(SDFactor *a)
+    bool SDFstateSpaceListScheduler::TransitionSystem::actorReadyToEnd(const CId a)
     {
-        if (currentState.actClk[a->getId()].empty())
-            return false;
-
-        // First actor firing in sorted list has execution time left?
-        if (currentState.actClk[a->getId()].front() != 0)
-            return false;
-
-        return true;
+        // First actor firing in sorted list has no execution time left?
+        return currentState.readyToEnd(a);
     }
 
     /**
@@ -413,27 +325,21 @@ namespace SDF
      * Produce tokens on all output channels and remove the actor firing from the
      * list of active firings.
      */
-    void SDFstateSpaceListScheduler::TransitionSystem::endActorFiring(SDFactor *a)
+    void SDFstateSpaceListScheduler::TransitionSystem::endActorFiring(const CId a)
     {
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = g.outPortsBegin(a);
+             p != g.outPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is source of the channel?
-            if (p->getType() == SDFport::Out)
-            {
-                PRODUCE(c->getId(), p->getRate());
-            }
+            PRODUCE(p->channel, p->rate);
         }
 
         // Remove the firing from the list of active actor firings
-        currentState.actClk[a->getId()].pop_front();
+        currentState.endFiring(a);
 
         // Actor bound to processor?
-        if (bindingAwareSDFG->getBindingOfActorToTile(a) != ACTOR_NOT_BOUND)
+        if (actorTile[a] != ACTOR_NOT_BOUND)
         {
-            uint p = bindingAwareSDFG->getBindingOfActorToTile(a);
+            uint p = actorTile[a];
 
             // Processor becomes idle
             procIdle[p] = true;
@@ -448,40 +354,14 @@ namespace SDF
      */
     SDFtime SDFstateSpaceListScheduler::TransitionSystem::clockStep()
     {
-        SDFtime step = UINT_MAX;
+        SDFtime step;
 
-        // Find maximal time progress
-        for (uint a = 0; a < bindingAwareSDFG->nrActors(); a++)
-        {
-            if (!currentState.actClk[a].empty())
-            {
-                SDFtime actClk = currentState.actClk[a].front();
-
-                if (step > actClk)
-                    step = actClk;
-            }
-        }
+        // Progress time till the first firing ends
+        step = currentState.clockStep();
 
-        // Still actors ready to end their firing?
-        if (step == 0)
-            return 0;
-
-        // Check for progress (i.e. no deadlock)
-        if (step == UINT_MAX)
-            return UINT_MAX;
-
-        // Lower remaining execution time actors
-        for (uint a = 0; a < bindingAwareSDFG->nrActors(); a++)
-        {
-            for (list<SDFtime>::iterator iter = currentState.actClk[a].begin();
-                 iter != currentState.actClk[a].end(); iter++)
-            {
-                SDFtime &actFiringTime = *iter;
-
-                // Lower remaining execution time of the actor firing
-                actFiringTime -= step;
-            }
-        }
+        // Still actors ready to end their firing or deadlock?
+        if (step == 0 || step == UINT_MAX)
+            return step;
 
         // Advance the time wheels
         for (uint t = 0; t < bindingAwareSDFG->nrTilesInPlatformGraph(); t++)
@@ -490,25 +370,30 @@ namespace SDF
                                       % bindingAwareSDFG->getTDMAsizeOnTile(t);
         }
 
-        // Advance the global clock
-        currentState.glbClk += step;
-
         return step;
     }
 
     /**
      * execSDFgraph()
      * Execute the SDF graph till a deadlock is found or a recurrent state.
-     * The throughput is returned.
+     * The throughput is returned. Only the actors whose firing ends at the
+     * current time are visited to end their firings. Only the consumers of
+     * the channels to which these actors produced tokens can get new firings
+     * in the actorReadyList and only these consumers and the first actors in
+     * the actorReadyList of the idle processors are checked for enabling.
      */
     TDtime SDFstateSpaceListScheduler::TransitionSystem::execSDFgraph()
     {
-        StatesIter recurrentState;
+        uint recurrentState;
         SDFtime clkStep;
         int repCnt = 0;
+        vector<CId> endingActors;
+        vector<CId> candidates;
+        vector<bool> isCandidate(g.nrActors(), true);
 
         // Clear the list of stored states
         clearStoredStates();
+        storedSchedulePos.clear();
 
         // Initialize processor states
         actorReadyList.resize(bindingAwareSDFG->nrTilesInPlatformGraph());
@@ -520,47 +405,44 @@ namespace SDF
         }
 
         // Create initial state
-        currentState.init(bindingAwareSDFG->nrActors(),
-                          bindingAwareSDFG->nrChannels(),
+        currentState.init(g.nrActors(), g.nrChannels(),
                           bindingAwareSDFG->nrTilesInPlatformGraph());
         currentState.clear();
-        previousState.init(bindingAwareSDFG->nrActors(),
-                           bindingAwareSDFG->nrChannels(),
+        previousState.init(g.nrActors(), g.nrChannels(),
                            bindingAwareSDFG->nrTilesInPlatformGraph());
         previousState.clear();
 
         // Initial tokens and schedules
-        for (SDFchannelsIter iter = bindingAwareSDFG->channelsBegin();
-             iter != bindingAwareSDFG->channelsEnd(); iter++)
-        {
-            SDFchannel *c = *iter;
-
-            CH(c->getId()) = c->getInitialTokens();
-        }
+        for (CId c = 0; c < g.nrChannels(); c++)
+            CH(c) = g.getInitialTokens(c);
         for (uint p = 0; p < bindingAwareSDFG->nrTilesInPlatformGraph(); p++)
         {
             SOS_POS(p) = 0;
             TDMA_POS(p) = 0;
         }
 
+        // Initially all actors may be enabled
+        for (CId a = 0; a < g.nrActors(); a++)
+            candidates.push_back(a);
+
         // Fire the actors
         while (true)
         {
             // Finish actor firings
-            for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-                 iter != bindingAwareSDFG->actorsEnd(); iter++)
+            currentState.actorsReadyToEnd(endingActors);
+            for (uint i = 0; i < endingActors.size(); i++)
             {
-                SDFactor *a = *iter;
+                CId a = endingActors[i];
 
                 while (actorReadyToEnd(a))
                 {
-                    if (outputActor->getId() == a->getId())
+                    if (outputActor == a)
                     {
                         repCnt++;
                         if (repCnt == outputActorRepCnt)
                         {
                             // Add state to hash of visited states
-                            if (!storeState(currentState, recurrentState))
+                            if (!storedStates.store(currentState, recurrentState))
                             {
                                 // Complete cycle in each processor schedule
                                 for (uint p = 0;
@@ -573,20 +455,24 @@ namespace SDF
                                         // on the one before the last must loop-back
                                         // to the schedule position in recurrent
                                         // state.
-                                        SOS(p).erase(--SOS(p).end());
+                                        SOS(p).removeLastActor();
                                         SOS(p).setStartPeriodicSchedule(
-                                            recurrentState->schedulePos[p]);
+                                            storedSchedulePos[recurrentState][p]);
                                     }
                                     else if (SOS(p).size() == 1)
                                     {
                                         // Single state schedule
                                         SOS(p).setStartPeriodicSchedule(0);
                                     }
+
+                                    // Replace repetitions by loops
+                                    SOS(p).compress();
                                 }
 
                                 // Done
                                 return computeThroughput(recurrentState);
                             }
+                            storedSchedulePos.push_back(currentState.schedulePos);
                             currentState.glbClk = 0;
                             repCnt = 0;
                         }
@@ -595,41 +481,47 @@ namespace SDF
                     // End the actor firing
                     endActorFiring(a);
                 }
+
+                // Consumers of the produced tokens may have become enabled
+                for (const CId *b = g.consumersBegin(a);
+                     b != g.consumersEnd(a); b++)
+                {
+                    if (!isCandidate[*b])
+                    {
+                        isCandidate[*b] = true;
+                        candidates.push_back(*b);
+                    }
+                }
             }
 
             // Update the actorReadyList with all firings that became enabled
-            // after last clock step
-            for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-                 iter != bindingAwareSDFG->actorsEnd(); iter++)
+            // after last clock step (in order of the actor ids)
+            std::sort(candidates.begin(), candidates.end());
+            for (uint i = 0; i < candidates.size(); i++)
             {
-                TimedSDFactor *a = (TimedSDFactor *)(*iter);
+                CId a = candidates[i];
 
-                if (bindingAwareSDFG->getBindingOfActorToTile(a) != ACTOR_NOT_BOUND)
+                if (actorTile[a] != ACTOR_NOT_BOUND)
                 {
-                    uint t = bindingAwareSDFG->getBindingOfActorToTile(a);
+                    uint t = actorTile[a];
                     uint nrFiringsCurrent = INT_MAX;
                     uint nrFiringsPrevious = INT_MAX;
                     uint nrFiringsEnabled;
 
                     // Compute number of enabled firings in current
                     // and previous state
-                    for (SDFportsIter iterP = a->portsBegin();
-                         iterP != a->portsEnd(); iterP++)
+                    for (const TimedSDFcompiledGraph::Port *p = g.inPortsBegin(a);
+                         p != g.inPortsEnd(a); p++)
                     {
-                        SDFport *p = *iterP;
-                        SDFchannel *c = p->getChannel();
                         uint nrCurrent, nrPrevious;
 
-                        if (p->getType() == SDFport::In)
-                        {
-                            nrCurrent = currentState.ch[c->getId()] / p->getRate();
-                            nrPrevious = previousState.ch[c->getId()] / p->getRate();
+                        nrCurrent = currentState.ch[p->channel] / p->rate;
+                        nrPrevious = previousState.ch[p->channel] / p->rate;
 
-                            if (nrCurrent < nrFiringsCurrent)
-                                nrFiringsCurrent = nrCurrent;
-                            if (nrPrevious < nrFiringsPrevious)
-                                nrFiringsPrevious = nrPrevious;
-                        }
+                        if (nrCurrent < nrFiringsCurrent)
+                            nrFiringsCurrent = nrCurrent;
+                        if (nrPrevious < nrFiringsPrevious)
+                            nrFiringsPrevious = nrPrevious;
                     }
 
                     if (nrFiringsCurrent <= nrFiringsPrevious)
@@ -638,16 +530,30 @@ namespace SDF
                         nrFiringsEnabled = nrFiringsCurrent - nrFiringsPrevious;
 
                     // Add as many firings to the actorReadyList as became enabled
-                    for (uint i = 0; i < nrFiringsEnabled; i++)
+                    for (uint j = 0; j < nrFiringsEnabled; j++)
                         actorReadyList[t].push_back(a);
                 }
             }
 
+            // First actor in the actorReadyList of an idle processor may fire
+            for (uint t = 0; t < bindingAwareSDFG->nrTilesInPlatformGraph(); t++)
+            {
+                if (procIdle[t] && !actorReadyList[t].empty())
+                {
+                    CId a = actorReadyList[t].front();
+
+                    if (!isCandidate[a])
+                    {
+                        isCandidate[a] = true;
+                        candidates.push_back(a);
+                    }
+                }
+            }
+
             // Start actor firings
-            for (SDFactorsIter iter = bindingAwareSDFG->actorsBegin();
-                 iter != bindingAwareSDFG->actorsEnd(); iter++)
+            for (uint i = 0; i < candidates.size(); i++)
             {
-                TimedSDFactor *a = (TimedSDFactor *)(*iter);
+                CId a = candidates[i];
 
                 // Ready to fire actor a?
                 while (actorReadyToFire(a))
@@ -655,7 +561,10 @@ namespace SDF
                     // Fire actor a
                     startActorFiring(a);
                 }
+
+                isCandidate[a] = false;
             }
+            candidates.clear();
 
             // Clock step
             clkStep = clockStep();
@@ -668,7 +577,7 @@ namespace SDF
             }
 
             // Store partial state to check for progress
-            for (uint i = 0; i < bindingAwareSDFG->nrChannels(); i++)
+            for (uint i = 0; i < g.nrChannels(); i++)
             {
                 previousState.ch[i] = currentState.ch[i];
             }
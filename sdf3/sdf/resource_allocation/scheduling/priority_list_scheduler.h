@@ -13,6 +13,9 @@
  *
  *  History         :
  *      06-03-08    :   Initial version.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
+ *      17-10-26    :   Only visit actors whose firing ends or which may have
+ *                      become enabled.
  *
  * $Id: priority_list_scheduler.h,v 1.1 2008-03-06 10:49:45 sander Exp $
  *
@@ -38,6 +41,8 @@
 #define SDF_RESOURCE_ALLOCATION_SCHEDULING_PRIORITY_LIST_SCHEDULER_H_INCLUDED
 
 #include "../../analysis/analysis.h"
+#include "../../analysis/statespace/state.h"
+#include "../../base/timed/compiled_graph.h"
 namespace SDF
 {
 
@@ -74,7 +79,7 @@ namespace SDF
                     /***********************************************************************
                      * State
                      **********************************************************************/
-                    class State
+                    class State : public SDFstateSpaceState
                     {
                         public:
                             // Constructor
@@ -91,35 +96,31 @@ namespace SDF
                             void init(const uint nrActors, const uint nrChannels,
                                       const uint nrTiles)
                             {
-                                actClk.resize(nrActors);
-                                ch.resize(nrChannels);
+                                SDFstateSpaceState::init(nrActors, nrChannels);
                                 schedulePos.resize(nrTiles);
                                 tdmaPos.resize(nrTiles);
                             };
 
                             // Compare states
-                            bool operator==(const State &s);
+                            bool operator==(const State &s) const;
 
                             // Clear state
                             void clear();
 
                             // Output state
-                            void print(ostream &out);
+                            void print(ostream &out) const;
+
+                            // Pack state into a sequence of words
+                            void pack(vector<SDFstateWord> &s) const;
 
                             // State information
-                            vector< list<SDFtime> > actClk;
-                            vector< TBufSize > ch;
-                            unsigned long glbClk;
                             vector< uint > schedulePos;
                             vector< SDFtime > tdmaPos;
                     };
 
-                    // Sequence of states in transition system
-                    typedef list<State>      States;
-                    typedef States::iterator StatesIter;
-
                     // Constructor
                     TransitionSystem(BindingAwareSDFG *bg)
+                        : g(bg)
                     {
                         bindingAwareSDFG = bg;
                         initOutputActor();
@@ -134,9 +135,6 @@ namespace SDF
                     TDtime execSDFgraph();
 
                 private:
-                    // Store state
-                    bool storeState(State &s, StatesIter &pos);
-
                     // Clear list of stored states
                     void clearStoredStates()
                     {
@@ -144,13 +142,13 @@ namespace SDF
                     };
 
                     // Compute throughput from transition system
-                    TDtime computeThroughput(const StatesIter cycleIter);
+                    TDtime computeThroughput(const uint cycleIdx);
 
                     // State transitions
-                    bool actorReadyToFire(SDFactor *a);
-                    void startActorFiring(TimedSDFactor *a);
-                    bool actorReadyToEnd(SDFactor *a);
-                    void endActorFiring(SDFactor *a);
+                    bool actorReadyToFire(const CId a);
+                    void startActorFiring(const CId a);
+                    bool actorReadyToEnd(const CId a);
+                    void endActorFiring(const CId a);
                     SDFtime clockStep();
 
                     // Output actor
@@ -164,26 +162,36 @@ namespace SDF
                                              const int actor, const int b, int *color, int *pi, int *cnt);
                     void initActorPriorities();
 
-                    // Binding-aware SDFG
+                    // Binding-aware SDFG and its compiled view
                     BindingAwareSDFG *bindingAwareSDFG;
+                    TimedSDFcompiledGraph g;
+
+                    // Tile to which every actor is bound (indexed on id)
+                    vector<CId> actorTile;
 
-                    // SDF graph and output actor
-                    SDFactor *outputActor;
+                    // Output actor
+                    CId outputActor;
                     TCnt outputActorRepCnt;
 
                     // Current and previous state
                     State currentState;
                     State previousState;
 
-                    // List of visited states that are stored
-                    States storedStates;
+                    // Visited states that are stored
+                    SDFvisitedStates<State> storedStates;
+
+                    // Schedule positions of the stored states
+                    vector< vector<uint> > storedSchedulePos;
 
                     // State information for schedulers
-                    vector< SDFactors > actorReadyList;
+                    vector< list<CId> > actorReadyList;
                     vector < bool > procIdle;
 
                     // Actor priorities
-                    SDFactors actorsOnPriority;
+                    vector<CId> actorsOnPriority;
+
+                    // Position of every actor in actorsOnPriority (indexed on id)
+                    vector<uint> actorPriority;
             };
     };
 
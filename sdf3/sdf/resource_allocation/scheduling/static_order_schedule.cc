@@ -12,6 +12,8 @@
  *
  *  History         :
  *      03-03-08    :   Initial version.
+ *      17-10-26    :   Loop-compressed schedule representation.
+ *      17-10-26    :   Schedule stored as a sequence of loops.
  *
  * $Id: static_order_schedule.cc,v 1.2 2008-03-06 13:59:06 sander Exp $
  *
@@ -34,9 +36,696 @@
  */
 
 #include "static_order_schedule.h"
+#include <climits>
 namespace SDF
 {
 
+    /**
+     * nrFirings ()
+     * The function returns the number of actor firings represented by the
+     * loop.
+     */
+    CSize StaticOrderScheduleLoop::nrFirings() const
+    {
+        CSize n = 0;
+
+        if (actor != NULL)
+            return count;
+
+        for (uint i = 0; i < body.size(); i++)
+            n += body[i].nrFirings();
+
+        return n * count;
+    }
+
+    /**
+     * unroll ()
+     * The function appends the actors fired by the loop to the sequence
+     * actors.
+     */
+    void StaticOrderScheduleLoop::unroll(vector<SDFactor *> &actors) const
+    {
+        for (uint i = 0; i < count; i++)
+        {
+            if (actor != NULL)
+            {
+                actors.push_back(actor);
+            }
+            else
+            {
+                for (uint j = 0; j < body.size(); j++)
+                    body[j].unroll(actors);
+            }
+        }
+    }
+
+    /**
+     * changeActorAssociations ()
+     * Change the associated actors in the loop. Actors which do not exist in
+     * the new graph are removed from the loop. The function returns false when
+     * the loop no longer fires any actor.
+     */
+    bool StaticOrderScheduleLoop::changeActorAssociations(SDFgraph *newGraph)
+    {
+        if (actor != NULL)
+        {
+            actor = newGraph->getActor(actor->getName());
+            return actor != NULL;
+        }
+
+        for (uint i = 0; i < body.size();)
+        {
+            if (body[i].changeActorAssociations(newGraph))
+                i++;
+            else
+                body.erase(body.begin() + i);
+        }
+
+        // A loop over a single actor fires this actor
+        if (body.size() == 1 && body[0].actor != NULL)
+        {
+            actor = body[0].actor;
+            count = count * body[0].count;
+            body.clear();
+        }
+
+        return actor != NULL || !body.empty();
+    }
+
+    /**
+     * convertToXML ()
+     * Convert the loop to an XML representation. A loop which fires an actor
+     * becomes a state node (with a count attribute when the actor is fired
+     * more than once), a loop with a body becomes a loop node.
+     */
+    CNode *StaticOrderScheduleLoop::convertToXML() const
+    {
+        CNode *loopNode;
+
+        if (actor != NULL)
+        {
+            loopNode = CNewNode("state");
+            CAddAttribute(loopNode, "actor", actor->getName());
+        }
+        else
+        {
+            loopNode = CNewNode("loop");
+            for (uint i = 0; i < body.size(); i++)
+                CAddNode(loopNode, body[i].convertToXML());
+        }
+
+        if (count != 1)
+            CAddAttribute(loopNode, "count", CString(count));
+
+        return loopNode;
+    }
+
+    /**
+     * constructFromXML ()
+     * Construct the loop from a state or loop node. The count of a loop must
+     * be a positive integer and the body of a loop may not be empty.
+     */
+    void StaticOrderScheduleLoop::constructFromXML(SDFgraph *g, CNode *loopNode)
+    {
+        count = 1;
+        if (CHasAttribute(loopNode, "count"))
+        {
+            long long c = CGetAttribute(loopNode, "count");
+            if (c < 1 || c > UINT_MAX)
+                throw CException("[ERROR] count of loop in schedule must be "
+                                 "a positive integer.");
+            count = (uint)c;
+        }
+
+        if (CIsNode(loopNode, "state"))
+        {
+            actor = g->getActor(CGetAttribute(loopNode, "actor"));
+            if (actor == NULL)
+                throw CException("[ERROR] actor in schedule does not exist.");
+            return;
+        }
+
+        actor = NULL;
+        for (CNode *n = CGetChildNode(loopNode); n != NULL; n = CNextNode(n))
+        {
+            if (CIsNode(n, "state") || CIsNode(n, "loop"))
+            {
+                body.push_back(StaticOrderScheduleLoop());
+                body.back().constructFromXML(g, n);
+            }
+        }
+
+        if (body.empty())
+            throw CException("[ERROR] loop in schedule has an empty body.");
+    }
+
+    /**
+     * StaticOrderScheduleLoopKeys
+     * Identical loops are assigned the same id, which makes comparing
+     * (sequences of) loops cheap. A loop is identified by its count and either
+     * the id of its actor or the id of the sequence of loops in its body.
+     */
+    class StaticOrderScheduleLoopKeys
+    {
+        public:
+            // Id of the loop with given count and actor (payload >= 0) or
+            // body sequence (payload = -1 - sequence id)
+            uint getLoopId(const uint count, const long long payload)
+            {
+                pair<uint, long long> key(count, payload);
+                map<pair<uint, long long>, uint>::iterator iter;
+
+                iter = loopIds.find(key);
+                if (iter != loopIds.end())
+                    return iter->second;
+
+                loopIds[key] = keys.size();
+                keys.push_back(key);
+                return keys.size() - 1;
+            };
+
+            // Id of a sequence of loops
+            long long getSequenceId(const vector<uint> &seq)
+            {
+                map<vector<uint>, long long>::iterator iter;
+
+                iter = sequenceIds.find(seq);
+                if (iter != sequenceIds.end())
+                    return iter->second;
+
+                long long id = sequenceIds.size();
+                sequenceIds[seq] = id;
+                return id;
+            };
+
+            // Payload of the loop with the given id
+            long long getPayload(const uint id) const
+            {
+                return keys[id].second;
+            };
+
+        private:
+            map<pair<uint, long long>, uint> loopIds;
+            map<vector<uint>, long long> sequenceIds;
+            vector< pair<uint, long long> > keys;
+    };
+
+    /**
+     * compressLoops ()
+     * The function replaces adjacent repetitions of a subsequence of loops by
+     * a single loop which iterates over this subsequence. A candidate
+     * subsequence starts at a loop and ends right before the next occurrence
+     * of the same loop. Each pass replaces (from left to right) all repeated
+     * candidates with the shortest length found in the sequence, so inner
+     * loops are formed before the loops around them. Passes are repeated till
+     * no repetition is left. The vector ids contains the id of each loop.
+     */
+    static void compressLoops(StaticOrderScheduleLoops &loops, vector<uint> &ids,
+                              StaticOrderScheduleLoopKeys &keys)
+    {
+        while (true)
+        {
+            StaticOrderScheduleLoops newLoops;
+            vector<uint> newIds;
+            vector<uint> length(ids.size(), UINT_MAX);
+            map<uint, uint> nextOccurrence;
+            uint minLength = UINT_MAX;
+            uint i = 0;
+
+            // Length of the repeated candidate subsequence at each position
+            for (uint j = ids.size(); j > 0; j--)
+            {
+                map<uint, uint>::iterator iter = nextOccurrence.find(ids[j - 1]);
+
+                if (iter != nextOccurrence.end())
+                {
+                    uint len = iter->second - (j - 1);
+
+                    if (iter->second + len <= ids.size()
+                        && equal(ids.begin() + j - 1, ids.begin() + iter->second,
+                                 ids.begin() + iter->second))
+                    {
+                        length[j - 1] = len;
+                        if (len < minLength)
+                            minLength = len;
+                    }
+                }
+                nextOccurrence[ids[j - 1]] = j - 1;
+            }
+
+            // No repetition left?
+            if (minLength == UINT_MAX)
+                break;
+
+            while (i < ids.size())
+            {
+                uint len = length[i];
+                uint k = 2;
+
+                // No repetition of the shortest length at this position?
+                if (len != minLength)
+                {
+                    newLoops.push_back(loops[i]);
+                    newIds.push_back(ids[i]);
+                    i++;
+                    continue;
+                }
+
+                // Count the repetitions of the subsequence [i, i + len)
+                while (i + (k + 1) * len <= ids.size()
+                       && equal(ids.begin() + i, ids.begin() + i + len,
+                                ids.begin() + i + k * len))
+                {
+                    k++;
+                }
+
+                if (len == 1)
+                {
+                    // (k (n X)) is equal to (k*n X)
+                    newLoops.push_back(loops[i]);
+                    newLoops.back().count *= k;
+                    newIds.push_back(keys.getLoopId(newLoops.back().count,
+                                                    keys.getPayload(ids[i])));
+                }
+                else
+                {
+                    // (k X Y ...)
+                    StaticOrderScheduleLoop l(NULL, k);
+                    vector<uint> bodyIds(ids.begin() + i,
+                                         ids.begin() + i + len);
+
+                    l.body.insert(l.body.end(), loops.begin() + i,
+                                  loops.begin() + i + len);
+                    newLoops.push_back(l);
+                    newIds.push_back(keys.getLoopId(k,
+                                                    -1 - keys.getSequenceId(bodyIds)));
+                }
+
+                i += k * len;
+            }
+
+            loops.swap(newLoops);
+            ids.swap(newIds);
+        }
+    }
+
+    /**
+     * getLoopId ()
+     * The function returns the id of loop l.
+     */
+    static uint getLoopId(const StaticOrderScheduleLoop &l,
+                          StaticOrderScheduleLoopKeys &keys)
+    {
+        vector<uint> bodyIds;
+
+        if (l.actor != NULL)
+            return keys.getLoopId(l.count, l.actor->getId());
+
+        for (uint i = 0; i < l.body.size(); i++)
+            bodyIds.push_back(getLoopId(l.body[i], keys));
+
+        return keys.getLoopId(l.count, -1 - keys.getSequenceId(bodyIds));
+    }
+
+    /**
+     * compressSequence ()
+     * The function merges adjacent loops which fire the same actor and then
+     * replaces adjacent repetitions of a subsequence of loops by a single loop
+     * (see compressLoops).
+     */
+    static void compressSequence(StaticOrderScheduleLoops &loops,
+                                 StaticOrderScheduleLoopKeys &keys)
+    {
+        StaticOrderScheduleLoops merged;
+        vector<uint> ids;
+
+        for (uint i = 0; i < loops.size(); i++)
+        {
+            if (!merged.empty() && merged.back().actor != NULL
+                && merged.back().actor == loops[i].actor)
+            {
+                merged.back().count += loops[i].count;
+            }
+            else
+            {
+                merged.push_back(loops[i]);
+            }
+        }
+
+        for (uint i = 0; i < merged.size(); i++)
+            ids.push_back(getLoopId(merged[i], keys));
+
+        compressLoops(merged, ids, keys);
+        loops.swap(merged);
+    }
+
+    /**
+     * insertActorBefore ()
+     * The function inserts actor a directly before every firing of actor b in
+     * the sequence of loops. The function returns the number of loops that
+     * are inserted into the sequence in front of position pos.
+     */
+    static uint insertActorBefore(StaticOrderScheduleLoops &loops,
+                                  const SDFactor *b, SDFactor *a,
+                                  const uint pos = UINT_MAX)
+    {
+        uint nrInserted = 0;
+
+        for (uint i = 0; i < loops.size(); i++)
+        {
+            StaticOrderScheduleLoop &l = loops[i];
+
+            if (l.actor == NULL)
+            {
+                insertActorBefore(l.body, b, a);
+            }
+            else if (l.actor->getId() == b->getId())
+            {
+                if (l.count == 1)
+                {
+                    // (1 B) becomes (1 A) (1 B) (i - nrInserted is the
+                    // index of the loop before any insertion)
+                    if (i - nrInserted < pos)
+                        nrInserted++;
+                    loops.insert(loops.begin() + i, StaticOrderScheduleLoop(a));
+                    i++;
+                }
+                else
+                {
+                    // (n B) becomes (n A B)
+                    StaticOrderScheduleLoop body(l.actor);
+
+                    l.actor = NULL;
+                    l.body.push_back(StaticOrderScheduleLoop(a));
+                    l.body.push_back(body);
+                }
+            }
+        }
+
+        return nrInserted;
+    }
+
+    /**
+     * nextInSchedule ()
+     * The function returns the index of the next entry in an unrolled
+     * schedule of the given size which loops back to index start.
+     */
+    static uint nextInSchedule(const uint current, const uint size,
+                               const uint start)
+    {
+        if (current + 1 == size)
+            return start;
+
+        return current + 1;
+    }
+
+    /**
+     * previousInSchedule ()
+     * The function returns the index of the previous entry in an unrolled
+     * schedule (UINT_MAX before the first entry).
+     */
+    static uint previousInSchedule(const uint current)
+    {
+        if (current == 0)
+            return UINT_MAX;
+
+        return current - 1;
+    }
+
+    /**
+     * appendActor ()
+     * The function appends a firing of actor a to the schedule. A firing of
+     * the actor fired by the last loop of the schedule is added to this loop
+     * (unless the periodic regime starts with the next loop).
+     */
+    void StaticOrderSchedule::appendActor(SDFactor *a)
+    {
+        if (!loops.empty() && loops.back().actor == a
+            && startPeriodicLoop != loops.size())
+        {
+            loops.back().count++;
+        }
+        else
+        {
+            loops.push_back(StaticOrderScheduleLoop(a));
+        }
+
+        nrFiringsInSchedule++;
+    }
+
+    /**
+     * appendLoop ()
+     * The function appends loop l to the schedule.
+     */
+    void StaticOrderSchedule::appendLoop(const StaticOrderScheduleLoop &l)
+    {
+        loops.push_back(l);
+        nrFiringsInSchedule += l.nrFirings();
+    }
+
+    /**
+     * removeLastActor ()
+     * The function removes the last actor firing from the schedule. The last
+     * loop of the schedule must fire a single actor.
+     */
+    void StaticOrderSchedule::removeLastActor()
+    {
+        ASSERT(!loops.empty() && loops.back().actor != NULL,
+               "Last loop in the schedule does not fire an actor.");
+
+        loops.back().count--;
+        if (loops.back().count == 0)
+            loops.pop_back();
+
+        nrFiringsInSchedule--;
+    }
+
+    /**
+     * insertActorBefore ()
+     * The function inserts actor a directly before every firing of actor b.
+     * When b is the first actor of the periodic regime, a becomes the first
+     * actor of the periodic regime.
+     */
+    void StaticOrderSchedule::insertActorBefore(const SDFactor *b, SDFactor *a)
+    {
+        uint nrInserted;
+
+        nrInserted = SDF::insertActorBefore(loops, b, a, startPeriodicLoop);
+        if (startPeriodicLoop != UINT_MAX)
+            startPeriodicLoop += nrInserted;
+
+        updateNrFirings();
+    }
+
+    /**
+     * setStartPeriodicSchedule ()
+     * The function sets the start of the periodic regime to the firing with
+     * index i in the unrolled schedule. A loop which contains this firing is
+     * split such that the periodic regime starts with a loop. The index is
+     * equal to the size of the schedule when the periodic regime starts with
+     * the next loop appended to the schedule.
+     */
+    void StaticOrderSchedule::setStartPeriodicSchedule(const uint i)
+    {
+        CSize first = 0;
+
+        // No periodic regime?
+        if (i == UINT_MAX)
+        {
+            startPeriodicSchedule = UINT_MAX;
+            startPeriodicLoop = UINT_MAX;
+            return;
+        }
+
+        for (uint l = 0; l < loops.size(); l++)
+        {
+            CSize n = loops[l].nrFirings();
+
+            // Firing i inside loop l?
+            if (i < first + n)
+            {
+                if (i != first)
+                {
+                    // Split the loop after the iterations before firing i
+                    StaticOrderScheduleLoop tail = loops[l];
+                    CSize nrFiringsPerIteration = n / tail.count;
+
+                    if ((i - first) % nrFiringsPerIteration != 0)
+                    {
+                        throw CException("[ERROR] start of periodic regime "
+                                         "inside the body of a loop.");
+                    }
+
+                    loops[l].count = (i - first) / nrFiringsPerIteration;
+                    tail.count = tail.count - loops[l].count;
+                    loops.insert(loops.begin() + l + 1, tail);
+                    l++;
+                }
+
+                startPeriodicSchedule = i;
+                startPeriodicLoop = l;
+                return;
+            }
+
+            first += n;
+        }
+
+        // Periodic regime starts with the next loop
+        startPeriodicSchedule = nrFiringsInSchedule;
+        startPeriodicLoop = loops.size();
+    }
+
+    /**
+     * updateNrFirings ()
+     * The function recomputes the number of firings in the schedule and the
+     * index of the start of the periodic regime in the unrolled schedule.
+     */
+    void StaticOrderSchedule::updateNrFirings()
+    {
+        nrFiringsInSchedule = 0;
+        startPeriodicSchedule = UINT_MAX;
+
+        for (uint l = 0; l < loops.size(); l++)
+        {
+            if (l == startPeriodicLoop)
+                startPeriodicSchedule = nrFiringsInSchedule;
+
+            nrFiringsInSchedule += loops[l].nrFirings();
+        }
+
+        if (startPeriodicLoop != UINT_MAX && startPeriodicLoop >= loops.size())
+        {
+            startPeriodicSchedule = nrFiringsInSchedule;
+            startPeriodicLoop = loops.size();
+        }
+    }
+
+    /**
+     * firstActorInLoop ()
+     * The function adds loop counters to position p till the innermost
+     * counter refers to a loop which fires an actor.
+     */
+    void StaticOrderSchedule::firstActorInLoop(
+        StaticOrderSchedulePosition &p) const
+    {
+        const StaticOrderScheduleLoop *l = &loops[p.counters[0].loop];
+        StaticOrderSchedulePosition::Counter c = { 0, 0 };
+
+        for (uint d = 1; d < p.counters.size(); d++)
+            l = &l->body[p.counters[d].loop];
+
+        while (l->actor == NULL)
+        {
+            p.counters.push_back(c);
+            l = &l->body[0];
+        }
+    }
+
+    /**
+     * initPosition ()
+     * The function sets position p to the first firing of the schedule.
+     */
+    void StaticOrderSchedule::initPosition(StaticOrderSchedulePosition &p) const
+    {
+        StaticOrderSchedulePosition::Counter c = { 0, 0 };
+
+        p.index = 0;
+        p.counters.clear();
+
+        if (loops.empty())
+            return;
+
+        p.counters.push_back(c);
+        firstActorInLoop(p);
+    }
+
+    /**
+     * getActor ()
+     * The function returns the actor fired at position p (NULL when the
+     * position is beyond the end of a schedule without periodic regime).
+     */
+    SDFactor *StaticOrderSchedule::getActor(
+        const StaticOrderSchedulePosition &p) const
+    {
+        const StaticOrderScheduleLoop *l;
+
+        if (p.counters.empty())
+            return NULL;
+
+        l = &loops[p.counters[0].loop];
+        for (uint d = 1; d < p.counters.size(); d++)
+            l = &l->body[p.counters[d].loop];
+
+        return l->actor;
+    }
+
+    /**
+     * nextPosition ()
+     * The function advances position p to the next firing in the schedule.
+     * The innermost loop which has iterations left is advanced; a completed
+     * loop continues with the next loop in its sequence. After the last loop
+     * of the schedule, the position loops back to the start of the periodic
+     * regime.
+     */
+    void StaticOrderSchedule::nextPosition(StaticOrderSchedulePosition &p) const
+    {
+        while (!p.counters.empty())
+        {
+            const StaticOrderScheduleLoops *seq = &loops;
+            const StaticOrderScheduleLoop *l;
+            uint d = p.counters.size() - 1;
+
+            for (uint i = 0; i < d; i++)
+                seq = &(*seq)[p.counters[i].loop].body;
+            l = &(*seq)[p.counters[d].loop];
+
+            // Next iteration of the loop?
+            p.counters[d].iteration++;
+            if (p.counters[d].iteration < l->count)
+            {
+                if (l->actor == NULL)
+                    firstActorInLoop(p);
+                p.index++;
+                return;
+            }
+
+            // Next loop in the sequence?
+            if (p.counters[d].loop + 1 < seq->size())
+            {
+                p.counters[d].loop++;
+                p.counters[d].iteration = 0;
+                firstActorInLoop(p);
+                p.index++;
+                return;
+            }
+
+            // Loop completed
+            p.counters.pop_back();
+        }
+
+        // Loop-back to the start of the periodic regime
+        if (startPeriodicLoop >= loops.size())
+        {
+            p.index = UINT_MAX;
+            return;
+        }
+
+        StaticOrderSchedulePosition::Counter c = { startPeriodicLoop, 0 };
+        p.counters.push_back(c);
+        firstActorInLoop(p);
+        p.index = startPeriodicSchedule;
+    }
+
+    /**
+     * unroll ()
+     * The function returns the actors fired in the unrolled schedule.
+     */
+    void StaticOrderSchedule::unroll(vector<SDFactor *> &actors) const
+    {
+        actors.clear();
+        for (uint l = 0; l < loops.size(); l++)
+            loops[l].unroll(actors);
+    }
 
     /**
      * minimize ()
@@ -44,14 +733,15 @@ namespace SDF
      * the current schedule is reduced as much as possible. This new schedule
      * contains the smallest repeated part in the periodic phase of the schedule.
      * From the transient phase, all complete repetitions of the periodic phase are
-     * removed. The schedule entries in the minimized schedule are assigned new
-     * id's once the minimization is completed.
+     * removed. The search is done on the unrolled schedule; the minimized
+     * schedule is compressed into loops again.
      */
     void StaticOrderSchedule::minimize()
     {
         uint periodicStart, periodicEnd, transientEnd, posPattern, posSchedule;
-        StaticOrderSchedule newSchedule;
+        vector<SDFactor *> s;
         bool startOfPattern = true;
+        uint n;
 
         // Empty schedule?
         if (empty())
@@ -61,10 +751,14 @@ namespace SDF
         periodicStart = getStartPeriodicSchedule();
         ASSERT(periodicStart != UINT_MAX, "No periodic regime in the schedule");
 
+        // Unrolled schedule
+        unroll(s);
+        n = s.size();
+
         // Find smallest repeated part in the periodic schedule
         periodicEnd = periodicStart;
         posPattern = periodicStart;
-        posSchedule = next(periodicEnd);
+        posSchedule = nextInSchedule(periodicEnd, n, periodicStart);
 
         while (posSchedule != periodicStart)
         {
@@ -72,8 +766,7 @@ namespace SDF
             startOfPattern = false;
 
             // Actor at posSchedule not equal to actor at posPattern?
-            if (getScheduleEntry(posSchedule)->actor->getId()
-                != getScheduleEntry(posPattern)->actor->getId())
+            if (s[posSchedule]->getId() != s[posPattern]->getId())
             {
                 // Add schedule part up-to and including posSchedule to the
                 // pattern and restart the search starting from the next
@@ -86,8 +779,8 @@ namespace SDF
                 // Actor in schedule matches with actor in pattern, move one
                 // position forward in pattern and in schedule (loop on pattern
                 // if needed).
-                posPattern = next(posPattern);
-                if (posPattern == next(periodicEnd))
+                posPattern = nextInSchedule(posPattern, n, periodicStart);
+                if (posPattern == nextInSchedule(periodicEnd, n, periodicStart))
                 {
                     posPattern = periodicStart;
                     startOfPattern = true;
@@ -95,11 +788,11 @@ namespace SDF
             }
 
             // Last element reached?
-            if (isLast(posSchedule))
+            if (posSchedule + 1 == n)
                 break;
 
             // Next
-            posSchedule = next(posSchedule);
+            posSchedule = nextInSchedule(posSchedule, n, periodicStart);
         }
 
         // Is the exact end of the repeated part of the schedule not reached?
@@ -114,19 +807,18 @@ namespace SDF
         // complete repeated pattern is found in the transient part.
         // If not, no further reduction of the transient part is
         // possible.
-        transientEnd = previous(periodicStart);
+        transientEnd = previousInSchedule(periodicStart);
         posPattern = periodicEnd;
         posSchedule = transientEnd;
-        while (getScheduleEntry(posSchedule) != end())
+        while (posSchedule < n)
         {
-            if (getScheduleEntry(posSchedule)->actor->getId()
-                != getScheduleEntry(posPattern)->actor->getId())
+            if (s[posSchedule]->getId() != s[posPattern]->getId())
             {
                 break;
             }
             else
             {
-                posSchedule = previous(posSchedule);
+                posSchedule = previousInSchedule(posSchedule);
                 if (posPattern == periodicStart)
                 {
                     posPattern = periodicEnd;
@@ -134,94 +826,136 @@ namespace SDF
                 }
                 else
                 {
-                    posPattern = previous(posPattern);
+                    posPattern = previousInSchedule(posPattern);
                 }
             }
         }
 
         // Create a new schedule
+        clear();
+
         // Step 1: Is there a transient part?
-        if (getScheduleEntry(transientEnd) != end())
+        if (transientEnd < n)
         {
             // Add transient to the schedule
-            newSchedule.insert(newSchedule.end(), begin(),
-                               getScheduleEntry(++transientEnd));
-
-            // Set the start of the periodic phase
-            newSchedule.setStartPeriodicSchedule(transientEnd);
-        }
-        else
-        {
-            // Set the start of the periodic phase
-            newSchedule.setStartPeriodicSchedule(0);
+            for (uint i = 0; i <= transientEnd; i++)
+                appendActor(s[i]);
         }
 
+        // Set the start of the periodic phase
+        setStartPeriodicSchedule(size());
+
         // Step 2: Add periodic part to the schedule
-        newSchedule.insert(newSchedule.end(), getScheduleEntry(periodicStart),
-                           getScheduleEntry(++periodicEnd));
+        for (uint i = periodicStart; i <= periodicEnd; i++)
+            appendActor(s[i]);
 
-        // Put new schedule in place of the old schedule
-        *this = newSchedule;
+        // Step 3: Compress the schedule into loops
+        compress();
+    }
+
+    /**
+     * compress ()
+     * The function compresses the transient and periodic part of the schedule
+     * separately, such that the start of the periodic regime remains the start
+     * of a loop. When the schedule has no periodic regime, all loops are in
+     * the transient.
+     */
+    void StaticOrderSchedule::compress()
+    {
+        StaticOrderScheduleLoopKeys keys;
+        StaticOrderScheduleLoops transient, periodic;
+        uint start = startPeriodicLoop;
+
+        if (start > loops.size())
+            start = loops.size();
+
+        transient.insert(transient.end(), loops.begin(), loops.begin() + start);
+        periodic.insert(periodic.end(), loops.begin() + start, loops.end());
+
+        compressSequence(transient, keys);
+        compressSequence(periodic, keys);
+
+        loops.swap(transient);
+        if (startPeriodicLoop != UINT_MAX)
+            startPeriodicLoop = loops.size();
+        loops.insert(loops.end(), periodic.begin(), periodic.end());
     }
 
     /**
      * changeActorAssociations ()
-     * Change the associated actors in the schedule.
+     * Change the associated actors in the schedule. Firings of actors that do
+     * not exist in the new graph are removed from the schedule.
      */
     void StaticOrderSchedule::changeActorAssociations(SDFgraph *newGraph)
     {
-        StaticOrderScheduleEntryIter pos = begin();
-
-        while (pos != end())
+        for (uint l = 0; l < loops.size();)
         {
-            if (newGraph->getActor(pos->actor->getName()) != NULL)
+            if (loops[l].changeActorAssociations(newGraph))
             {
-                pos->actor = newGraph->getActor(pos->actor->getName());
-
-                // Next
-                pos++;
+                l++;
             }
             else
             {
-                // Entry at pos inside the transient?
-                if (pos < begin() + startPeriodicSchedule)
-                    startPeriodicSchedule--;
+                // Loop inside the transient?
+                if (l < startPeriodicLoop && startPeriodicLoop != UINT_MAX)
+                    startPeriodicLoop--;
 
-                pos = erase(pos);
+                loops.erase(loops.begin() + l);
             }
         }
+
+        updateNrFirings();
+        compress();
     }
 
     /**
      * convertToXML ()
-     * Convert the schedule to an XML representation.
+     * Convert the schedule to an XML representation. Every loop of the
+     * schedule becomes a node; the first node of the periodic part carries the
+     * startOfPeriodicRegime attribute.
      */
     CNode *StaticOrderSchedule::convertToXML()
     {
-        CNode *scheduleNode, *stateNode;
+        CNode *scheduleNode, *loopNode;
 
         // Create a schedule node
         scheduleNode = CNewNode("schedule");
 
-        // Create a state node for each schedule entry
-        for (uint i = 0 ; i < size(); i++)
+        // Create a node for each loop
+        for (uint l = 0; l < loops.size(); l++)
         {
-            StaticOrderScheduleEntryIter pos = getScheduleEntry(i);
-            stateNode = CAddNode(scheduleNode, "state");
+            loopNode = CAddNode(scheduleNode, loops[l].convertToXML());
 
-            // Check that the state is associated with an actor
-            ASSERT(pos->actor != NULL, "State not associated with an actor.");
+            if (l == startPeriodicLoop)
+                CAddAttribute(loopNode, "startOfPeriodicRegime", "true");
+        }
 
-            // Set attributes on the node
-            CAddAttribute(stateNode, "actor", pos->actor->getName());
+        return scheduleNode;
+    }
 
-            if (i == startPeriodicSchedule)
+    /**
+     * constructFromXML ()
+     * Construct the schedule from an XML representation.
+     */
+    void StaticOrderSchedule::constructFromXML(SDFgraph *g, CNode *scheduleNode)
+    {
+        for (CNode *n = CGetChildNode(scheduleNode); n != NULL; n = CNextNode(n))
+        {
+            StaticOrderScheduleLoop l;
+
+            if (!CIsNode(n, "state") && !CIsNode(n, "loop"))
+                continue;
+
+            // Is this node the start of the periodic regime?
+            if (CHasAttribute(n, "startOfPeriodicRegime")
+                && CGetAttribute(n, "startOfPeriodicRegime") == "true")
             {
-                CAddAttribute(stateNode, "startOfPeriodicRegime", "true");
+                setStartPeriodicSchedule(size());
             }
-        }
 
-        return scheduleNode;
+            l.constructFromXML(g, n);
+            appendLoop(l);
+        }
     }
 
 }//namespace SDF
@@ -12,6 +12,8 @@
  *
  *  History         :
  *      03-03-08    :   Initial version.
+ *      17-10-26    :   Loop-compressed schedule representation.
+ *      17-10-26    :   Schedule stored as a sequence of loops.
  *
  * $Id: static_order_schedule.h,v 1.2 2008-03-06 13:59:06 sander Exp $
  *
@@ -42,127 +44,202 @@ namespace SDF
 
 
     /**
-     * Static-order schedule entry
-     * One position in a static-order schedule.
+     * Static-order schedule loop
+     * Looped representation of a sequence of actor firings. A loop with an
+     * actor fires this actor count times; a loop without an actor executes its
+     * body count times. The sequence A A B A A B is for example represented by
+     * the loop (2 (2 A) B).
      **/
-    class StaticOrderScheduleEntry
+    class StaticOrderScheduleLoop
     {
         public:
             // Constructor
-            StaticOrderScheduleEntry(SDFactor *actor = NULL)
-                : actor(actor) {};
+            StaticOrderScheduleLoop(SDFactor *actor = NULL, uint count = 1)
+                : actor(actor), count(count) {};
 
             // Destructor
-            ~StaticOrderScheduleEntry() {};
+            ~StaticOrderScheduleLoop() {};
 
-            // Actor scheduled with this entry
+            // Number of actor firings represented by the loop
+            CSize nrFirings() const;
+
+            // Append the actors fired by the loop to the sequence actors
+            void unroll(vector<SDFactor *> &actors) const;
+
+            // Change the associated actors in the loop
+            bool changeActorAssociations(SDFgraph *newGraph);
+
+            // Convert the loop to an XML representation
+            CNode *convertToXML() const;
+
+            // Construct the loop from an XML representation
+            void constructFromXML(SDFgraph *g, CNode *loopNode);
+
+        public:
+            // Actor fired in each iteration (NULL when the body is executed)
             SDFactor *actor;
+
+            // Number of iterations
+            uint count;
+
+            // Body of the loop
+            vector<StaticOrderScheduleLoop> body;
     };
 
     /**
-     * Static-order schedule entry iterator
-     * Iterator that provides a reference to an entry in a static-order schedule.
+     * Static-order schedule loops
+     * Sequence of loops.
      **/
-    typedef vector<StaticOrderScheduleEntry>::iterator StaticOrderScheduleEntryIter;
+    typedef vector<StaticOrderScheduleLoop> StaticOrderScheduleLoops;
 
     /**
-     * Static-order schedule
-     * A static-order schedule provides a sequence of actor firings. The schedule
-     * may contain a cycle which makes it effectively an infinite schedule.
+     * Static-order schedule position
+     * Position in a static-order schedule. For every level of nesting, the
+     * position contains the loop in the sequence at that level and the number
+     * of completed iterations of this loop. The position also contains its
+     * index in the unrolled schedule. This index identifies the position
+     * (e.g. in the state of a state-space exploration).
      **/
-    class StaticOrderSchedule : public vector<StaticOrderScheduleEntry>
+    class StaticOrderSchedulePosition
     {
         public:
-            // Constructor
-            StaticOrderSchedule()
+            // Loop counter
+            struct Counter
             {
-                startPeriodicSchedule = UINT_MAX;
+                // Loop in the sequence
+                uint loop;
+
+                // Completed iterations of the loop
+                uint iteration;
             };
 
+            // Constructor
+            StaticOrderSchedulePosition() : index(0) {};
+
             // Destructor
-            ~StaticOrderSchedule() {};
+            ~StaticOrderSchedulePosition() {};
 
-            // Append actor to the schedule
-            void appendActor(SDFactor *a)
+            // Compare positions
+            bool operator==(const StaticOrderSchedulePosition &p) const
             {
-                push_back(StaticOrderScheduleEntry(a));
+                return index == p.index;
             };
-
-            // Append schedule entry to the schedule
-            void appendScheduleEntry(StaticOrderScheduleEntry &s)
+            bool operator!=(const StaticOrderSchedulePosition &p) const
             {
-                push_back(s);
+                return index != p.index;
             };
 
-            // Insert actor befere the element at position into the schedule and return
-            // iterator to newly inserted element
-            StaticOrderScheduleEntryIter insertActor(
-                StaticOrderScheduleEntryIter position, SDFactor *a)
-            {
-                // Update start of periodic schedule when new element is in transient
-                if (begin() + startPeriodicSchedule > position)
-                    startPeriodicSchedule++;
+        public:
+            // Index in the unrolled schedule
+            uint index;
+
+            // Loop counters (outermost loop first)
+            vector<Counter> counters;
+    };
 
-                // Insert actor
-                return insert(position, StaticOrderScheduleEntry(a));
+    /**
+     * Static-order schedule
+     * A static-order schedule provides a sequence of actor firings. The schedule
+     * may contain a cycle which makes it effectively an infinite schedule. The
+     * schedule is stored as a sequence of (nested) loops; the start of the
+     * periodic regime is always the start of a loop in this sequence.
+     **/
+    class StaticOrderSchedule
+    {
+        public:
+            // Constructor
+            StaticOrderSchedule()
+            {
+                clear();
             };
 
-            // Access schedule entry
-            StaticOrderScheduleEntryIter getScheduleEntry(const uint i)
+            // Destructor
+            ~StaticOrderSchedule() {};
+
+            // Loops in the schedule
+            const StaticOrderScheduleLoops &getLoops() const
             {
-                if (i >= size())
-                    return end();
-                return (begin() + i);
+                return loops;
             };
 
-            // Loop-back in schedule
-            uint getStartPeriodicSchedule()
+            // Number of actor firings in the schedule
+            CSize size() const
             {
-                return startPeriodicSchedule;
+                return nrFiringsInSchedule;
             };
-            void setStartPeriodicSchedule(const uint i)
+            bool empty() const
             {
-                startPeriodicSchedule = i;
+                return nrFiringsInSchedule == 0;
             };
 
-            // Next entry in the schedule
-            uint next(uint current)
+            // Remove all loops from the schedule
+            void clear()
             {
-                if (isLast(current))
-                    return getStartPeriodicSchedule();
-
-                return ++current;
+                loops.clear();
+                nrFiringsInSchedule = 0;
+                startPeriodicSchedule = UINT_MAX;
+                startPeriodicLoop = UINT_MAX;
             };
 
-            // Previous entry in the schedule
-            uint previous(uint current)
-            {
-                if (current == 0)
-                    return UINT_MAX;
+            // Append actor to the schedule
+            void appendActor(SDFactor *a);
 
-                return --current;
-            };
+            // Append loop to the schedule
+            void appendLoop(const StaticOrderScheduleLoop &l);
+
+            // Remove the last actor firing from the schedule
+            void removeLastActor();
+
+            // Insert actor a directly before every firing of actor b
+            void insertActorBefore(const SDFactor *b, SDFactor *a);
 
-            // Last entry before the loop-back
-            bool isLast(uint current) const
+            // Loop-back in schedule (index in the unrolled schedule)
+            uint getStartPeriodicSchedule() const
             {
-                if (current + 1 == size())
-                    return true;
+                return startPeriodicSchedule;
+            };
+            void setStartPeriodicSchedule(const uint i);
+
+            // Walk through the schedule
+            void initPosition(StaticOrderSchedulePosition &p) const;
+            SDFactor *getActor(const StaticOrderSchedulePosition &p) const;
+            void nextPosition(StaticOrderSchedulePosition &p) const;
 
-                return false;
-            }
+            // Actors fired in the unrolled schedule
+            void unroll(vector<SDFactor *> &actors) const;
 
             // Compute a minimized version of the schedule
             void minimize();
 
+            // Replace repeated sequences of loops by a single loop
+            void compress();
+
             // Change the associated actors in the schedule
             void changeActorAssociations(SDFgraph *newGraph);
 
             // Convert the schedule to an XML representation
             CNode *convertToXML();
 
+            // Construct the schedule from an XML representation
+            void constructFromXML(SDFgraph *g, CNode *scheduleNode);
+
         private:
+            // Descend from the loop at the innermost counter to its first actor
+            void firstActorInLoop(StaticOrderSchedulePosition &p) const;
+
+            // Recompute the number of firings and start of the periodic regime
+            void updateNrFirings();
+
+            // Loops in the schedule
+            StaticOrderScheduleLoops loops;
+
+            // Number of actor firings in the schedule
+            CSize nrFiringsInSchedule;
+
+            // Start of the periodic regime (index in the unrolled schedule and
+            // position of its first loop in the sequence of loops)
             uint startPeriodicSchedule;
+            uint startPeriodicLoop;
     };
 
 }//namespace SDF
@@ -13,6 +13,7 @@
  *
  *  History         :
  *      21-08-08    :   Initial version.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
  *
  * $Id: static_periodic_scheduler.h,v 1.1 2008-09-18 07:35:55 sander Exp $
  *
@@ -38,6 +39,8 @@
 #define SDF_RESOURCE_ALLOCATION_SCHEDULING_STATIC_PERIODIC_SCHEDULER_H_INCLUDED
 
 #include "../../base/timed/graph.h"
+#include "../../analysis/statespace/state.h"
+#include "../../base/timed/compiled_graph.h"
 namespace SDF
 {
 
@@ -68,49 +71,12 @@ namespace SDF
             {
                 public:
 
-                    /***********************************************************************
-                     * State
-                     **********************************************************************/
-                    class State
-                    {
-                        public:
-                            // Constructor
-                            State(const uint nrActors = 0, const uint nrChannels = 0)
-                            {
-                                init(nrActors, nrChannels);
-                            };
-
-                            // Destructor
-                            ~State() {};
-
-                            // Initialize the state
-                            void init(const uint nrActors, const uint nrChannels)
-                            {
-                                actClk.resize(nrActors);
-                                ch.resize(nrChannels);
-                            };
-
-                            // Compare states
-                            bool operator==(const State &s);
-
-                            // Clear state
-                            void clear();
-
-                            // Output state
-                            void print(ostream &out);
-
-                            // State information
-                            vector< list<SDFtime> > actClk;
-                            vector< TBufSize > ch;
-                            unsigned long glbClk;
-                    };
-
-                    // Sequence of states in transition system
-                    typedef list<State>      States;
-                    typedef States::iterator StatesIter;
+                    // State of the transition system
+                    typedef SDFstateSpaceState State;
 
                     // Constructor
                     TransitionSystem(TimedSDFgraph *gr)
+                        : cg(gr)
                     {
                         g = gr;
                         initOutputActor();
@@ -130,9 +96,6 @@ namespace SDF
                         const long long int period);
 
                 private:
-                    // Store state
-                    bool storeState(State &s, StatesIter &pos);
-
                     // Clear list of stored states
                     void clearStoredStates()
                     {
@@ -140,28 +103,31 @@ namespace SDF
                     };
 
                     // Compute throughput from transition system
-                    CFraction computeThroughput(const StatesIter cycleIter);
+                    CFraction computeThroughput(const uint cycleIdx);
 
                     // State transitions
-                    bool actorReadyToFire(SDFactor *a);
-                    void startActorFiring(TimedSDFactor *a);
-                    bool actorReadyToEnd(SDFactor *a);
-                    void endActorFiring(SDFactor *a);
+                    bool actorReadyToFire(const CId a);
+                    void startActorFiring(const CId a);
+                    bool actorReadyToEnd(const CId a);
+                    void endActorFiring(const CId a);
                     SDFtime clockStep(SDFtime step = UINT_MAX);
 
                     // Output actor
                     void initOutputActor();
 
-                    // SDF graph and output actor
+                    // SDF graph and its compiled view
                     TimedSDFgraph *g;
+                    TimedSDFcompiledGraph cg;
+
+                    // Output actor
                     CId outputActor;
                     TCnt outputActorRepCnt;
 
                     // Current state
                     State currentState;
 
-                    // List of visited states that are stored
-                    States storedStates;
+                    // Visited states that are stored
+                    SDFvisitedStates<State> storedStates;
             };
     };
 
@@ -15,6 +15,7 @@
  *
  *  History         :
  *      18-09-08    :   Initial version.
+ *      17-10-26    :   Exploration on the compiled view of the graph.
  *
  * $Id: static_periodic_scheduler_chao.cc,v 1.1.2.3 2010-04-25 02:08:52 mgeilen Exp $
  *
@@ -47,84 +48,6 @@ namespace SDF
 
     //#define _PRINT_STATESPACE
 
-    /******************************************************************************
-     * State
-     *****************************************************************************/
-
-    /**
-     * printState ()
-     * Print the state to the supplied stream.
-     */
-    void SDFstateSpaceStaticPeriodicSchedulerChao::TransitionSystem::State::print(
-        ostream &out)
-    {
-        out << "### State ###" << endl;
-
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            out << "actClk[" << i << "] =";
-
-            for (list<SDFtime>::const_iterator iter = actClk[i].begin();
-                 iter != actClk[i].end(); iter++)
-            {
-                out << " " << (*iter) << ", ";
-            }
-
-            out << endl;
-        }
-
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            out << "ch[" << i << "] = " << ch[i] << endl;
-        }
-
-        out << "glbClk = " << glbClk << endl;
-    }
-
-    /**
-     * clearState ()
-     * The function sets the state to zero.
-     */
-    void SDFstateSpaceStaticPeriodicSchedulerChao::TransitionSystem::State::clear()
-    {
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            actClk[i].clear();
-        }
-
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            ch[i] = 0;
-        }
-
-        glbClk = 0;
-    }
-
-    /**
-     * operator== ()
-     * The function compares to states and returns true if they are equal.
-     */
-    bool SDFstateSpaceStaticPeriodicSchedulerChao::TransitionSystem::State::operator==(
-        const State &s)
-    {
-        if (glbClk != s.glbClk)
-            return false;
-
-        for (uint i = 0; i < ch.size(); i++)
-        {
-            if (ch[i] != s.ch[i])
-                return false;
-        }
-
-        for (uint i = 0; i < actClk.size(); i++)
-        {
-            if (actClk[i] != s.actClk[i])
-                return false;
-        }
-
-        return true;
-    }
-
     /******************************************************************************
      * Transition system
      *****************************************************************************/
@@ -136,84 +59,43 @@ namespace SDF
      */
     void SDFstateSpaceStaticPeriodicSchedulerChao::TransitionSystem::initOutputActor()
     {
-        RepetitionVector repVec;
+        const RepetitionVector &repVec = cg.getRepetitionVector();
         int min = INT_MAX;
-        SDFactor *a = NULL;
-
-        // Compute repetition vector
-        repVec = computeRepetitionVector(g);
 
         // Select actor with lowest entry in repetition vector as output actor
-        for (SDFactorsIter iter = g->actorsBegin(); iter != g->actorsEnd(); iter++)
+        for (CId a = 0; a < cg.nrActors(); a++)
         {
-            if (repVec[(*iter)->getId()] < min)
+            if (repVec[a] < min)
             {
-                a = *iter;
-                min = repVec[a->getId()];
+                outputActor = a;
+                min = repVec[a];
             }
         }
 
-        // Set output actor and its repetition vector count
-        outputActor = a->getId();
+        // Set output actor repetition vector count
         outputActorRepCnt = repVec[outputActor];
     }
 
-    /**
-     * storeState ()
-     * The function stores the state s on whenever s is not already in the
-     * list of storedStates. When s is stored, the function returns true. When the
-     * state s is already in the list, the state s is not stored. The function
-     * returns false. The function always sets the pos variable to the position
-     * where the state s is in the list.
-     */
-    bool SDFstateSpaceStaticPeriodicSchedulerChao::TransitionSystem::storeState(State &s,
-            StatesIter &pos)
-    {
-        // Find state in the list of stored states
-        for (StatesIter iter = storedStates.begin();
-             iter != storedStates.end(); iter++)
-        {
-            State &x = *iter;
-
-            // State s at position iter in the list?
-            if (x == s)
-            {
-                pos = iter;
-                return false;
-            }
-        }
-
-        // State not found, store it at the end of the list
-        storedStates.push_back(s);
-
-        // Added state to the end of the list
-        pos = storedStates.end();
-
-        return true;
-    }
-
     /**
      * computeThroughput ()
      * The function calculates the throughput of the states on the cycle. Its
      * value is equal to the average number of firings of an actor per time unit.
      */
     CFraction SDFstateSpaceStaticPeriodicSchedulerChao::TransitionSystem
-    ::computeThroughput(const StatesIter cycleIter)
+    ::computeThroughput(const uint cycleIdx)
     {
         int nr_fire = 0;
         int time = 0;
 
         // Check all state from stack till cycle complete
-        for (StatesIter iter = cycleIter; iter != storedStates.end(); iter++)
+        for (uint i = cycleIdx; i < storedStates.size(); i++)
         {
-            State &s = *iter;
-
             // Number of states in cycle is equal to number of iterations
             // in the period
             nr_fire++;
 
             // Time between previous state
-            time += s.glbClk;
+            time += storedStates.glbClk(i);
         }
 
         return CFraction(nr_fire, time);
@@ -234,22 +116,14 @@ namespace SDF
      * s. Else it returns false.
      */
     bool SDFstateSpaceStaticPeriodicSchedulerChao::TransitionSystem::actorReadyToFire(
-        SDFactor *a)
+        const CId a)
     {
         // Check all input ports for tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = cg.inPortsBegin(a);
+             p != cg.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                if (!CH_TOKENS(c->getId(), p->getRate()))
-                {
-                    return false;
-                }
-            }
+            if (!CH_TOKENS(p->channel, p->rate))
+                return false;
         }
 
         return true;
@@ -262,26 +136,20 @@ namespace SDF
      * position.
      */
     void SDFstateSpaceStaticPeriodicSchedulerChao::TransitionSystem::startActorFiring(
-        TimedSDFactor *a)
+        const CId a)
     {
-        // Consume tokens from inputs and space for output tokens
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        // Consume tokens from inputs
+        for (const TimedSDFcompiledGraph::Port *p = cg.inPortsBegin(a);
+             p != cg.inPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is destination of the channel?
-            if (p->getType() == SDFport::In)
-            {
-                CONSUME(c->getId(), p->getRate());
-            }
+            CONSUME(p->channel, p->rate);
         }
 
         // Add actor firing to the list of active firings of this actor
-        currentState.actClk[a->getId()].push_back(a->getExecutionTime());
+        currentState.startFiring(a, cg.getExecutionTime(a));
 
 #ifdef _PRINT_STATESPACE
-        cout << "start: " << a->getName() << endl;
+        cout << "start: " << cg.getActor(a)->getName() << endl;
 #endif
     }
 
@@ -291,16 +159,10 @@ namespace SDF
      * the function returns false.
      */
     bool SDFstateSpaceStaticPeriodicSchedulerChao::TransitionSystem::actorReadyToEnd(
-        SDFactor *a)
+        const CId a)
     {
-        if (currentState.actClk[a->getId()].empty())
-            return false;
-
-        // First actor firing in sorted list has execution time left?
-        if (currentState.actClk[a->getId()].front() != 0)
-            return false;
-
-        return true;
+        // First actor firing in sorted list has no execution time left?
+        return currentState.readyToEnd(a);
     }
 
     /**
@@ -309,25 +171,19 @@ namespace SDF
      * list of active firings.
      */
     void SDFstateSpaceStaticPeriodicSchedulerChao::TransitionSystem::endActorFiring(
-        SDFactor *a)
+        const CId a)
     {
-        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        for (const TimedSDFcompiledGraph::Port *p = cg.outPortsBegin(a);
+             p != cg.outPortsEnd(a); p++)
         {
-            SDFport *p = *iter;
-            SDFchannel *c = p->getChannel();
-
-            // Actor is source of the channel?
-            if (p->getType() == SDFport::Out)
-            {
-                PRODUCE(c->getId(), p->getRate());
-            }
+            PRODUCE(p->channel, p->rate);
         }
 
         // Remove the firing from the list of active actor firings
-        currentState.actClk[a->getId()].pop_front();
+        currentState.endFiring(a);
 
 #ifdef _PRINT_STATESPACE
-        cout << "end:   " << a->getName() << endl;
+        cout << "end:   " << cg.getActor(a)->getName() << endl;
 #endif
     }
 
@@ -340,44 +196,8 @@ namespace SDF
     SDFtime SDFstateSpaceStaticPeriodicSchedulerChao::TransitionSystem::clockStep(
         SDFtime step)
     {
-        // Find maximal time progress
-        for (uint a = 0; a < g->nrActors(); a++)
-        {
-            SDFtime actClk;
-
-            // Remaining execution time
-            if (!currentState.actClk[a].empty())
-            {
-                actClk = currentState.actClk[a].front();
-
-                if (step > actClk)
-                    step = actClk;
-            }
-        }
-
-        // Still actors ready to end their firing?
-        if (step == 0)
-            return 0;
-
-        // Check for progress (i.e. no deadlock)
-        if (step == UINT_MAX)
-            return UINT_MAX;
-
-        // Lower remaining execution time actors
-        for (uint a = 0; a < g->nrActors(); a++)
-        {
-            for (list<SDFtime>::iterator iter = currentState.actClk[a].begin();
-                 iter != currentState.actClk[a].end(); iter++)
-            {
-                SDFtime &actFiringTime = *iter;
-
-                // Lower remaining execution time of the actor firing
-                actFiringTime -= step;
-            }
-        }
-
-        // Advance the global clock
-        currentState.glbClk += step;
+        // Progress time till the first firing ends
+        step = currentState.clockStep(step);
 
 #ifdef _PRINT_STATESPACE
         cout << "clk:   " << step << endl;
@@ -400,7 +220,7 @@ namespace SDF
         vector< vector<long long int> > iterCnt;
         vector<long long int> firingIdx;
         long long int globalTime = 0;
-        StatesIter recurrentState;
+        uint recurrentState;
         SDFtime clkStep;
         int repCnt = 0;
 
@@ -422,17 +242,12 @@ namespace SDF
         clearStoredStates();
 
         // Create initial state
-        currentState.init(g->nrActors(), g->nrChannels());
+        currentState.init(cg.nrActors(), cg.nrChannels());
         currentState.clear();
 
         // Initial tokens and space
-        for (SDFchannelsIter iter = g->channelsBegin();
-             iter != g->channelsEnd(); iter++)
-        {
-            SDFchannel *c = *iter;
-
-            CH(c->getId()) = c->getInitialTokens();
-        }
+        for (CId c = 0; c < cg.nrChannels(); c++)
+            CH(c) = cg.getInitialTokens(c);
 
 #ifdef _PRINT_STATESPACE
         cout << "### start statespace exploration" << endl;
@@ -442,14 +257,11 @@ namespace SDF
         while (true)
         {
             // Finish actor firings
-            for (SDFactorsIter iter = g->actorsBegin();
-                 iter != g->actorsEnd(); iter++)
+            for (CId a = 0; a < cg.nrActors(); a++)
             {
-                SDFactor *a = *iter;
-
                 while (actorReadyToEnd(a))
                 {
-                    if (outputActor == a->getId())
+                    if (outputActor == a)
                     {
                         repCnt++;
                         if (repCnt == outputActorRepCnt)
@@ -458,7 +270,7 @@ namespace SDF
                             printState(currentState, cout);
 #endif
                             // Add state to hash of visited states
-                            if (!storeState(currentState, recurrentState))
+                            if (!storedStates.store(currentState, recurrentState))
                             {
 #ifdef _PRINT_STATESPACE
                                 cout << "### end statespace exploration" << endl;
@@ -476,14 +288,11 @@ namespace SDF
             }
 
             // Start actor firings
-            for (SDFactorsIter iter = g->actorsBegin();
-                 iter != g->actorsEnd(); iter++)
+            for (CId a = 0; a < cg.nrActors(); a++)
             {
-                TimedSDFactor *a = (TimedSDFactor *)(*iter);
-
                 // Should next firing of actor a start now?
-                while (startTime[(size_t) a->getId()][(size_t) firingIdx[(size_t) a->getId()]]
-                       + period * iterCnt[(size_t) a->getId()][(size_t) firingIdx[a->getId()]]
+                while (startTime[a][(size_t) firingIdx[a]]
+                       + period * iterCnt[a][(size_t) firingIdx[a]]
                        <= globalTime)
                 {
                     // Ready to fire actor a?
@@ -491,9 +300,8 @@ namespace SDF
                     {
                         // Fire actor a
                         startActorFiring(a);
-                        iterCnt[(size_t) a->getId()][(size_t) firingIdx[(size_t) a->getId()]]++;
-                        firingIdx[(size_t) a->getId()] = (firingIdx[(size_t) a->getId()] + 1)
-                                                         % startTime[(size_t) a->getId()].size();
+                        iterCnt[a][(size_t) firingIdx[a]]++;
+                        firingIdx[a] = (firingIdx[a] + 1) % startTime[a].size();
                     }
                     else
                     {
@@ -543,7 +351,7 @@ namespace SDF
     CFraction SDFstateSpaceStaticPeriodicSchedulerChao::TransitionSystem
     ::execSDFgraphSelfTimed()
     {
-        StatesIter recurrentState;
+        uint recurrentState;
         SDFtime clkStep;
         int repCnt = 0;
 
@@ -551,17 +359,12 @@ namespace SDF
         clearStoredStates();
 
         // Create initial state
-        currentState.init(g->nrActors(), g->nrChannels());
+        currentState.init(cg.nrActors(), cg.nrChannels());
         currentState.clear();
 
         // Initial tokens and space
-        for (SDFchannelsIter iter = g->channelsBegin();
-             iter != g->channelsEnd(); iter++)
-        {
-            SDFchannel *c = *iter;
-
-            CH(c->getId()) = c->getInitialTokens();
-        }
+        for (CId c = 0; c < cg.nrChannels(); c++)
+            CH(c) = cg.getInitialTokens(c);
 
 #ifdef _PRINT_STATESPACE
         cout << "### start statespace exploration" << endl;
@@ -571,14 +374,11 @@ namespace SDF
         while (true)
         {
             // Finish actor firings
-            for (SDFactorsIter iter = g->actorsBegin();
-                 iter != g->actorsEnd(); iter++)
+            for (CId a = 0; a < cg.nrActors(); a++)
             {
-                SDFactor *a = *iter;
-
                 while (actorReadyToEnd(a))
                 {
-                    if (outputActor == a->getId())
+                    if (outputActor == a)
                     {
                         repCnt++;
                         if (repCnt == outputActorRepCnt)
@@ -587,7 +387,7 @@ namespace SDF
                             printState(currentState, cout);
 #endif
                             // Add state to hash of visited states
-                            if (!storeState(currentState, recurrentState))
+                            if (!storedStates.store(currentState, recurrentState))
                             {
 #ifdef _PRINT_STATESPACE
                                 cout << "### end statespace exploration" << endl;
@@ -605,11 +405,8 @@ namespace SDF
             }
 
             // Start actor firings
-            for (SDFactorsIter iter = g->actorsBegin();
-                 iter != g->actorsEnd(); iter++)
+            for (CId a = 0; a < cg.nrActors(); a++)
             {
-                TimedSDFactor *a = (TimedSDFactor *)(*iter);
-
                 // Ready to fire actor a?
                 while (actorReadyToFire(a))
                 {
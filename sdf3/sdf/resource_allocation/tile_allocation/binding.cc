@@ -12,6 +12,8 @@
  *
  *  History         :
  *      11-04-06    :   Initial version.
+ *      17-10-26    :   Incremental throughput analysis of time slices.
+ *      17-10-26    :   Max-plus throughput analysis.
  *
  * $Id: binding.cc,v 1.5 2008-03-06 10:49:45 sander Exp $
  *
@@ -94,7 +96,10 @@ namespace SDF
         }
 
         // Compute throughput of the SDFG
-        thrGraph = thrAnalysisAlgo.analyze(gr);
+        if (maxPlusThroughputAnalysis)
+            thrGraph = SDFmaxPlusThroughputAnalysis().analyze(gr);
+        else
+            thrGraph = thrAnalysisAlgo.analyze(gr);
 
         // Cleanup
         delete g;
@@ -110,7 +115,6 @@ namespace SDF
      */
     double Binding::analyzeThroughput(vector<double> &tileUtilization)
     {
-        SDFstateSpaceBindingAwareThroughputAnalysis thrAnalysisAlgo;
         BindingAwareSDFG *bindingAwareSDFG;
         double thrGraph;
 
@@ -118,7 +122,7 @@ namespace SDF
         bindingAwareSDFG = new BindingAwareSDFG(appGraph, archGraph, flowType);
 
         // Compute throughput of mapped SDF graph
-        thrGraph = thrAnalysisAlgo.analyze(bindingAwareSDFG, tileUtilization);
+        thrGraph = analyzeThroughput(bindingAwareSDFG, tileUtilization);
 
         // Cleanup
         delete bindingAwareSDFG;
@@ -126,6 +130,116 @@ namespace SDF
         return thrGraph;
     }
 
+    /**
+     * analyzeThroughput ()
+     * The function returns the throughput of a binding-aware SDFG. The
+     * max-plus analysis is used when it is selected and exact for the graph,
+     * the state-space analysis otherwise.
+     */
+    double Binding::analyzeThroughput(BindingAwareSDFG *bindingAwareSDFG,
+                                      vector<double> &tileUtilization)
+    {
+        if (maxPlusThroughputAnalysis
+            && SDFmaxPlusThroughputAnalysis::isExact(bindingAwareSDFG))
+        {
+            SDFmaxPlusThroughputAnalysis thrAnalysisAlgo;
+
+            return thrAnalysisAlgo.analyze(bindingAwareSDFG, tileUtilization);
+        }
+        else
+        {
+            SDFstateSpaceBindingAwareThroughputAnalysis thrAnalysisAlgo;
+
+            return thrAnalysisAlgo.analyze(bindingAwareSDFG, tileUtilization);
+        }
+    }
+
+    /**
+     * analyzeThroughputTimeSlices ()
+     * The function returns the throughput of the application graph mapped
+     * onto the platform graph, like analyzeThroughput. It is intended for a
+     * search over the TDMA time slices in which the binding, the schedules and
+     * the buffers do not change. The binding-aware SDFG is constructed by the
+     * first call. Later calls only update the time slices in this graph, and
+     * a time slice allocation that was analyzed before is not analyzed again.
+     * The function releaseTimeSliceAnalysis must be called when any other
+     * part of the mapping changes.
+     */
+    double Binding::analyzeThroughputTimeSlices(vector<double> &tileUtilization)
+    {
+        vector<SDFtime> slices(archGraph->nrTiles(), 0);
+        ThroughputAnalysisResult result;
+
+        // Current time slice allocation
+        for (TilesIter iter = archGraph->tilesBegin();
+             iter != archGraph->tilesEnd(); iter++)
+        {
+            Tile *t = *iter;
+            Processor *p = t->getProcessor();
+
+            if (p != NULL)
+                slices[t->getId()] = (SDFtime) p->getReservedTimeSlice();
+        }
+
+        // Time slice allocation analyzed before?
+        map< vector<SDFtime>, ThroughputAnalysisResult >::iterator cached
+            = timeSliceAnalysisCache.find(slices);
+        if (cached != timeSliceAnalysisCache.end())
+        {
+            tileUtilization = cached->second.tileUtilization;
+            return cached->second.thr;
+        }
+
+        // Update the time slices in the binding-aware SDFG (the graph is
+        // constructed again when its structure depends on a new slice)
+        if (timeSliceAnalysisGraph != NULL)
+        {
+            for (TilesIter iter = archGraph->tilesBegin();
+                 iter != archGraph->tilesEnd(); iter++)
+            {
+                Tile *t = *iter;
+
+                if (t->getProcessor() == NULL)
+                    continue;
+
+                if (!timeSliceAnalysisGraph->setTDMAsliceOnTile(t->getId(),
+                        slices[t->getId()]))
+                {
+                    delete timeSliceAnalysisGraph;
+                    timeSliceAnalysisGraph = NULL;
+                    break;
+                }
+            }
+        }
+
+        // Create binding-aware SDFG
+        if (timeSliceAnalysisGraph == NULL)
+        {
+            timeSliceAnalysisGraph = new BindingAwareSDFG(appGraph, archGraph,
+                    flowType);
+        }
+
+        // Compute throughput of mapped SDF graph
+        result.thr = analyzeThroughput(timeSliceAnalysisGraph,
+                                       result.tileUtilization);
+        timeSliceAnalysisCache[slices] = result;
+
+        tileUtilization = result.tileUtilization;
+        return result.thr;
+    }
+
+    /**
+     * releaseTimeSliceAnalysis ()
+     * The function releases the binding-aware SDFG and the analysis results
+     * used by analyzeThroughputTimeSlices.
+     */
+    void Binding::releaseTimeSliceAnalysis()
+    {
+        delete timeSliceAnalysisGraph;
+        timeSliceAnalysisGraph = NULL;
+        timeSliceAnalysisCache.clear();
+    }
+
     /**
      * isThroughputConstraintSatisfied ()
      * Check wether or not the throughput constraint is satisfied.
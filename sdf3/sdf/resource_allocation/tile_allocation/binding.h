@@ -12,6 +12,9 @@
  *
  *  History         :
  *      11-04-06    :   Initial version.
+ *      17-10-26    :   Incremental throughput analysis of time slices.
+ *      17-10-26    :   Max-plus throughput analysis.
+ *      17-10-26    :   Binary copy of the custom tile binding.
  *
  * $Id: binding.h,v 1.2.2.1 2010-04-22 07:18:42 mgeilen Exp $
  *
@@ -57,10 +60,15 @@ namespace SDF
                 archGraph = NULL;
                 appGraph = NULL;
                 flowType = type;
+                maxPlusThroughputAnalysis = false;
+                timeSliceAnalysisGraph = NULL;
             };
 
             // Destructor
-            virtual ~Binding() {};
+            virtual ~Binding()
+            {
+                releaseTimeSliceAnalysis();
+            };
 
             // Application graph
             TimedSDFgraph *getAppGraph()
@@ -85,6 +93,17 @@ namespace SDF
                 return flowType;
             };
 
+            // Analyze throughput on the max-plus matrix of the graph instead
+            // of its state space (when the analysis is exact)
+            bool getMaxPlusThroughputAnalysis() const
+            {
+                return maxPlusThroughputAnalysis;
+            };
+            void setMaxPlusThroughputAnalysis(bool flag)
+            {
+                maxPlusThroughputAnalysis = flag;
+            };
+
             // Binding algorithm
             virtual bool bind() = 0;
             virtual bool bindSDFGtoTiles() = 0;
@@ -97,15 +116,25 @@ namespace SDF
 
             void setCustomTileBinding(CString _binding) { tileBinding = _binding; }
 
+            // File to which the custom tile binding is written in binary form
+            void setBinaryTileBindingFile(CString _file) { tileBindingBinary = _file; }
+
         protected:
             CString tileBinding = "N/A";
+            CString tileBindingBinary = "N/A";
 
         protected:
             // Throughput
             double analyzeThroughputApplication();
             double analyzeThroughput(vector<double> &tileUtilization);
+            double analyzeThroughput(BindingAwareSDFG *bindingAwareSDFG,
+                                     vector<double> &tileUtilization);
             bool isThroughputConstraintSatisfied();
 
+            // Throughput while only the TDMA time slices change
+            double analyzeThroughputTimeSlices(vector<double> &tileUtilization);
+            void releaseTimeSliceAnalysis();
+
             // Static order schedule
             void minimizeStaticOrderSchedules(PlatformGraph *archGraph);
 
@@ -118,6 +147,21 @@ namespace SDF
 
             // Flow
             SDFflowType flowType;
+
+            // Throughput analysis on the max-plus matrix
+            bool maxPlusThroughputAnalysis;
+
+        private:
+            // Result of a throughput analysis
+            struct ThroughputAnalysisResult
+            {
+                double thr;
+                vector<double> tileUtilization;
+            };
+
+            // Binding-aware SDFG and analyzed time slice allocations
+            BindingAwareSDFG *timeSliceAnalysisGraph;
+            map< vector<SDFtime>, ThroughputAnalysisResult > timeSliceAnalysisCache;
     };
 
 }//namespace SDF
@@ -0,0 +1,458 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   binding_file.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Loader for custom actor-to-tile binding files
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "binding_file.h"
+#include <fstream>
+#include <sstream>
+#include <cstring>
+namespace SDF
+{
+    // Magic at the start of a binary binding file (version 1 has no string
+    // table)
+    static const char binaryMagic[] = "SDF3TB02";
+    static const char binaryMagicV1[] = "SDF3TB01";
+    static const size_t binaryMagicSize = 8;
+
+    // Names which are stored verbatim are referred to by their index in the
+    // string table with this bit set
+    static const uint32_t verbatimFlag = 0x80000000;
+
+    /**
+     * readUint32 ()
+     * The function reads a 32-bit unsigned little-endian integer from the
+     * stream. It returns false when the stream ends before the integer.
+     */
+    static bool readUint32(std::istream &in, uint32_t &v)
+    {
+        unsigned char b[4];
+
+        if (!in.read((char *)b, 4))
+            return false;
+
+        v = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16)
+            | ((uint32_t)b[3] << 24);
+
+        return true;
+    }
+
+    /**
+     * writeUint32 ()
+     * The function writes a 32-bit unsigned little-endian integer to the
+     * stream.
+     */
+    static void writeUint32(std::ostream &out, uint32_t v)
+    {
+        unsigned char b[4];
+
+        b[0] = v & 0xff;
+        b[1] = (v >> 8) & 0xff;
+        b[2] = (v >> 16) & 0xff;
+        b[3] = (v >> 24) & 0xff;
+
+        out.write((const char *)b, 4);
+    }
+
+    /**
+     * suffixOf ()
+     * The function returns true when the name has the form 'prefix_n' and n
+     * can be stored as a number, i.e. n has no leading zeros and is below
+     * verbatimFlag. The number is returned in n.
+     */
+    static bool suffixOf(const CString &name, const char *prefix, uint32_t &n)
+    {
+        size_t len = strlen(prefix);
+        unsigned long long v = 0;
+
+        if (name.compare(0, len, prefix) != 0 || name.size() == len)
+            return false;
+
+        // Leading zeros would be lost
+        if (name[len] == '0' && name.size() != len + 1)
+            return false;
+
+        for (size_t i = len; i < name.size(); i++)
+        {
+            if (name[i] < '0' || name[i] > '9')
+                return false;
+
+            v = 10 * v + (name[i] - '0');
+            if (v >= verbatimFlag)
+                return false;
+        }
+
+        n = (uint32_t)v;
+        return true;
+    }
+
+    /**
+     * readName ()
+     * The function reads a name of a binary binding file. A number n refers
+     * to the name 'prefix_n', a number with the verbatimFlag set to an entry
+     * of the string table. It returns false when the stream ends before the
+     * name.
+     */
+    static bool readName(std::istream &in, const char *prefix,
+                         const vector<std::string> &strings,
+                         const CString &fileName, std::string &name)
+    {
+        uint32_t v;
+
+        if (!readUint32(in, v))
+            return false;
+
+        if ((v & verbatimFlag) == 0)
+        {
+            name = prefix + std::to_string(v);
+        }
+        else
+        {
+            if ((v & ~verbatimFlag) >= strings.size())
+                throw CException("Binding file '" + fileName + "' refers to "
+                                 "an unknown string.");
+            name = strings[v & ~verbatimFlag];
+        }
+
+        return true;
+    }
+
+    /**
+     * TileBindingFile ()
+     * Constructor. The function builds the name indices of the actors and
+     * tiles.
+     */
+    TileBindingFile::TileBindingFile(TimedSDFgraph *appGraph,
+                                     PlatformGraph *archGraph)
+        : appGraph(appGraph), archGraph(archGraph)
+    {
+        CId maxId = 0;
+
+        actors.reserve(appGraph->nrActors());
+        for (SDFactorsIter iter = appGraph->actorsBegin();
+             iter != appGraph->actorsEnd(); iter++)
+        {
+            SDFactor *a = *iter;
+
+            actors[a->getName()] = a;
+            if (a->getId() + 1 > maxId)
+                maxId = a->getId() + 1;
+        }
+        actorTile.assign(maxId, NULL);
+
+        tiles.reserve(archGraph->nrTiles());
+        for (TilesIter iter = archGraph->tilesBegin();
+             iter != archGraph->tilesEnd(); iter++)
+        {
+            tiles[(*iter)->getName()] = *iter;
+        }
+    }
+
+    /**
+     * read ()
+     * The function reads the binding from the file. Binary files are
+     * recognized on their magic, all other files are read as text. The
+     * function throws an exception when the file cannot be read or when it
+     * does not bind every actor of the application graph to exactly one tile.
+     */
+    void TileBindingFile::read(const CString &fileName)
+    {
+        char magic[binaryMagicSize];
+
+        std::ifstream in(fileName.c_str(), std::ios::in | std::ios::binary);
+        if (!in.is_open())
+            throw CException("Failed opening binding file '" + fileName
+                             + "'.");
+
+        records.clear();
+        actorTile.assign(actorTile.size(), NULL);
+
+        if (in.read(magic, binaryMagicSize)
+            && memcmp(magic, binaryMagic, binaryMagicSize) == 0)
+        {
+            readBinary(in, fileName, true);
+        }
+        else if (in.gcount() == (std::streamsize)binaryMagicSize
+                 && memcmp(magic, binaryMagicV1, binaryMagicSize) == 0)
+        {
+            readBinary(in, fileName, false);
+        }
+        else
+        {
+            in.clear();
+            in.seekg(0);
+            readText(in, fileName);
+        }
+
+        checkComplete();
+    }
+
+    /**
+     * readText ()
+     * The function reads the records of a text binding file.
+     */
+    void TileBindingFile::readText(std::istream &in, const CString &fileName)
+    {
+        vector<std::string> names;
+        std::string line, tile, actor;
+        uint lineNr = 0;
+
+        while (getline(in, line))
+        {
+            std::istringstream lineStream(line);
+
+            lineNr++;
+            if (!(lineStream >> tile))
+                continue;
+
+            names.clear();
+            while (lineStream >> actor)
+                names.push_back("actor_" + actor);
+
+            addRecord("tile_" + tile, names,
+                      fileName + ":" + CString(lineNr));
+        }
+    }
+
+    /**
+     * readBinary ()
+     * The function reads the records of a binary binding file. The magic has
+     * already been consumed. Files of version 1 have no string table.
+     */
+    void TileBindingFile::readBinary(std::istream &in,
+                                     const CString &fileName,
+                                     const bool hasStrings)
+    {
+        vector<std::string> names, strings;
+        uint32_t nrRecords, nrActors, nrStrings, length;
+        std::streamoff remaining;
+        std::string tile;
+
+        // Size of the rest of the file, used to check lengths from the file
+        std::streampos pos = in.tellg();
+        in.seekg(0, std::ios::end);
+        remaining = in.tellg() - pos;
+        in.seekg(pos);
+
+        if (hasStrings)
+        {
+            if (!readUint32(in, nrStrings) || nrStrings > remaining / 4)
+                throw CException("Binding file '" + fileName
+                                 + "' is truncated.");
+
+            strings.resize(nrStrings);
+            for (uint32_t i = 0; i < nrStrings; i++)
+            {
+                if (!readUint32(in, length) || length > remaining)
+                    throw CException("Binding file '" + fileName
+                                     + "' is truncated.");
+
+                strings[i].resize(length);
+                if (!in.read(&strings[i][0], length))
+                    throw CException("Binding file '" + fileName
+                                     + "' is truncated.");
+            }
+        }
+
+        if (!readUint32(in, nrRecords))
+            throw CException("Binding file '" + fileName + "' is truncated.");
+
+        // The count comes from the file, so do not trust it for the reserve
+        records.reserve(nrRecords < 65536 ? nrRecords : 65536);
+        for (uint32_t r = 0; r < nrRecords; r++)
+        {
+            if (!readName(in, "tile_", strings, fileName, tile)
+                || !readUint32(in, nrActors))
+            {
+                throw CException("Binding file '" + fileName
+                                 + "' is truncated.");
+            }
+
+            names.clear();
+            for (uint32_t i = 0; i < nrActors; i++)
+            {
+                std::string actor;
+
+                if (!readName(in, "actor_", strings, fileName, actor))
+                    throw CException("Binding file '" + fileName
+                                     + "' is truncated.");
+
+                names.push_back(actor);
+            }
+
+            addRecord(tile, names, fileName + " record " + CString(r));
+        }
+    }
+
+    /**
+     * addRecord ()
+     * The function binds the actors to the tile. The location is used to
+     * report errors.
+     */
+    void TileBindingFile::addRecord(const std::string &tile,
+                                    const vector<std::string> &names,
+                                    const CString &location)
+    {
+        Record record;
+
+        std::unordered_map<std::string, Tile *>::const_iterator t
+            = tiles.find(tile);
+        if (t == tiles.end())
+            throw CException(location + ": unknown tile '" + CString(tile)
+                             + "'.");
+        record.tile = t->second;
+
+        record.actors.reserve(names.size());
+        for (vector<std::string>::const_iterator iter = names.begin();
+             iter != names.end(); iter++)
+        {
+            std::unordered_map<std::string, SDFactor *>::const_iterator a
+                = actors.find(*iter);
+            if (a == actors.end())
+                throw CException(location + ": unknown actor '"
+                                 + CString(*iter) + "'.");
+
+            Tile *&bound = actorTile[a->second->getId()];
+            if (bound != NULL && bound != record.tile)
+            {
+                throw CException(location + ": actor '" + CString(*iter)
+                                 + "' is already bound to tile '"
+                                 + bound->getName() + "'.");
+            }
+            else if (bound == NULL)
+            {
+                bound = record.tile;
+                record.actors.push_back(a->second);
+            }
+        }
+
+        records.push_back(record);
+    }
+
+    /**
+     * checkComplete ()
+     * The function throws an exception when some actors of the application
+     * graph are not bound to a tile.
+     */
+    void TileBindingFile::checkComplete() const
+    {
+        CString unbound;
+        uint nrUnbound = 0;
+
+        for (SDFactorsIter iter = appGraph->actorsBegin();
+             iter != appGraph->actorsEnd(); iter++)
+        {
+            SDFactor *a = *iter;
+
+            if (actorTile[a->getId()] != NULL)
+                continue;
+
+            if (nrUnbound < 10)
+                unbound += (nrUnbound == 0 ? "" : ", ") + a->getName();
+            nrUnbound++;
+        }
+
+        if (nrUnbound != 0)
+        {
+            throw CException(CString(nrUnbound) + " actor(s) not bound to a "
+                             "tile: " + unbound
+                             + (nrUnbound > 10 ? ", ..." : "") + ".");
+        }
+    }
+
+    /**
+     * writeBinary ()
+     * The function writes the binding in the binary form to the file.
+     */
+    void TileBindingFile::writeBinary(const CString &fileName) const
+    {
+        std::ofstream out(fileName.c_str(), std::ios::out | std::ios::binary);
+        if (!out.is_open())
+            throw CException("Failed opening binding file '" + fileName
+                             + "'.");
+
+        // Names which cannot be stored as a number go to the string table
+        vector<CString> strings;
+        vector<uint32_t> tileIds(records.size());
+        vector< vector<uint32_t> > actorIds(records.size());
+
+        for (uint r = 0; r < records.size(); r++)
+        {
+            const Record &record = records[r];
+
+            if (!suffixOf(record.tile->getName(), "tile_", tileIds[r]))
+            {
+                tileIds[r] = verbatimFlag | strings.size();
+                strings.push_back(record.tile->getName());
+            }
+
+            actorIds[r].resize(record.actors.size());
+            for (uint i = 0; i < record.actors.size(); i++)
+            {
+                CString name = record.actors[i]->getName();
+
+                if (!suffixOf(name, "actor_", actorIds[r][i]))
+                {
+                    actorIds[r][i] = verbatimFlag | strings.size();
+                    strings.push_back(name);
+                }
+            }
+        }
+
+        if (strings.size() >= verbatimFlag)
+            throw CException("Binding has too many names for a binary "
+                             "binding file.");
+
+        out.write(binaryMagic, binaryMagicSize);
+
+        writeUint32(out, strings.size());
+        for (uint i = 0; i < strings.size(); i++)
+        {
+            writeUint32(out, strings[i].size());
+            out.write(strings[i].data(), strings[i].size());
+        }
+
+        writeUint32(out, records.size());
+        for (uint r = 0; r < records.size(); r++)
+        {
+            writeUint32(out, tileIds[r]);
+            writeUint32(out, actorIds[r].size());
+
+            for (uint i = 0; i < actorIds[r].size(); i++)
+                writeUint32(out, actorIds[r][i]);
+        }
+
+        if (!out.good())
+            throw CException("Failed writing binding file '" + fileName
+                             + "'.");
+    }
+
+}//namespace SDF
@@ -0,0 +1,132 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   binding_file.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Loader for custom actor-to-tile binding files
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef SDF_RESOURCE_ALLOCATION_TILE_ALLOCATION_BINDING_FILE_H_INCLUDED
+#define SDF_RESOURCE_ALLOCATION_TILE_ALLOCATION_BINDING_FILE_H_INCLUDED
+
+#include "../mpsoc_arch/graph.h"
+#include "../../base/timed/graph.h"
+#include <string>
+#include <unordered_map>
+namespace SDF
+{
+    /**
+     * TileBindingFile
+     * A custom binding of the actors of an application graph to the tiles of
+     * a platform graph. The binding is read from a file which lists for a
+     * number of tiles the actors bound to them. Tile n refers to the tile
+     * with name 'tile_n' and actor m to the actor with name 'actor_m'.
+     *
+     * The file is either a text file with one line per tile:
+     *
+     *     <tile> <actor> <actor> ...
+     *
+     * or a binary file which starts with the 8 byte magic 'SDF3TB02',
+     * followed by a string table, the number of records and the records
+     * themselves. The string table contains the number of strings and for
+     * each string its length and characters. A record contains the tile, the
+     * number of actors and the actors. A tile or actor n below 2^31 refers to
+     * the name 'tile_n' or 'actor_n'; with bit 31 set, the other bits give
+     * the entry of the string table with the name. Names which are not of
+     * this form, like 'actor_007', are stored in the string table. All
+     * numbers are 32-bit unsigned little-endian integers. Files with the
+     * magic 'SDF3TB01' have no string table and are still read.
+     *
+     * Names are resolved through hash tables, so reading a binding is linear
+     * in the size of the file and the graphs. Unknown tiles and actors,
+     * actors bound to more than one tile and actors without a tile are
+     * reported through a CException.
+     */
+    class TileBindingFile
+    {
+        public:
+            // Record of the file
+            struct Record
+            {
+                Tile *tile;
+                vector<SDFactor *> actors;
+            };
+            typedef vector<Record> Records;
+            typedef Records::const_iterator RecordsCIter;
+
+            // Constructor
+            TileBindingFile(TimedSDFgraph *appGraph, PlatformGraph *archGraph);
+
+            // Destructor
+            ~TileBindingFile() {};
+
+            // Read (text or binary) and write (binary)
+            void read(const CString &fileName);
+            void writeBinary(const CString &fileName) const;
+
+            // Tile to which actor with id a is bound
+            Tile *getTile(const CId a) const
+            {
+                return actorTile[a];
+            };
+
+            // Records in the order of the file
+            RecordsCIter recordsBegin() const
+            {
+                return records.begin();
+            };
+            RecordsCIter recordsEnd() const
+            {
+                return records.end();
+            };
+
+        private:
+            // Parsing
+            void readText(std::istream &in, const CString &fileName);
+            void readBinary(std::istream &in, const CString &fileName,
+                            const bool hasStrings);
+            void addRecord(const std::string &tile,
+                           const vector<std::string> &names,
+                           const CString &location);
+            void checkComplete() const;
+
+            // Graphs
+            TimedSDFgraph *appGraph;
+            PlatformGraph *archGraph;
+
+            // Name indices
+            std::unordered_map<std::string, SDFactor *> actors;
+            std::unordered_map<std::string, Tile *> tiles;
+
+            // Binding
+            Records records;
+            Tiles actorTile;
+    };
+
+}//namespace SDF
+#endif
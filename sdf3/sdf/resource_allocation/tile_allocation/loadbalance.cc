@@ -12,6 +12,11 @@
  *
  *  History         :
  *      11-04-06    :   Initial version.
+ *      17-10-26    :   Parallel multi-start binding search.
+ *      17-10-26    :   Incremental throughput analysis of time slices.
+ *      17-10-26    :   Indexed loader for custom tile bindings.
+ *      17-10-26    :   Incremental tile cost function.
+ *      17-10-26    :   Binary copy of the custom tile binding.
  *
  * $Id: loadbalance.cc,v 1.4.2.2 2010-04-25 02:08:52 mgeilen Exp $
  *
@@ -35,12 +40,15 @@
 
 #include "base/base.h"
 #include "loadbalance.h"
+#include "binding_file.h"
 #include "../../base/algo/cycle.h"
 #include "../scheduling/scheduling.h"
+#include "../mpsoc_arch/xml.h"
 
 #include <unordered_map>
 #include <fstream>
 #include <sstream>
+#include <exception>
 
 namespace SDF
 {
@@ -57,8 +65,10 @@ namespace SDF
     {
         maxCycleMean = NULL;
         tileLoad = NULL;
+        appLoad = 0;
         setConstantsTileCostFunction(1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
                                      1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0);
+        setBindingSearch(0);
     }
 
     /**
@@ -83,6 +93,25 @@ namespace SDF
         // Compute repetition vector
         repVec = computeRepetitionVector(appGraph);
 
+        // Computation load of the application graph when every actor is
+        // executed on its slowest processor
+        appLoad = 0;
+        for (SDFactorsIter iter = appGraph->actorsBegin();
+             iter != appGraph->actorsEnd(); iter++)
+        {
+            TimedSDFactor *a = (TimedSDFactor *) *iter;
+            SDFtime maxExecTime = 0;
+
+            for (TimedSDFactor::ProcessorsIter iterP = a->processorsBegin();
+                 iterP != a->processorsEnd(); iterP++)
+            {
+                if ((*iterP)->execTime > maxExecTime)
+                    maxExecTime = (*iterP)->execTime;
+            }
+
+            appLoad += repVec[a->getId()] * maxExecTime;
+        }
+
         // Cleanup existing cycle mean estimate
         delete [] maxCycleMean;
         maxCycleMean = NULL;
@@ -143,6 +172,21 @@ namespace SDF
         cnst_q = q;
     }
 
+    /**
+     * setBindingSearch ()
+     * The function sets the number of bindings which are explored by the
+     * binding search, the number of threads used to explore them and the seed
+     * of the random perturbations. With zero starts, the actors are bound to
+     * the tiles in a single greedy pass.
+     */
+    void LoadBalanceBinding::setBindingSearch(uint nrStarts, uint nrThreads,
+            uint seed)
+    {
+        nrSearchStarts = nrStarts;
+        nrSearchThreads = nrThreads;
+        searchSeed = seed;
+    }
+
     /**
      * estimateMaxCycleMean ()
      * The function estimates the maximum cycle mean of all actors in the
@@ -291,6 +335,27 @@ namespace SDF
         return sortedActors;
     }
 
+    /**
+     * addTileCostTerm ()
+     * The function adds the term c*x^e to the cost of every tile. Linear terms
+     * are computed without calls to pow, which allows the compiler to
+     * vectorize the loop.
+     */
+    static void addTileCostTerm(vector<double> &cost, const vector<double> &x,
+                                const double c, const double e)
+    {
+        if (e == 1)
+        {
+            for (uint i = 0; i < cost.size(); i++)
+                cost[i] += c * x[i];
+        }
+        else
+        {
+            for (uint i = 0; i < cost.size(); i++)
+                cost[i] += c * pow(x[i], e);
+        }
+    }
+
     /**
      * sortTilesOnLoad ()
      * The function sorts the list of tiles from a low to a high load to which actor
@@ -319,6 +384,11 @@ namespace SDF
      * The constants a, b, c, d, e are used to scale the various properties
      * determining the cost wrt each other. The constants k, l, m, n, o are used to
      * increase cost for heavily loaded tiles.
+     *
+     * The resource usage of the tiles is kept up-to-date by allocateResources
+     * and releaseResources (tileLoad and the bindings of the memories and
+     * network interfaces). Only the tiles to which the actors connected to
+     * actor a are bound are inspected channel by channel.
      */
     void LoadBalanceBinding::sortTilesOnLoad(TimedSDFactor *a, Tiles &tiles,
             double const_a, double const_b, double const_c, double const_d,
@@ -326,84 +396,83 @@ namespace SDF
             double const_l, double const_m, double const_n, double const_o,
             double const_p, double const_q)
     {
-        double procLoad, memLoad, inBwLoad, outBwLoad, bwLoad, connLoad, commLoad;
-        double newConnLoad, maxProcLoad, maxConnBinding = 0;
-        double *connBinding, *costOfTile;
-
-        // Initialize
-        connBinding = new double [(unsigned int) archGraph->nrTiles()];
-        costOfTile = new double [(unsigned int) archGraph->nrTiles()];
+        const uint nrTiles = tiles.size();
+        vector<double> procLoad(nrTiles), memLoad(nrTiles), bwLoad(nrTiles);
+        vector<double> connLoad(nrTiles), newConnLoad(nrTiles), commLoad(nrTiles);
+        vector<double> connBinding(nrTiles), cost(nrTiles, 0);
+        vector<double> connBindingOfTile;
+        vector<bool> neighborOnTile;
+        double maxProcLoad, maxConnBinding = 0;
+        double remoteInBw, remoteOutBw;
+        CSize remoteMem;
+        int remoteNrConn;
+        double *costOfTile;
+        uint i;
 
         // Estimate the maximum, average processing load to scale procLoad
-        maxProcLoad = 0;
-        for (SDFactorsIter iter = appGraph->actorsBegin();
-             iter != appGraph->actorsEnd(); iter++)
-        {
-            TimedSDFactor *b = (TimedSDFactor *) *iter;
-            SDFtime maxExecTime = 0;
+        maxProcLoad = appLoad / (double) archGraph->nrTiles();
 
-            for (TimedSDFactor::ProcessorsIter iterP = b->processorsBegin();
-                 iterP != b->processorsEnd(); iterP++)
-            {
-                if ((*iterP)->execTime > maxExecTime)
-                    maxExecTime = (*iterP)->execTime;
-            }
+        // Tiles to which the actors connected to actor a are bound
+        neighborOnTile.resize(archGraph->nrTiles(), false);
+        for (SDFportsIter iter = a->portsBegin(); iter != a->portsEnd(); iter++)
+        {
+            SDFport *p = *iter;
+            Tile *tB = actorTileBinding[p->getChannel()->oppositePort(p)
+                                        ->getActor()->getId()];
 
-            maxProcLoad += repVec[b->getId()] * maxExecTime;
+            if (tB != NULL)
+                neighborOnTile[tB->getId()] = true;
         }
-        maxProcLoad = maxProcLoad / (double) archGraph->nrTiles();
 
-        // Compute resource usage and cost for each tile
-        for (TilesIter iter = tiles.begin(); iter != tiles.end(); iter++)
+        // On all other tiles, every channel of actor a to a bound actor is
+        // mapped to a connection
+        remoteMem = memLoadChannelsOnTile(a, NULL);
+        remoteInBw = bwChannelsMappedToInConnection(a, NULL);
+        remoteOutBw = bwChannelsMappedToOutConnection(a, NULL);
+        remoteNrConn = nrChannelsMappedToConnection(a, NULL);
+
+        // Latency of the connections created by binding actor a to each tile
+        computeLoadOfChannelToConnectionBinding(a, connBindingOfTile);
+
+        // Compute resource usage for each tile
+        i = 0;
+        for (TilesIter iter = tiles.begin(); iter != tiles.end(); iter++, i++)
         {
             Tile *t = *iter;
             Processor *p = t->getProcessor();
             Memory *m = t->getMemory();
             NetworkInterface *ni = t->getNetworkInterface();
             bool actorOnTile = false;
+            double inBwLoad, outBwLoad;
+            CSize memCh = remoteMem;
+            double inBw = remoteInBw;
+            double outBw = remoteOutBw;
+            int nrConn = remoteNrConn;
 
             // Can actor a be mapped to tile t?
             if (p != NULL && a->getProcessor(p->getType()) != NULL)
                 actorOnTile = true;
 
-            // Processing load of actors mapped to tile t
-            procLoad = 0;
-            for (SDFactorsIter iterA = appGraph->actorsBegin();
-                 iterA != appGraph->actorsEnd(); iterA++)
+            // Channels to actors bound to tile t are not mapped to a connection
+            if (actorOnTile && neighborOnTile[t->getId()])
             {
-                TimedSDFactor *b = (TimedSDFactor *) *iterA;
-                Tile *tB = actorTileBinding[b->getId()];
-
-                // Actor b mapped to tile t?
-                if (tB != NULL && tB->getId() == t->getId())
-                {
-                    // Add total execution time for executing actor b on tile t
-                    // to processing load of tile t
-                    procLoad += actorLoadOnTile(b, t);
-                }
-
-                // Actor b is same as actor a which is considered for mapping
-                // and actor a can be mapped to tile t?
-                if (a->getId() == b->getId() && actorOnTile)
-                {
-                    // Add total execution time for executing actor a on tile t
-                    // to processing load of tile t
-                    procLoad += actorLoadOnTile(a, t);
-                }
+                memCh = memLoadChannelsOnTile(a, t);
+                inBw = bwChannelsMappedToInConnection(a, t);
+                outBw = bwChannelsMappedToOutConnection(a, t);
+                nrConn = nrChannelsMappedToConnection(a, t);
             }
 
-            // Add penalty for time wheel occupation
-            //procLoad = procLoad * (p->availableTimewheelSize()
-            //                                / (double) p->getTimewheelSize());
-            //if (p->availableTimewheelSize() > 0)
-            //    procLoad = procLoad * (p->getTimewheelSize()
-            //                            / (double) p->availableTimewheelSize());
+            // Processing load of actors mapped to tile t (including actor a
+            // when it can be mapped to tile t)
+            procLoad[i] = tileLoad[t->getId()];
+            if (actorOnTile)
+                procLoad[i] += actorLoadOnTile(a, t);
 
             // Scale procLoad
-            procLoad = procLoad / maxProcLoad;
+            procLoad[i] = procLoad[i] / maxProcLoad;
 
             // Memory
-            memLoad = (double)(m->getSize() - m->availableMemorySize());
+            memLoad[i] = (double)(m->getSize() - m->availableMemorySize());
             if (actorOnTile)
             {
                 // Is the memory reserved for actors not large enough?
@@ -411,81 +480,76 @@ namespace SDF
                     < a->getProcessor(p->getType())->stateSize)
                 {
                     // Increase memory needed for actor state
-                    memLoad = memLoad + a->getProcessor(p->getType())->stateSize
-                              - m->occupiedMemorySizeByActors();
+                    memLoad[i] = memLoad[i] + a->getProcessor(p->getType())->stateSize
+                                 - m->occupiedMemorySizeByActors();
                 }
 
                 // Add memory needed for newly mapped channels
-                memLoad += memLoadChannelsOnTile(a, t);
+                memLoad[i] += memCh;
             }
-            memLoad = memLoad / (double) m->getSize();
+            memLoad[i] = memLoad[i] / (double) m->getSize();
 
             // Incoming bandwidth
             inBwLoad = ni->getInBandwidth() - ni->availableInBandwidth();
             if (actorOnTile)
-                inBwLoad += bwChannelsMappedToInConnection(a, t);
+                inBwLoad += inBw;
             inBwLoad = inBwLoad / (double) ni->getInBandwidth();
 
             // Outgoing bandwidth
             outBwLoad = ni->getOutBandwidth() - ni->availableOutBandwidth();
             if (actorOnTile)
-                outBwLoad += bwChannelsMappedToOutConnection(a, t);
+                outBwLoad += outBw;
             outBwLoad = outBwLoad / (double) ni->getOutBandwidth();
 
             // Bandwidth
             if (inBwLoad > outBwLoad)
-                bwLoad = inBwLoad;
+                bwLoad[i] = inBwLoad;
             else
-                bwLoad = outBwLoad;
+                bwLoad[i] = outBwLoad;
 
             // Connections
-            connLoad = (double)(ni->getNrConnections() - ni->availableNrConnections());
+            connLoad[i] = (double)(ni->getNrConnections() - ni->availableNrConnections());
             if (actorOnTile)
-                connLoad += nrChannelsMappedToConnection(a, t);
-            connLoad = connLoad / (double) ni->getNrConnections();
+                connLoad[i] += nrConn;
+            connLoad[i] = connLoad[i] / (double) ni->getNrConnections();
 
             // New connections
-            newConnLoad = 0;
+            newConnLoad[i] = 0;
             if (actorOnTile)
-                newConnLoad = nrChannelsMappedToConnection(a, t);
-            newConnLoad = newConnLoad / (double) a->nrPorts();
+                newConnLoad[i] = nrConn;
+            newConnLoad[i] = newConnLoad[i] / (double) a->nrPorts();
 
             // Communication load
-            commLoad = (inBwLoad + outBwLoad + connLoad) / 3.0;
+            commLoad[i] = (inBwLoad + outBwLoad + connLoad[i]) / 3.0;
 
             // Connection binding
-            connBinding[t->getId()] = computeLoadOfChannelToConnectionBinding(a, t);
-            if (connBinding[t->getId()] > maxConnBinding)
-                maxConnBinding = connBinding[t->getId()];
-
-            // Cost of tile t
-            costOfTile[t->getId()]  = const_a * pow(procLoad, const_k);
-            costOfTile[t->getId()] += const_b * pow(memLoad, const_l);
-            costOfTile[t->getId()] += const_c * pow(bwLoad, const_m);
-            costOfTile[t->getId()] += const_d * pow(connLoad, const_n);
-            costOfTile[t->getId()] += const_e * pow(newConnLoad, const_o);
-            costOfTile[t->getId()] += const_f * pow(commLoad, const_p);
+            connBinding[i] = connBindingOfTile[t->getId()];
+            if (connBinding[i] > maxConnBinding)
+                maxConnBinding = connBinding[i];
         }
 
-        // Add cost of connections (latency) to the cost of every tile
-        for (TilesIter iter = tiles.begin(); iter != tiles.end(); iter++)
-        {
-            Tile *t = *iter;
-
-            // Connection binding (normalize wrt to maximal load)
-            connBinding[t->getId()] = connBinding[t->getId()] / maxConnBinding;
+        // Connection binding (normalize wrt to maximal load)
+        for (i = 0; i < nrTiles; i++)
+            connBinding[i] = connBinding[i] / maxConnBinding;
 
-            // Cost of tile t
-            costOfTile[t->getId()] += const_g
-                                      * pow(connBinding[t->getId()], const_q);
-        }
+        // Cost of the tiles
+        addTileCostTerm(cost, procLoad, const_a, const_k);
+        addTileCostTerm(cost, memLoad, const_b, const_l);
+        addTileCostTerm(cost, bwLoad, const_c, const_m);
+        addTileCostTerm(cost, connLoad, const_d, const_n);
+        addTileCostTerm(cost, newConnLoad, const_e, const_o);
+        addTileCostTerm(cost, commLoad, const_f, const_p);
+        addTileCostTerm(cost, connBinding, const_g, const_q);
 
         // Sort tiles on cost
+        costOfTile = new double [(unsigned int) archGraph->nrTiles()];
+        i = 0;
+        for (TilesIter iter = tiles.begin(); iter != tiles.end(); iter++, i++)
+            costOfTile[(*iter)->getId()] = cost[i];
         sortOnCost(tiles, costOfTile);
 
         // Cleanup
         delete [] costOfTile;
-        delete [] connBinding;
     }
 
     /**
@@ -636,41 +700,68 @@ namespace SDF
 
     /**
      * computeLoadOfChannelToConnectionBinding ()
-     * The function computes the cost of binding actor a to tile t in terms of the
-     * latency of the created connections. It computes the sum of the latency of
-     * all channels that are bound to a connection by binding actor a to tile t.
+     * The function computes for every tile t the cost of binding actor a to
+     * tile t in terms of the latency of the created connections. It computes
+     * the sum of the latency of all channels that are bound to a connection by
+     * binding actor a to tile t. The connections of the tiles to which the
+     * actors connected to actor a are bound are visited once, instead of
+     * searching the connection for every pair of tiles.
      */
-    double LoadBalanceBinding::computeLoadOfChannelToConnectionBinding(SDFactor *a,
-            Tile *t)
+    void LoadBalanceBinding::computeLoadOfChannelToConnectionBinding(SDFactor *a,
+            vector<double> &connBindingCost)
     {
-        PlatformGraph *archGraph = (PlatformGraph *)(t->getParent());
-        double connBindingCost = 0;
-        Connection *c;
+        vector<uint> visited(archGraph->nrTiles(), 0);
+        uint nrVisits = 0;
+
+        connBindingCost.assign(archGraph->nrTiles(), 0);
 
         for (SDFportsIter iterP = a->portsBegin();
              iterP != a->portsEnd(); iterP++)
         {
             SDFport *p = *iterP;
             SDFactor *b;
+            Tile *tB;
 
             // Opposite actor connected to channel c
             b = p->getChannel()->oppositePort(p)->getActor();
+            tB = actorTileBinding[b->getId()];
 
-            // Actor b mapped to a tile not equal to tile t?
-            if (actorTileBinding[b->getId()] != NULL
-                && actorTileBinding[b->getId()]->getId() != t->getId())
+            // Actor b not mapped?
+            if (tB == NULL)
+                continue;
+
+            // The first connection between tile tB and every tile t not equal
+            // to tile tB carries the channel
+            nrVisits++;
+            if (p->getType() == SDFport::In)
             {
+                for (ConnectionsIter iter = tB->outConnectionsBegin();
+                     iter != tB->outConnectionsEnd(); iter++)
+                {
+                    Tile *t = (*iter)->getDstTile();
 
-                if (p->getType() == SDFport::In)
-                    c = archGraph->getConnection(actorTileBinding[b->getId()], t);
-                else
-                    c = archGraph->getConnection(t, actorTileBinding[b->getId()]);
+                    if (t != tB && visited[t->getId()] != nrVisits)
+                    {
+                        visited[t->getId()] = nrVisits;
+                        connBindingCost[t->getId()] += (*iter)->getLatency();
+                    }
+                }
+            }
+            else
+            {
+                for (ConnectionsIter iter = tB->inConnectionsBegin();
+                     iter != tB->inConnectionsEnd(); iter++)
+                {
+                    Tile *t = (*iter)->getSrcTile();
 
-                connBindingCost += c->getLatency();
+                    if (t != tB && visited[t->getId()] != nrVisits)
+                    {
+                        visited[t->getId()] = nrVisits;
+                        connBindingCost[t->getId()] += (*iter)->getLatency();
+                    }
+                }
             }
         }
-
-        return connBindingCost;
     }
 
     /**
@@ -678,7 +769,8 @@ namespace SDF
      * The function returns the memory size needed to map all channels connected to
      * actor a when the actor is mapped to tile t. The size of a channel is only
      * considered when the other actor which is connected to the channel is already
-     * mapped to a tile.
+     * mapped to a tile. When t is NULL, none of these actors is mapped to the
+     * same tile as actor a.
      */
     CSize LoadBalanceBinding::memLoadChannelsOnTile(SDFactor *a, Tile *t)
     {
@@ -696,7 +788,7 @@ namespace SDF
             if (tB != NULL)
             {
                 // Actor b mapped to same tile as actor a?
-                if (t->getId() == tB->getId())
+                if (tB == t)
                 {
                     mem += c->getBufferSize().mem * c->getTokenSize();
                 }
@@ -722,7 +814,8 @@ namespace SDF
      * bwChannelsMappedToInConnection ()
      * The function returns the bandwidth of channels connected to the actor a which
      * will be mapped to an ingoing connection if the actor is mapped to tile t.
-     * Channels of which the other actor is not mapped are ignored.
+     * Channels of which the other actor is not mapped are ignored. When t is
+     * NULL, all other channels are mapped to a connection.
      */
     double LoadBalanceBinding::bwChannelsMappedToInConnection(SDFactor *a, Tile *t)
     {
@@ -743,7 +836,7 @@ namespace SDF
 
                 // Actor b mapped to a tile not equal to tile t?
                 if (actorTileBinding[b->getId()] != NULL
-                    && actorTileBinding[b->getId()]->getId() != t->getId())
+                    && actorTileBinding[b->getId()] != t)
                 {
                     bw += c->getMinBandwidth();
                 }
@@ -757,7 +850,8 @@ namespace SDF
      * bwChannelsMappedToOutConnection ()
      * The function returns the bandwidth of channels connected to the actor a which
      * will be mapped to an outgoing connection if the actor is mapped to tile t.
-     * Channels of which the other actor is not mapped are ignored.
+     * Channels of which the other actor is not mapped are ignored. When t is
+     * NULL, all other channels are mapped to a connection.
      */
     double LoadBalanceBinding::bwChannelsMappedToOutConnection(SDFactor *a, Tile *t)
     {
@@ -779,7 +873,7 @@ namespace SDF
 
                 // Actor b mapped to a tile not equal to tile t?
                 if (actorTileBinding[b->getId()] != NULL
-                    && actorTileBinding[b->getId()]->getId() != t->getId())
+                    && actorTileBinding[b->getId()] != t)
                 {
                     bw += c->getMinBandwidth();
                 }
@@ -793,7 +887,8 @@ namespace SDF
      * nrChannelsMappedToConnection ()
      * The function returns the number of channels connected to the actor a which
      * will be mapped to a connection if the actor is mapped to tile t. Channels of
-     * which the other actor is not mapped are ignored.
+     * which the other actor is not mapped are ignored. When t is NULL, all other
+     * channels are mapped to a connection.
      */
     int LoadBalanceBinding::nrChannelsMappedToConnection(SDFactor *a, Tile *t)
     {
@@ -811,7 +906,7 @@ namespace SDF
 
             // Actor b mapped to a tile not equal to tile t?
             if (actorTileBinding[b->getId()] != NULL
-                && actorTileBinding[b->getId()]->getId() != t->getId())
+                && actorTileBinding[b->getId()] != t)
             {
                 nrConnections++;
             }
@@ -1393,53 +1488,16 @@ namespace SDF
     bool LoadBalanceBinding::bindActorsToTiles()
     {
         SDFactorsIter actorIter;
-        SDFactors actors;
 
-        // Sort actors based on criticality
-        actors = sortActorsOnCriticality();
-
-        // Map actors one-by-one
-        actorIter = actors.begin();
-        while (actorIter != actors.end())
+        // Search for the best binding or bind the actors in a single pass
+        if (nrSearchStarts > 0 && tileBinding == "N/A")
         {
-            TimedSDFactor *a = (TimedSDFactor *)(*actorIter);
-            bool mappedActor = false;
-            Tiles tiles;
-
-            // Sort tiles based on load
-            tiles = archGraph->getTiles();
-            sortTilesOnLoad(a, tiles, cnst_a, cnst_b, cnst_c, cnst_d, cnst_e,
-                            cnst_f, cnst_g, cnst_k, cnst_l, cnst_m, cnst_n,
-                            cnst_o, cnst_p, cnst_q);
-
-            // Try resource allocation on tiles
-            for (TilesIter tileIter = tiles.begin();
-                 tileIter != tiles.end(); tileIter++)
-            {
-                Tile *t = *tileIter;
-
-                // Successfully allocated resources for the actor on the tile?
-                if (allocateResources(a, t))
-                {
-                    mappedActor = true;
-                    break;
-                }
-            }
-
-            // No resources allocated for the actor?
-            if (!mappedActor)
-            {
-#ifdef VERBOSE
-                cerr << "Failed allocating resources for actor '";
-                cerr << a->getName();
-                cerr << "'." << endl;
-#endif
-
+            if (!searchActorToTileBindings())
                 return false;
-            }
-
-            // Next actor
-            actorIter++;
+        }
+        else if (!bindActorsToTiles(sortActorsOnCriticality(), NULL))
+        {
+            return false;
         }
 
         // The mapping is successful now
@@ -1481,67 +1539,258 @@ namespace SDF
         releaseResources();
         std::cerr << "[DFSynthesizer] Custom actor-tile mapping." << std::endl;
 
-        std::unordered_map<std::string, std::string> actor_to_tile;
-        std::ifstream binding_file(tileBinding);
-        assert(binding_file.good());
-        std::string line;
-        getline(binding_file, line);
-        while (!binding_file.eof())
-        {
-            // std::cerr << line << std::endl;
-            std::stringstream line_stream(line);
-            std::vector<std::string> tokens;
-            std::string intermidiate;
-            while (getline(line_stream, intermidiate, ' '))
-            {
-                tokens.push_back(intermidiate);
-            }
-            assert(tokens.size());
+        TileBindingFile binding(appGraph, archGraph);
+        binding.read(tileBinding);
 
-            std::cerr << "[DFSynthesizer] Tile " << "tile_" << tokens[0] << ": ";
-            // Build binding table
-            std::string tile = "tile_" + tokens[0];
-            for (unsigned i = 1; i < tokens.size(); i++)
+        // Store a binary copy of the binding (faster to load next time)
+        if (tileBindingBinary != "N/A")
+            binding.writeBinary(tileBindingBinary);
+
+        for (TileBindingFile::RecordsCIter iter = binding.recordsBegin();
+             iter != binding.recordsEnd(); iter++)
+        {
+            std::cerr << "[DFSynthesizer] Tile " << iter->tile->getName()
+                      << ": ";
+            for (vector<SDFactor *>::const_iterator a = iter->actors.begin();
+                 a != iter->actors.end(); a++)
             {
-                std::cerr << "actor_" << tokens[i] << " ";
-                std::string actor = "actor_" + tokens[i];
-                actor_to_tile[actor] = tile;
+                std::cerr << (*a)->getName() << " ";
             }
             std::cerr << std::endl;
+        }
 
-            getline(binding_file, line);
+        for (actorIter = appGraph->actorsBegin();
+             actorIter != appGraph->actorsEnd(); actorIter++)
+        {
+            TimedSDFactor *a = (TimedSDFactor *)(*actorIter);
+            Tile *t = binding.getTile(a->getId());
+
+            if (!allocateResources(a, t))
+            {
+                std::cerr << "[INFO] Allocation of actor '" << a->getName()
+                          << "' to tile '" << t->getName() << "' failed."
+                          << std::endl;
+                return false;
+            }
         }
-        // for (auto [k, v] : actor_to_tile) { std::cerr << k << " : " << v << std::endl; }
-        // exit(0);
-        actors = appGraph->getActors();
-        actorIter = actors.begin();
-        while (actorIter != actors.end())
+
+        return true;
+    }
+
+    /**
+     * bindActorsToTiles ()
+     * Bind the actors one-by-one in the supplied order to a tile. Tiles are
+     * tried in order of their load. Tiles with an equal load are tried in the
+     * order of the platform graph or, when a random number generator is
+     * supplied, in a random order.
+     */
+    bool LoadBalanceBinding::bindActorsToTiles(const SDFactors &actors,
+            MTRand *tieBreaking)
+    {
+        for (SDFactorsCIter actorIter = actors.begin();
+             actorIter != actors.end(); actorIter++)
         {
             TimedSDFactor *a = (TimedSDFactor *)(*actorIter);
-            std::string tile_to_be_mapped = actor_to_tile[a->getName()];
+            bool mappedActor = false;
+            Tiles tiles;
+
+            // Shuffle tiles (the sort is stable, so this breaks ties randomly)
+            tiles = archGraph->getTiles();
+            if (tieBreaking != NULL)
+            {
+                for (uint i = tiles.size(); i > 1; i--)
+                {
+                    uint j = tieBreaking->randInt(i - 1);
+                    std::swap(tiles[i - 1], tiles[j]);
+                }
+            }
 
-            Tiles tiles = archGraph->getTiles();
+            // Sort tiles based on load
+            sortTilesOnLoad(a, tiles, cnst_a, cnst_b, cnst_c, cnst_d, cnst_e,
+                            cnst_f, cnst_g, cnst_k, cnst_l, cnst_m, cnst_n,
+                            cnst_o, cnst_p, cnst_q);
+
+            // Try resource allocation on tiles
             for (TilesIter tileIter = tiles.begin();
                  tileIter != tiles.end(); tileIter++)
             {
                 Tile *t = *tileIter;
 
-                if (t->getName() == tile_to_be_mapped)
+                // Successfully allocated resources for the actor on the tile?
+                if (allocateResources(a, t))
                 {
-                    if (!allocateResources(a, t))
-                    {
-                        std::cerr << "[INFO] Allocation failed." << std::endl;
-                        exit(0);
-                    }
+                    mappedActor = true;
+                    break;
                 }
             }
 
-            actorIter++;
+            // No resources allocated for the actor?
+            if (!mappedActor)
+            {
+#ifdef VERBOSE
+                cerr << "Failed allocating resources for actor '";
+                cerr << a->getName();
+                cerr << "'." << endl;
+#endif
+
+                return false;
+            }
         }
 
         return true;
     }
 
+    /**
+     * searchActorToTileBindings ()
+     * The function explores nrSearchStarts bindings of the actors to the tiles
+     * in parallel and applies the binding with the highest throughput to the
+     * platform graph. The first binding is the greedy binding. All other
+     * bindings perturb the weights of the tile cost function, swap actors
+     * which are adjacent in the criticality order and break ties between tiles
+     * randomly. Every binding is constructed on a private copy of the platform
+     * graph. Its throughput is analyzed with a static-order schedule on every
+     * tile and half of the available TDMA wheel of every used tile reserved,
+     * which is the starting point of the time slice allocation (see
+     * allocateTDMAtimeSlices). The random choices of a binding depend only on
+     * the seed and the index of the binding, so the outcome of the search does
+     * not depend on the number of threads. Ties in throughput are broken in
+     * favor of the binding with the lowest index.
+     */
+    bool LoadBalanceBinding::searchActorToTileBindings()
+    {
+        vector<LoadBalanceBinding *> candidates(nrSearchStarts, NULL);
+        vector<MTRand *> tieBreaking(nrSearchStarts, NULL);
+        vector<SDFactors> actorOrder(nrSearchStarts);
+        vector<double> thr(nrSearchStarts, -1);
+        SDFactors actors = sortActorsOnCriticality();
+        vector< vector<double> > tileUtilization(CNrWorkers(nrSearchStarts,
+                nrSearchThreads));
+        std::exception_ptr error;
+        uint best;
+
+        // Create the candidate bindings (the XML library is used to copy the
+        // platform graph and is only used from this thread)
+        CNode *archNode = createPlatformGraphNode(archGraph);
+        CNode *usageNode = createSystemUsageNode(archGraph);
+        for (uint i = 0; i < nrSearchStarts; i++)
+        {
+            LoadBalanceBinding *c = new LoadBalanceBinding(getFlowType());
+            PlatformGraph *g = constructPlatformGraph(archNode);
+            setUsagePlatformGraph(g, usageNode);
+
+            c->setAppGraph(appGraph);
+            c->setArchGraph(g);
+            c->setMaxPlusThroughputAnalysis(maxPlusThroughputAnalysis);
+            c->setConstantsTileCostFunction(cnst_a, cnst_b, cnst_c, cnst_d,
+                                            cnst_e, cnst_f, cnst_g, cnst_k, cnst_l, cnst_m, cnst_n,
+                                            cnst_o, cnst_p, cnst_q);
+            candidates[i] = c;
+            actorOrder[i] = actors;
+
+            // The first candidate is the greedy binding
+            if (i == 0)
+                continue;
+
+            MTRand *r = new MTRand(searchSeed + i);
+            tieBreaking[i] = r;
+
+            // Scale the weights of the tile cost function with a factor in
+            // [0.5,1.5]; unused terms get a small weight
+            double w[7] = { cnst_a, cnst_b, cnst_c, cnst_d, cnst_e, cnst_f,
+                            cnst_g
+                          };
+            for (uint j = 0; j < 7; j++)
+            {
+                if (w[j] == 0)
+                    w[j] = r->rand(0.1);
+                w[j] = w[j] * (0.5 + r->rand());
+            }
+            c->setConstantsTileCostFunction(w[0], w[1], w[2], w[3], w[4],
+                                            w[5], w[6], cnst_k, cnst_l, cnst_m, cnst_n, cnst_o,
+                                            cnst_p, cnst_q);
+
+            // Swap actors which are adjacent in the criticality order
+            vector<SDFactor *> order(actors.begin(), actors.end());
+            for (uint j = 1; j < order.size(); j++)
+            {
+                if (r->rand() < 0.2)
+                    std::swap(order[j - 1], order[j]);
+            }
+            actorOrder[i].assign(order.begin(), order.end());
+        }
+        CRemoveNode(archNode);
+        CRemoveNode(usageNode);
+
+        // Bind and analyze the candidates; the candidates are cleaned up
+        // before an exception is rethrown
+        try
+        {
+            CParallelFor(nrSearchStarts, nrSearchThreads, [&](uint i, uint t)
+            {
+                LoadBalanceBinding *c = candidates[i];
+
+                c->initTileLoad();
+                if (!c->bindActorsToTiles(actorOrder[i], tieBreaking[i]))
+                    return;
+
+                c->constructStaticOrderScheduleTiles();
+                c->reserveTimeSlices(0.5);
+                thr[i] = c->analyzeThroughput(tileUtilization[t]);
+                c->releaseTimeSlices();
+            });
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        // Select the binding with the highest throughput
+        best = nrSearchStarts;
+        for (uint i = 0; i < nrSearchStarts && !error; i++)
+        {
+            if (thr[i] >= 0 && (best == nrSearchStarts || thr[i] > thr[best]))
+                best = i;
+        }
+
+        // Apply the selected binding to the platform graph in the order in
+        // which it was constructed
+        bool success = (best < nrSearchStarts);
+        if (success)
+        {
+#ifdef VERBOSE
+            cerr << "Selected binding " << best << " of " << nrSearchStarts;
+            cerr << " (throughput: " << thr[best] << ")." << endl;
+#endif
+
+            for (SDFactorsIter iter = actorOrder[best].begin();
+                 iter != actorOrder[best].end() && success; iter++)
+            {
+                TimedSDFactor *a = (TimedSDFactor *)(*iter);
+                Tile *t = candidates[best]->actorTileBinding[a->getId()];
+
+                success = allocateResources(a, archGraph->getTile(t->getName()));
+            }
+
+            if (!success)
+                releaseResources();
+        }
+
+        // Cleanup
+        for (uint i = 0; i < nrSearchStarts; i++)
+        {
+            PlatformGraph *g = candidates[i]->getArchGraph();
+
+            delete candidates[i];
+            delete g;
+            delete tieBreaking[i];
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+
+        return success;
+    }
+
     /**
      * constructStaticOrderSchedules ()
      * The function generates a static-order schedule for each processor in the
@@ -1805,7 +2054,7 @@ namespace SDF
 
         // Analyze throughput
         startTimer(&timer);
-        thrGraph = analyzeThroughput(tileUtilization);
+        thrGraph = analyzeThroughputTimeSlices(tileUtilization);
         stopTimer(&timer);
 
 #ifdef VERBOSE
@@ -2121,7 +2370,7 @@ namespace SDF
 
         // Analyze throughput
         startTimer(&timer);
-        thrGraph = analyzeThroughput(tileUtilization);
+        thrGraph = analyzeThroughputTimeSlices(tileUtilization);
         stopTimer(&timer);
 
 #ifdef VERBOSE
@@ -2591,6 +2840,9 @@ namespace SDF
         cerr << "[INFO] Minimize time slices" << endl;
 #endif
 
+        // The binding-aware SDFG is reused while only time slices change
+        releaseTimeSliceAnalysis();
+
         success = minimizeTimeSlices(0.5, 0.01);
 
         if (success)
@@ -2605,7 +2857,7 @@ namespace SDF
             cerr << "[INFO] Tile utilization" << endl;
 
             // Analyze tile utilization
-            analyzeThroughput(tileUtilization);
+            analyzeThroughputTimeSlices(tileUtilization);
 
             for (TilesIter iter = archGraph->tilesBegin();
                  iter != archGraph->tilesEnd(); iter++)
@@ -2618,6 +2870,8 @@ namespace SDF
 #endif
         }
 
+        releaseTimeSliceAnalysis();
+
 #ifdef VERBOSE
         cerr << "[INFO] Verifying throughput constraint" << endl;
 #endif
@@ -12,6 +12,8 @@
  *
  *  History         :
  *      11-04-06    :   Initial version.
+ *      17-10-26    :   Parallel multi-start binding search.
+ *      17-10-26    :   Incremental tile cost function.
  *
  * $Id: loadbalance.h,v 1.3 2008-03-06 10:49:45 sander Exp $
  *
@@ -75,6 +77,12 @@ namespace SDF
             // Application graph (overload)
             void setAppGraph(TimedSDFgraph *g);
 
+            // Search over nrStarts actor to tile bindings using nrThreads
+            // threads (0 selects the number of hardware threads); a search
+            // with 0 starts performs a single greedy binding
+            void setBindingSearch(uint nrStarts, uint nrThreads = 0,
+                                  uint seed = 0);
+
         private:
             // Check bindings
             bool isActorBound(const SDFactor *a) const;
@@ -91,6 +99,8 @@ namespace SDF
 
             // Actor binding
             bool bindActorsToTiles();
+            bool bindActorsToTiles(const SDFactors &actors, MTRand *tieBreaking);
+            bool searchActorToTileBindings();
             void optimizeActorToTileBindings();
             bool moveActorBinding(TimedSDFactor *a, bool allowExistingTile);
 
@@ -116,7 +126,8 @@ namespace SDF
 
             // Resource estimation
             void estimateMaxCycleMean();
-            double computeLoadOfChannelToConnectionBinding(SDFactor *a, Tile *t);
+            void computeLoadOfChannelToConnectionBinding(SDFactor *a,
+                    vector<double> &connBindingCost);
             double bwChannelsMappedToInConnection(SDFactor *a, Tile *t);
             double bwChannelsMappedToOutConnection(SDFactor *a, Tile *t);
             CSize memLoadChannelsOnTile(SDFactor *a, Tile *t);
@@ -148,12 +159,21 @@ namespace SDF
             // Computation load of tiles
             double *tileLoad;
 
+            // Computation load of the application graph on its slowest
+            // processors
+            double appLoad;
+
             // Repetition vector application graph
             RepetitionVector repVec;
 
             // Constants used in tile sort function
             double cnst_a, cnst_b, cnst_c, cnst_d, cnst_e, cnst_f, cnst_g;
             double cnst_k, cnst_l, cnst_m, cnst_n, cnst_o, cnst_p, cnst_q;
+
+            // Settings of the binding search
+            uint nrSearchStarts;
+            uint nrSearchThreads;
+            uint searchSeed;
     };
 
 }//namespace SDF
@@ -41,6 +41,8 @@
 
 // Timed SDF graph
 #include "base/timed/graph.h"
+#include "base/timed/compiled_graph.h"
+#include "base/timed/stream.h"
 
 // Basic graph algorithms
 #include "base/algo/acyclic.h"
@@ -74,6 +76,7 @@
 #include "resource_allocation/mpsoc_arch/memory.h"
 #include "resource_allocation/mpsoc_arch/networkinterface.h"
 #include "resource_allocation/mpsoc_arch/processor.h"
+#include "resource_allocation/mpsoc_arch/stream.h"
 #include "resource_allocation/mpsoc_arch/tile.h"
 #include "resource_allocation/mpsoc_arch/xml.h"
 
@@ -12,6 +12,11 @@
  *
  *  History         :
  *      23-04-07    :   Initial version.
+ *      17-10-26    :   MCM of an SDF graph without an HSDF graph.
+ *      17-10-26    :   MCM with automatic selection of the algorithm.
+ *      17-10-26    :   Streaming graph loader and binary graph cache.
+ *      17-10-26    :   Buffer sizing with a specialized kernel.
+ *      17-10-26    :   Throughput with a specialized kernel.
  *
  * $Id: sdf3analysis.cc,v 1.10 2009-12-23 13:32:08 sander Exp $
  *
@@ -35,6 +40,7 @@
 
 #include "sdf3analysis.h"
 #include "../../sdf.h"
+#include <memory>
 using namespace SDF;
 namespace SDF
 {
@@ -74,6 +80,12 @@ namespace SDF
 
         // Mapping
         CNode *xmlMapping;
+
+        // Build graphs with the streaming parser
+        bool streamFlag;
+
+        // Binary graph cache (empty when not used)
+        std::unique_ptr<CBinaryCache> graphCache;
     } Settings;
 
     /**
@@ -91,10 +103,14 @@ namespace SDF
         out << "SDF3 " << TOOL << " (version " << DOTTED_VERSION ")" << endl;
         out << endl;
         out << "Usage: " << TOOL << " --graph <file> --algo <algorithm>";
-        out << " [--output <file>]";
+        out << " [--output <file> --stream --cache <dir>]";
         out << endl;
         out << "   --graph  <file>     input SDF graph" << endl;
         out << "   --output <file>     output file (default: stdout)" << endl;
+        out << "   --stream            build graphs with the streaming parser";
+        out << endl;
+        out << "   --cache <dir>       reuse graphs from a binary cache (implies";
+        out << " --stream)" << endl;
         out << "   --algo <algorithm>  analyze the graph with requested algorithm:";
         out << endl;
         out << "       consistency" << endl;
@@ -105,15 +121,15 @@ namespace SDF
         out << "       repetition_vector" << endl;
         out << "       repetition_vector_sum" << endl;
         out << "       strongly_connected_components" << endl;
-        out << "       mcm[(cycle,dasdan,karp,howard,yto,yto-mcr)]" << endl;
+        out << "       mcm[(cycle,dasdan,karp,howard,yto,yto-mcr,sdf,auto)]" << endl;
         out << "       mpthroughput" << endl;
         out << "       mpdelay" << endl;
         out << "       mpeigen" << endl;
         out << "       mpconverthsdf" << endl;
         out << "       is_hsdf" << endl;
         out << "       statistics" << endl;
-        out << "       throughput" << endl;
-        out << "       buffersize" << endl;
+        out << "       throughput[(specialize[(<dir>)])]" << endl;
+        out << "       buffersize[(specialize[(<dir>)])]" << endl;
         out << "       buffersize_ning_gao" << endl;
         out << "       buffersize_capacity_constrained" << endl;
         out << "       latency(method,srcActor,dstActor)" << endl;
@@ -227,6 +243,16 @@ namespace SDF
                 arg++;
                 settings.arguments = parseSwitchArgument(argv[arg]);
             }
+            else if (argv[arg] == CString("--stream"))
+            {
+                settings.streamFlag = true;
+            }
+            else if (argv[arg] == CString("--cache") && arg + 1 < argc)
+            {
+                arg++;
+                settings.graphCache.reset(new CBinaryCache(argv[arg]));
+                settings.streamFlag = true;
+            }
             else
             {
                 helpMessage(cerr);
@@ -328,6 +354,29 @@ namespace SDF
         return mappingNode;
     }
 
+    /**
+     * loadXmlSettings ()
+     * The function loads the XML data structures of the input file. With the
+     * streaming parser, this is only done when an algorithm needs them.
+     */
+    void loadXmlSettings()
+    {
+        // Already loaded?
+        if (settings.xmlAppGraph != NULL)
+            return;
+
+        // Load application graph
+        settings.xmlAppGraph = loadApplicationGraphFromFile(settings.graphFile,
+                               MODULE);
+
+        // Load architecture graph
+        settings.xmlArchGraph = loadArchitectureGraphFromFile(settings.graphFile,
+                                MODULE);
+
+        // Load mapping
+        settings.xmlMapping = loadMappingFromFile(settings.graphFile, MODULE);
+    }
+
     /**
      * initSettings ()
      * The function initializes the program settings.
@@ -344,16 +393,9 @@ namespace SDF
             throw CException("");
         }
 
-        // Load application graph
-        settings.xmlAppGraph = loadApplicationGraphFromFile(settings.graphFile,
-                               MODULE);
-
-        // Load architecture graph
-        settings.xmlArchGraph = loadArchitectureGraphFromFile(settings.graphFile,
-                                MODULE);
-
-        // Load mapping
-        settings.xmlMapping = loadMappingFromFile(settings.graphFile, MODULE);
+        // Load XML data structures
+        if (!settings.streamFlag)
+            loadXmlSettings();
     }
 
     /**
@@ -468,7 +510,11 @@ namespace SDF
             // Measure execution time
             startTimer(&timer);
 
-            hsdfGraph = (TimedSDFgraph *)transformSDFtoHSDF(g);
+            // The 'sdf' algorithm works on the SDF graph itself
+            if (analyze.front().value == "sdf")
+                hsdfGraph = NULL;
+            else
+                hsdfGraph = (TimedSDFgraph *)transformSDFtoHSDF(g);
 
             if (analyze.front().value.empty() || analyze.front().value == "cycle")
             {
@@ -494,6 +540,14 @@ namespace SDF
             {
                 mcm = maximumCycleYoungTarjanOrlin(hsdfGraph, false);
             }
+            else if (analyze.front().value == "sdf")
+            {
+                mcm = maximumCycleMeanSDF(g);
+            }
+            else if (analyze.front().value == "auto")
+            {
+                mcm = maximumCycleMeanAuto(hsdfGraph);
+            }
             else
             {
                 throw CException("Unknown MCM algorithm.");
@@ -512,13 +566,33 @@ namespace SDF
         }
         else if (analyze.front().key == "throughput")
         {
-            SDFstateSpaceThroughputAnalysis thrAnalysisAlgo;
+            CPairs options = parseSwitchArgument(analyze.front().value);
             double thr;
 
             // Measure execution time
             startTimer(&timer);
 
-            thr = thrAnalysisAlgo.analyze(g);
+            if (options.empty())
+            {
+                SDFstateSpaceThroughputAnalysis thrAnalysisAlgo;
+                thr = thrAnalysisAlgo.analyze(g);
+            }
+            else if (options.front().key == "specialize")
+            {
+                CString dir = options.front().value;
+
+                // Kernels are cached in the per-user cache by default
+                if (dir.empty())
+                    dir = SDFbuffyKernelBufferAnalysis::defaultCacheDir();
+
+                SDFbuffyKernelBufferAnalysis thrAnalysisAlgo(dir);
+                thr = thrAnalysisAlgo.analyzeThroughput(g);
+            }
+            else
+            {
+                throw CException("Unknown option '" + options.front().key
+                                 + "' for throughput.");
+            }
 
             // Measure execution time
             stopTimer(&timer);
@@ -582,9 +656,29 @@ namespace SDF
         else if (analyze.front().key == "buffersize")
         {
             StorageDistributionSet *minStorageDistributions;
-            SDFstateSpaceBufferAnalysis bufferAnalysisAlgo;
+            CPairs options = parseSwitchArgument(analyze.front().value);
+
+            if (options.empty())
+            {
+                SDFstateSpaceBufferAnalysis bufferAnalysisAlgo;
+                minStorageDistributions = bufferAnalysisAlgo.analyze(g);
+            }
+            else if (options.front().key == "specialize")
+            {
+                CString dir = options.front().value;
 
-            minStorageDistributions = bufferAnalysisAlgo.analyze(g);
+                // Kernels are cached in the per-user cache by default
+                if (dir.empty())
+                    dir = SDFbuffyKernelBufferAnalysis::defaultCacheDir();
+
+                SDFbuffyKernelBufferAnalysis bufferAnalysisAlgo(dir);
+                minStorageDistributions = bufferAnalysisAlgo.analyze(g);
+            }
+            else
+            {
+                throw CException("Unknown option '" + options.front().key
+                                 + "' for buffersize.");
+            }
 
             out << "<?xml version='1.0' encoding='UTF-8'?>" << endl;
             out << "<sdf3 type='sdf' version='1.0'" << endl;
@@ -915,11 +1009,22 @@ namespace SDF
             }
 
             // Create a platform graph
-            if (settings.xmlArchGraph == NULL)
-                throw CException("No architectureGraph given.");
-            platformGraph = constructPlatformGraph(settings.xmlArchGraph);
+            if (settings.streamFlag)
+            {
+                platformGraph = loadPlatformGraph(settings.graphFile, MODULE,
+                                                  settings.graphCache.get());
+                if (platformGraph == NULL)
+                    throw CException("No architectureGraph given.");
+            }
+            else
+            {
+                if (settings.xmlArchGraph == NULL)
+                    throw CException("No architectureGraph given.");
+                platformGraph = constructPlatformGraph(settings.xmlArchGraph);
+            }
 
             // Set the mapping of the application onto the platform graph
+            loadXmlSettings();
             if (settings.xmlMapping == NULL)
                 throw CException("No mapping given.");
             setMappingPlatformGraph(platformGraph, g, settings.xmlMapping);
@@ -992,6 +1097,7 @@ namespace SDF
             MaxPlusAnalysis::Exploration mpe;
             mpe.G = G;
 
+            loadXmlSettings();
             CNode *sdfPropertiesNode = CGetChildNode(settings.xmlAppGraph, "sdfProperties");
             if (sdfPropertiesNode == NULL)
                 throw CException("Invalid xml file - missing 'sdfProperties' node");
@@ -1131,15 +1237,24 @@ namespace SDF
         TimedSDFgraph *sdfGraph;
         CNode *sdfNode, *sdfPropertiesNode;
 
-        // Find sdf graph in XML structure
-        sdfNode = CGetChildNode(settings.xmlAppGraph, "sdf");
-        if (sdfNode == NULL)
-            throw CException("Invalid xml file - missing 'sdf' node");
-        sdfPropertiesNode = CGetChildNode(settings.xmlAppGraph, "sdfProperties");
-
-        // Construction SDF graph model
-        sdfGraph = new TimedSDFgraph();
-        sdfGraph->construct(sdfNode, sdfPropertiesNode);
+        if (settings.streamFlag)
+        {
+            // Construct SDF graph model while streaming the file
+            sdfGraph = loadTimedSDFgraph(settings.graphFile, MODULE,
+                                         settings.graphCache.get());
+        }
+        else
+        {
+            // Find sdf graph in XML structure
+            sdfNode = CGetChildNode(settings.xmlAppGraph, "sdf");
+            if (sdfNode == NULL)
+                throw CException("Invalid xml file - missing 'sdf' node");
+            sdfPropertiesNode = CGetChildNode(settings.xmlAppGraph, "sdfProperties");
+
+            // Construction SDF graph model
+            sdfGraph = new TimedSDFgraph();
+            sdfGraph->construct(sdfNode, sdfPropertiesNode);
+        }
 
         // The actual analysis...
         analyzeSDFG(sdfGraph, settings.arguments, out);
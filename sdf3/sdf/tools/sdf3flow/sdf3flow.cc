@@ -12,6 +12,8 @@
  *
  *  History         :
  *      07-02-07    :   Initial version.
+ *      17-10-26    :   Batch mode with concurrent mapping jobs.
+ *      17-10-26    :   Binary copy of the custom tile binding.
  *
  * $Id: sdf3flow.cc,v 1.5 2008-05-07 11:29:38 sander Exp $
  *
@@ -36,6 +38,10 @@
 #include "sdf3flow.h"
 #include "settings.h"
 #include "../../sdf.h"
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <sstream>
 using namespace SDF;
 namespace SDF
 {
@@ -56,13 +62,25 @@ namespace SDF
         out << "SDF3 " << TOOL << " (version " << DOTTED_VERSION ")" << endl;
         out << endl;
         out << "Usage: " << TOOL << " [--settings <file> --output <file>";
-        out << " --step]";
+        out << " --step --batch <file> --threads <n>";
+        out << " --binary-binding <file> --stream --cache <dir>]";
         out << endl;
         out << "   --settings <file>  settings for algorithms (default: sdf3.opt)";
         out << endl;
         out << "   --output <file>    output file (default:stdout)" << endl;
         out << "   --step             run flow step-by-step" << endl;
         out << "   --html             output result of flow in HTML" << endl;
+        out << "   --batch <file>     run the mapping jobs of a manifest";
+        out << endl;
+        out << "   --threads <n>      number of concurrent jobs in batch mode";
+        out << " (default: hardware threads)" << endl;
+        out << "   --binary-binding <file>  write the custom tile binding in";
+        out << " binary form" << endl;
+        out << "   --stream           build the application and architecture";
+        out << " graphs with the" << endl;
+        out << "                      streaming parser" << endl;
+        out << "   --cache <dir>      reuse graphs from a binary cache (implies";
+        out << " --stream)" << endl;
         out << endl;
     }
 
@@ -89,15 +107,65 @@ namespace SDF
         return true;
     }
 
+    /**
+     * jobFileName ()
+     * The function returns the name of a file of a job. This is the file with
+     * the name of the job and an underscore put in front of its base name.
+     */
+    CString jobFileName(const MappingJob &job, const CString &fileName)
+    {
+        CString::size_type pos = fileName.rfind('/');
+        CString dir, file;
+
+        if (pos == CString::npos)
+            return job.name + "_" + fileName;
+
+        dir = fileName.substr(0, pos + 1);
+        file = fileName.substr(pos + 1);
+
+        return dir + job.name + "_" + file;
+    }
+
+    /**
+     * createAppGraph ()
+     * The function constructs the application graph of a job from the binary
+     * form of the graph. Every job works on its own copy.
+     */
+    TimedSDFgraph *createAppGraph(const MappingJob &job)
+    {
+        CBinaryReader in(job.appGraph->sdfGraph.data(),
+                         job.appGraph->sdfGraph.size());
+
+        return readTimedSDFgraph(in);
+    }
+
+    /**
+     * createPlatformGraph ()
+     * The function constructs the platform graph of a job from the binary
+     * form of its architecture graph. The flow modifies the platform graph,
+     * so every job works on its own copy.
+     */
+    PlatformGraph *createPlatformGraph(const MappingJob &job)
+    {
+        CBinaryReader in(job.archGraph->platformGraph.data(),
+                         job.archGraph->platformGraph.size());
+
+        return readPlatformGraph(in);
+    }
+
     /**
      * mapApplicationGraphToArchitectureGraph ()
-     * The complete mapping flow. The function returns the system usage
-     * after the mapping is completed. On failure, it returns NULL.
+     * The complete mapping flow of a job. The function returns the system usage
+     * after the mapping is completed. On failure, it returns NULL. The XML
+     * nodes of the job and the system usage are only read, so different jobs
+     * can be mapped concurrently. Messages on the progress of the flow are
+     * written to the stream msg.
      */
-    CNode *mapApplicationGraphToArchitectureGraph(CNode *xmlAppGraph,
-            CNode *xmlArchGraph, CNode *xmlSystemUsage, ostream &out,
+    CNode *mapApplicationGraphToArchitectureGraph(const MappingJob &job,
+            CNode *xmlSystemUsage, ostream &out, ostream &msg,
             bool outputAsHTML)
     {
+        const TileCostConstants &cnst = job.constants;
         NoCScheduler *nocMappingAlgo;
         TileMapping *tileMapping;
         NoCMapping *nocMapping;
@@ -107,28 +175,45 @@ namespace SDF
         CTimer timer;
 
         // Create a new mapping flow
-        flow = new SDF3Flow(settings.flowType, xmlAppGraph, xmlArchGraph,
-                            xmlSystemUsage);
+        flow = new SDF3Flow(settings.flowType, createAppGraph(job),
+                            createPlatformGraph(job),
+                            job.archGraph->xmlArchGraph, xmlSystemUsage);
 
-        if (settings.tileBinding != "N/A")
+        if (job.tileBinding != "N/A")
         {
-            flow->setCustomTileBinding(settings.tileBinding);
+            flow->setCustomTileBinding(job.tileBinding);
+
+            // Binary copy of the binding (one per job when running more jobs)
+            if (!settings.binaryBindingFile.empty())
+            {
+                if (settings.jobs.size() == 1)
+                    flow->setBinaryTileBindingFile(settings.binaryBindingFile);
+                else
+                    flow->setBinaryTileBindingFile(
+                        jobFileName(job, settings.binaryBindingFile));
+            }
         }
 
-        // Run flow step-by-step?
-        if (settings.stepFlag)
+        // Run flow step-by-step? (not in batch mode)
+        if (settings.stepFlag && settings.batchFile.empty())
             flow->setStepMode(true);
 
+        // Jobs in batch mode end with the time-slice allocation
+        if (!settings.batchFile.empty())
+            flow->setCompleteAfterTimeSlices(true);
+
         // Tile binding and scheduling algorithm
         if (settings.tileMappingAlgo == "loadbalance")
         {
             tileMapping = new LoadBalanceBinding(flow->getFlowType());
             ((LoadBalanceBinding *)(tileMapping))->setConstantsTileCostFunction(
-                settings.cnst_a, settings.cnst_b, settings.cnst_c,
-                settings.cnst_d, settings.cnst_e, settings.cnst_f,
-                settings.cnst_g, settings.cnst_k, settings.cnst_l,
-                settings.cnst_m, settings.cnst_n, settings.cnst_o,
-                settings.cnst_p, settings.cnst_q);
+                cnst.a, cnst.b, cnst.c, cnst.d, cnst.e, cnst.f, cnst.g,
+                cnst.k, cnst.l, cnst.m, cnst.n, cnst.o, cnst.p, cnst.q);
+            ((LoadBalanceBinding *)(tileMapping))->setBindingSearch(
+                settings.bindingSearchStarts, settings.bindingSearchThreads,
+                settings.bindingSearchSeed);
+            tileMapping->setMaxPlusThroughputAnalysis(
+                settings.maxPlusThroughputAnalysis);
         }
         else
         {
@@ -177,9 +262,9 @@ namespace SDF
         // Measure execution time
         stopTimer(&timer);
 
-        cerr << "Execution time: ";
-        printTimer(cerr, &timer);
-        cerr << endl;
+        msg << "Execution time: ";
+        printTimer(msg, &timer);
+        msg << endl;
 
         // Output the result of the flow
         flow->outputMappingAsXML(out);
@@ -191,6 +276,7 @@ namespace SDF
         if (status != SDF3Flow::FlowCompleted)
         {
             logError("Failed to complete flow.");
+            delete flow;
             return NULL;
         }
 
@@ -201,10 +287,24 @@ namespace SDF
         // Retrieve system usage in XML format
         xmlSDF3Node = flow->createSDF3Node();
 
+        // Cleanup
+        delete flow;
+
         // Done
         return CGetChildNode(xmlSDF3Node, "systemUsage");
     }
 
+    /**
+     * jobOutputFile ()
+     * The function returns the name of the output file of a job. This is the
+     * output file with the name of the job and an underscore put in front of
+     * its base name.
+     */
+    CString jobOutputFile(const MappingJob &job)
+    {
+        return jobFileName(job, settings.outputFile);
+    }
+
     /**
      * mapApplicationGraphsToArchitectureGraph ()
      * Map all application graphs in the order specified by the settings to
@@ -214,25 +314,21 @@ namespace SDF
     {
         CNode *xmlSystemUsage = settings.xmlSystemUsage;
 
-        for (list<CNode *>::iterator appsIter = settings.xmlAppGraphs.begin();
-             appsIter != settings.xmlAppGraphs.end(); appsIter++)
+        for (MappingJobsIter iter = settings.jobs.begin();
+             iter != settings.jobs.end(); iter++)
         {
-            CNode *xmlAppGraph = *appsIter;
-            CString appName;
             ofstream outFile;
 
             // Output every mapping to a different file
-            if (!settings.outputFile.empty() && settings.xmlAppGraphs.size() != 1)
+            if (!settings.outputFile.empty() && settings.jobs.size() != 1)
             {
-                appName = CGetAttribute(xmlAppGraph, "name");
-                outFile.open(appName + "_" + settings.outputFile);
+                outFile.open(jobOutputFile(*iter));
                 out.rdbuf(outFile.rdbuf());
             }
 
             // Map application to architecture
-            xmlSystemUsage = mapApplicationGraphToArchitectureGraph(xmlAppGraph,
-                             settings.xmlArchGraph, xmlSystemUsage, out,
-                             settings.outputAsHTML);
+            xmlSystemUsage = mapApplicationGraphToArchitectureGraph(*iter,
+                             xmlSystemUsage, out, cerr, settings.outputAsHTML);
 
             // Flow failed?
             if (xmlSystemUsage == NULL)
@@ -242,6 +338,79 @@ namespace SDF
         return true;
     }
 
+    /**
+     * mapJobsConcurrently ()
+     * Run all jobs of the batch manifest on a pool of worker threads. The jobs
+     * are independent: every job starts from the system usage given in the
+     * settings. The result of a job is written as soon as the job finishes,
+     * either to its own file (name_output) or to the output stream. The
+     * function returns true when all jobs completed.
+     */
+    bool mapJobsConcurrently(ostream &out)
+    {
+        vector<MappingJob *> jobs;
+        std::atomic<uint> nrFailed(0);
+        std::mutex outputMutex;
+
+        for (MappingJobsIter iter = settings.jobs.begin();
+             iter != settings.jobs.end(); iter++)
+        {
+            jobs.push_back(&(*iter));
+        }
+
+        // Map the jobs on a pool of threads
+        CParallelFor(jobs.size(), settings.nrThreads, [&](uint i, uint)
+        {
+            MappingJob *job = jobs[i];
+            ostringstream result, messages;
+            CString error;
+            bool completed = false;
+
+            try
+            {
+                completed = mapApplicationGraphToArchitectureGraph(*job,
+                            settings.xmlSystemUsage, result, messages,
+                            false) != NULL;
+            }
+            catch (CException &e)
+            {
+                error = e.getMessage();
+            }
+            catch (std::exception &e)
+            {
+                error = e.what();
+            }
+
+            if (!completed)
+                nrFailed++;
+
+            // Stream the result of the job
+            std::lock_guard<std::mutex> lock(outputMutex);
+
+            if (!settings.outputFile.empty())
+            {
+                ofstream outFile;
+
+                outFile.open(jobOutputFile(*job));
+                outFile << result.str();
+            }
+            else
+            {
+                out << result.str();
+                out.flush();
+            }
+
+            cerr << messages.str();
+            cerr << "Job '" << job->name << "' ";
+            cerr << (completed ? "completed" : "failed");
+            if (!error.empty())
+                cerr << ": " << error;
+            cerr << endl;
+        });
+
+        return nrFailed == 0;
+    }
+
 }//namespace SDF
 /**
  * main ()
@@ -258,7 +427,14 @@ int main(int argc, char **argv)
             return 1;
 
         // Run mapping flow
-        if (mapApplicationGraphsToArchitectureGraph(settings.outputStream))
+        if (!settings.batchFile.empty())
+        {
+            if (mapJobsConcurrently(settings.outputStream))
+                exit_status = 0;
+            else
+                exit_status = 1;
+        }
+        else if (mapApplicationGraphsToArchitectureGraph(settings.outputStream))
             exit_status = 0;
         else
             exit_status = 1;
@@ -12,6 +12,10 @@
  *
  *  History         :
  *      24-07-07    :   Initial version.
+ *      17-10-26    :   Batch mode with a manifest of mapping jobs.
+ *      17-10-26    :   Binary copy of the custom tile binding.
+ *      17-10-26    :   Platform graph built once per architecture.
+ *      17-10-26    :   Streaming graph loader and binary graph cache.
  *
  * $Id: settings.cc,v 1.4 2008-03-20 16:16:21 sander Exp $
  *
@@ -60,11 +64,21 @@ namespace SDF
         // Output results as HTML
         outputAsHTML = false;
 
+        // No batch mode
+        batchFile = "";
+        nrThreads = 0;
+
+        // No binary copy of the custom tile binding
+        binaryBindingFile = "";
+
+        // Build graphs from the document tree (no cache)
+        streamFlag = false;
+
         // Flow type
         flowType = SDFflowTypeNSoC;
 
         // Architecture graph
-        xmlArchGraph = NULL;
+        archGraph = NULL;
         xmlSystemUsage = NULL;
 
         // Tile mapping algorithm
@@ -73,10 +87,13 @@ namespace SDF
         // NoC mapping algorithm
         nocMappingAlgo = "greedy";
 
-        // Constants used in tile cost function
-        cnst_a = 1;
-        cnst_b = cnst_c = cnst_d = cnst_e = cnst_f = cnst_g = 0;
-        cnst_k = cnst_l = cnst_m = cnst_n = cnst_o = cnst_p = cnst_q = 1;
+        // Search over multiple tile bindings (disabled)
+        bindingSearchStarts = 0;
+        bindingSearchThreads = 0;
+        bindingSearchSeed = 0;
+
+        // Throughput analysis on the state space
+        maxPlusThroughputAnalysis = false;
 
         // Constrains used in NoC scheduling problem
         maxDetour = 0;
@@ -123,6 +140,10 @@ namespace SDF
 
         // Parse settings file
         parseSettingsFile();
+
+        // Parse batch manifest
+        if (!batchFile.empty())
+            parseBatchFile();
     }
 
     /**
@@ -168,6 +189,31 @@ namespace SDF
             {
                 outputAsHTML = true;
             }
+            else if (arg == "--batch")
+            {
+                batchFile = argNext;
+                argIter++;
+            }
+            else if (arg == "--threads")
+            {
+                nrThreads = (uint)CString(argNext);
+                argIter++;
+            }
+            else if (arg == "--binary-binding")
+            {
+                binaryBindingFile = argNext;
+                argIter++;
+            }
+            else if (arg == "--stream")
+            {
+                streamFlag = true;
+            }
+            else if (arg == "--cache")
+            {
+                graphCache.reset(new CBinaryCache(argNext));
+                streamFlag = true;
+                argIter++;
+            }
             else
             {
                 helpFlag = true;
@@ -183,12 +229,12 @@ namespace SDF
     {
         CNode *maxDetourNode, *maxNrRipupsNode, *maxNrTriesNode;
         CNode *tileMappingNode, *nocMappingNode, *systemUsageNode;
-        CNode *constantsNode, *constantNode, *constraintsNode;
+        CNode *constantsNode, *constraintsNode, *searchNode, *thrAnalysisNode;
         CNode *settingsNode, *archGraphNode, *appGraphNode;
         CNode *sdf3Node, *flowTypeNode;
-        CString name, file, flowTypeString;
+        CString file, flowTypeString;
+        list<const ApplicationGraph *> appGraphs;
         CDoc *settingsDoc;
-        double value;
 
         // Open settings file and get root node
         settingsDoc = CParseFile(settingsFile);
@@ -255,24 +301,28 @@ namespace SDF
 
             // Load the application from the specified file
             file = CGetAttribute(appGraphNode, "file");
-            xmlAppGraphs.push_back(loadApplicationGraphFromFile(file));
+            appGraphs.push_back(loadApplicationGraphFromFile(file));
 
             // Next application graph
             appGraphNode =  CNextNode(appGraphNode, "applicationGraph");
         }
 
-        // At least one application is needed
-        if (xmlAppGraphs.size() == 0)
+        // At least one application is needed (unless the batch manifest
+        // specifies the applications)
+        if (appGraphs.size() == 0 && batchFile.empty())
             throw CException("No applicationGraph specified.");
 
-        // Architecture graph
+        // Architecture graph (the batch manifest may specify it per job)
         archGraphNode =  CGetChildNode(settingsNode, "architectureGraph");
-        if (archGraphNode == NULL)
+        if (archGraphNode == NULL && batchFile.empty())
             throw CException("No architectureGraph specified.");
-        if (!CHasAttribute(archGraphNode, "file"))
-            throw CException("Missing file attribute on architectureGraph.");
-        file = CGetAttribute(archGraphNode, "file");
-        xmlArchGraph = loadArchitectureGraphFromFile(file);
+        if (archGraphNode != NULL)
+        {
+            if (!CHasAttribute(archGraphNode, "file"))
+                throw CException("Missing file attribute on architectureGraph.");
+            file = CGetAttribute(archGraphNode, "file");
+            archGraph = loadArchitectureGraphFromFile(file);
+        }
 
         // Custom tile binding
         CNode *tileBindingNode = CGetChildNode(settingsNode, "TileBinding");
@@ -312,43 +362,36 @@ namespace SDF
         // Constants used in tile cost function
         constantsNode = CGetChildNode(tileMappingNode, "constants");
         if (constantsNode != NULL)
+            parseConstants(constantsNode, constants);
+
+        // Search over multiple tile bindings
+        searchNode = CGetChildNode(tileMappingNode, "search");
+        if (searchNode != NULL)
         {
-            for (constantNode = CGetChildNode(constantsNode, "constant");
-                 constantNode != NULL;
-                 constantNode = CNextNode(constantNode, "constant"))
-            {
-                name = CGetAttribute(constantNode, "name");
-                value = CGetAttribute(constantNode, "value");
-
-                if (name == "a")
-                    cnst_a = value;
-                else if (name == "b")
-                    cnst_b = value;
-                else if (name == "c")
-                    cnst_c = value;
-                else if (name == "d")
-                    cnst_d = value;
-                else if (name == "e")
-                    cnst_e = value;
-                else if (name == "f")
-                    cnst_f = value;
-                else if (name == "g")
-                    cnst_g = value;
-                else if (name == "k")
-                    cnst_k = value;
-                else if (name == "l")
-                    cnst_l = value;
-                else if (name == "m")
-                    cnst_m = value;
-                else if (name == "n")
-                    cnst_n = value;
-                else if (name == "o")
-                    cnst_o = value;
-                else if (name == "p")
-                    cnst_p = value;
-                else if (name == "q")
-                    cnst_q = value;
-            }
+            if (!CHasAttribute(searchNode, "starts"))
+                throw CException("Missing starts attribute on search.");
+            bindingSearchStarts = (uint)CGetAttribute(searchNode, "starts");
+
+            if (CHasAttribute(searchNode, "threads"))
+                bindingSearchThreads = (uint)CGetAttribute(searchNode, "threads");
+            if (CHasAttribute(searchNode, "seed"))
+                bindingSearchSeed = (uint)CGetAttribute(searchNode, "seed");
+        }
+
+        // Throughput analysis method
+        thrAnalysisNode = CGetChildNode(tileMappingNode, "throughputAnalysis");
+        if (thrAnalysisNode != NULL)
+        {
+            if (!CHasAttribute(thrAnalysisNode, "method"))
+                throw CException("Missing method attribute on throughputAnalysis.");
+            CString method = CGetAttribute(thrAnalysisNode, "method");
+
+            if (method == "maxplus")
+                maxPlusThroughputAnalysis = true;
+            else if (method == "statespace")
+                maxPlusThroughputAnalysis = false;
+            else
+                throw CException("Unknown throughput analysis method.");
         }
 
         // Constrains used in NoC scheduling problem
@@ -367,6 +410,160 @@ namespace SDF
             if (maxNrTriesNode != NULL)
                 maxNrTries = (uint)CGetAttribute(maxNrTriesNode, "n");
         }
+
+        // Every application graph in the settings is a mapping job
+        for (list<const ApplicationGraph *>::iterator iter = appGraphs.begin();
+             iter != appGraphs.end(); iter++)
+        {
+            MappingJob job;
+
+            job.name = (*iter)->name;
+            job.appGraph = *iter;
+            job.archGraph = archGraph;
+            job.tileBinding = tileBinding;
+            job.constants = constants;
+            jobs.push_back(job);
+        }
+    }
+
+    /**
+     * parseBatchFile ()
+     * Load the mapping jobs from the batch manifest. The jobs replace the
+     * application graphs of the settings file. Settings which are not given
+     * for a job (architecture graph, tile binding and constants) are taken
+     * from the settings file. Every graph file is parsed only once, also when
+     * it is used by many jobs. The graphs are also built only once.
+     */
+    void Settings::parseBatchFile()
+    {
+        CNode *sdf3Node, *batchNode, *jobNode, *node;
+        set<CString> names;
+        CDoc *batchDoc;
+        CString file;
+
+        // Open manifest and get root node
+        batchDoc = CParseFile(batchFile);
+        sdf3Node = CGetRootNode(batchDoc);
+        if (sdf3Node == NULL)
+            throw CException("Failed opening '" + batchFile + "'.");
+
+        // Is the node of the correct type?
+        if (CGetAttribute(sdf3Node, "type") != module)
+        {
+            throw CException("Root element in file '" + batchFile + "' is not "
+                             "of type '" + module + "'.");
+        }
+
+        batchNode = CGetChildNode(sdf3Node, "batch");
+        if (batchNode == NULL)
+            throw CException("No batch element in '" + batchFile + "'.");
+
+        jobs.clear();
+        for (jobNode = CGetChildNode(batchNode, "job"); jobNode != NULL;
+             jobNode = CNextNode(jobNode, "job"))
+        {
+            MappingJob job;
+
+            // Application graph
+            node = CGetChildNode(jobNode, "applicationGraph");
+            if (node == NULL || !CHasAttribute(node, "file"))
+                throw CException("Missing applicationGraph file of job.");
+            file = CGetAttribute(node, "file");
+            job.appGraph = loadApplicationGraphFromFile(file);
+
+            // Architecture graph
+            node = CGetChildNode(jobNode, "architectureGraph");
+            if (node != NULL)
+            {
+                if (!CHasAttribute(node, "file"))
+                    throw CException("Missing file attribute on "
+                                     "architectureGraph.");
+                file = CGetAttribute(node, "file");
+                job.archGraph = loadArchitectureGraphFromFile(file);
+            }
+            else
+            {
+                job.archGraph = archGraph;
+            }
+            if (job.archGraph == NULL)
+                throw CException("No architectureGraph specified for job.");
+
+            // Custom tile binding
+            node = CGetChildNode(jobNode, "TileBinding");
+            if (node != NULL)
+                job.tileBinding = CGetAttribute(node, "file");
+            else
+                job.tileBinding = tileBinding;
+
+            // Constants used in tile cost function
+            job.constants = constants;
+            node = CGetChildNode(jobNode, "constants");
+            if (node != NULL)
+                parseConstants(node, job.constants);
+
+            // Name of the job (defaults to the name of the application)
+            if (CHasAttribute(jobNode, "name"))
+                job.name = CGetAttribute(jobNode, "name");
+            else
+                job.name = job.appGraph->name;
+            if (!names.insert(job.name).second)
+                throw CException("Job '" + job.name + "' is not unique.");
+
+            jobs.push_back(job);
+        }
+
+        if (jobs.empty())
+            throw CException("No jobs in '" + batchFile + "'.");
+    }
+
+    /**
+     * parseConstants ()
+     * Parse the constants of the tile cost function. Constants which are not
+     * present in the XML node keep their value.
+     */
+    void Settings::parseConstants(CNode *constantsNode,
+                                  TileCostConstants &constants)
+    {
+        CNode *constantNode;
+        CString name;
+        double value;
+
+        for (constantNode = CGetChildNode(constantsNode, "constant");
+             constantNode != NULL;
+             constantNode = CNextNode(constantNode, "constant"))
+        {
+            name = CGetAttribute(constantNode, "name");
+            value = CGetAttribute(constantNode, "value");
+
+            if (name == "a")
+                constants.a = value;
+            else if (name == "b")
+                constants.b = value;
+            else if (name == "c")
+                constants.c = value;
+            else if (name == "d")
+                constants.d = value;
+            else if (name == "e")
+                constants.e = value;
+            else if (name == "f")
+                constants.f = value;
+            else if (name == "g")
+                constants.g = value;
+            else if (name == "k")
+                constants.k = value;
+            else if (name == "l")
+                constants.l = value;
+            else if (name == "m")
+                constants.m = value;
+            else if (name == "n")
+                constants.n = value;
+            else if (name == "o")
+                constants.o = value;
+            else if (name == "p")
+                constants.p = value;
+            else if (name == "q")
+                constants.q = value;
+        }
     }
 
     /**
@@ -375,8 +572,8 @@ namespace SDF
      */
     void Settings::initOutputStream()
     {
-        // Set output stream
-        if (!outputFile.empty())
+        // Set output stream (jobs in batch mode use their own files)
+        if (!outputFile.empty() && batchFile.empty())
             outputStream.open(outputFile.c_str());
         else
             ((ostream &)(outputStream)).rdbuf(cout.rdbuf());
@@ -384,64 +581,128 @@ namespace SDF
 
     /**
      * loadApplicationGraphFromFile ()
-     * The function returns a pointer to an XML data structures contained in the
-     * supplied file that describes the SDFG.
+     * The function returns the application graph contained in the supplied
+     * file. The graph is constructed once and stored in its binary form, from
+     * which the jobs construct their own copies. With the streaming loader
+     * the graph is named after its sdf element, otherwise after its
+     * applicationGraph element.
      */
-    CNode *Settings::loadApplicationGraphFromFile(CString &file)
+    const ApplicationGraph *Settings::loadApplicationGraphFromFile(
+        CString &file)
     {
         CNode *appGraphNode, *sdf3Node;
+        CBinaryWriter sdfGraphBinary;
+        TimedSDFgraph *sdfGraph;
         CDoc *appGraphDoc;
+        CString name;
 
-        // Open file
-        appGraphDoc = CParseFile(file);
-        if (appGraphDoc == NULL)
-            throw CException("Failed loading application from '" + file + "'.");
+        // File loaded before?
+        if (appGraphFiles.find(file) != appGraphFiles.end())
+            return &appGraphFiles[file];
 
-        // Locate the sdf3 root element and check module type
-        sdf3Node = CGetRootNode(appGraphDoc);
-        if (CGetAttribute(sdf3Node, "type") != module)
+        if (streamFlag)
         {
-            throw CException("Root element in file '" + file + "' is not "
-                             "of type '" + module + "'.");
+            // Construct the graph while streaming the file
+            sdfGraph = loadTimedSDFgraph(file, module, graphCache.get());
+            name = sdfGraph->getName();
+        }
+        else
+        {
+            // Open file
+            appGraphDoc = CParseFile(file);
+            if (appGraphDoc == NULL)
+                throw CException("Failed loading application from '" + file + "'.");
+
+            // Locate the sdf3 root element and check module type
+            sdf3Node = CGetRootNode(appGraphDoc);
+            if (CGetAttribute(sdf3Node, "type") != module)
+            {
+                throw CException("Root element in file '" + file + "' is not "
+                                 "of type '" + module + "'.");
+            }
+
+            // Get application graph node
+            appGraphNode = CGetChildNode(sdf3Node, "applicationGraph");
+            if (appGraphNode == NULL)
+                throw CException("No application graph in '" + file + "'.");
+
+            sdfGraph = new TimedSDFgraph();
+            sdfGraph->construct(CGetChildNode(appGraphNode, "sdf"),
+                                CGetChildNode(appGraphNode, "sdfProperties"));
+            name = CGetAttribute(appGraphNode, "name");
         }
 
-        // Get application graph node
-        appGraphNode = CGetChildNode(sdf3Node, "applicationGraph");
-        if (appGraphNode == NULL)
-            throw CException("No application graph in '" + file + "'.");
+        // Graph in binary form
+        writeTimedSDFgraph(sdfGraph, sdfGraphBinary);
+        delete sdfGraph;
 
-        return appGraphNode;
+        ApplicationGraph &appGraph = appGraphFiles[file];
+        appGraph.name = name;
+        appGraph.sdfGraph = sdfGraphBinary.getBuffer();
+
+        return &appGraph;
     }
 
     /**
      * loadArchitectureGraphFromFile ()
-     * The function returns a pointer to an XML data structures contained in the
-     * supplied file that describes the platform.
+     * The function returns the architecture graph contained in the supplied
+     * file. The platform graph is constructed once and stored in its binary
+     * form, from which the jobs construct their own copies. The streaming
+     * loader keeps only the tiles and the network of the XML description.
      */
-    CNode *Settings::loadArchitectureGraphFromFile(CString &file)
+    const ArchitectureGraph *Settings::loadArchitectureGraphFromFile(
+        CString &file)
     {
         CNode *archGraphNode, *sdf3Node;
+        PlatformGraph *platformGraph;
+        CBinaryWriter platformGraphBinary;
         CDoc *archGraphDoc;
 
-        // Open file
-        archGraphDoc = CParseFile(file);
-        if (archGraphDoc == NULL)
-            throw CException("Failed loading architecture from '" + file + "'.");
+        // File loaded before?
+        if (archGraphFiles.find(file) != archGraphFiles.end())
+            return &archGraphFiles[file];
 
-        // Locate the sdf3 root element and check module type
-        sdf3Node = CGetRootNode(archGraphDoc);
-        if (CGetAttribute(sdf3Node, "type") != module)
+        if (streamFlag)
         {
-            throw CException("Root element in file '" + file + "' is not "
-                             "of type '" + module + "'.");
+            // Construct the graph while streaming the file
+            platformGraph = loadPlatformGraph(file, module, graphCache.get());
+            if (platformGraph == NULL)
+                throw CException("No architecture graph in '" + file + "'.");
+            archGraphNode = loadArchitectureNetwork(file, module,
+                                                    graphCache.get());
+        }
+        else
+        {
+            // Open file
+            archGraphDoc = CParseFile(file);
+            if (archGraphDoc == NULL)
+                throw CException("Failed loading architecture from '" + file + "'.");
+
+            // Locate the sdf3 root element and check module type
+            sdf3Node = CGetRootNode(archGraphDoc);
+            if (CGetAttribute(sdf3Node, "type") != module)
+            {
+                throw CException("Root element in file '" + file + "' is not "
+                                 "of type '" + module + "'.");
+            }
+
+            // Get architecture graph node
+            archGraphNode = CGetChildNode(sdf3Node, "architectureGraph");
+            if (archGraphNode == NULL)
+                throw CException("No architecture graph in '" + file + "'.");
+
+            platformGraph = constructPlatformGraph(archGraphNode);
         }
 
-        // Get architecture graph node
-        archGraphNode = CGetChildNode(sdf3Node, "architectureGraph");
-        if (archGraphNode == NULL)
-            throw CException("No architecture graph in '" + file + "'.");
+        // Platform graph in binary form
+        writePlatformGraph(platformGraph, platformGraphBinary);
+        delete platformGraph;
+
+        ArchitectureGraph &archGraph = archGraphFiles[file];
+        archGraph.xmlArchGraph = archGraphNode;
+        archGraph.platformGraph = platformGraphBinary.getBuffer();
 
-        return archGraphNode;
+        return &archGraph;
     }
 
     /**
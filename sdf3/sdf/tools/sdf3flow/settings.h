@@ -12,6 +12,9 @@
  *
  *  History         :
  *      24-07-07    :   Initial version.
+ *      17-10-26    :   Batch mode with a manifest of mapping jobs.
+ *      17-10-26    :   Binary copy of the custom tile binding.
+ *      17-10-26    :   Streaming graph loader and binary graph cache.
  *
  * $Id: settings.h,v 1.3 2008-03-20 16:16:21 sander Exp $
  *
@@ -37,9 +40,81 @@
 #define SDF_TOOLS_SDF3FLOW_SETTINGS_H_INCLUDED
 
 #include "../../sdf.h"
+#include <memory>
 namespace SDF
 {
+    /**
+     * TileCostConstants
+     * Constants used in the tile cost function of the tile binding.
+     */
+    struct TileCostConstants
+    {
+        // Constructor
+        TileCostConstants()
+        {
+            a = 1;
+            b = c = d = e = f = g = 0;
+            k = l = m = n = o = p = q = 1;
+        };
+
+        double a, b, c, d, e, f, g;
+        double k, l, m, n, o, p, q;
+    };
+
+    /**
+     * ApplicationGraph
+     * An application graph of the settings. The graph is built once and kept
+     * in binary form (see base/cache), from which every job constructs its
+     * own copy.
+     */
+    struct ApplicationGraph
+    {
+        // Name of the application graph
+        CString name;
+
+        // Binary form of the timed SDF graph
+        std::string sdfGraph;
+    };
+
+    /**
+     * ArchitectureGraph
+     * An architecture graph of the settings. Its platform graph is built once
+     * and kept in binary form (see base/cache). The flow modifies the
+     * platform graph, so every job constructs its own copy from this form.
+     */
+    struct ArchitectureGraph
+    {
+        // XML description (the NoC mapping reads the network from it; with
+        // the streaming loader only the tiles and the network are present)
+        CNode *xmlArchGraph;
+
+        // Binary form of the platform graph
+        std::string platformGraph;
+    };
 
+    /**
+     * MappingJob
+     * A single mapping of an application graph onto an architecture graph.
+     * The graphs are shared between jobs and must only be read.
+     */
+    struct MappingJob
+    {
+        // Name of the job (used to name its output)
+        CString name;
+
+        // Application and architecture graph
+        const ApplicationGraph *appGraph;
+        const ArchitectureGraph *archGraph;
+
+        // Custom tile binding file ("N/A" when not used)
+        CString tileBinding;
+
+        // Constants used in tile cost function
+        TileCostConstants constants;
+    };
+
+    typedef list<MappingJob> MappingJobs;
+    typedef MappingJobs::iterator MappingJobsIter;
 
     /**
      * Settings
@@ -67,12 +142,21 @@ namespace SDF
             // Parsing of settings
             void parseArguments(CStrings args);
             void parseSettingsFile();
+            void parseBatchFile();
+            void parseConstants(CNode *constantsNode,
+                                TileCostConstants &constants);
 
             // Loading of applications, architecture and usage data
-            CNode *loadApplicationGraphFromFile(CString &file);
-            CNode *loadArchitectureGraphFromFile(CString &file);
+            const ApplicationGraph *loadApplicationGraphFromFile(
+                CString &file);
+            const ArchitectureGraph *loadArchitectureGraphFromFile(
+                CString &file);
             CNode *loadSystemUsageFromFile(CString &file);
 
+            // Graphs loaded so far (every file is parsed only once)
+            map<CString, ApplicationGraph> appGraphFiles;
+            map<CString, ArchitectureGraph> archGraphFiles;
+
         public:
             // MoC supported by the tool
             CString module;
@@ -96,6 +180,21 @@ namespace SDF
             // Output results as HTML
             bool outputAsHTML;
 
+            // Batch manifest (empty when not running in batch mode)
+            CString batchFile;
+
+            // Number of concurrent jobs in batch mode (0 is hardware threads)
+            uint nrThreads;
+
+            // Binary copy of the custom tile binding (empty when not used)
+            CString binaryBindingFile;
+
+            // Build graphs with the streaming parser
+            bool streamFlag;
+
+            // Binary graph cache (empty when not used)
+            std::unique_ptr<CBinaryCache> graphCache;
+
             // Flow type
             SDFflowType flowType;
 
@@ -105,18 +204,25 @@ namespace SDF
             // NoC mapping algorithm
             CString nocMappingAlgo;
 
-            // Application graphs
-            list<CNode *> xmlAppGraphs;
+            // Mapping jobs
+            MappingJobs jobs;
 
             // Architecture graph
-            CNode *xmlArchGraph;
+            const ArchitectureGraph *archGraph;
 
             // Architecture usage information
             CNode *xmlSystemUsage;
 
             // Constants used in tile cost function
-            double cnst_a, cnst_b, cnst_c, cnst_d, cnst_e, cnst_f, cnst_g;
-            double cnst_k, cnst_l, cnst_m, cnst_n, cnst_o, cnst_p, cnst_q;
+            TileCostConstants constants;
+
+            // Search over multiple tile bindings
+            uint bindingSearchStarts;
+            uint bindingSearchThreads;
+            uint bindingSearchSeed;
+
+            // Throughput analysis on the max-plus matrix of the graph
+            bool maxPlusThroughputAnalysis;
 
             // Constrains used in NoC scheduling problem
             uint maxDetour;
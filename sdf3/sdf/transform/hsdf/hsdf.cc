@@ -12,6 +12,7 @@
  *
  *  History         :
  *      20-07-05    :   Initial version.
+ *      17-10-26    :   Index-based addressing of the actor copies.
  *
  * $Id: hsdf.cc,v 1.1.1.1 2007-10-02 10:59:47 sander Exp $
  *
@@ -41,7 +42,11 @@ namespace SDF
 
     /**
      * transformSDFtoHSDF ()
-     * The function transform a SDF graph into a HSDF graph.
+     * The function transform a SDF graph into a HSDF graph. Firing i of actor
+     * a is represented by the HSDF actor a_i. The copies of all actors are
+     * stored in one array in which the copies of an actor start at a prefix
+     * sum of the repetition vector, so the copy of a firing is found in
+     * constant time.
      */
     SDFgraph *transformSDFtoHSDF(SDFgraph *g)
     {
@@ -54,20 +59,28 @@ namespace SDF
         // Calculate repetition vector for the graph
         RepetitionVector repetitionVector = computeRepetitionVector(g);
 
+        // Offset of the first copy of every actor
+        vector<uint> offset(repetitionVector.size() + 1, 0);
+        for (uint a = 0; a < repetitionVector.size(); a++)
+            offset[a + 1] = offset[a] + repetitionVector[a];
+        vector<SDFactor *> copies(offset[repetitionVector.size()], NULL);
+
         // Add actors to graph (number of actors depends on repetition vector)
         for (SDFactorsIter iter = g->actorsBegin(); iter != g->actorsEnd(); iter++)
         {
             SDFactor *gA = *iter;
+            CString prefix = gA->getName() + CString("_");
 
             for (int i = 0; i < repetitionVector[gA->getId()]; i++)
             {
                 // Create new actor
                 component = SDFcomponent(h, h->nrActors());
                 SDFactor *a = gA->createCopy(component);
-                a->setName(gA->getName() + CString("_") + CString(i));
+                a->setName(prefix + CString(i));
 
                 // Add actor to graph
                 h->addActor(a);
+                copies[offset[gA->getId()] + i] = a;
             }
         }
 
@@ -88,48 +101,52 @@ namespace SDF
             uint qA = repetitionVector[gSrcA->getId()];
             uint qB = repetitionVector[gDstA->getId()];
             uint d = gC->getInitialTokens();
+
+            // Copies of the source and destination actor
+            SDFactor **hSrcCopies = &copies[offset[gSrcA->getId()]];
+            SDFactor **hDstCopies = &copies[offset[gDstA->getId()]];
+
+            // Name prefixes of the ports and channels
+            CString srcPrefix = gSrcP->getName() + CString("_");
+            CString dstPrefix = gDstP->getName() + CString("_");
+            CString chPrefix = gC->getName() + CString("_");
+
             for (uint i = 1; i <= qA; i++)
             {
                 // Get pointer to source actor
-                SDFactor *hSrcA = h->getActor(gSrcA->getName()
-                                              + CString("_") + CString(i - 1));
+                SDFactor *hSrcA = hSrcCopies[i - 1];
 
                 for (uint k = 1; k <= nA; k++)
                 {
-                    uint l = 1 + (d + (i - 1) * nA + k - 1) % (nB * qB);
-                    uint j = 1 + (uint)floor((double)((d + (i - 1) * nA + k - 1) %
-                                                      (nB * qB)) / (double)(nB));
+                    // Token produced by this firing (counting initial tokens)
+                    uint n = d + (i - 1) * nA + k - 1;
+                    uint l = 1 + n % (nB * qB);
+                    uint j = 1 + (n % (nB * qB)) / nB;
 
                     // Create port on source node
                     component = SDFcomponent(hSrcA, hSrcA->nrPorts());
                     SDFport *hSrcP = gSrcP->createCopy(component);
-                    hSrcP->setName(gSrcP->getName()
-                                   + CString("_") + CString(k - 1));
+                    hSrcP->setName(srcPrefix + CString(k - 1));
                     hSrcP->setRate(1);
                     hSrcA->addPort(hSrcP);
 
                     // Create port on destination node
-                    SDFactor *hDstA = h->getActor(gDstA->getName()
-                                                  + CString("_") + CString(j - 1));
+                    SDFactor *hDstA = hDstCopies[j - 1];
                     component = SDFcomponent(hDstA, hDstA->nrPorts());
                     SDFport *hDstP = gDstP->createCopy(component);
-                    hDstP->setName(gDstP->getName()
-                                   + CString("_") + CString(l - 1));
+                    hDstP->setName(dstPrefix + CString(l - 1));
                     hDstP->setRate(1);
                     hDstA->addPort(hDstP);
 
                     // Create channel between actors
                     component = SDFcomponent(h, h->nrChannels());
                     SDFchannel *c = gC->createCopy(component);
-                    c->setName(gC->getName() + CString("_")
-                               + CString((i - 1)*nA + (k - 1)));
+                    c->setName(chPrefix + CString((i - 1)*nA + (k - 1)));
                     c->connectSrc(hSrcP);
                     c->connectDst(hDstP);
 
                     // Initial tokens
-                    uint t = (uint) floor((double)(d + (i - 1) * nA + k - 1) /
-                                          (double)(nB * qB));
-                    c->setInitialTokens(t);
+                    c->setInitialTokens(n / (nB * qB));
 
                     // Add channel to graph
                     h->addChannel(c);
@@ -0,0 +1,367 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   mptest.cc
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Check of the max-plus matrix kernels
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#include "mptest.h"
+
+#include "base/maxplus/mpmatrix.h"
+#include "base/random/random.h"
+
+#include <cmath>
+
+using namespace MaxPlus;
+
+// Fraction of the random elements that is -inf
+#define MPTEST_MINUSINFINITY_RATIO  0.3
+
+// Relative tolerance used when comparing finite elements
+#define MPTEST_EPSILON              1e-9
+
+/**
+ * randomElement ()
+ * Returns -inf or a negative finite value. Negative values keep all cycles
+ * negative, so that the closures exist.
+ */
+static MPTime randomElement(MTRand &rnd)
+{
+    if (rnd.rand() < MPTEST_MINUSINFINITY_RATIO)
+        return MP_MINUSINFINITY;
+    return -1.0 - floor(rnd.rand(2000.0)) / 100.0;
+}
+
+/**
+ * randomMatrix ()
+ * Returns a new rows x cols matrix with random elements.
+ */
+static Matrix *randomMatrix(MTRand &rnd, unsigned int rows, unsigned int cols)
+{
+    Matrix *m = new Matrix(rows, cols);
+    for (unsigned int i = 0; i < rows; i++)
+        for (unsigned int j = 0; j < cols; j++)
+            m->put(i, j, randomElement(rnd));
+    return m;
+}
+
+/**
+ * randomVector ()
+ * Returns a new vector with random elements.
+ */
+static Vector *randomVector(MTRand &rnd, unsigned int size)
+{
+    Vector *v = new Vector(size);
+    for (unsigned int i = 0; i < size; i++)
+        v->put(i, randomElement(rnd));
+    return v;
+}
+
+/**
+ * equalElements ()
+ * Two elements are equal when both are -inf or when they are finite and
+ * differ by less than the relative tolerance.
+ */
+static bool equalElements(CDouble a, CDouble b)
+{
+    if (MP_ISMINUSINFINITY(a) || MP_ISMINUSINFINITY(b))
+        return MP_ISMINUSINFINITY(a) && MP_ISMINUSINFINITY(b);
+    return fabs(a - b) <= MPTEST_EPSILON * (fabs(a) > 1.0 ? fabs(a) : 1.0);
+}
+
+/**
+ * referenceProduct ()
+ * Element-wise definition of the matrix product:
+ * r(i,j) = max_k a(i,k) + b(k,j).
+ */
+static Matrix *referenceProduct(const Matrix &a, const Matrix &b)
+{
+    Matrix *r = new Matrix(a.getRows(), b.getCols());
+    for (unsigned int i = 0; i < a.getRows(); i++)
+    {
+        for (unsigned int j = 0; j < b.getCols(); j++)
+        {
+            MPTime e = MP_MINUSINFINITY;
+            for (unsigned int k = 0; k < a.getCols(); k++)
+                e = MP_MAX(e, MP_PLUS(a.get(i, k), b.get(k, j)));
+            r->put(i, j, e);
+        }
+    }
+    return r;
+}
+
+/**
+ * referenceClosure ()
+ * Definition of the closures: A+ = max(A, A^2, ..., A^N) and, with
+ * implied zero self-edges, A* = max(E, A+).
+ */
+static Matrix *referenceClosure(const Matrix &a, bool implyZeroSelfEdges)
+{
+    const unsigned int N = a.getRows();
+    Matrix *closure = a.createCopy();
+    Matrix *power = a.createCopy();
+
+    for (unsigned int n = 1; n < N; n++)
+    {
+        Matrix *next = referenceProduct(*power, a);
+        delete power;
+        power = next;
+        for (unsigned int i = 0; i < N; i++)
+            for (unsigned int j = 0; j < N; j++)
+                closure->put(i, j, MP_MAX(closure->get(i, j), power->get(i, j)));
+    }
+    delete power;
+
+    if (implyZeroSelfEdges)
+    {
+        for (unsigned int i = 0; i < N; i++)
+            closure->put(i, i, MP_MAX(closure->get(i, i), MPTime(0)));
+    }
+    return closure;
+}
+
+/**
+ * compareMatrices ()
+ * Compares a kernel result against its reference and reports the first
+ * mismatch on out.
+ */
+static bool compareMatrices(ostream &out, const char *operation,
+                            const Matrix &result, const Matrix &reference)
+{
+    if (result.getRows() != reference.getRows()
+        || result.getCols() != reference.getCols())
+    {
+        out << operation << ": result has the wrong size." << std::endl;
+        return false;
+    }
+
+    for (unsigned int i = 0; i < result.getRows(); i++)
+    {
+        for (unsigned int j = 0; j < result.getCols(); j++)
+        {
+            if (!equalElements(result.get(i, j), reference.get(i, j)))
+            {
+                out << operation << ": element (" << i << "," << j << ") is "
+                    << (CDouble) result.get(i, j) << " instead of "
+                    << (CDouble) reference.get(i, j) << "." << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * compareVectors ()
+ * Compares a kernel result against its reference and reports the first
+ * mismatch on out.
+ */
+static bool compareVectors(ostream &out, const char *operation,
+                           const Vector &result, const Vector &reference)
+{
+    if (result.getSize() != reference.getSize())
+    {
+        out << operation << ": result has the wrong size." << std::endl;
+        return false;
+    }
+
+    for (unsigned int i = 0; i < result.getSize(); i++)
+    {
+        if (!equalElements(result.get(i), reference.get(i)))
+        {
+            out << operation << ": element " << i << " is "
+                << (CDouble) result.get(i) << " instead of "
+                << (CDouble) reference.get(i) << "." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * testVectorOperations ()
+ * Matrix-vector product, vector maximum and vector addition.
+ */
+static bool testVectorOperations(ostream &out, MTRand &rnd,
+                                 unsigned int rows, unsigned int cols)
+{
+    bool correct = true;
+    Matrix *a = randomMatrix(rnd, rows, cols);
+    Vector *x = randomVector(rnd, cols);
+    Vector *y = randomVector(rnd, cols);
+    MPTime c = randomElement(rnd);
+
+    // Matrix-vector product
+    Vector *ax = a->mpmultiply(*x);
+    Vector refAx(rows);
+    for (unsigned int i = 0; i < rows; i++)
+    {
+        MPTime e = MP_MINUSINFINITY;
+        for (unsigned int k = 0; k < cols; k++)
+            e = MP_MAX(e, MP_PLUS(a->get(i, k), x->get(k)));
+        refAx.put(i, e);
+    }
+    correct = correct && compareVectors(out, "Matrix::mpmultiply(Vector)",
+                                        *ax, refAx);
+
+    // Maximum, vector addition and scalar addition
+    Vector xMaxY(cols), refMax(cols), refAdd(cols), refScalar(cols);
+    x->maximum(y, &xMaxY);
+    Vector *xPlusY = x->add(y);
+    Vector *xPlusC = x->add(c);
+    for (unsigned int i = 0; i < cols; i++)
+    {
+        refMax.put(i, MP_MAX(x->get(i), y->get(i)));
+        refAdd.put(i, MP_PLUS(x->get(i), y->get(i)));
+        refScalar.put(i, MP_PLUS(x->get(i), c));
+    }
+    correct = correct && compareVectors(out, "Vector::maximum", xMaxY, refMax);
+    correct = correct && compareVectors(out, "Vector::add(Vector)", *xPlusY,
+                                        refAdd);
+    correct = correct && compareVectors(out, "Vector::add(MPTime)", *xPlusC,
+                                        refScalar);
+
+    // Cleanup
+    delete a;
+    delete x;
+    delete y;
+    delete ax;
+    delete xPlusY;
+    delete xPlusC;
+
+    return correct;
+}
+
+/**
+ * testMatrixOperations ()
+ * Matrix maximum, scalar addition and matrix-matrix product.
+ */
+static bool testMatrixOperations(ostream &out, MTRand &rnd, unsigned int rows,
+                                 unsigned int inner, unsigned int cols)
+{
+    bool correct = true;
+    Matrix *a = randomMatrix(rnd, rows, inner);
+    Matrix *b = randomMatrix(rnd, rows, inner);
+    Matrix *m = randomMatrix(rnd, inner, cols);
+    MPTime c = randomElement(rnd);
+
+    // Maximum and scalar addition
+    Matrix aMaxB(rows, inner), refMax(rows, inner), refAdd(rows, inner);
+    a->maximum(b, &aMaxB);
+    Matrix *aPlusC = a->add(c);
+    for (unsigned int i = 0; i < rows; i++)
+    {
+        for (unsigned int j = 0; j < inner; j++)
+        {
+            refMax.put(i, j, MP_MAX(a->get(i, j), b->get(i, j)));
+            refAdd.put(i, j, MP_PLUS(a->get(i, j), c));
+        }
+    }
+    correct = correct && compareMatrices(out, "Matrix::maximum", aMaxB, refMax);
+    correct = correct && compareMatrices(out, "Matrix::add(MPTime)", *aPlusC,
+                                         refAdd);
+
+    // Matrix-matrix product
+    Matrix *am = a->mpmultiply(*m);
+    Matrix *refAm = referenceProduct(*a, *m);
+    correct = correct && compareMatrices(out, "Matrix::mpmultiply(Matrix)",
+                                         *am, *refAm);
+
+    // Cleanup
+    delete a;
+    delete b;
+    delete m;
+    delete aPlusC;
+    delete am;
+    delete refAm;
+
+    return correct;
+}
+
+/**
+ * testClosures ()
+ * All-pair longest path matrix with and without implied self-edges.
+ */
+static bool testClosures(ostream &out, MTRand &rnd, unsigned int size)
+{
+    bool correct = true;
+    Matrix *a = randomMatrix(rnd, size, size);
+
+    for (unsigned int implied = 0; implied < 2; implied++)
+    {
+        Matrix *closure = a->allPairLongestPathMatrix(MP_EPSILON, implied == 1);
+        Matrix *refClosure = referenceClosure(*a, implied == 1);
+        correct = correct && compareMatrices(out,
+                                             "Matrix::allPairLongestPathMatrix", *closure, *refClosure);
+        delete closure;
+        delete refClosure;
+    }
+
+    // Cleanup
+    delete a;
+
+    return correct;
+}
+
+/**
+ * testMaxPlusKernels ()
+ * Compare the results of the MaxPlus::Vector and MaxPlus::Matrix operations
+ * against their element-wise definitions on random (partially -inf)
+ * operands. The sizes cover the remainder loops of the inner product lanes
+ * and partial blocks of the matrix-matrix product.
+ */
+bool testMaxPlusKernels(ostream &out)
+{
+    const unsigned int sizes[] = { 1, 2, 3, 15, 16, 17, 33, 70 };
+    const unsigned int nrSizes = sizeof(sizes) / sizeof(sizes[0]);
+    MTRand rnd(1);
+    bool correct = true;
+
+    for (unsigned int i = 0; i < nrSizes && correct; i++)
+    {
+        for (unsigned int j = 0; j < nrSizes && correct; j++)
+        {
+            correct = testVectorOperations(out, rnd, sizes[i], sizes[j]);
+            if (correct)
+            {
+                correct = testMatrixOperations(out, rnd, sizes[i], sizes[j],
+                                               sizes[(i + j) % nrSizes]);
+            }
+        }
+        if (correct)
+            correct = testClosures(out, rnd, sizes[i]);
+    }
+
+    // Blocks of the right operand of the matrix-matrix product are 64 rows
+    // by 512 columns
+    if (correct)
+        correct = testMatrixOperations(out, rnd, 5, 131, 1029);
+
+    return correct;
+}
@@ -0,0 +1,50 @@
+/*
+ *  TU Eindhoven
+ *  Eindhoven, The Netherlands
+ *
+ *  Name            :   mptest.h
+ *
+ *  Author          :   DFSynthesizer contributors
+ *
+ *  Date            :   October 17, 2026
+ *
+ *  Function        :   Check of the max-plus matrix kernels
+ *
+ *  History         :
+ *      17-10-26    :   Initial version.
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ *
+ * In other words, you are welcome to use, share and improve this program.
+ * You are forbidden to forbid anyone else to use, share and improve
+ * what you give them.   Happy coding!
+ */
+
+#ifndef TOOLS_TEST_MPTEST_H_INCLUDED
+#define TOOLS_TEST_MPTEST_H_INCLUDED
+
+#include <iostream>
+
+using std::ostream;
+
+/**
+ * testMaxPlusKernels ()
+ * Compare the results of the MaxPlus::Vector and MaxPlus::Matrix operations
+ * against their element-wise definitions on random (partially -inf)
+ * operands. Mismatches are reported on out. The function returns true when
+ * all results match.
+ */
+bool testMaxPlusKernels(ostream &out);
+
+#endif
@@ -35,6 +35,7 @@
 
 #include "runtest.h"
 #include "tester.h"
+#include "mptest.h"
 
 #include "base/exception/exception.h"
 #include "base/shell/dirs.h"
@@ -94,6 +95,18 @@ int main(int argc, char **argv)
         //        else
         ((ostream &)(out)).rdbuf(cout.rdbuf());
 
+        // Check the max-plus kernels against their definitions
+        cout << "Processing test: max-plus kernels";
+        if (testMaxPlusKernels(cout))
+        {
+            cout << " pass." << endl;
+        }
+        else
+        {
+            cout << " fail." << endl;
+            exit_status = 1;
+        }
+
         // Perform requested actions
         Tester tester;
         tester.runTest(startdir, out);